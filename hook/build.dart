@@ -70,6 +70,7 @@ Future<void> _builder(BuildInput input, BuildOutputBuilder output) async {
       "MNN_KLEIDIAI": 'OFF',
       "MNN_BUILD_OPENCV": "ON",
       "MNN_IMGCODECS": "OFF",
+      "MNN_WITH_PLUGIN": "ON",
       ...defines,
     },
   );
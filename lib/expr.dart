@@ -1,4 +1,8 @@
+export 'src/expr/eager.dart';
 export 'src/expr/expr.dart';
 export 'src/expr/formatter.dart';
+export 'src/expr/graph.dart';
 export 'src/expr/op.dart';
+export 'src/expr/plugin.dart';
+export 'src/expr/scope.dart';
 // export 'src/expr/utils.dart';
@@ -9,24 +9,38 @@ export 'src/core/autotime.dart';
 export 'src/core/backend.dart';
 export 'src/core/base.dart';
 export 'src/core/constant.dart';
+export 'src/core/detection.dart';
 export 'src/core/exception.dart';
 export 'src/core/halide_runtime.dart';
 export 'src/core/interpreter.dart';
+export 'src/core/npy.dart';
+export 'src/core/postprocess.dart';
+export 'src/core/quantize.dart';
 export 'src/core/runtime_info.dart';
 export 'src/core/schedule.dart';
 export 'src/core/session.dart';
+export 'src/core/stats.dart';
 export 'src/core/tensor.dart';
+export 'src/core/topk.dart';
 export 'src/core/vec.dart';
+export 'src/expr/eager.dart';
 export 'src/expr/expr.dart';
 export 'src/expr/formatter.dart';
+export 'src/expr/graph.dart';
+export 'src/expr/plugin.dart';
+export 'src/expr/scope.dart';
 export 'src/expr/utils.dart';
 export 'src/g/mnn.g.dart'
     show
+        DetectFormat,
         DimensionType,
         HalideTypeCode,
         HandleDataType,
         ErrorCode,
         MapType,
+        NmsMethod,
+        RngDistribution,
+        ScoreActivation,
         StbirDataType,
         StbirEdge,
         StbirFilter,
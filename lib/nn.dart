@@ -1,2 +1,3 @@
 export 'src/nn/executor.dart';
 export 'src/nn/module.dart';
+export 'src/nn/sampler.dart';
@@ -0,0 +1,304 @@
+/// Copyright (c) 2025, rainyl. All rights reserved.
+/// Use of this source code is governed by a
+/// Apache 2.0 license that can be found in the LICENSE file.
+
+import 'dart:ffi' as ffi;
+import 'dart:math' as math;
+
+import 'package:ffi/ffi.dart';
+
+import '../g/mnn.g.dart' as c;
+import 'base.dart';
+import 'exception.dart';
+import 'postprocess.dart';
+
+/// A detected box in original image coordinates if a [Letterbox] is given,
+/// otherwise in network input coordinates.
+typedef Detection = ({double x0, double y0, double x1, double y1, double score, int classId});
+
+/// Mapping from network input coordinates back to the original image,
+/// `xOriginal = (x - padX) / scale`.
+class Letterbox {
+  const Letterbox({required this.scale, this.padX = 0, this.padY = 0, this.width = 0, this.height = 0});
+
+  /// Letterbox of an image of [srcWidth] x [srcHeight] resized with its aspect ratio kept
+  /// and padded to [dstWidth] x [dstHeight], centered if [center] is true.
+  factory Letterbox.fit(int srcWidth, int srcHeight, int dstWidth, int dstHeight, {bool center = true}) {
+    final scale = math.min(dstWidth / srcWidth, dstHeight / srcHeight);
+    return Letterbox(
+      scale: scale,
+      padX: center ? (dstWidth - srcWidth * scale) / 2 : 0,
+      padY: center ? (dstHeight - srcHeight * scale) / 2 : 0,
+      width: srcWidth.toDouble(),
+      height: srcHeight.toDouble(),
+    );
+  }
+
+  final double scale;
+  final double padX;
+  final double padY;
+
+  /// size of the original image to clip boxes to, <= 0 disables clipping
+  final double width;
+  final double height;
+
+  @override
+  String toString() => 'Letterbox(scale=$scale, pad=($padX, $padY), size=($width, $height))';
+}
+
+/// Parameters of [detectPostprocess].
+class DetectParams {
+  const DetectParams({
+    this.format = c.DetectFormat.MNN_DETECT_YOLO,
+    this.activation = c.ScoreActivation.MNN_SCORE_NONE,
+    this.scoreThreshold = 0.25,
+    this.iouThreshold = 0.45,
+    this.topK = 0,
+    this.maxDetections = 100,
+    this.classAgnostic = false,
+    this.backgroundClass = -1,
+    this.variances = const [0.1, 0.1, 0.2, 0.2],
+  });
+
+  final c.DetectFormat format;
+  final c.ScoreActivation activation;
+  final double scoreThreshold;
+  final double iouThreshold;
+
+  /// highest scoring candidates kept per image before NMS, <= 0 keeps all
+  final int topK;
+
+  /// maximum number of detections per image
+  final int maxDetections;
+
+  /// whether boxes of different classes suppress each other
+  final bool classAgnostic;
+
+  /// class never reported, e.g., 0 for SSD, -1 for none
+  final int backgroundClass;
+
+  /// SSD only, scales of dx, dy, dw and dh
+  final List<double> variances;
+
+  ffi.Pointer<c.mnn_detect_params_t> _toNative() {
+    if (maxDetections <= 0 || variances.length != 4) {
+      throw MNNException('Invalid detect params: $this');
+    }
+    final p = calloc<c.mnn_detect_params_t>()
+      ..ref.format = format.value
+      ..ref.activation = activation.value
+      ..ref.score_threshold = scoreThreshold
+      ..ref.iou_threshold = iouThreshold
+      ..ref.top_k = topK
+      ..ref.max_detections = maxDetections
+      ..ref.class_agnostic = classAgnostic
+      ..ref.background_class = backgroundClass;
+    for (var i = 0; i < 4; i++) {
+      p.ref.variances[i] = variances[i];
+    }
+    return p;
+  }
+
+  @override
+  String toString() {
+    return 'DetectParams(format=$format, activation=$activation, scoreThreshold=$scoreThreshold, '
+        'iouThreshold=$iouThreshold, topK=$topK, maxDetections=$maxDetections)';
+  }
+}
+
+/// @brief Decode, score filter, NMS and letterbox un-mapping of a detection head in one native call.
+///
+/// @param head float data of the head, box regressions for SSD.
+///
+/// @param headLayout layout of [head] viewed as [batch, channel, anchors], use
+/// [TensorLayout.channelLast] for [batch, anchors, channel] heads.
+///
+/// @param scores SSD class scores with [scoreLayout], and [priors] of shape [anchors, 4]
+/// as cx, cy, w, h in input pixels.
+///
+/// @param letterbox empty for no mapping, one shared letterbox or one for each image.
+///
+/// @param numThreads number of threads, <= 0 means using all available threads.
+///
+/// @return detections of each image sorted by score.
+List<List<Detection>> detectPostprocess(
+  ffi.Pointer<ffi.Float> head,
+  TensorLayout headLayout,
+  DetectParams params, {
+  ffi.Pointer<ffi.Float>? scores,
+  TensorLayout? scoreLayout,
+  ffi.Pointer<ffi.Float>? priors,
+  List<Letterbox> letterbox = const [],
+  int numThreads = 0,
+}) {
+  final batch = headLayout.batch;
+  final pHeadLayout = headLayout.toNative();
+  final pScoreLayout = scoreLayout?.toNative() ?? ffi.nullptr;
+  final pParams = params._toNative();
+  final pLetterbox = letterbox.isEmpty ? ffi.nullptr : calloc<c.mnn_letterbox_t>(letterbox.length);
+  final pDets = calloc<c.mnn_detection_t>(batch * params.maxDetections);
+  final pCounts = calloc<ffi.Int32>(batch);
+  try {
+    for (var i = 0; i < letterbox.length; i++) {
+      pLetterbox[i]
+        ..scale = letterbox[i].scale
+        ..pad_x = letterbox[i].padX
+        ..pad_y = letterbox[i].padY
+        ..width = letterbox[i].width
+        ..height = letterbox[i].height;
+    }
+    mnnRun(
+      () => c.mnn_detect_postprocess(
+        head,
+        pHeadLayout,
+        scores ?? ffi.nullptr,
+        pScoreLayout,
+        priors ?? ffi.nullptr,
+        pParams,
+        pLetterbox,
+        letterbox.length,
+        pDets,
+        pCounts,
+        numThreads,
+      ),
+    );
+    return List.generate(batch, (n) {
+      final base = n * params.maxDetections;
+      return List.generate(pCounts[n], (i) {
+        final d = pDets[base + i];
+        return (x0: d.x0, y0: d.y0, x1: d.x1, y1: d.y1, score: d.score, classId: d.class_id);
+      });
+    });
+  } finally {
+    calloc.free(pHeadLayout);
+    if (pScoreLayout != ffi.nullptr) calloc.free(pScoreLayout);
+    calloc.free(pParams);
+    if (pLetterbox != ffi.nullptr) calloc.free(pLetterbox);
+    calloc.free(pDets);
+    calloc.free(pCounts);
+  }
+}
+
+/// A box kept by [nmsBatched], [score] is decayed by Soft-NMS.
+typedef NmsResult = ({int boxIndex, int classId, double score});
+
+/// Parameters of [nmsBatched].
+class NmsParams {
+  const NmsParams({
+    this.method = c.NmsMethod.MNN_NMS_HARD,
+    this.iouThreshold = 0.5,
+    this.scoreThreshold = 0.0,
+    this.sigma = 0.5,
+    this.maxPerClass = 0,
+    this.maxDetections = 100,
+    this.classAgnostic = false,
+    this.rotated = false,
+  });
+
+  final c.NmsMethod method;
+  final double iouThreshold;
+
+  /// candidates below it are dropped, also after Soft-NMS decay
+  final double scoreThreshold;
+
+  /// gaussian Soft-NMS only
+  final double sigma;
+
+  /// maximum number of boxes kept per class and image, <= 0 means no limit
+  final int maxPerClass;
+
+  /// maximum number of boxes kept per image
+  final int maxDetections;
+
+  /// whether boxes of different classes suppress each other
+  final bool classAgnostic;
+
+  /// whether boxes are rotated [cx, cy, w, h, angle] with angle in radians
+  final bool rotated;
+
+  ffi.Pointer<c.mnn_nms_params_t> _toNative() {
+    if (maxDetections <= 0) {
+      throw MNNException('Invalid nms params: $this');
+    }
+    return calloc<c.mnn_nms_params_t>()
+      ..ref.method = method.value
+      ..ref.iou_threshold = iouThreshold
+      ..ref.score_threshold = scoreThreshold
+      ..ref.sigma = sigma
+      ..ref.max_per_class = maxPerClass
+      ..ref.max_detections = maxDetections
+      ..ref.class_agnostic = classAgnostic
+      ..ref.rotated = rotated;
+  }
+
+  @override
+  String toString() {
+    return 'NmsParams(method=$method, iouThreshold=$iouThreshold, scoreThreshold=$scoreThreshold, '
+        'maxPerClass=$maxPerClass, maxDetections=$maxDetections, classAgnostic=$classAgnostic, '
+        'rotated=$rotated)';
+  }
+}
+
+/// @brief Batched multi-class NMS, every class of every image is suppressed in parallel.
+///
+/// @param boxes boxes shared by all classes, [batch, numBoxes, 4] as x0, y0, x1, y1,
+/// or [batch, numBoxes, 5] as cx, cy, w, h, angle if [NmsParams.rotated].
+///
+/// @param scores scores, [batch, numBoxes, numClasses].
+///
+/// @param numThreads number of threads, <= 0 means using all available threads.
+///
+/// @return kept boxes of each image sorted by score.
+List<List<NmsResult>> nmsBatched(
+  ffi.Pointer<ffi.Float> boxes,
+  ffi.Pointer<ffi.Float> scores,
+  int batch,
+  int numBoxes,
+  int numClasses,
+  NmsParams params, {
+  int numThreads = 0,
+}) {
+  final pParams = params._toNative();
+  final pResults = calloc<c.mnn_nms_result_t>(batch * params.maxDetections);
+  final pCounts = calloc<ffi.Int32>(batch);
+  try {
+    mnnRun(
+      () => c.mnn_nms_batched(
+        boxes,
+        scores,
+        batch,
+        numBoxes,
+        numClasses,
+        pParams,
+        pResults,
+        pCounts,
+        numThreads,
+      ),
+    );
+    return List.generate(batch, (n) {
+      final base = n * params.maxDetections;
+      return List.generate(pCounts[n], (i) {
+        final r = pResults[base + i];
+        return (boxIndex: r.box_index, classId: r.class_id, score: r.score);
+      });
+    });
+  } finally {
+    calloc.free(pParams);
+    calloc.free(pResults);
+    calloc.free(pCounts);
+  }
+}
+
+/// Intersection over union of two rotated boxes [cx, cy, w, h, angle] with angle in radians.
+double rotatedIou(List<double> a, List<double> b) {
+  MnnAssert(a.length == 5 && b.length == 5, 'rotated boxes must be [cx, cy, w, h, angle]');
+  final p = calloc<ffi.Float>(10);
+  try {
+    p.asTypedList(10)
+      ..setAll(0, a)
+      ..setAll(5, b);
+    return c.mnn_rotated_iou(p, p + 5);
+  } finally {
+    calloc.free(p);
+  }
+}
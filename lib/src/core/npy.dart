@@ -0,0 +1,111 @@
+/// Copyright (c) 2025, rainyl. All rights reserved.
+/// Use of this source code is governed by a
+/// Apache 2.0 license that can be found in the LICENSE file.
+
+import 'dart:ffi' as ffi;
+
+import 'package:ffi/ffi.dart';
+
+import '../g/mnn.g.dart' as c;
+import 'base.dart';
+import 'exception.dart';
+import 'tensor.dart';
+
+/// A set of named tensors stored in one file, see [NpyArchive.save].
+///
+/// Tensors of an archive reference the file data directly without copying,
+/// a plain .npy file can also be opened as an archive with one entry named "".
+class NpyArchive extends NativeObject {
+  static final ffi.NativeFinalizer _finalizer = ffi.NativeFinalizer(c.addresses.mnn_npy_archive_destroy);
+
+  // keeps the archive alive as long as any tensor obtained from it is reachable
+  static final _owners = Expando<NpyArchive>('NpyArchive');
+
+  NpyArchive.fromPointer(c.mnn_npy_archive_t ptr, {super.attach, super.externalSize}) : super(ptr.cast());
+
+  /// @brief Open an archive or a single .npy file
+  ///
+  /// @param path File path
+  ///
+  /// @param mmap Whether to memory-map the file (copy-on-write), otherwise the file is read once
+  factory NpyArchive.open(String path, {bool mmap = true}) {
+    final cPath = path.toNativeUtf8().cast<ffi.Char>();
+    final p = c.mnn_npy_archive_open(cPath, mmap);
+    malloc.free(cPath);
+    if (p == ffi.nullptr) {
+      throw MNNException('Failed to open npy archive: $path');
+    }
+    return NpyArchive.fromPointer(p);
+  }
+
+  /// @brief Save named host tensors to an archive file
+  ///
+  /// @param path File path
+  ///
+  /// @param tensors Named host tensors
+  static void save(String path, Map<String, Tensor> tensors) {
+    final cPath = path.toNativeUtf8().cast<ffi.Char>();
+    final names = tensors.keys.toList();
+    final cNames = calloc<ffi.Pointer<ffi.Char>>(names.length);
+    final cTensors = calloc<c.mnn_tensor_t>(names.length);
+    for (var i = 0; i < names.length; i++) {
+      cNames[i] = names[i].toNativeUtf8().cast<ffi.Char>();
+      cTensors[i] = tensors[names[i]]!.ptr;
+    }
+    try {
+      mnnRun(() => c.mnn_npy_save_archive(cPath, cNames, cTensors, names.length));
+    } finally {
+      for (var i = 0; i < names.length; i++) {
+        malloc.free(cNames[i]);
+      }
+      calloc.free(cNames);
+      calloc.free(cTensors);
+      malloc.free(cPath);
+    }
+  }
+
+  int get length => c.mnn_npy_archive_size(ptr);
+
+  List<String> get names =>
+      List.generate(length, (i) => c.mnn_npy_archive_name(ptr, i).cast<Utf8>().toDartString());
+
+  /// @brief Get the i-th tensor, the tensor shares memory with the archive
+  Tensor at(int index) {
+    final p = c.mnn_npy_archive_get(ptr, index);
+    if (p == ffi.nullptr) {
+      throw MNNException('index=$index out of range [0, $length)');
+    }
+    final tensor = Tensor.fromPointer(p, attach: false);
+    _owners[tensor] = this;
+    return tensor;
+  }
+
+  /// @brief Get tensor by name, the tensor shares memory with the archive
+  Tensor? operator [](String name) {
+    final cName = name.toNativeUtf8().cast<ffi.Char>();
+    final index = c.mnn_npy_archive_find(ptr, cName);
+    malloc.free(cName);
+    return index < 0 ? null : at(index);
+  }
+
+  Map<String, Tensor> toMap() {
+    final names = this.names;
+    return {for (var i = 0; i < names.length; i++) names[i]: at(i)};
+  }
+
+  @override
+  ffi.NativeFinalizer get finalizer => _finalizer;
+
+  @override
+  void release() {
+    c.mnn_npy_archive_destroy(ptr);
+  }
+
+  @override
+  List<Object?> get props => [ptr.address];
+
+  @override
+  String toString() {
+    return 'NpyArchive(address=0x${ptr.address.toRadixString(16)}, length=$length)';
+  }
+}
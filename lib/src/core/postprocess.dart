@@ -0,0 +1,179 @@
+/// Copyright (c) 2025, rainyl. All rights reserved.
+/// Use of this source code is governed by a
+/// Apache 2.0 license that can be found in the LICENSE file.
+
+import 'dart:ffi' as ffi;
+import 'dart:typed_data';
+
+import 'package:ffi/ffi.dart';
+
+import '../g/mnn.g.dart' as c;
+import 'base.dart';
+import 'exception.dart';
+
+/// Memory layout of a tensor or variable viewed as [batch, channel, area].
+///
+/// Element (n, c, a) is at
+/// `n * batchStride + (c ~/ pack) * channelStride + a * areaStride + c % pack`,
+/// which covers NCHW, NHWC and the packed NC4HW4 layout, so outputs can be
+/// postprocessed without converting them to NCHW first. NC4HW4 is `[C/4][N][area][4]`
+/// as in MNN, each block of 4 channels holds every batch.
+class TensorLayout {
+  const TensorLayout({
+    required this.dimType,
+    required this.batch,
+    required this.channel,
+    required this.area,
+    required this.pack,
+    required this.batchStride,
+    required this.channelStride,
+    required this.areaStride,
+  });
+
+  /// Layout of contiguous [batch, area, channel] data, e.g., a [1, 8400, 84] detection head.
+  const TensorLayout.channelLast(this.batch, this.area, this.channel)
+    : dimType = c.DimensionType.MNN_TENSORFLOW,
+      pack = 1,
+      batchStride = area * channel,
+      channelStride = 1,
+      areaStride = channel;
+
+  final c.DimensionType dimType;
+  final int batch;
+  final int channel;
+
+  /// product of the spatial dims
+  final int area;
+
+  /// channels stored together, 4 for NC4HW4 and 1 otherwise
+  final int pack;
+
+  /// strides in elements
+  final int batchStride;
+  final int channelStride;
+  final int areaStride;
+
+  /// @brief Query a layout from native.
+  ///
+  /// @param func native query function, e.g., mnn_tensor_get_layout
+  static TensorLayout query(c.ErrorCode Function(ffi.Pointer<c.mnn_tensor_layout_t> layout) func) {
+    final p = calloc<c.mnn_tensor_layout_t>();
+    try {
+      mnnRun(() => func(p));
+      final l = p.ref;
+      return TensorLayout(
+        dimType: l.dim_type,
+        batch: l.batch,
+        channel: l.channel,
+        area: l.area,
+        pack: l.pack,
+        batchStride: l.batch_stride,
+        channelStride: l.channel_stride,
+        areaStride: l.area_stride,
+      );
+    } finally {
+      calloc.free(p);
+    }
+  }
+
+  /// whether channels are packed, i.e., NC4HW4
+  bool get isPacked => pack > 1;
+
+  /// number of elements in memory, including the padding of packed channels
+  int get storageSize => isPacked ? (channel + pack - 1) ~/ pack * channelStride : batch * batchStride;
+
+  /// @brief Channel-wise argmax over float data of this layout, ties resolve to the smallest channel.
+  ///
+  /// @param data float data, e.g., host of a tensor or readMap of a variable.
+  ///
+  /// @param numThreads number of threads, <= 0 means using all available threads.
+  ///
+  /// @return channel indices and max values, both of shape [batch, area].
+  (Int32List, Float32List) channelArgmax(ffi.Pointer<ffi.Float> data, {int numThreads = 0}) {
+    final count = batch * area;
+    final pLayout = toNative();
+    final pIndices = calloc<ffi.Int32>(count);
+    final pScores = calloc<ffi.Float>(count);
+    try {
+      mnnRun(() => c.mnn_channel_argmax(data, pLayout, pIndices, pScores, numThreads));
+      return (
+        Int32List.fromList(pIndices.asTypedList(count)),
+        Float32List.fromList(pScores.asTypedList(count)),
+      );
+    } finally {
+      calloc.free(pLayout);
+      calloc.free(pIndices);
+      calloc.free(pScores);
+    }
+  }
+
+  /// @brief Channel-wise softmax over float data of this layout.
+  ///
+  /// @param data float data, e.g., host of a tensor or readMap of a variable.
+  ///
+  /// @param numThreads number of threads, <= 0 means using all available threads.
+  ///
+  /// @return probabilities in NCHW, shape [batch, channel, area].
+  Float32List channelSoftmax(ffi.Pointer<ffi.Float> data, {int numThreads = 0}) {
+    final count = batch * channel * area;
+    final pLayout = toNative();
+    final pDst = calloc<ffi.Float>(count);
+    try {
+      mnnRun(() => c.mnn_channel_softmax(data, pLayout, pDst, numThreads));
+      return Float32List.fromList(pDst.asTypedList(count));
+    } finally {
+      calloc.free(pLayout);
+      calloc.free(pDst);
+    }
+  }
+
+  /// @brief Element-wise sigmoid followed by a threshold over float data of this layout.
+  ///
+  /// @param data float data, e.g., host of a tensor or readMap of a variable.
+  ///
+  /// @param threshold probability threshold in [0, 1].
+  ///
+  /// @param numThreads number of threads, <= 0 means using all available threads.
+  ///
+  /// @return mask in NCHW with shape [batch, channel, area], 1 where sigmoid(x) > threshold,
+  /// and the number of positive elements.
+  (Uint8List, int) channelSigmoidThreshold(
+    ffi.Pointer<ffi.Float> data,
+    double threshold, {
+    int numThreads = 0,
+  }) {
+    final count = batch * channel * area;
+    final pLayout = toNative();
+    final pMask = calloc<ffi.Uint8>(count);
+    final pCount = calloc<ffi.Size>();
+    try {
+      mnnRun(() => c.mnn_channel_sigmoid_threshold(data, pLayout, threshold, pMask, pCount, numThreads));
+      return (Uint8List.fromList(pMask.asTypedList(count)), pCount.value);
+    } finally {
+      calloc.free(pLayout);
+      calloc.free(pMask);
+      calloc.free(pCount);
+    }
+  }
+
+  /// Native copy of this layout, must be freed by calloc.free.
+  ffi.Pointer<c.mnn_tensor_layout_t> toNative() {
+    if (batch < 0 || channel < 0 || area < 0 || pack < 1) {
+      throw MNNException('Invalid layout: $this');
+    }
+    return calloc<c.mnn_tensor_layout_t>()
+      ..ref.dim_typeAsInt = dimType.value
+      ..ref.batch = batch
+      ..ref.channel = channel
+      ..ref.area = area
+      ..ref.pack = pack
+      ..ref.batch_stride = batchStride
+      ..ref.channel_stride = channelStride
+      ..ref.area_stride = areaStride;
+  }
+
+  @override
+  String toString() {
+    return 'TensorLayout(dimType=$dimType, batch=$batch, channel=$channel, area=$area, pack=$pack)';
+  }
+}
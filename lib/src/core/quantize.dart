@@ -0,0 +1,95 @@
+/// Copyright (c) 2025, rainyl. All rights reserved.
+/// Use of this source code is governed by a
+/// Apache 2.0 license that can be found in the LICENSE file.
+
+import 'dart:ffi' as ffi;
+
+import 'package:ffi/ffi.dart';
+
+import '../g/mnn.g.dart' as c;
+import 'base.dart';
+
+/// Affine quantization parameters, q = clamp(round(x / scale) + zeroPoint, qmin, qmax)
+///
+/// If only one scale is given the parameters are applied per-tensor, otherwise
+/// the number of scales must equal the length of dimension [axis].
+class QuantParams extends NativeObject {
+  static final ffi.NativeFinalizer _finalizer = ffi.NativeFinalizer(calloc.nativeFree);
+
+  QuantParams.fromPointer(ffi.Pointer<c.mnn_quant_params_t> ptr, {super.attach, super.externalSize})
+    : super(ptr.cast());
+
+  /// @brief Create quantization parameters
+  ///
+  /// @param scales Scale for each channel, or a single scale for per-tensor
+  ///
+  /// @param zeroPoints Zero point for each channel, null means all zero
+  ///
+  /// @param axis Channel axis for per-channel parameters
+  ///
+  /// @param qmin Lower clamp bound, qmin >= qmax means the full range of the quantized type
+  ///
+  /// @param qmax Upper clamp bound
+  factory QuantParams.create(
+    List<double> scales, {
+    List<int>? zeroPoints,
+    int axis = 0,
+    int qmin = 0,
+    int qmax = 0,
+  }) {
+    MnnAssert(scales.isNotEmpty, 'scales must not be empty');
+    MnnAssert(
+      zeroPoints == null || zeroPoints.length == scales.length,
+      'zeroPoints.length=${zeroPoints?.length} not match scales.length=${scales.length}',
+    );
+    // struct and arrays share one allocation, so the finalizer frees them together
+    final structSize = ffi.sizeOf<c.mnn_quant_params_t>();
+    final count = scales.length;
+    final p = calloc<ffi.Uint8>(structSize + count * (ffi.sizeOf<ffi.Float>() + ffi.sizeOf<ffi.Int32>()));
+    final pScale = (p + structSize).cast<ffi.Float>();
+    final pZeroPoint = (p + structSize + count * ffi.sizeOf<ffi.Float>()).cast<ffi.Int32>();
+    pScale.asTypedList(count).setAll(0, scales);
+    final params = p.cast<c.mnn_quant_params_t>()
+      ..ref.scale = pScale
+      ..ref.zero_point = ffi.nullptr
+      ..ref.count = count
+      ..ref.axis = axis
+      ..ref.qmin = qmin
+      ..ref.qmax = qmax;
+    if (zeroPoints != null) {
+      pZeroPoint.asTypedList(count).setAll(0, zeroPoints);
+      params.ref.zero_point = pZeroPoint;
+    }
+    return QuantParams.fromPointer(params);
+  }
+
+  c.mnn_quant_params_t get ref => ptr.cast<c.mnn_quant_params_t>().ref;
+
+  List<double> get scales => ref.scale.asTypedList(ref.count).toList();
+
+  List<int>? get zeroPoints => ref.zero_point == ffi.nullptr ? null : ref.zero_point.asTypedList(ref.count).toList();
+
+  int get count => ref.count;
+
+  int get axis => ref.axis;
+
+  int get qmin => ref.qmin;
+
+  int get qmax => ref.qmax;
+
+  @override
+  void release() {
+    calloc.free(ptr);
+  }
+
+  @override
+  ffi.NativeFinalizer get finalizer => _finalizer;
+
+  @override
+  List<Object?> get props => [ptr.address];
+
+  @override
+  String toString() {
+    return 'QuantParams(address=0x${ptr.address.toRadixString(16)}, count=$count, axis=$axis, qmin=$qmin, qmax=$qmax)';
+  }
+}
@@ -0,0 +1,99 @@
+/// Copyright (c) 2025, rainyl. All rights reserved.
+/// Use of this source code is governed by a
+/// Apache 2.0 license that can be found in the LICENSE file.
+
+import 'dart:ffi' as ffi;
+
+import 'package:ffi/ffi.dart';
+
+import '../g/mnn.g.dart' as c;
+import 'base.dart';
+
+/// Statistics of a tensor or variable.
+///
+/// [min], [max], [mean] and [variance] only take finite values into account,
+/// and are NaN if there is no finite value.
+class TensorStats {
+  const TensorStats({
+    required this.count,
+    required this.nanCount,
+    required this.infCount,
+    required this.min,
+    required this.max,
+    required this.mean,
+    required this.variance,
+    this.histogram,
+  });
+
+  final int count;
+  final int nanCount;
+  final int infCount;
+  final double min;
+  final double max;
+  final double mean;
+
+  /// population variance
+  final double variance;
+
+  /// fixed-bin histogram, null if not requested
+  final List<int>? histogram;
+
+  /// whether all elements are finite
+  bool get isFinite => nanCount == 0 && infCount == 0;
+
+  /// @brief Run a native statistics scan.
+  ///
+  /// @param func native scan function, e.g., mnn_tensor_stats
+  ///
+  /// @param bins number of histogram bins, 0 disables the histogram
+  ///
+  /// @param histMin histogram lower bound, null means using [min] of the data
+  ///
+  /// @param histMax histogram upper bound, null means using [max] of the data
+  ///
+  /// @param numThreads number of threads, <= 0 means using all available threads
+  static TensorStats compute(
+    c.ErrorCode Function(ffi.Pointer<c.mnn_stats_config_t> config, ffi.Pointer<c.mnn_tensor_stats_t> stats)
+    func, {
+    int bins = 0,
+    double? histMin,
+    double? histMax,
+    int numThreads = 0,
+  }) {
+    MnnAssert(bins >= 0, 'bins must be >= 0');
+    final pHist = bins > 0 ? calloc<ffi.Uint64>(bins) : ffi.nullptr.cast<ffi.Uint64>();
+    // any missing bound falls back to the data range
+    final hasRange = histMin != null && histMax != null;
+    final pConfig = calloc<c.mnn_stats_config_t>()
+      ..ref.bins = bins
+      ..ref.hist_min = hasRange ? histMin! : 0.0
+      ..ref.hist_max = hasRange ? histMax! : 0.0
+      ..ref.histogram = pHist
+      ..ref.num_threads = numThreads;
+    final pStats = calloc<c.mnn_tensor_stats_t>();
+    try {
+      mnnRun(() => func(pConfig, pStats));
+      final s = pStats.ref;
+      return TensorStats(
+        count: s.count,
+        nanCount: s.nan_count,
+        infCount: s.inf_count,
+        min: s.min,
+        max: s.max,
+        mean: s.mean,
+        variance: s.variance,
+        histogram: bins > 0 ? pHist.asTypedList(bins).toList() : null,
+      );
+    } finally {
+      if (bins > 0) calloc.free(pHist);
+      calloc.free(pConfig);
+      calloc.free(pStats);
+    }
+  }
+
+  @override
+  String toString() {
+    return 'TensorStats(count=$count, nanCount=$nanCount, infCount=$infCount, '
+        'min=$min, max=$max, mean=$mean, variance=$variance)';
+  }
+}
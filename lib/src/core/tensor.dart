@@ -12,6 +12,10 @@ import '../g/mnn.g.dart' as c;
 import 'base.dart';
 import 'exception.dart';
 import 'halide_runtime.dart';
+import 'postprocess.dart';
+import 'quantize.dart';
+import 'stats.dart';
+import 'topk.dart';
 
 class Tensor extends NativeObject {
   static final ffi.NativeFinalizer _finalizer = ffi.NativeFinalizer(c.addresses.mnn_tensor_destroy);
@@ -59,6 +63,21 @@ class Tensor extends NativeObject {
     return Tensor.fromPointer(p);
   }
 
+  /// @brief Load a .npy file into a new host tensor, the data is copied.
+  ///
+  /// Use [NpyArchive] to map a file without copying.
+  factory Tensor.fromNpy(String path) {
+    final cPath = path.toNativeUtf8().cast<ffi.Char>();
+    final p = calloc<c.mnn_tensor_t>();
+    try {
+      mnnRun(() => c.mnn_tensor_load_npy(cPath, p));
+      return Tensor.fromPointer(p.value);
+    } finally {
+      malloc.free(cPath);
+      calloc.free(p);
+    }
+  }
+
   @override
   ffi.NativeFinalizer get finalizer => _finalizer;
 
@@ -76,9 +95,23 @@ class Tensor extends NativeObject {
   ///
   /// @param hostTensor    host tensor, the data provider.
   ///
-  /// @return true for DEVICE tensor, and false for HOST tensor.
-  bool copyFromHost(Tensor hostTensor) {
-    final code = c.mnn_tensor_copy_from_host(ptr, hostTensor.ptr);
+  /// @param parallel    whether to split the copy and layout conversion of large host-accessible
+  /// tensors across multiple threads.
+  ///
+  /// @param numThreads    number of threads, <= 0 means using all available threads.
+  ///
+  /// @param threshold    tensors smaller than threshold bytes are copied by MNN directly.
+  ///
+  /// @return true for DEVICE tensor or if copied in parallel, and false for HOST tensor.
+  bool copyFromHost(
+    Tensor hostTensor, {
+    bool parallel = false,
+    int numThreads = 0,
+    int threshold = 1 << 20,
+  }) {
+    final code = parallel
+        ? c.mnn_tensor_copy_from_host_parallel(ptr, hostTensor.ptr, numThreads, threshold)
+        : c.mnn_tensor_copy_from_host(ptr, hostTensor.ptr);
     return switch (code) {
       c.ErrorCode.MNNC_BOOL_TRUE => true,
       c.ErrorCode.MNNC_BOOL_FALSE => false,
@@ -90,9 +123,23 @@ class Tensor extends NativeObject {
   ///
   /// @param hostTensor    host tensor, the data consumer.
   ///
-  /// @return true for DEVICE tensor, and false for HOST tensor.
-  bool copyToHost(Tensor hostTensor) {
-    final code = c.mnn_tensor_copy_to_host(ptr, hostTensor.ptr);
+  /// @param parallel    whether to split the copy and layout conversion of large host-accessible
+  /// tensors across multiple threads.
+  ///
+  /// @param numThreads    number of threads, <= 0 means using all available threads.
+  ///
+  /// @param threshold    tensors smaller than threshold bytes are copied by MNN directly.
+  ///
+  /// @return true for DEVICE tensor or if copied in parallel, and false for HOST tensor.
+  bool copyToHost(
+    Tensor hostTensor, {
+    bool parallel = false,
+    int numThreads = 0,
+    int threshold = 1 << 20,
+  }) {
+    final code = parallel
+        ? c.mnn_tensor_copy_to_host_parallel(ptr, hostTensor.ptr, numThreads, threshold)
+        : c.mnn_tensor_copy_to_host(ptr, hostTensor.ptr);
     return switch (code) {
       c.ErrorCode.MNNC_BOOL_TRUE => true,
       c.ErrorCode.MNNC_BOOL_FALSE => false,
@@ -100,6 +147,118 @@ class Tensor extends NativeObject {
     };
   }
 
+  /// @brief for HOST tensor, save to .npy file.
+  ///
+  /// @param path    file path.
+  void saveNpy(String path) {
+    final cPath = path.toNativeUtf8().cast<ffi.Char>();
+    try {
+      mnnRun(() => c.mnn_tensor_save_npy(ptr, cPath));
+    } finally {
+      malloc.free(cPath);
+    }
+  }
+
+  /// @brief for int8/uint8/int16 HOST tensor, quantize float data into host memory.
+  ///
+  /// @param data    float data, length must equal the tensor's element count.
+  ///
+  /// @param params  quantization parameters, axis refers to the tensor's shape.
+  void quantizeFrom(Float32List data, QuantParams params) {
+    MnnAssert(data.length == elementSize, 'data.length=${data.length} not match elementSize=$elementSize');
+    final pData = calloc<ffi.Float>(data.length);
+    pData.asTypedList(data.length).setAll(0, data);
+    try {
+      mnnRun(() => c.mnn_tensor_quantize_from_f32(ptr, pData, params.ptr.cast()));
+    } finally {
+      calloc.free(pData);
+    }
+  }
+
+  /// @brief for int8/uint8/int16 HOST tensor, dequantize host memory to float data.
+  ///
+  /// @param params  quantization parameters, axis refers to the tensor's shape.
+  ///
+  /// @return dequantized float data.
+  Float32List dequantize(QuantParams params) {
+    final count = elementSize;
+    final pData = calloc<ffi.Float>(count);
+    try {
+      mnnRun(() => c.mnn_tensor_dequantize_to_f32(ptr, pData, params.ptr.cast()));
+      return Float32List.fromList(pData.asTypedList(count));
+    } finally {
+      calloc.free(pData);
+    }
+  }
+
+  /// @brief for HOST tensor, compute count, NaN/Inf counts, min, max, mean, variance
+  /// and an optional histogram in one native pass.
+  ///
+  /// @param bins          number of histogram bins, 0 disables the histogram.
+  ///
+  /// @param histMin       histogram lower bound, null means using the data range.
+  ///
+  /// @param histMax       histogram upper bound, null means using the data range.
+  ///
+  /// @param numThreads    number of threads, <= 0 means using all available threads.
+  TensorStats stats({int bins = 0, double? histMin, double? histMax, int numThreads = 0}) =>
+      TensorStats.compute(
+        (config, stats) => c.mnn_tensor_stats(ptr, config, stats),
+        bins: bins,
+        histMin: histMin,
+        histMax: histMax,
+        numThreads: numThreads,
+      );
+
+  /// @brief for float32 HOST tensor, select the top [k] entries along the last dimension
+  /// without sorting whole rows.
+  ///
+  /// @param largest       select the largest entries if true, otherwise the smallest.
+  ///
+  /// @param softmax       whether to compute the softmax over the selected values.
+  ///
+  /// @param numThreads    number of threads, <= 0 means using all available threads.
+  TopK topK(int k, {bool largest = true, bool softmax = false, int numThreads = 0}) {
+    MnnAssert(type == HalideType.f32, 'topK only supports float32 tensor, got $type');
+    final dims = shape;
+    final cols = dims.isEmpty ? 1 : dims.last;
+    return TopK.compute(
+      (config, values, indices, probs) => c.mnn_tensor_topk(ptr, config, values, indices, probs),
+      k,
+      cols == 0 ? 0 : elementSize ~/ cols,
+      largest: largest,
+      softmax: softmax,
+      numThreads: numThreads,
+    );
+  }
+
+  /// @brief Get the memory layout of this tensor, including the packed NC4HW4 layout.
+  TensorLayout get layout => TensorLayout.query((p) => c.mnn_tensor_get_layout(ptr, p));
+
+  /// @brief for float32 HOST tensor, channel-wise argmax reading the data in its own layout.
+  ///
+  /// @return channel indices and max values, both of shape [batch, area].
+  (Int32List, Float32List) channelArgmax({int numThreads = 0}) {
+    MnnAssert(type == HalideType.f32, 'channelArgmax only supports float32 tensor, got $type');
+    return layout.channelArgmax(cast<ffi.Float>(), numThreads: numThreads);
+  }
+
+  /// @brief for float32 HOST tensor, channel-wise softmax reading the data in its own layout.
+  ///
+  /// @return probabilities in NCHW, shape [batch, channel, area].
+  Float32List channelSoftmax({int numThreads = 0}) {
+    MnnAssert(type == HalideType.f32, 'channelSoftmax only supports float32 tensor, got $type');
+    return layout.channelSoftmax(cast<ffi.Float>(), numThreads: numThreads);
+  }
+
+  /// @brief for float32 HOST tensor, sigmoid followed by a threshold reading the data in its own layout.
+  ///
+  /// @return mask in NCHW with shape [batch, channel, area] and the number of positive elements.
+  (Uint8List, int) channelSigmoidThreshold(double threshold, {int numThreads = 0}) {
+    MnnAssert(type == HalideType.f32, 'channelSigmoidThreshold only supports float32 tensor, got $type');
+    return layout.channelSigmoidThreshold(cast<ffi.Float>(), threshold, numThreads: numThreads);
+  }
+
   int get dimensions => c.mnn_tensor_dimensions(ptr);
 
   List<int> get shape {
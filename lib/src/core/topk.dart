@@ -0,0 +1,82 @@
+/// Copyright (c) 2025, rainyl. All rights reserved.
+/// Use of this source code is governed by a
+/// Apache 2.0 license that can be found in the LICENSE file.
+
+import 'dart:ffi' as ffi;
+import 'dart:typed_data';
+
+import 'package:ffi/ffi.dart';
+
+import '../g/mnn.g.dart' as c;
+import 'base.dart';
+
+/// Top k entries along the last dimension, each of [values], [indices] and [probs]
+/// has shape [rows, k] with the best entry of each row first.
+class TopK {
+  const TopK({required this.k, required this.values, required this.indices, this.probs});
+
+  final int k;
+  final Float32List values;
+  final Int32List indices;
+
+  /// softmax over the selected values of each row, null if not requested
+  final Float32List? probs;
+
+  int get rows => k == 0 ? 0 : values.length ~/ k;
+
+  /// @brief Run a native top-k selection.
+  ///
+  /// Rows are selected with a bounded heap or quickselect instead of a full sort, long
+  /// rows are split into chunks selected in parallel.
+  ///
+  /// @param func native selection function, e.g., mnn_tensor_topk
+  ///
+  /// @param rows number of rows, i.e., element count / last dim
+  ///
+  /// @param largest select the largest entries if true, otherwise the smallest
+  ///
+  /// @param softmax whether to compute [probs]
+  ///
+  /// @param numThreads number of threads, <= 0 means using all available threads
+  static TopK compute(
+    c.ErrorCode Function(
+      ffi.Pointer<c.mnn_topk_config_t> config,
+      ffi.Pointer<ffi.Float> values,
+      ffi.Pointer<ffi.Int32> indices,
+      ffi.Pointer<ffi.Float> probs,
+    )
+    func,
+    int k,
+    int rows, {
+    bool largest = true,
+    bool softmax = false,
+    int numThreads = 0,
+  }) {
+    MnnAssert(k > 0, 'k must be > 0');
+    final count = rows * k;
+    final pConfig = calloc<c.mnn_topk_config_t>()
+      ..ref.k = k
+      ..ref.largest = largest
+      ..ref.num_threads = numThreads;
+    final pValues = calloc<ffi.Float>(count);
+    final pIndices = calloc<ffi.Int32>(count);
+    final pProbs = softmax ? calloc<ffi.Float>(count) : ffi.nullptr.cast<ffi.Float>();
+    try {
+      mnnRun(() => func(pConfig, pValues, pIndices, pProbs));
+      return TopK(
+        k: k,
+        values: Float32List.fromList(pValues.asTypedList(count)),
+        indices: Int32List.fromList(pIndices.asTypedList(count)),
+        probs: softmax ? Float32List.fromList(pProbs.asTypedList(count)) : null,
+      );
+    } finally {
+      calloc.free(pConfig);
+      calloc.free(pValues);
+      calloc.free(pIndices);
+      if (softmax) calloc.free(pProbs);
+    }
+  }
+
+  @override
+  String toString() => 'TopK(k=$k, rows=$rows)';
+}
@@ -0,0 +1,37 @@
+/// Copyright (c) 2025, rainyl. All rights reserved.
+/// Use of this source code is governed by a
+/// Apache 2.0 license that can be found in the LICENSE file.
+
+import '../core/base.dart';
+import '../g/mnn.g.dart' as C;
+
+/// Eager evaluation of ops on small constant variables.
+///
+/// When enabled, elementwise, broadcast and reduction ops whose inputs are all
+/// float32 or int32 constants with at most [threshold] elements are computed
+/// directly on host memory and return a constant [VARP], so tiny math such as
+/// box coordinates and thresholds skips graph construction and shape inference.
+///
+/// The setting belongs to the current native thread and is disabled by default. An isolate
+/// may resume on another thread after an `await`, so prefer [run] with a synchronous
+/// [fn] over setting [threshold] around asynchronous code.
+abstract final class Eager {
+  /// maximum number of elements of each input on the current thread, 0 means disabled
+  static int get threshold => C.mnn_expr_get_eager_threshold();
+  static set threshold(int value) {
+    MnnAssert(value >= 0, 'threshold must be >= 0, got $value');
+    C.mnn_expr_set_eager_threshold(value);
+  }
+
+  /// @brief Run [fn] with eager evaluation for inputs of at most [threshold] elements,
+  /// the previous threshold is restored afterwards.
+  static T run<T>(T Function() fn, {int threshold = 1024}) {
+    final old = Eager.threshold;
+    Eager.threshold = threshold;
+    try {
+      return fn();
+    } finally {
+      Eager.threshold = old;
+    }
+  }
+}
@@ -8,12 +8,17 @@ import 'dart:typed_data';
 import 'package:ffi/ffi.dart';
 
 import '../core/base.dart';
+import '../core/detection.dart';
 import '../core/exception.dart';
 import '../core/halide_runtime.dart';
+import '../core/postprocess.dart';
+import '../core/stats.dart';
 import '../core/tensor.dart';
+import '../core/topk.dart';
 import '../core/vec.dart';
 import '../g/mnn.g.dart' as C;
 import 'op.dart' as op;
+import 'scope.dart';
 
 enum MemoryType {
   COPY(0),
@@ -138,7 +143,9 @@ class VariableInfo extends NativeObject {
 class Expr extends NativeObject {
   static final _finalizer = ffi.NativeFinalizer(C.addresses.mnn_expr_Expr_free);
 
-  Expr.fromPointer(C.mnn_expr_Expr_t ptr, {super.attach, super.externalSize}) : super(ptr.cast());
+  /// Handles created inside an [ExprScope] are owned by the scope and not attached by default.
+  Expr.fromPointer(C.mnn_expr_Expr_t ptr, {bool? attach, super.externalSize})
+    : super(ptr.cast(), attach: attach ?? !ExprScope.isActive);
 
   factory Expr.empty() => Expr.fromPointer(C.mnn_expr_Expr_create_empty());
 
@@ -222,10 +229,32 @@ class Expr extends NativeObject {
   }
 }
 
+/// Shape, type and format of a [VARP] queried without allocating a [VariableInfo].
+typedef VARPInfo = ({DimensionFormat order, List<int> dim, HalideType type, int size});
+
 class VARP extends NativeObject {
   static final _finalizer = ffi.NativeFinalizer(C.addresses.mnn_expr_VARP_free);
 
-  VARP.fromPointer(C.VARP_t ptr, {super.attach, super.externalSize}) : super(ptr.cast());
+  /// Whether [order], [dim], [dtype], [size] and friends cache the queried info on the VARP.
+  ///
+  /// The cache is dropped by calls on the same VARP that change its shape or expression, e.g.,
+  /// [resize], [input], [setExpr], [fix] and [setOrder], but not by changes made to upstream
+  /// variables, so only enable it when the graph is not mutated while the info is in use.
+  static bool cacheInfo = false;
+
+  VARPInfo? _info;
+
+  // scratch buffers reused by all queries, dims beyond the capacity fall back to an exact buffer
+  static const _scratchDims = 32;
+  static final _pNdim = calloc<ffi.Int32>();
+  static final _pDims = calloc<ffi.Int32>(_scratchDims);
+  static final _pType = calloc<C.halide_type_c_t>();
+  static final _pOrder = calloc<ffi.Int32>();
+  static final _pSize = calloc<ffi.Size>();
+
+  /// Handles created inside an [ExprScope] are owned by the scope and not attached by default.
+  VARP.fromPointer(C.VARP_t ptr, {bool? attach, super.externalSize})
+    : super(ptr.cast(), attach: attach ?? !ExprScope.isActive);
 
   factory VARP.empty() => VARP.fromPointer(C.mnn_expr_VARP_create_empty());
 
@@ -294,6 +323,7 @@ class VARP extends NativeObject {
   }
 
   bool resize(List<int> dims) {
+    _info = null;
     final cdims = dims.i32;
     final rval = C.mnn_expr_VARP_resize(ptr, cdims.ptr);
     cdims.dispose();
@@ -303,15 +333,34 @@ class VARP extends NativeObject {
   ffi.Pointer<T> readMap<T extends ffi.NativeType>() => C.mnn_expr_VARP_readMap(ptr).cast<T>();
   ffi.Pointer<T> writeMap<T extends ffi.NativeType>() => C.mnn_expr_VARP_writeMap(ptr).cast<T>();
 
-  bool input(VARP src) => C.mnn_expr_VARP_input(ptr, src.ptr);
+  bool input(VARP src) {
+    _info = null;
+    return C.mnn_expr_VARP_input(ptr, src.ptr);
+  }
 
-  static void replace(VARP dst, VARP src) => C.mnn_expr_VARP_static_replace(dst.ptr, src.ptr);
+  static void replace(VARP dst, VARP src) {
+    dst._info = null;
+    C.mnn_expr_VARP_static_replace(dst.ptr, src.ptr);
+  }
 
   // static std::vector<VARP> load(const char* fileName);
-  static List<VARP> loadFromFile(String fileName) {
+  /// Load variables from a file, with [mmap] the file is mapped instead of read into memory.
+  static List<VARP> loadFromFile(String fileName, {bool mmap = true}) {
     final cname = fileName.toNativeUtf8().cast<ffi.Char>();
-    final p = C.mnn_expr_VARP_static_load(cname);
-    malloc.free(cname);
+    final ffi.Pointer<ffi.Void> p;
+    if (mmap) {
+      final pOut = calloc<C.VecVARP_t>();
+      try {
+        mnnRun(() => C.mnn_expr_VARP_static_load_mmap(cname, pOut));
+        p = pOut.value;
+      } finally {
+        calloc.free(pOut);
+        malloc.free(cname);
+      }
+    } else {
+      p = C.mnn_expr_VARP_static_load(cname);
+      malloc.free(cname);
+    }
     final size = C.mnn_expr_VecVARP_size(p);
     final rval = List.generate(size, (index) => VARP.fromPointer(C.mnn_expr_VecVARP_at(p, index)));
     C.mnn_expr_VecVARP_free(p);
@@ -319,10 +368,23 @@ class VARP extends NativeObject {
   }
 
   // static std::map<std::string, VARP> loadMap(const char* fileName);
-  static Map<String, VARP> loadMapFromFile(String fileName) {
+  /// Load named variables from a file, with [mmap] the file is mapped instead of read into memory.
+  static Map<String, VARP> loadMapFromFile(String fileName, {bool mmap = true}) {
     final cname = fileName.toNativeUtf8().cast<ffi.Char>();
-    final p = C.mnn_expr_VARP_static_loadMap(cname);
-    malloc.free(cname);
+    final ffi.Pointer<ffi.Void> p;
+    if (mmap) {
+      final pOut = calloc<C.VARMAP_t>();
+      try {
+        mnnRun(() => C.mnn_expr_VARP_static_loadMap_mmap(cname, pOut));
+        p = pOut.value;
+      } finally {
+        calloc.free(pOut);
+        malloc.free(cname);
+      }
+    } else {
+      p = C.mnn_expr_VARP_static_loadMap(cname);
+      malloc.free(cname);
+    }
     final varmap = VarMap.fromPointer(p);
     final rval = varmap.toMap();
     varmap.dispose();
@@ -376,17 +438,80 @@ class VARP extends NativeObject {
     return VecI8.fromPointer(p);
   }
 
+  /// Serialize variables and pass the bytes to [write] in chunks of at most [chunkSize] bytes,
+  /// without copying them into a buffer first, e.g., to stream into an [IOSink].
+  ///
+  /// Each chunk is a view of native memory that is only valid during the call, copy it if it
+  /// must outlive the call.
+  static void saveToSink(List<VARP> vars, void Function(Uint8List chunk) write, {int chunkSize = 1 << 20}) {
+    Object? error;
+    int onChunk(ffi.Pointer<ffi.Void> userData, ffi.Pointer<ffi.Void> data, int size) {
+      try {
+        write(data.cast<ffi.Uint8>().asTypedList(size));
+        return size;
+      } catch (e) {
+        error = e;
+        return 0;
+      }
+    }
+
+    final callback = ffi.NativeCallable<C.mnn_expr_write_callback_tFunction>.isolateLocal(
+      onChunk,
+      exceptionalReturn: 0,
+    );
+    final cVars = vars.toNativeVec();
+    try {
+      final code = C.mnn_expr_VARP_static_save_callback(
+        cVars.ptr,
+        callback.nativeFunction,
+        ffi.nullptr,
+        chunkSize,
+      );
+      if (error != null) throw error!;
+      if (code != C.ErrorCode.MNNC_NO_ERROR) throw MNNException('saveToSink failed: $code');
+    } finally {
+      callback.close();
+      cVars.dispose();
+    }
+  }
+
   // static void save(const std::vector<VARP>& vars, NetT* dest);
 
   // Pack a few Variable to compute in one pipeline
   // static void prepareCompute(const std::vector<VARP>& vars, bool forceCPU = false);
-  // static void compute(const std::vector<VARP>& vars, bool forceCPU = false);
+  static void compute(List<VARP> vars, {bool forceCPU = false}) {
+    final vec = VecVARP.of(vars);
+    C.mnn_expr_VARP_static_compute(vec.ptr, forceCPU);
+    vec.dispose();
+  }
+
+  /// Compute variables whose graphs share no op nodes concurrently, e.g., the postprocess
+  /// graphs of each image in a batch, each group runs on its own executor.
+  ///
+  /// Args:
+  /// - maxWorkers: maximum number of concurrent groups, <= 0 means one per pooled executor
+  ///
+  /// Returns the number of independent groups.
+  static int computeParallel(List<VARP> vars, {bool forceCPU = false, int maxWorkers = 0}) {
+    final vec = VecVARP.of(vars);
+    final pGroups = calloc<ffi.Size>();
+    try {
+      mnnRun(() => C.mnn_expr_VARP_static_compute_parallel(vec.ptr, forceCPU, maxWorkers, pGroups));
+      return pGroups.value;
+    } finally {
+      calloc.free(pGroups);
+      vec.dispose();
+    }
+  }
 
   int linkNumber() => C.mnn_expr_VARP_linkNumber(ptr);
 
   // const std::vector<WeakEXPRP>& toExprs() const;
 
-  void setExpr(Expr expr, int index) => C.mnn_expr_VARP_setExpr(ptr, expr.ptr, index);
+  void setExpr(Expr expr, int index) {
+    _info = null;
+    C.mnn_expr_VARP_setExpr(ptr, expr.ptr, index);
+  }
 
   Tensor getTensor() => Tensor.fromPointer(C.mnn_expr_VARP_getTensor(ptr), attach: false);
 
@@ -397,63 +522,247 @@ class VARP extends NativeObject {
 
   VariableInfo? getInfo() => info;
 
-  DimensionFormat? get order {
-    final p = C.mnn_expr_VARP_getInfo(ptr);
-    final rval = p == ffi.nullptr ? null : DimensionFormat.fromValue(p.ref.order);
-    C.mnn_expr_Variable_Info_free(p.cast());
-    return rval;
+  /// Query the info into reused native buffers, returns null if it can not be computed.
+  ///
+  /// Returns the cached info if [cacheInfo] is enabled and the info was queried before.
+  VARPInfo? queryInfo() {
+    final cached = _info;
+    if (cached != null) return cached;
+    var code = C.mnn_expr_VARP_get_info_into(ptr, _pNdim, _pDims, _scratchDims, _pType, _pOrder, _pSize);
+    if (code != C.ErrorCode.MNNC_NO_ERROR && code != C.ErrorCode.MNNC_INVALID_VALUE) {
+      throw MNNException('queryInfo failed: $code');
+    }
+    final ndim = _pNdim.value;
+    if (ndim < 0) return null;
+    final List<int> dim;
+    if (code == C.ErrorCode.MNNC_INVALID_VALUE) {
+      final pDims = calloc<ffi.Int32>(ndim);
+      code = C.mnn_expr_VARP_get_info_into(ptr, _pNdim, pDims, ndim, _pType, _pOrder, _pSize);
+      dim = pDims.asTypedList(ndim).toList();
+      calloc.free(pDims);
+    } else {
+      dim = _pDims.asTypedList(ndim).toList();
+    }
+    final info = _toInfo(dim, _pType.ref, _pOrder.value, _pSize.value);
+    if (cacheInfo) _info = info;
+    return info;
   }
 
+  /// Drop the info cached by [queryInfo].
+  void invalidateInfo() => _info = null;
+
+  /// Query the info of many variables in one native call, null for those can not be computed.
+  ///
+  /// Caches the info on each variable if [cacheInfo] is enabled.
+  static List<VARPInfo?> queryInfos(List<VARP> vars) {
+    if (vars.isEmpty) return [];
+    final n = vars.length;
+    final vec = VecVARP.of(vars);
+    final pNdims = calloc<ffi.Int32>(n);
+    final pTypes = calloc<C.halide_type_c_t>(n);
+    final pOrders = calloc<ffi.Int32>(n);
+    final pSizes = calloc<ffi.Size>(n);
+    var capacity = n * 4;
+    var pDims = calloc<ffi.Int32>(capacity);
+    try {
+      var code = C.mnn_expr_VecVARP_get_info(vec.ptr, pNdims, pDims, capacity, pTypes, pOrders, pSizes);
+      if (code == C.ErrorCode.MNNC_INVALID_VALUE) {
+        // ndims are always written, retry with the exact capacity
+        capacity = pNdims.asTypedList(n).fold(0, (a, b) => b > 0 ? a + b : a);
+        calloc.free(pDims);
+        pDims = calloc<ffi.Int32>(capacity);
+        code = C.mnn_expr_VecVARP_get_info(vec.ptr, pNdims, pDims, capacity, pTypes, pOrders, pSizes);
+      }
+      if (code != C.ErrorCode.MNNC_NO_ERROR) {
+        throw MNNException('queryInfos failed: $code');
+      }
+      final infos = <VARPInfo?>[];
+      var offset = 0;
+      for (var i = 0; i < n; i++) {
+        final ndim = pNdims[i];
+        if (ndim < 0) {
+          infos.add(null);
+          continue;
+        }
+        final dim = (pDims + offset).asTypedList(ndim).toList();
+        offset += ndim;
+        final info = _toInfo(dim, pTypes[i], pOrders[i], pSizes[i]);
+        if (cacheInfo) vars[i]._info = info;
+        infos.add(info);
+      }
+      return infos;
+    } finally {
+      calloc.free(pNdims);
+      calloc.free(pDims);
+      calloc.free(pTypes);
+      calloc.free(pOrders);
+      calloc.free(pSizes);
+      vec.dispose();
+    }
+  }
+
+  static VARPInfo _toInfo(List<int> dim, C.halide_type_c_t type, int order, int size) =>
+      (order: DimensionFormat.fromValue(order), dim: dim, type: HalideType.fromNative(type), size: size);
+
+  DimensionFormat? get order => queryInfo()?.order;
+
   DimensionFormat? get dataFormat => order;
 
-  List<int>? get dim {
-    final p = C.mnn_expr_VARP_getInfo(ptr);
-    final rval = p == ffi.nullptr ? null : p.ref.dim.asTypedList(p.ref.ndim).toList();
-    C.mnn_expr_Variable_Info_free(p.cast());
-    return rval;
-  }
+  List<int>? get dim => queryInfo()?.dim;
 
   List<int>? get shape => dim;
-  int? get ndim {
-    final p = C.mnn_expr_VARP_getInfo(ptr);
-    final rval = p == ffi.nullptr ? null : p.ref.ndim;
-    C.mnn_expr_Variable_Info_free(p.cast());
-    return rval;
+  int? get ndim => queryInfo()?.dim.length;
+
+  HalideType? get dtype => queryInfo()?.type;
+
+  int? get size => queryInfo()?.size;
+
+  static final _pinFinalizer = C.addresses.mnn_expr_VARP_free.cast<ffi.NativeFinalizerFunction>();
+
+  /// Compute the variable and view its host data without copying.
+  ///
+  /// The view holds a native reference to the expression that is released when the view
+  /// is garbage collected, so it stays valid after this VARP is disposed. It shares the
+  /// expression's memory and is invalidated by [resize], [input] and [writeMap] on this
+  /// variable, and by changes upstream that recompute it, copy it with `toList()` first
+  /// when the data must outlive those.
+  List<num>? get data {
+    final pData = calloc<ffi.Pointer<ffi.Void>>();
+    final pSize = calloc<ffi.Size>();
+    final pType = calloc<C.halide_type_c_t>();
+    final pPin = calloc<C.VARP_t>();
+    try {
+      final code = C.mnn_expr_VARP_readMap_pinned(ptr, pData, pSize, pType, pPin);
+      if (code == C.ErrorCode.MNNC_COMPUTE_SIZE_ERROR) return null;
+      if (code != C.ErrorCode.MNNC_NO_ERROR) throw MNNException("MNN_ERROR: $code");
+      final (p, size, pin) = (pData.value, pSize.value, pPin.value);
+      if (size <= 0 || p == ffi.nullptr) {
+        // the pin is only owned by a view
+        C.mnn_expr_VARP_free(pin);
+        return null;
+      }
+      final type = HalideType.fromNative(pType.ref);
+      try {
+        return switch (type) {
+          HalideType.f32 => p.cast<ffi.Float>().asTypedList(size, finalizer: _pinFinalizer, token: pin),
+          HalideType.f64 => p.cast<ffi.Double>().asTypedList(size, finalizer: _pinFinalizer, token: pin),
+          HalideType.i32 => p.cast<ffi.Int32>().asTypedList(size, finalizer: _pinFinalizer, token: pin),
+          HalideType.u32 => p.cast<ffi.Uint32>().asTypedList(size, finalizer: _pinFinalizer, token: pin),
+          HalideType.u8 => p.cast<ffi.Uint8>().asTypedList(size, finalizer: _pinFinalizer, token: pin),
+          HalideType.i8 => p.cast<ffi.Int8>().asTypedList(size, finalizer: _pinFinalizer, token: pin),
+          HalideType.i16 => p.cast<ffi.Int16>().asTypedList(size, finalizer: _pinFinalizer, token: pin),
+          HalideType.u16 => p.cast<ffi.Uint16>().asTypedList(size, finalizer: _pinFinalizer, token: pin),
+          HalideType.i64 => p.cast<ffi.Int64>().asTypedList(size, finalizer: _pinFinalizer, token: pin),
+          HalideType.u64 => p.cast<ffi.Uint64>().asTypedList(size, finalizer: _pinFinalizer, token: pin),
+          _ => throw UnsupportedError('Data type $type not supported'),
+        };
+      } on UnsupportedError {
+        C.mnn_expr_VARP_free(pin);
+        rethrow;
+      }
+    } finally {
+      calloc.free(pData);
+      calloc.free(pSize);
+      calloc.free(pType);
+      calloc.free(pPin);
+    }
   }
 
-  HalideType? get dtype {
-    final p = C.mnn_expr_VARP_getInfo(ptr);
-    final rval = p == ffi.nullptr ? null : HalideType.fromNative(p.ref.type);
-    C.mnn_expr_Variable_Info_free(p.cast());
-    return rval;
+  /// Compute count, NaN/Inf counts, min, max, mean, variance and an optional
+  /// histogram in one native pass, the variable will be computed if needed.
+  ///
+  /// Args:
+  /// - bins: number of histogram bins, 0 disables the histogram
+  /// - histMin, histMax: histogram range, null means using the data range
+  /// - numThreads: number of threads, <= 0 means using all available threads
+  TensorStats stats({int bins = 0, double? histMin, double? histMax, int numThreads = 0}) =>
+      TensorStats.compute(
+        (config, stats) => C.mnn_expr_VARP_stats(ptr, config, stats),
+        bins: bins,
+        histMin: histMin,
+        histMax: histMax,
+        numThreads: numThreads,
+      );
+
+  /// Top [k] entries along the last dimension without sorting whole rows, the variable
+  /// will be computed if needed. [TopK.probs] holds the softmax over the selected values
+  /// if [softmax] is true.
+  TopK topK(int k, {bool largest = true, bool softmax = false, int numThreads = 0}) {
+    MnnAssert(dtype == HalideType.f32, 'topK only supports float32, got $dtype');
+    final dims = dim ?? const <int>[];
+    final cols = dims.isEmpty ? 1 : dims.last;
+    return TopK.compute(
+      (config, values, indices, probs) => C.mnn_expr_VARP_topk(ptr, config, values, indices, probs),
+      k,
+      cols == 0 ? 0 : (size ?? 0) ~/ cols,
+      largest: largest,
+      softmax: softmax,
+      numThreads: numThreads,
+    );
   }
 
-  int? get size {
-    final p = C.mnn_expr_VARP_getInfo(ptr);
-    final rval = p == ffi.nullptr ? null : p.ref.size;
-    C.mnn_expr_Variable_Info_free(p.cast());
-    return rval;
+  /// Memory layout of the data returned by [readMap], including the packed NC4HW4 layout.
+  TensorLayout get layout => TensorLayout.query((p) => C.mnn_expr_VARP_get_layout(ptr, p));
+
+  /// Channel-wise argmax that reads the data in its own layout, e.g., NC4HW4
+  /// outputs are not converted to NCHW first.
+  ///
+  /// Returns channel indices and max values, both of shape [batch, area].
+  (Int32List, Float32List) channelArgmax({int numThreads = 0}) {
+    MnnAssert(dtype == HalideType.f32, 'channelArgmax only supports float32, got $dtype');
+    return layout.channelArgmax(readMap<ffi.Float>(), numThreads: numThreads);
   }
 
-  List<num>? get data {
-    final info = this.info;
-    final pRead = readMap<ffi.Void>();
-    if (info == null || (info.isEmpty) || info.size <= 0 || pRead == ffi.nullptr) {
-      return null;
+  /// Channel-wise softmax that reads the data in its own layout.
+  ///
+  /// Returns probabilities in NCHW, shape [batch, channel, area].
+  Float32List channelSoftmax({int numThreads = 0}) {
+    MnnAssert(dtype == HalideType.f32, 'channelSoftmax only supports float32, got $dtype');
+    return layout.channelSoftmax(readMap<ffi.Float>(), numThreads: numThreads);
+  }
+
+  /// Sigmoid followed by a threshold that reads the data in its own layout.
+  ///
+  /// Returns the mask in NCHW with shape [batch, channel, area] and the number of positive elements.
+  (Uint8List, int) channelSigmoidThreshold(double threshold, {int numThreads = 0}) {
+    MnnAssert(dtype == HalideType.f32, 'channelSigmoidThreshold only supports float32, got $dtype');
+    return layout.channelSigmoidThreshold(readMap<ffi.Float>(), threshold, numThreads: numThreads);
+  }
+
+  /// Fused detector postprocess of this detection head, see [detectPostprocess].
+  ///
+  /// The head is [batch, channel, anchors], e.g., [1, 84, 8400] of YOLOv8, or
+  /// [batch, anchors, channel] if [channelLast] is true, e.g., [1, 25200, 85] of YOLOv5.
+  /// For SSD this holds the box regressions, [scores] holds the class scores in the same
+  /// arrangement and [priors] is a contiguous [anchors, 4].
+  ///
+  /// Returns detections of each image sorted by score.
+  List<List<Detection>> detect(
+    DetectParams params, {
+    VARP? scores,
+    VARP? priors,
+    bool channelLast = false,
+    List<Letterbox> letterbox = const [],
+    int numThreads = 0,
+  }) {
+    TensorLayout headLayout(VARP v) {
+      MnnAssert(v.dtype == HalideType.f32, 'detect only supports float32, got ${v.dtype}');
+      if (!channelLast) return v.layout;
+      final dims = v.dim ?? const <int>[];
+      MnnAssert(dims.length == 3, 'channel last head must be [batch, anchors, channel], got $dims');
+      return TensorLayout.channelLast(dims[0], dims[1], dims[2]);
     }
-    final List<num> dataList = switch (dtype) {
-      HalideType.f32 => pRead.cast<ffi.Float>().asTypedList(info.size),
-      HalideType.f64 => pRead.cast<ffi.Double>().asTypedList(info.size),
-      HalideType.i32 => pRead.cast<ffi.Int32>().asTypedList(info.size),
-      HalideType.u8 => pRead.cast<ffi.Uint8>().asTypedList(info.size),
-      HalideType.i8 => pRead.cast<ffi.Int8>().asTypedList(info.size),
-      HalideType.i16 => pRead.cast<ffi.Int16>().asTypedList(info.size),
-      HalideType.u16 => pRead.cast<ffi.Uint16>().asTypedList(info.size),
-      HalideType.i64 => pRead.cast<ffi.Int64>().asTypedList(info.size),
-      HalideType.u64 => pRead.cast<ffi.Uint64>().asTypedList(info.size),
-      _ => throw UnsupportedError('Data type $dtype not supported'),
-    };
-    return dataList;
+
+    return detectPostprocess(
+      readMap<ffi.Float>(),
+      headLayout(this),
+      params,
+      scores: scores?.readMap<ffi.Float>(),
+      scoreLayout: scores == null ? null : headLayout(scores),
+      priors: priors?.readMap<ffi.Float>(),
+      letterbox: letterbox,
+      numThreads: numThreads,
+    );
   }
 
   set data(List<num> data) {
@@ -719,15 +1028,22 @@ class VARP extends NativeObject {
 
   num item() => value;
 
-  bool fix(InputType type) => C.mnn_expr_VARP_fix(ptr, type.value);
+  bool fix(InputType type) {
+    _info = null;
+    return C.mnn_expr_VARP_fix(ptr, type.value);
+  }
 
-  void setOrder(DimensionFormat format) => C.mnn_expr_VARP_setOrder(ptr, format.value);
+  void setOrder(DimensionFormat format) {
+    _info = null;
+    C.mnn_expr_VARP_setOrder(ptr, format.value);
+  }
 
   @override
   String toString() {
     final s = StringBuffer('VARP(address=0x${ptr.address.toRadixString(16)}');
-    if (!(info?.isEmpty ?? true)) {
-      s.write(', shape=$shape, dtype=$dtype, size=$size');
+    final info = queryInfo();
+    if (info != null) {
+      s.write(', shape=${info.dim}, dtype=${info.type}, size=${info.size}');
     } else {
       s.write(', shape=(), dtype=(), size=0');
     }
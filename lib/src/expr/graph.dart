@@ -0,0 +1,215 @@
+/// Copyright (c) 2025, rainyl. All rights reserved.
+/// Use of this source code is governed by a
+/// Apache 2.0 license that can be found in the LICENSE file.
+
+import 'dart:ffi' as ffi;
+import 'dart:typed_data';
+
+import 'package:ffi/ffi.dart';
+
+import '../core/base.dart';
+import '../core/exception.dart';
+import '../core/halide_runtime.dart';
+import '../g/mnn.g.dart' as C;
+import 'expr.dart';
+
+/// Records expression ops as bytecode and builds the whole graph with one native call.
+///
+/// Every op returns a register index instead of a [VARP], registers
+/// `[0, numInputs)` are the inputs passed to [build]. Only the requested
+/// outputs get native handles, intermediates never cross the FFI boundary.
+///
+/// ```dart
+/// final g = GraphBuilder(numInputs: 1);
+/// final y = g.sigmoid(g.add(0, g.scalar(1.0)));
+/// final outputs = g.build([x], [y]);
+/// ```
+class GraphBuilder {
+  GraphBuilder({this.numInputs = 0}) : _numRegs = numInputs;
+
+  final int numInputs;
+  final List<int> _code = [];
+  int _numRegs;
+
+  static final _f32 = Float32List(1);
+  static final _f32Bits = _f32.buffer.asInt32List();
+
+  /// number of registers defined so far, including inputs
+  int get numRegisters => _numRegs;
+
+  /// recorded bytecode
+  Int32List get code => Int32List.fromList(_code);
+
+  /// @brief Append a raw instruction and return its result register.
+  int emit(C.ExprOpcode op, List<int> inputs, [List<int> attrs = const []]) {
+    for (final r in inputs) {
+      MnnAssert(r >= 0 && r < _numRegs, 'Invalid register $r, only $_numRegs defined');
+    }
+    _code
+      ..add(op.value)
+      ..add(inputs.length)
+      ..addAll(inputs)
+      ..add(attrs.length)
+      ..addAll(attrs);
+    return _numRegs++;
+  }
+
+  static int _bits(double v) {
+    _f32[0] = v;
+    return _f32Bits[0];
+  }
+
+  int scalar(double value) => emit(C.ExprOpcode.MNN_EXPR_OP_SCALAR_F32, [], [_bits(value)]);
+  int scalarInt(int value) => emit(C.ExprOpcode.MNN_EXPR_OP_SCALAR_I32, [], [value]);
+
+  /// @brief Embed a constant, [values] are stored as float32 or int32 depending on [dtype].
+  int constant(List<num> values, List<int> shape, {HalideType dtype = HalideType.f32}) {
+    MnnAssert(
+      dtype == HalideType.f32 || dtype == HalideType.i32,
+      'Only float32 and int32 constants are supported, got $dtype',
+    );
+    MnnAssert(
+      values.length == shape.fold(1, (a, b) => a * b),
+      'values.length=${values.length} does not match shape $shape',
+    );
+    final isFloat = dtype == HalideType.f32;
+    return emit(
+      isFloat ? C.ExprOpcode.MNN_EXPR_OP_CONST_F32 : C.ExprOpcode.MNN_EXPR_OP_CONST_I32,
+      [],
+      [shape.length, ...shape, for (final v in values) isFloat ? _bits(v.toDouble()) : v.toInt()],
+    );
+  }
+
+  int add(int x, int y) => emit(C.ExprOpcode.MNN_EXPR_OP_ADD, [x, y]);
+  int subtract(int x, int y) => emit(C.ExprOpcode.MNN_EXPR_OP_SUB, [x, y]);
+  int multiply(int x, int y) => emit(C.ExprOpcode.MNN_EXPR_OP_MUL, [x, y]);
+  int divide(int x, int y) => emit(C.ExprOpcode.MNN_EXPR_OP_DIV, [x, y]);
+  int pow(int x, int y) => emit(C.ExprOpcode.MNN_EXPR_OP_POW, [x, y]);
+  int maximum(int x, int y) => emit(C.ExprOpcode.MNN_EXPR_OP_MAXIMUM, [x, y]);
+  int minimum(int x, int y) => emit(C.ExprOpcode.MNN_EXPR_OP_MINIMUM, [x, y]);
+  int greater(int x, int y) => emit(C.ExprOpcode.MNN_EXPR_OP_GREATER, [x, y]);
+  int greaterEqual(int x, int y) => emit(C.ExprOpcode.MNN_EXPR_OP_GREATER_EQUAL, [x, y]);
+  int less(int x, int y) => emit(C.ExprOpcode.MNN_EXPR_OP_LESS, [x, y]);
+  int lessEqual(int x, int y) => emit(C.ExprOpcode.MNN_EXPR_OP_LESS_EQUAL, [x, y]);
+  int equal(int x, int y) => emit(C.ExprOpcode.MNN_EXPR_OP_EQUAL, [x, y]);
+
+  int negative(int x) => emit(C.ExprOpcode.MNN_EXPR_OP_NEG, [x]);
+  int abs(int x) => emit(C.ExprOpcode.MNN_EXPR_OP_ABS, [x]);
+  int exp(int x) => emit(C.ExprOpcode.MNN_EXPR_OP_EXP, [x]);
+  int log(int x) => emit(C.ExprOpcode.MNN_EXPR_OP_LOG, [x]);
+  int sqrt(int x) => emit(C.ExprOpcode.MNN_EXPR_OP_SQRT, [x]);
+  int square(int x) => emit(C.ExprOpcode.MNN_EXPR_OP_SQUARE, [x]);
+  int sigmoid(int x) => emit(C.ExprOpcode.MNN_EXPR_OP_SIGMOID, [x]);
+  int tanh(int x) => emit(C.ExprOpcode.MNN_EXPR_OP_TANH, [x]);
+  int relu(int x) => emit(C.ExprOpcode.MNN_EXPR_OP_RELU, [x]);
+  int floor(int x) => emit(C.ExprOpcode.MNN_EXPR_OP_FLOOR, [x]);
+  int ceil(int x) => emit(C.ExprOpcode.MNN_EXPR_OP_CEIL, [x]);
+
+  /// empty [axes] reduces all dims
+  int reduceSum(int x, List<int> axes, {bool keepDims = false}) =>
+      emit(C.ExprOpcode.MNN_EXPR_OP_REDUCE_SUM, [x], [keepDims ? 1 : 0, ...axes]);
+  int reduceMean(int x, List<int> axes, {bool keepDims = false}) =>
+      emit(C.ExprOpcode.MNN_EXPR_OP_REDUCE_MEAN, [x], [keepDims ? 1 : 0, ...axes]);
+  int reduceMax(int x, List<int> axes, {bool keepDims = false}) =>
+      emit(C.ExprOpcode.MNN_EXPR_OP_REDUCE_MAX, [x], [keepDims ? 1 : 0, ...axes]);
+  int reduceMin(int x, List<int> axes, {bool keepDims = false}) =>
+      emit(C.ExprOpcode.MNN_EXPR_OP_REDUCE_MIN, [x], [keepDims ? 1 : 0, ...axes]);
+  int argMax(int x, int axis) => emit(C.ExprOpcode.MNN_EXPR_OP_ARGMAX, [x], [axis]);
+  int argMin(int x, int axis) => emit(C.ExprOpcode.MNN_EXPR_OP_ARGMIN, [x], [axis]);
+  int softmax(int x, {int axis = -1}) => emit(C.ExprOpcode.MNN_EXPR_OP_SOFTMAX, [x], [axis]);
+
+  int reshape(int x, List<int> shape) => emit(C.ExprOpcode.MNN_EXPR_OP_RESHAPE, [x], shape);
+  int transpose(int x, List<int> perm) => emit(C.ExprOpcode.MNN_EXPR_OP_TRANSPOSE, [x], perm);
+  int squeeze(int x, [List<int> axes = const []]) => emit(C.ExprOpcode.MNN_EXPR_OP_SQUEEZE, [x], axes);
+  int unsqueeze(int x, List<int> axes) => emit(C.ExprOpcode.MNN_EXPR_OP_UNSQUEEZE, [x], axes);
+  int convert(int x, DimensionFormat format) =>
+      emit(C.ExprOpcode.MNN_EXPR_OP_CONVERT, [x], [format.value]);
+  int cast(int x, HalideType dtype) =>
+      emit(C.ExprOpcode.MNN_EXPR_OP_CAST, [x], [dtype.code.value, dtype.bits]);
+
+  int stridedSlice(
+    int x,
+    List<int> begin,
+    List<int> end,
+    List<int> strides, {
+    int beginMask = 0,
+    int endMask = 0,
+    int ellipsisMask = 0,
+    int newAxisMask = 0,
+    int shrinkAxisMask = 0,
+  }) {
+    MnnAssert(
+      begin.length == end.length && begin.length == strides.length,
+      'begin, end and strides must have the same length',
+    );
+    final masks = [beginMask, endMask, ellipsisMask, newAxisMask, shrinkAxisMask];
+    final attrs = [begin.length, ...begin, ...end, ...strides, ...masks];
+    return emit(C.ExprOpcode.MNN_EXPR_OP_STRIDED_SLICE, [x], attrs);
+  }
+
+  int gather(int params, int indices, {int axis = 0}) =>
+      emit(C.ExprOpcode.MNN_EXPR_OP_GATHER, [params, indices], [axis]);
+  int stack(List<int> values, {int axis = 0}) => emit(C.ExprOpcode.MNN_EXPR_OP_STACK, values, [axis]);
+  int concat(List<int> values, int axis) => emit(C.ExprOpcode.MNN_EXPR_OP_CONCAT, values, [axis]);
+  int select(int cond, int x, int y) => emit(C.ExprOpcode.MNN_EXPR_OP_SELECT, [cond, x, y]);
+  int matMul(int a, int b, {bool transposeA = false, bool transposeB = false}) =>
+      emit(C.ExprOpcode.MNN_EXPR_OP_MATMUL, [a, b], [transposeA ? 1 : 0, transposeB ? 1 : 0]);
+  int nms(
+    int boxes,
+    int scores,
+    int maxDetections, {
+    double iouThreshold = -1,
+    double scoreThreshold = -1,
+  }) {
+    final attrs = [maxDetections, _bits(iouThreshold), _bits(scoreThreshold)];
+    return emit(C.ExprOpcode.MNN_EXPR_OP_NMS, [boxes, scores], attrs);
+  }
+
+  /// @brief Build the recorded graph.
+  ///
+  /// @param inputs variables bound to registers `[0, numInputs)`.
+  ///
+  /// @param outputs registers to return.
+  ///
+  /// @return variables of [outputs], in order.
+  List<VARP> build(List<VARP> inputs, List<int> outputs) {
+    MnnAssert(inputs.length == numInputs, 'Expected $numInputs inputs, got ${inputs.length}');
+    final vInputs = inputs.toNativeVec();
+    final pCode = calloc<ffi.Int32>(_code.length);
+    final pOutputs = calloc<ffi.Int32>(outputs.length);
+    final pOut = calloc<C.VecVARP_t>();
+    final pOffset = calloc<ffi.Size>();
+    try {
+      pCode.asTypedList(_code.length).setAll(0, _code);
+      pOutputs.asTypedList(outputs.length).setAll(0, outputs);
+      final code = C.mnn_expr_build_graph(
+        pCode,
+        _code.length,
+        vInputs.ptr,
+        pOutputs,
+        outputs.length,
+        pOut,
+        pOffset,
+      );
+      if (code != C.ErrorCode.MNNC_NO_ERROR) {
+        throw MNNException('Failed to build graph at word ${pOffset.value}: $code');
+      }
+      final p = pOut.value;
+      final size = C.mnn_expr_VecVARP_size(p);
+      final rval = List.generate(size, (index) => VARP.fromPointer(C.mnn_expr_VecVARP_at(p, index)));
+      C.mnn_expr_VecVARP_free(p);
+      return rval;
+    } finally {
+      vInputs.dispose();
+      calloc.free(pCode);
+      calloc.free(pOutputs);
+      calloc.free(pOut);
+      calloc.free(pOffset);
+    }
+  }
+
+  @override
+  String toString() {
+    return 'GraphBuilder(numInputs=$numInputs, numRegisters=$_numRegs, codeLength=${_code.length})';
+  }
+}
@@ -5,6 +5,7 @@ import 'dart:ffi' as ffi;
 import 'package:ffi/ffi.dart';
 
 import '../core/base.dart';
+import '../core/detection.dart';
 import '../core/halide_runtime.dart';
 import '../core/vec.dart';
 import '../g/mnn.g.dart' as C;
@@ -1072,6 +1073,26 @@ VARP argMin(VARP x, int axis) => VARP.fromPointer(C.mnn_expr_ArgMin(x.ptr, axis)
 /// - Output: 3-D or higher with shape [..., r_o, c_o]
 VARP batchMatMul(VARP x, VARP y, {bool adjX = false, bool adjY = false}) =>
     VARP.fromPointer(C.mnn_expr_BatchMatMul(x.ptr, y.ptr, adjX, adjY));
+
+/// Einstein summation over the operands, e.g., `einsum('bhqd,bhkd->bhqk', [q, k])`.
+///
+/// Supports the numpy subscript syntax including `...` and implicit outputs. The operands
+/// are contracted pairwise in the order with the least multiply-adds, each step lowered to
+/// MatMul or BatchMatMul, so shapes of all operands must be known.
+VARP einsum(String subscripts, List<VARP> operands) {
+  final cSubscripts = subscripts.toNativeUtf8().cast<ffi.Char>();
+  final vec = VecVARP.of(operands);
+  final pOut = calloc<C.VARP_t>();
+  try {
+    mnnRun(() => C.mnn_expr_Einsum(cSubscripts, vec.ptr, pOut));
+    return VARP.fromPointer(pOut.value);
+  } finally {
+    calloc.free(pOut);
+    vec.dispose();
+    malloc.free(cSubscripts);
+  }
+}
+
 VARP unravelIndex(VARP indices, VARP dims) =>
     VARP.fromPointer(C.mnn_expr_UnravelIndex(indices.ptr, dims.ptr));
 VARP scatterND(VARP indices, VARP updates, VARP shape, {VARP? input, int? reduction}) => switch ((
@@ -2120,3 +2141,45 @@ VARP nms(
   double iouThreshold = -1.0,
   double scoreThreshold = -1.0,
 }) => VARP.fromPointer(C.mnn_expr_Nms(boxes.ptr, scores.ptr, maxDetections, iouThreshold, scoreThreshold));
+
+/// Batched multi-class NMS on the host, see [nmsBatched].
+///
+/// - boxes: [batch, numBoxes, 4] as x0, y0, x1, y1, or [batch, numBoxes, 5] as
+///   cx, cy, w, h, angle if [NmsParams.rotated], shared by all classes.
+/// - scores: [batch, numBoxes, numClasses].
+///
+/// Returns kept boxes of each image sorted by score.
+List<List<NmsResult>> batchedNms(
+  VARP boxes,
+  VARP scores, {
+  NmsParams params = const NmsParams(),
+  int numThreads = 0,
+}) {
+  final bd = boxes.dim ?? const <int>[];
+  final sd = scores.dim ?? const <int>[];
+  MnnAssert(sd.length == 3, 'scores must be [batch, numBoxes, numClasses], got $sd');
+  MnnAssert(
+    bd.length == 3 && bd[0] == sd[0] && bd[1] == sd[1] && bd[2] == (params.rotated ? 5 : 4),
+    'boxes must be [batch, numBoxes, ${params.rotated ? 5 : 4}] matching scores $sd, got $bd',
+  );
+  MnnAssert(
+    boxes.dtype == HalideType.f32 && scores.dtype == HalideType.f32,
+    'batchedNms only supports float32',
+  );
+  final b = convert(boxes, DimensionFormat.NCHW);
+  final s = convert(scores, DimensionFormat.NCHW);
+  try {
+    return nmsBatched(
+      b.readMap<ffi.Float>(),
+      s.readMap<ffi.Float>(),
+      sd[0],
+      sd[1],
+      sd[2],
+      params,
+      numThreads: numThreads,
+    );
+  } finally {
+    b.dispose();
+    s.dispose();
+  }
+}
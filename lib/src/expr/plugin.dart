@@ -0,0 +1,111 @@
+/// Copyright (c) 2025, rainyl. All rights reserved.
+/// Use of this source code is governed by a
+/// Apache 2.0 license that can be found in the LICENSE file.
+
+import 'dart:ffi' as ffi;
+
+import 'package:ffi/ffi.dart';
+
+import '../core/base.dart';
+import '../g/mnn.g.dart' as C;
+import 'expr.dart';
+
+/// Whether custom ops are supported, i.e., MNN is built with `MNN_WITH_PLUGIN`.
+bool get pluginSupported => C.mnn_plugin_supported();
+
+/// Register a custom CPU op computed by native functions.
+///
+/// The functions receive a `mnn_plugin_context_t` to read inputs, outputs and attributes
+/// through the `mnn_plugin_context_*` bindings, and are called on the thread running the
+/// graph, so `NativeCallable.isolateLocal` only works for graphs computed synchronously.
+/// [inferShape] sets the output shapes, if null the outputs take the shape and type of
+/// input 0. Registrations live as long as the process, registering [name] again
+/// replaces the op.
+void registerPluginOp(
+  String name, {
+  required C.mnn_plugin_kernel_fn compute,
+  C.mnn_plugin_kernel_fn? inferShape,
+  C.mnn_plugin_kernel_fn? resize,
+  ffi.Pointer<ffi.Void>? userdata,
+}) {
+  final cName = name.toNativeUtf8().cast<ffi.Char>();
+  final pOp = calloc<C.mnn_plugin_op_t>()
+    ..ref.infer_shape = inferShape ?? ffi.nullptr
+    ..ref.compute = compute
+    ..ref.resize = resize ?? ffi.nullptr
+    ..ref.userdata = userdata ?? ffi.nullptr;
+  try {
+    mnnRun(() => C.mnn_plugin_register_cpu_op(cName, pOp));
+  } finally {
+    calloc.free(pOp);
+    malloc.free(cName);
+  }
+}
+
+/// Expression of a custom op registered by [registerPluginOp].
+///
+/// [attrs] values are `int`, `double`, `String`, `List<int>` or `List<double>`.
+List<VARP> pluginOp(
+  String name,
+  List<VARP> inputs, {
+  Map<String, Object> attrs = const {},
+  int numOutputs = 1,
+}) {
+  final cName = name.toNativeUtf8().cast<ffi.Char>();
+  final vInputs = inputs.toNativeVec();
+  final pAttrs = calloc<C.mnn_plugin_attr_t>(attrs.length);
+  final allocated = <ffi.Pointer>[];
+  final pOut = calloc<C.VecVARP_t>();
+  try {
+    var i = 0;
+    for (final MapEntry(:key, :value) in attrs.entries) {
+      final attr = pAttrs[i++];
+      final cKey = key.toNativeUtf8(allocator: calloc).cast<ffi.Char>();
+      allocated.add(cKey);
+      attr.key = cKey;
+      switch (value) {
+        case int():
+          attr.type = C.PluginAttrType.MNN_PLUGIN_ATTR_INT.value;
+          attr.i = value;
+        case double():
+          attr.type = C.PluginAttrType.MNN_PLUGIN_ATTR_FLOAT.value;
+          attr.f = value;
+        case String():
+          final s = value.toNativeUtf8(allocator: calloc).cast<ffi.Char>();
+          allocated.add(s);
+          attr.type = C.PluginAttrType.MNN_PLUGIN_ATTR_STRING.value;
+          attr.s = s;
+        case List<int>():
+          final p = calloc<ffi.Int32>(value.length);
+          allocated.add(p);
+          p.asTypedList(value.length).setAll(0, value);
+          attr.type = C.PluginAttrType.MNN_PLUGIN_ATTR_INTS.value;
+          attr.ints = p;
+          attr.count = value.length;
+        case List<double>():
+          final p = calloc<ffi.Float>(value.length);
+          allocated.add(p);
+          p.asTypedList(value.length).setAll(0, value);
+          attr.type = C.PluginAttrType.MNN_PLUGIN_ATTR_FLOATS.value;
+          attr.floats = p;
+          attr.count = value.length;
+        default:
+          throw ArgumentError.value(value, key, 'Unsupported attribute type ${value.runtimeType}');
+      }
+    }
+    mnnRun(() => C.mnn_expr_plugin_op(cName, vInputs.ptr, pAttrs, attrs.length, numOutputs, pOut));
+    final p = pOut.value;
+    final size = C.mnn_expr_VecVARP_size(p);
+    final rval = List.generate(size, (index) => VARP.fromPointer(C.mnn_expr_VecVARP_at(p, index)));
+    C.mnn_expr_VecVARP_free(p);
+    return rval;
+  } finally {
+    for (final p in allocated) {
+      calloc.free(p);
+    }
+    vInputs.dispose();
+    calloc.free(pAttrs);
+    calloc.free(pOut);
+    malloc.free(cName);
+  }
+}
@@ -0,0 +1,65 @@
+/// Copyright (c) 2025, rainyl. All rights reserved.
+/// Use of this source code is governed by a
+/// Apache 2.0 license that can be found in the LICENSE file.
+
+import '../core/base.dart';
+import '../core/exception.dart';
+import '../g/mnn.g.dart' as C;
+import 'expr.dart';
+
+/// A scope that owns the native handles of [VARP] and [Expr] objects created in it.
+///
+/// Expression chains create many short-lived intermediates, in a scope their
+/// handles are allocated from native slabs and released all at once when the
+/// scope ends, instead of one allocation and one finalizer each.
+///
+/// ```dart
+/// final y = ExprScope.run((scope) {
+///   final t = x * x + x;
+///   return scope.escape(t.sum([]));
+/// });
+/// ```
+class ExprScope {
+  ExprScope._(this._ptr);
+
+  final C.mnn_expr_scope_t _ptr;
+
+  static int _depth = 0;
+
+  /// whether the current isolate is running inside a scope
+  static bool get isActive => _depth > 0;
+
+  /// @brief Run [fn] in a new scope.
+  ///
+  /// [VARP] and [Expr] objects created in [fn] have no finalizer and become invalid
+  /// when [fn] returns, use [escape] for results that outlive the scope.
+  /// [fn] must be synchronous, native scopes belong to the calling thread.
+  static T run<T>(T Function(ExprScope scope) fn) {
+    final scope = ExprScope._(C.mnn_expr_scope_begin());
+    _depth++;
+    try {
+      final result = fn(scope);
+      if (result is Future) {
+        throw MNNException('ExprScope.run does not support async functions');
+      }
+      return result;
+    } finally {
+      _depth--;
+      mnnRun(() => C.mnn_expr_scope_end(scope._ptr));
+    }
+  }
+
+  /// number of native handles owned by this scope
+  int get size => C.mnn_expr_scope_size(_ptr);
+
+  /// @brief Copy a variable out of the scope, the result is released by its finalizer.
+  VARP escape(VARP v) => VARP.fromPointer(C.mnn_expr_scope_escape_VARP(v.ptr), attach: true);
+
+  /// @brief Copy an expression out of the scope, the result is released by its finalizer.
+  Expr escapeExpr(Expr e) => Expr.fromPointer(C.mnn_expr_scope_escape_EXPRP(e.ptr), attach: true);
+
+  @override
+  String toString() {
+    return 'ExprScope(address=0x${_ptr.address.toRadixString(16)}, size=$size)';
+  }
+}
@@ -30,6 +30,129 @@ external void mnn_auto_time_destroy(
   mnn_auto_time_t auto_time,
 );
 
+/// @brief Channel-wise argmax, ties resolve to the smallest channel
+/// @param data Float data
+/// @param layout Data layout
+/// @param indices Output channel indices, shape [batch, area]
+/// @param scores Output max values, shape [batch, area], can be NULL
+/// @param num_threads Number of threads, <= 0 means using all available threads
+/// @return Error code
+@ffi.Native<
+  ffi.UnsignedInt Function(
+    ffi.Pointer<ffi.Float>,
+    ffi.Pointer<mnn_tensor_layout_t>,
+    ffi.Pointer<ffi.Int32>,
+    ffi.Pointer<ffi.Float>,
+    ffi.Int,
+  )
+>(symbol: 'mnn_channel_argmax')
+external int _mnn_channel_argmax(
+  ffi.Pointer<ffi.Float> data,
+  ffi.Pointer<mnn_tensor_layout_t> layout,
+  ffi.Pointer<ffi.Int32> indices,
+  ffi.Pointer<ffi.Float> scores,
+  int num_threads,
+);
+
+ErrorCode mnn_channel_argmax(
+  ffi.Pointer<ffi.Float> data,
+  ffi.Pointer<mnn_tensor_layout_t> layout,
+  ffi.Pointer<ffi.Int32> indices,
+  ffi.Pointer<ffi.Float> scores,
+  int num_threads,
+) => ErrorCode.fromValue(
+  _mnn_channel_argmax(
+    data,
+    layout,
+    indices,
+    scores,
+    num_threads,
+  ),
+);
+
+/// @brief Element-wise sigmoid followed by a threshold
+///
+/// sigmoid(x) > threshold is evaluated as x > logit(threshold), so no exp is computed.
+///
+/// @param data Float data
+/// @param layout Data layout
+/// @param threshold Probability threshold in [0, 1]
+/// @param mask Output mask in NCHW, 1 if sigmoid(x) > threshold else 0, shape [batch, channel, area]
+/// @param count Output number of positive elements, can be NULL
+/// @param num_threads Number of threads, <= 0 means using all available threads
+/// @return Error code
+@ffi.Native<
+  ffi.UnsignedInt Function(
+    ffi.Pointer<ffi.Float>,
+    ffi.Pointer<mnn_tensor_layout_t>,
+    ffi.Float,
+    ffi.Pointer<ffi.Uint8>,
+    ffi.Pointer<ffi.Size>,
+    ffi.Int,
+  )
+>(symbol: 'mnn_channel_sigmoid_threshold')
+external int _mnn_channel_sigmoid_threshold(
+  ffi.Pointer<ffi.Float> data,
+  ffi.Pointer<mnn_tensor_layout_t> layout,
+  double threshold,
+  ffi.Pointer<ffi.Uint8> mask,
+  ffi.Pointer<ffi.Size> count,
+  int num_threads,
+);
+
+ErrorCode mnn_channel_sigmoid_threshold(
+  ffi.Pointer<ffi.Float> data,
+  ffi.Pointer<mnn_tensor_layout_t> layout,
+  double threshold,
+  ffi.Pointer<ffi.Uint8> mask,
+  ffi.Pointer<ffi.Size> count,
+  int num_threads,
+) => ErrorCode.fromValue(
+  _mnn_channel_sigmoid_threshold(
+    data,
+    layout,
+    threshold,
+    mask,
+    count,
+    num_threads,
+  ),
+);
+
+/// @brief Channel-wise softmax
+/// @param data Float data
+/// @param layout Data layout
+/// @param dst Output probabilities in NCHW, shape [batch, channel, area]
+/// @param num_threads Number of threads, <= 0 means using all available threads
+/// @return Error code
+@ffi.Native<
+  ffi.UnsignedInt Function(
+    ffi.Pointer<ffi.Float>,
+    ffi.Pointer<mnn_tensor_layout_t>,
+    ffi.Pointer<ffi.Float>,
+    ffi.Int,
+  )
+>(symbol: 'mnn_channel_softmax')
+external int _mnn_channel_softmax(
+  ffi.Pointer<ffi.Float> data,
+  ffi.Pointer<mnn_tensor_layout_t> layout,
+  ffi.Pointer<ffi.Float> dst,
+  int num_threads,
+);
+
+ErrorCode mnn_channel_softmax(
+  ffi.Pointer<ffi.Float> data,
+  ffi.Pointer<mnn_tensor_layout_t> layout,
+  ffi.Pointer<ffi.Float> dst,
+  int num_threads,
+) => ErrorCode.fromValue(
+  _mnn_channel_softmax(
+    data,
+    layout,
+    dst,
+    num_threads,
+  ),
+);
+
 @ffi.Native<VARP_t Function(VARP_t, mnn_cv_size2i_t, ffi.Double, ffi.Double, ffi.Int)>()
 external VARP_t mnn_cv_GaussianBlur(
   VARP_t src,
@@ -1158,6 +1281,247 @@ external VARP_t mnn_cv_warpPerspective(
   int borderValue,
 );
 
+/// @brief Dequantize int8/uint8/int16 buffer to float32 buffer
+/// @param src Source buffer, element type is given by src_type
+/// @param src_type Source type, one of int8, uint8, int16
+/// @param dst Destination float buffer
+/// @param shape Logical shape of the buffer
+/// @param ndim Shape array size
+/// @param params Quantization parameters
+/// @return Error code
+@ffi.Native<
+  ffi.UnsignedInt Function(
+    ffi.Pointer<ffi.Void>,
+    halide_type_c_t,
+    ffi.Pointer<ffi.Float>,
+    ffi.Pointer<ffi.Int>,
+    ffi.Int,
+    ffi.Pointer<mnn_quant_params_t>,
+  )
+>(symbol: 'mnn_dequantize_f32')
+external int _mnn_dequantize_f32(
+  ffi.Pointer<ffi.Void> src,
+  halide_type_c_t src_type,
+  ffi.Pointer<ffi.Float> dst,
+  ffi.Pointer<ffi.Int> shape,
+  int ndim,
+  ffi.Pointer<mnn_quant_params_t> params,
+);
+
+ErrorCode mnn_dequantize_f32(
+  ffi.Pointer<ffi.Void> src,
+  halide_type_c_t src_type,
+  ffi.Pointer<ffi.Float> dst,
+  ffi.Pointer<ffi.Int> shape,
+  int ndim,
+  ffi.Pointer<mnn_quant_params_t> params,
+) => ErrorCode.fromValue(
+  _mnn_dequantize_f32(
+    src,
+    src_type,
+    dst,
+    shape,
+    ndim,
+    params,
+  ),
+);
+
+/// @brief Decode, score filter, NMS and letterbox un-mapping of a detection head
+///
+/// The head is viewed as [batch, channel, anchors] by its layout, so [1, 84, 8400] and
+/// [1, 8400, 84] outputs are both read in place. Each anchor keeps its best class, boxes
+/// are decoded only for the candidates that pass score_threshold and top_k, and NMS stops
+/// once max_detections boxes are kept. Images of the batch are processed in parallel.
+///
+/// @param head Float data of the head, box regressions for SSD
+/// @param head_layout Layout of head, channel is 4 for SSD
+/// @param scores SSD class scores, NULL for YOLO
+/// @param score_layout Layout of scores, channel is the number of classes, NULL for YOLO
+/// @param priors SSD priors [anchors, 4] as cx, cy, w, h in input pixels, NULL for YOLO
+/// @param params Postprocess parameters
+/// @param letterbox Letterbox of each image, can be NULL
+/// @param num_letterbox 0 for no mapping, 1 to share one letterbox, or the batch size
+/// @param dets Output detections, [batch, max_detections], sorted by score in each image
+/// @param counts Output number of detections of each image, [batch]
+/// @param num_threads Number of threads, <= 0 means using all available threads
+/// @return Error code
+@ffi.Native<
+  ffi.UnsignedInt Function(
+    ffi.Pointer<ffi.Float>,
+    ffi.Pointer<mnn_tensor_layout_t>,
+    ffi.Pointer<ffi.Float>,
+    ffi.Pointer<mnn_tensor_layout_t>,
+    ffi.Pointer<ffi.Float>,
+    ffi.Pointer<mnn_detect_params_t>,
+    ffi.Pointer<mnn_letterbox_t>,
+    ffi.Size,
+    ffi.Pointer<mnn_detection_t>,
+    ffi.Pointer<ffi.Int32>,
+    ffi.Int,
+  )
+>(symbol: 'mnn_detect_postprocess')
+external int _mnn_detect_postprocess(
+  ffi.Pointer<ffi.Float> head,
+  ffi.Pointer<mnn_tensor_layout_t> head_layout,
+  ffi.Pointer<ffi.Float> scores,
+  ffi.Pointer<mnn_tensor_layout_t> score_layout,
+  ffi.Pointer<ffi.Float> priors,
+  ffi.Pointer<mnn_detect_params_t> params,
+  ffi.Pointer<mnn_letterbox_t> letterbox,
+  int num_letterbox,
+  ffi.Pointer<mnn_detection_t> dets,
+  ffi.Pointer<ffi.Int32> counts,
+  int num_threads,
+);
+
+ErrorCode mnn_detect_postprocess(
+  ffi.Pointer<ffi.Float> head,
+  ffi.Pointer<mnn_tensor_layout_t> head_layout,
+  ffi.Pointer<ffi.Float> scores,
+  ffi.Pointer<mnn_tensor_layout_t> score_layout,
+  ffi.Pointer<ffi.Float> priors,
+  ffi.Pointer<mnn_detect_params_t> params,
+  ffi.Pointer<mnn_letterbox_t> letterbox,
+  int num_letterbox,
+  ffi.Pointer<mnn_detection_t> dets,
+  ffi.Pointer<ffi.Int32> counts,
+  int num_threads,
+) => ErrorCode.fromValue(
+  _mnn_detect_postprocess(
+    head,
+    head_layout,
+    scores,
+    score_layout,
+    priors,
+    params,
+    letterbox,
+    num_letterbox,
+    dets,
+    counts,
+    num_threads,
+  ),
+);
+
+/// @brief Create a dynamic batcher over a clone of a module sharing its parameters
+/// @param module Module to clone, must outlive the batcher, its inputs and outputs must have
+/// the batch on axis 0
+/// @param type Forward type of the executor, MNNForwardType
+/// @param config Backend config of the executor
+/// @param num_thread Number of threads of the executor
+/// @param max_batch Maximum number of rows along axis 0 in one forward
+/// @param max_delay_us Maximum time the oldest request waits for a batch to fill, in
+/// microseconds
+/// @return Dynamic batcher, NULL if max_batch < 1 or the clone failed
+@ffi.Native<
+  mnn_dynamic_batcher_t Function(mnn_module_t, ffi.Int, mnn_backend_config_t, ffi.Int, ffi.Int, ffi.Uint64)
+>()
+external mnn_dynamic_batcher_t mnn_dynamic_batcher_create(
+  mnn_module_t module,
+  int type,
+  mnn_backend_config_t config,
+  int num_thread,
+  int max_batch,
+  int max_delay_us,
+);
+
+/// @brief Destroy a dynamic batcher, queued requests are served first without waiting
+/// @param self Dynamic batcher
+@ffi.Native<ffi.Void Function(mnn_dynamic_batcher_t)>()
+external void mnn_dynamic_batcher_destroy(
+  mnn_dynamic_batcher_t self$1,
+);
+
+/// @brief Queue a request for the next batch
+///
+/// All inputs must have the same size on axis 0, between 1 and max_batch. Requests are
+/// batched with requests whose inputs match in count, type, format and shape except axis 0.
+/// The inputs are referenced until the request is served and must not be written meanwhile.
+/// Outputs with the batch size on axis 0 are split back, other outputs are shared by all
+/// requests of the batch.
+///
+/// @param self Dynamic batcher
+/// @param inputs Input variables
+/// @param outputs Output variables, must be freed by mnn_expr_VecVARP_free, set to NULL if
+/// forward fails
+/// @param callback If NULL, block until the outputs are ready, otherwise return after
+/// queueing and call it from the batcher thread once outputs is written
+/// @return Error code, MNNC_INVALID_VALUE if the batch sizes of the inputs are invalid,
+/// MNNC_UNKNOWN_ERROR if a blocking forward fails
+@ffi.Native<
+  ffi.UnsignedInt Function(
+    mnn_dynamic_batcher_t,
+    VecVARP_t,
+    ffi.Pointer<VecVARP_t>,
+    mnn_callback_0,
+  )
+>(symbol: 'mnn_dynamic_batcher_forward')
+external int _mnn_dynamic_batcher_forward(
+  mnn_dynamic_batcher_t self$1,
+  VecVARP_t inputs,
+  ffi.Pointer<VecVARP_t> outputs,
+  mnn_callback_0 callback,
+);
+
+ErrorCode mnn_dynamic_batcher_forward(
+  mnn_dynamic_batcher_t self$1,
+  VecVARP_t inputs,
+  ffi.Pointer<VecVARP_t> outputs,
+  mnn_callback_0 callback,
+) => ErrorCode.fromValue(_mnn_dynamic_batcher_forward(self$1, inputs, outputs, callback));
+
+/// @brief Get the histogram of batch sizes
+/// @param self Dynamic batcher
+/// @param counts Output counts, counts[i] is the number of forwards of i + 1 rows
+/// @param size Length of counts, entries past max_batch are set to 0
+/// @return Error code
+@ffi.Native<ffi.UnsignedInt Function(mnn_dynamic_batcher_t, ffi.Pointer<ffi.Uint64>, ffi.Size)>(
+  symbol: 'mnn_dynamic_batcher_get_histogram',
+)
+external int _mnn_dynamic_batcher_get_histogram(
+  mnn_dynamic_batcher_t self$1,
+  ffi.Pointer<ffi.Uint64> counts,
+  int size,
+);
+
+ErrorCode mnn_dynamic_batcher_get_histogram(
+  mnn_dynamic_batcher_t self$1,
+  ffi.Pointer<ffi.Uint64> counts,
+  int size,
+) => ErrorCode.fromValue(_mnn_dynamic_batcher_get_histogram(self$1, counts, size));
+
+/// @brief Get the request and queueing delay statistics
+/// @param self Dynamic batcher
+/// @param stats Output statistics
+/// @return Error code
+@ffi.Native<ffi.UnsignedInt Function(mnn_dynamic_batcher_t, ffi.Pointer<mnn_dynamic_batcher_stats_t>)>(
+  symbol: 'mnn_dynamic_batcher_get_stats',
+)
+external int _mnn_dynamic_batcher_get_stats(
+  mnn_dynamic_batcher_t self$1,
+  ffi.Pointer<mnn_dynamic_batcher_stats_t> stats,
+);
+
+ErrorCode mnn_dynamic_batcher_get_stats(
+  mnn_dynamic_batcher_t self$1,
+  ffi.Pointer<mnn_dynamic_batcher_stats_t> stats,
+) => ErrorCode.fromValue(_mnn_dynamic_batcher_get_stats(self$1, stats));
+
+/// @brief Get the maximum number of rows in one forward
+/// @param self Dynamic batcher
+/// @return Maximum batch size
+@ffi.Native<ffi.Int Function(mnn_dynamic_batcher_t)>()
+external int mnn_dynamic_batcher_max_batch(
+  mnn_dynamic_batcher_t self$1,
+);
+
+/// @brief Get the number of queued requests
+/// @param self Dynamic batcher
+/// @return Number of pending requests
+@ffi.Native<ffi.Size Function(mnn_dynamic_batcher_t)>()
+external int mnn_dynamic_batcher_pending(
+  mnn_dynamic_batcher_t self$1,
+);
+
 @ffi.Native<ffi.Void Function(mnn_executor_t)>()
 external void mnn_executor_destroy(
   mnn_executor_t self$1,
@@ -1185,6 +1549,161 @@ external int mnn_executor_get_lazy_mode(
   mnn_executor_t self$1,
 );
 
+/// @brief Bind the calling thread to an executor of the pool
+///
+/// Leases a free executor to the thread, blocking while all of them are leased, and enters
+/// an ExecutorScope of it so that expressions created and computed on this thread use it.
+/// Nested binds on the same thread reuse the executor. Bindings of different pools on one
+/// thread must be unbound in reverse order.
+/// Bindings are keyed by the OS thread, the matching unbind must run on the same thread
+/// before any point where the caller may move to another one.
+///
+/// @param self Executor pool
+/// @param index Output index of the bound executor, can be NULL
+/// @return Error code
+@ffi.Native<ffi.UnsignedInt Function(mnn_executor_pool_t, ffi.Pointer<ffi.Size>)>(
+  symbol: 'mnn_executor_pool_bind',
+)
+external int _mnn_executor_pool_bind(
+  mnn_executor_pool_t self$1,
+  ffi.Pointer<ffi.Size> index,
+);
+
+ErrorCode mnn_executor_pool_bind(
+  mnn_executor_pool_t self$1,
+  ffi.Pointer<ffi.Size> index,
+) => ErrorCode.fromValue(_mnn_executor_pool_bind(self$1, index));
+
+/// @brief Compute variables whose graphs are independent concurrently on the pool
+///
+/// The same as mnn_expr_VARP_static_compute_parallel with the executors of this pool.
+///
+/// A thread bound to the pool computes its share on its own executor, other executors
+/// are only used while free, so it can be called between bind and unbind.
+///
+/// @param self Executor pool
+/// @param vars Variables to compute
+/// @param forceCPU Whether to force computing on CPU
+/// @param max_workers Maximum number of concurrent groups, <= 0 means the size of the pool
+/// @param num_groups Output number of independent groups, can be NULL
+/// @return Error code
+@ffi.Native<
+  ffi.UnsignedInt Function(
+    mnn_executor_pool_t,
+    VecVARP_t,
+    ffi.Bool,
+    ffi.Int,
+    ffi.Pointer<ffi.Size>,
+  )
+>(symbol: 'mnn_executor_pool_compute')
+external int _mnn_executor_pool_compute(
+  mnn_executor_pool_t self$1,
+  VecVARP_t vars,
+  bool forceCPU,
+  int max_workers,
+  ffi.Pointer<ffi.Size> num_groups,
+);
+
+ErrorCode mnn_executor_pool_compute(
+  mnn_executor_pool_t self$1,
+  VecVARP_t vars,
+  bool forceCPU,
+  int max_workers,
+  ffi.Pointer<ffi.Size> num_groups,
+) => ErrorCode.fromValue(
+  _mnn_executor_pool_compute(
+    self$1,
+    vars,
+    forceCPU,
+    max_workers,
+    num_groups,
+  ),
+);
+
+/// @brief Create a pool of executors by mnn_executor_static_new_executor
+/// @param type Forward type, MNNForwardType
+/// @param config Backend config of each executor
+/// @param num_thread Number of threads of each executor
+/// @param size Number of executors, 0 means one per hardware thread
+/// @return Executor pool
+@ffi.Native<mnn_executor_pool_t Function(ffi.Int, mnn_backend_config_t, ffi.Int, ffi.Size)>()
+external mnn_executor_pool_t mnn_executor_pool_create(
+  int type,
+  mnn_backend_config_t config,
+  int num_thread,
+  int size,
+);
+
+/// @brief Destroy an executor pool, no thread may be bound to it
+/// @param self Executor pool
+@ffi.Native<ffi.Void Function(mnn_executor_pool_t)>()
+external void mnn_executor_pool_destroy(
+  mnn_executor_pool_t self$1,
+);
+
+/// @brief Run gc on all executors that are not leased
+/// @param self Executor pool
+/// @param flag GCFlag, 0 for FULL and 1 for PART
+/// @return Number of collected executors
+@ffi.Native<ffi.Size Function(mnn_executor_pool_t, ffi.Int)>()
+external int mnn_executor_pool_gc(
+  mnn_executor_pool_t self$1,
+  int flag,
+);
+
+/// @brief Get an executor of the pool
+/// @param self Executor pool
+/// @param index Index of the executor
+/// @return Executor, must be freed by mnn_executor_destroy, NULL if index is out of range
+@ffi.Native<mnn_executor_t Function(mnn_executor_pool_t, ffi.Size)>()
+external mnn_executor_t mnn_executor_pool_get(
+  mnn_executor_pool_t self$1,
+  int index,
+);
+
+/// @brief Get the usage statistics of an executor
+/// @param self Executor pool
+/// @param index Index of the executor
+/// @param stats Output statistics
+/// @return Error code, MNNC_INVALID_VALUE if index is out of range
+@ffi.Native<
+  ffi.UnsignedInt Function(mnn_executor_pool_t, ffi.Size, ffi.Pointer<mnn_executor_stats_t>)
+>(symbol: 'mnn_executor_pool_get_stats')
+external int _mnn_executor_pool_get_stats(
+  mnn_executor_pool_t self$1,
+  int index,
+  ffi.Pointer<mnn_executor_stats_t> stats,
+);
+
+ErrorCode mnn_executor_pool_get_stats(
+  mnn_executor_pool_t self$1,
+  int index,
+  ffi.Pointer<mnn_executor_stats_t> stats,
+) => ErrorCode.fromValue(_mnn_executor_pool_get_stats(self$1, index, stats));
+
+/// @brief Get the number of executors
+/// @param self Executor pool
+/// @return Number of executors
+@ffi.Native<ffi.Size Function(mnn_executor_pool_t)>()
+external int mnn_executor_pool_size(
+  mnn_executor_pool_t self$1,
+);
+
+/// @brief Leave the scope entered by the last mnn_executor_pool_bind on the calling thread
+///
+/// The executor is returned to the pool when the outermost bind is left.
+///
+/// @param self Executor pool
+/// @return Error code, MNNC_INVALID_VALUE if the thread is not bound
+@ffi.Native<ffi.UnsignedInt Function(mnn_executor_pool_t)>(symbol: 'mnn_executor_pool_unbind')
+external int _mnn_executor_pool_unbind(
+  mnn_executor_pool_t self$1,
+);
+
+ErrorCode mnn_executor_pool_unbind(
+  mnn_executor_pool_t self$1,
+) => ErrorCode.fromValue(_mnn_executor_pool_unbind(self$1));
+
 @ffi.Native<mnn_executor_scope_t Function(mnn_executor_t)>()
 external mnn_executor_scope_t mnn_executor_scope_create(
   mnn_executor_t current,
@@ -1593,6 +2112,35 @@ external VARP_t mnn_expr_Divide(
   VARP_t y,
 );
 
+/// @brief Evaluate an Einstein summation over the operands
+///
+/// Supports the numpy subscript syntax, e.g., "ij,jk->ik", "bhqd,bhkd->bhqk", "ii->i",
+/// "...ij,...jk" and implicit outputs. Dimensions of size 1 broadcast. Labels used by a
+/// single operand are summed first, then operands are contracted pairwise in the order
+/// with the least multiply-adds, exhaustively for up to 8 operands and greedily beyond,
+/// each step lowered to Transpose, Reshape and MatMul or BatchMatMul. Shapes of all
+/// operands must be known.
+///
+/// @param subscripts Subscripts of the operands and optionally of the output
+/// @param operands Operands
+/// @param out Result variable, must be freed by mnn_expr_VARP_free
+/// @return Error code, MNNC_INVALID_VALUE if the subscripts do not match the operands,
+/// MNNC_COMPUTE_SIZE_ERROR if a shape is unknown
+@ffi.Native<ffi.UnsignedInt Function(ffi.Pointer<ffi.Char>, VecVARP_t, ffi.Pointer<VARP_t>)>(
+  symbol: 'mnn_expr_Einsum',
+)
+external int _mnn_expr_Einsum(
+  ffi.Pointer<ffi.Char> subscripts,
+  VecVARP_t operands,
+  ffi.Pointer<VARP_t> out,
+);
+
+ErrorCode mnn_expr_Einsum(
+  ffi.Pointer<ffi.Char> subscripts,
+  VecVARP_t operands,
+  ffi.Pointer<VARP_t> out,
+) => ErrorCode.fromValue(_mnn_expr_Einsum(subscripts, operands, out));
+
 @ffi.Native<VARP_t Function(VARP_t, ffi.Float)>()
 external VARP_t mnn_expr_Elu(
   VARP_t features,
@@ -2776,6 +3324,78 @@ external mnn_tensor_t mnn_expr_VARP_getTensor(
   VARP_t self$1,
 );
 
+/// @brief Query the info of a variable into caller-provided storage
+/// @param self Variable
+/// @param ndim Output number of dims, -1 if the info can not be computed
+/// @param dims Output dims, can be NULL if dims_capacity is 0
+/// @param dims_capacity Capacity of dims in elements
+/// @param type Output data type, can be NULL
+/// @param order Output dimension format, can be NULL
+/// @param size Output number of elements, can be NULL
+/// @return Error code, MNNC_INVALID_VALUE if dims_capacity is too small, ndim is still set
+@ffi.Native<
+  ffi.UnsignedInt Function(
+    VARP_t,
+    ffi.Pointer<ffi.Int32>,
+    ffi.Pointer<ffi.Int32>,
+    ffi.Size,
+    ffi.Pointer<halide_type_c_t>,
+    ffi.Pointer<ffi.Int32>,
+    ffi.Pointer<ffi.Size>,
+  )
+>(symbol: 'mnn_expr_VARP_get_info_into')
+external int _mnn_expr_VARP_get_info_into(
+  VARP_t self$1,
+  ffi.Pointer<ffi.Int32> ndim,
+  ffi.Pointer<ffi.Int32> dims,
+  int dims_capacity,
+  ffi.Pointer<halide_type_c_t> type,
+  ffi.Pointer<ffi.Int32> order,
+  ffi.Pointer<ffi.Size> size,
+);
+
+ErrorCode mnn_expr_VARP_get_info_into(
+  VARP_t self$1,
+  ffi.Pointer<ffi.Int32> ndim,
+  ffi.Pointer<ffi.Int32> dims,
+  int dims_capacity,
+  ffi.Pointer<halide_type_c_t> type,
+  ffi.Pointer<ffi.Int32> order,
+  ffi.Pointer<ffi.Size> size,
+) => ErrorCode.fromValue(
+  _mnn_expr_VARP_get_info_into(
+    self$1,
+    ndim,
+    dims,
+    dims_capacity,
+    type,
+    order,
+    size,
+  ),
+);
+
+/// @brief Get the memory layout of the data returned by mnn_expr_VARP_readMap
+/// @param self Variable
+/// @param layout Output layout
+/// @return Error code
+@ffi.Native<ffi.UnsignedInt Function(VARP_t, ffi.Pointer<mnn_tensor_layout_t>)>(
+  symbol: 'mnn_expr_VARP_get_layout',
+)
+external int _mnn_expr_VARP_get_layout(
+  VARP_t self$1,
+  ffi.Pointer<mnn_tensor_layout_t> layout,
+);
+
+ErrorCode mnn_expr_VARP_get_layout(
+  VARP_t self$1,
+  ffi.Pointer<mnn_tensor_layout_t> layout,
+) => ErrorCode.fromValue(
+  _mnn_expr_VARP_get_layout(
+    self$1,
+    layout,
+  ),
+);
+
 @ffi.Native<ffi.Bool Function(VARP_t, VARP_t)>()
 external bool mnn_expr_VARP_input(
   VARP_t self$1,
@@ -2846,6 +3466,46 @@ external ffi.Pointer<ffi.Void> mnn_expr_VARP_readMap(
   VARP_t self$1,
 );
 
+/// @brief Compute a variable and map its host data with a reference that keeps it alive
+///
+/// The pin is a new variable bound to the same expression as `self`, it keeps the
+/// expression alive so the mapped memory stays valid after `self` is freed. The memory
+/// is not copied and is invalidated when the variable is resized, rebound by
+/// mnn_expr_VARP_input, written through mnn_expr_VARP_writeMap or recomputed after an
+/// upstream change. Release the pin with mnn_expr_VARP_free, which can be used directly
+/// as the finalizer of a view over the data.
+///
+/// @param self Variable
+/// @param data Output pointer to the host data
+/// @param size Output number of elements
+/// @param type Output data type, can be NULL
+/// @param pin Output retained variable, must be freed by mnn_expr_VARP_free
+/// @return Error code, MNNC_COMPUTE_SIZE_ERROR if the info can not be computed
+@ffi.Native<
+  ffi.UnsignedInt Function(
+    VARP_t,
+    ffi.Pointer<ffi.Pointer<ffi.Void>>,
+    ffi.Pointer<ffi.Size>,
+    ffi.Pointer<halide_type_c_t>,
+    ffi.Pointer<VARP_t>,
+  )
+>(symbol: 'mnn_expr_VARP_readMap_pinned')
+external int _mnn_expr_VARP_readMap_pinned(
+  VARP_t self$1,
+  ffi.Pointer<ffi.Pointer<ffi.Void>> data,
+  ffi.Pointer<ffi.Size> size,
+  ffi.Pointer<halide_type_c_t> type,
+  ffi.Pointer<VARP_t> pin,
+);
+
+ErrorCode mnn_expr_VARP_readMap_pinned(
+  VARP_t self$1,
+  ffi.Pointer<ffi.Pointer<ffi.Void>> data,
+  ffi.Pointer<ffi.Size> size,
+  ffi.Pointer<halide_type_c_t> type,
+  ffi.Pointer<VARP_t> pin,
+) => ErrorCode.fromValue(_mnn_expr_VARP_readMap_pinned(self$1, data, size, type, pin));
+
 @ffi.Native<ffi.Bool Function(VARP_t, VecI32)>()
 external bool mnn_expr_VARP_resize(
   VARP_t self$1,
@@ -2885,6 +3545,35 @@ external void mnn_expr_VARP_static_compute(
   bool forceCPU,
 );
 
+/// @brief Compute variables whose graphs are independent concurrently
+///
+/// The variables are partitioned into groups that share no op nodes, leaves such as
+/// inputs and constants may be shared. Each group is computed by
+/// mnn_expr_VARP_static_compute on a worker thread under the ExecutorScope of an executor
+/// leased from a shared pool of CPU executors. Returns when all groups are computed.
+///
+/// @param vars Variables to compute
+/// @param forceCPU Whether to force computing on CPU
+/// @param max_workers Maximum number of concurrent groups, <= 0 means the size of the pool
+/// @param num_groups Output number of independent groups, can be NULL
+/// @return Error code
+@ffi.Native<ffi.UnsignedInt Function(VecVARP_t, ffi.Bool, ffi.Int, ffi.Pointer<ffi.Size>)>(
+  symbol: 'mnn_expr_VARP_static_compute_parallel',
+)
+external int _mnn_expr_VARP_static_compute_parallel(
+  VecVARP_t vars,
+  bool forceCPU,
+  int max_workers,
+  ffi.Pointer<ffi.Size> num_groups,
+);
+
+ErrorCode mnn_expr_VARP_static_compute_parallel(
+  VecVARP_t vars,
+  bool forceCPU,
+  int max_workers,
+  ffi.Pointer<ffi.Size> num_groups,
+) => ErrorCode.fromValue(_mnn_expr_VARP_static_compute_parallel(vars, forceCPU, max_workers, num_groups));
+
 @ffi.Native<VARP_t Function(EXPRP_t, ffi.Int)>()
 external VARP_t mnn_expr_VARP_static_create_EXPRP(
   EXPRP_t expr,
@@ -2913,15 +3602,52 @@ external VARMAP_t mnn_expr_VARP_static_loadMapBuffer(
   int length,
 );
 
-@ffi.Native<ffi.Void Function(VecVARP_t, ffi.Bool)>()
-external void mnn_expr_VARP_static_prepareCompute(
-  VecVARP_t vars,
-  bool forceCPU,
+/// @brief Load named variables from a memory-mapped file
+/// @param fileName Path of the file
+/// @param out Loaded variables, must be freed by mnn_expr_VARMAP_free
+/// @return Error code
+@ffi.Native<ffi.UnsignedInt Function(ffi.Pointer<ffi.Char>, ffi.Pointer<VARMAP_t>)>(
+  symbol: 'mnn_expr_VARP_static_loadMap_mmap',
+)
+external int _mnn_expr_VARP_static_loadMap_mmap(
+  ffi.Pointer<ffi.Char> fileName,
+  ffi.Pointer<VARMAP_t> out,
 );
 
-@ffi.Native<ffi.Void Function(VARP_t, VARP_t)>()
-external void mnn_expr_VARP_static_replace(
-  VARP_t dst,
+ErrorCode mnn_expr_VARP_static_loadMap_mmap(
+  ffi.Pointer<ffi.Char> fileName,
+  ffi.Pointer<VARMAP_t> out,
+) => ErrorCode.fromValue(_mnn_expr_VARP_static_loadMap_mmap(fileName, out));
+
+/// @brief Load variables from a memory-mapped file
+///
+/// The file is mapped instead of read into a heap buffer and unmapped after loading.
+///
+/// @param fileName Path of the file
+/// @param out Loaded variables, must be freed by mnn_expr_VecVARP_free
+/// @return Error code
+@ffi.Native<ffi.UnsignedInt Function(ffi.Pointer<ffi.Char>, ffi.Pointer<VecVARP_t>)>(
+  symbol: 'mnn_expr_VARP_static_load_mmap',
+)
+external int _mnn_expr_VARP_static_load_mmap(
+  ffi.Pointer<ffi.Char> fileName,
+  ffi.Pointer<VecVARP_t> out,
+);
+
+ErrorCode mnn_expr_VARP_static_load_mmap(
+  ffi.Pointer<ffi.Char> fileName,
+  ffi.Pointer<VecVARP_t> out,
+) => ErrorCode.fromValue(_mnn_expr_VARP_static_load_mmap(fileName, out));
+
+@ffi.Native<ffi.Void Function(VecVARP_t, ffi.Bool)>()
+external void mnn_expr_VARP_static_prepareCompute(
+  VecVARP_t vars,
+  bool forceCPU,
+);
+
+@ffi.Native<ffi.Void Function(VARP_t, VARP_t)>()
+external void mnn_expr_VARP_static_replace(
+  VARP_t dst,
   VARP_t src,
 );
 
@@ -2943,6 +3669,74 @@ external void mnn_expr_VARP_static_saveNet(
   Net_t dest,
 );
 
+/// @brief Serialize variables and pass the bytes to a writer chunk by chunk
+///
+/// Unlike mnn_expr_VARP_static_saveBytes the serialized bytes are not copied into a
+/// returned vector, the writer consumes them in place.
+///
+/// @param vars Variables to save
+/// @param writer Writer called on the calling thread
+/// @param user_data User data passed to writer
+/// @param chunk_size Maximum size of each chunk, 0 means the whole buffer at once
+/// @return Error code, MNNC_CALL_BACK_STOP if the writer stopped the save
+@ffi.Native<
+  ffi.UnsignedInt Function(VecVARP_t, mnn_expr_write_callback_t, ffi.Pointer<ffi.Void>, ffi.Size)
+>(symbol: 'mnn_expr_VARP_static_save_callback')
+external int _mnn_expr_VARP_static_save_callback(
+  VecVARP_t vars,
+  mnn_expr_write_callback_t writer,
+  ffi.Pointer<ffi.Void> user_data,
+  int chunk_size,
+);
+
+ErrorCode mnn_expr_VARP_static_save_callback(
+  VecVARP_t vars,
+  mnn_expr_write_callback_t writer,
+  ffi.Pointer<ffi.Void> user_data,
+  int chunk_size,
+) => ErrorCode.fromValue(_mnn_expr_VARP_static_save_callback(vars, writer, user_data, chunk_size));
+
+/// @brief Serialize variables directly to an open file descriptor
+/// @param vars Variables to save
+/// @param fd File descriptor opened for writing, not closed
+/// @return Error code, MNNC_FILE_CREATE_FAILED if writing fails
+@ffi.Native<ffi.UnsignedInt Function(VecVARP_t, ffi.Int)>(symbol: 'mnn_expr_VARP_static_save_fd')
+external int _mnn_expr_VARP_static_save_fd(
+  VecVARP_t vars,
+  int fd,
+);
+
+ErrorCode mnn_expr_VARP_static_save_fd(
+  VecVARP_t vars,
+  int fd,
+) => ErrorCode.fromValue(_mnn_expr_VARP_static_save_fd(vars, fd));
+
+/// @brief Compute statistics of a variable, the variable will be computed if needed
+/// @param self Variable
+/// @param config Scan options, NULL means default options
+/// @param stats Output statistics
+/// @return Error code
+@ffi.Native<
+  ffi.UnsignedInt Function(VARP_t, ffi.Pointer<mnn_stats_config_t>, ffi.Pointer<mnn_tensor_stats_t>)
+>(symbol: 'mnn_expr_VARP_stats')
+external int _mnn_expr_VARP_stats(
+  VARP_t self$1,
+  ffi.Pointer<mnn_stats_config_t> config,
+  ffi.Pointer<mnn_tensor_stats_t> stats,
+);
+
+ErrorCode mnn_expr_VARP_stats(
+  VARP_t self$1,
+  ffi.Pointer<mnn_stats_config_t> config,
+  ffi.Pointer<mnn_tensor_stats_t> stats,
+) => ErrorCode.fromValue(
+  _mnn_expr_VARP_stats(
+    self$1,
+    config,
+    stats,
+  ),
+);
+
 @ffi.Native<VARP_t Function(VARP_t, VecI32)>()
 external VARP_t mnn_expr_VARP_sum(
   VARP_t self$1,
@@ -2954,6 +3748,38 @@ external VecWeakEXPRP_t mnn_expr_VARP_toExprs(
   VARP_t self$1,
 );
 
+/// @brief Select the top k entries along the last dimension of a float variable
+/// @param self Variable, it will be computed if needed
+/// @param config Selection options
+/// @param values Output values, [element count / last dim, k]
+/// @param indices Output indices, [element count / last dim, k]
+/// @param probs Output softmax over the selected values, can be NULL
+/// @return Error code
+@ffi.Native<
+  ffi.UnsignedInt Function(
+    VARP_t,
+    ffi.Pointer<mnn_topk_config_t>,
+    ffi.Pointer<ffi.Float>,
+    ffi.Pointer<ffi.Int32>,
+    ffi.Pointer<ffi.Float>,
+  )
+>(symbol: 'mnn_expr_VARP_topk')
+external int _mnn_expr_VARP_topk(
+  VARP_t self$1,
+  ffi.Pointer<mnn_topk_config_t> config,
+  ffi.Pointer<ffi.Float> values,
+  ffi.Pointer<ffi.Int32> indices,
+  ffi.Pointer<ffi.Float> probs,
+);
+
+ErrorCode mnn_expr_VARP_topk(
+  VARP_t self$1,
+  ffi.Pointer<mnn_topk_config_t> config,
+  ffi.Pointer<ffi.Float> values,
+  ffi.Pointer<ffi.Int32> indices,
+  ffi.Pointer<ffi.Float> probs,
+) => ErrorCode.fromValue(_mnn_expr_VARP_topk(self$1, config, values, indices, probs));
+
 @ffi.Native<ffi.Pointer<ffi.Void> Function(VARP_t)>()
 external ffi.Pointer<ffi.Void> mnn_expr_VARP_writeMap(
   VARP_t self$1,
@@ -2994,6 +3820,60 @@ external void mnn_expr_VecVARP_free(
   VecVARP_t self$1,
 );
 
+/// @brief Query the info of many variables in one call
+///
+/// The dims of all variables are concatenated into `dims`, variables whose info can not
+/// be computed get ndim -1 and contribute no dims.
+///
+/// @param self Variables
+/// @param ndims Output number of dims of each variable
+/// @param dims Output dims, can be NULL if dims_capacity is 0
+/// @param dims_capacity Capacity of dims in elements
+/// @param types Output data types, can be NULL
+/// @param orders Output dimension formats, can be NULL
+/// @param sizes Output numbers of elements, can be NULL
+/// @return Error code, MNNC_INVALID_VALUE if dims_capacity is too small, ndims are still set
+@ffi.Native<
+  ffi.UnsignedInt Function(
+    VecVARP_t,
+    ffi.Pointer<ffi.Int32>,
+    ffi.Pointer<ffi.Int32>,
+    ffi.Size,
+    ffi.Pointer<halide_type_c_t>,
+    ffi.Pointer<ffi.Int32>,
+    ffi.Pointer<ffi.Size>,
+  )
+>(symbol: 'mnn_expr_VecVARP_get_info')
+external int _mnn_expr_VecVARP_get_info(
+  VecVARP_t self$1,
+  ffi.Pointer<ffi.Int32> ndims,
+  ffi.Pointer<ffi.Int32> dims,
+  int dims_capacity,
+  ffi.Pointer<halide_type_c_t> types,
+  ffi.Pointer<ffi.Int32> orders,
+  ffi.Pointer<ffi.Size> sizes,
+);
+
+ErrorCode mnn_expr_VecVARP_get_info(
+  VecVARP_t self$1,
+  ffi.Pointer<ffi.Int32> ndims,
+  ffi.Pointer<ffi.Int32> dims,
+  int dims_capacity,
+  ffi.Pointer<halide_type_c_t> types,
+  ffi.Pointer<ffi.Int32> orders,
+  ffi.Pointer<ffi.Size> sizes,
+) => ErrorCode.fromValue(
+  _mnn_expr_VecVARP_get_info(
+    self$1,
+    ndims,
+    dims,
+    dims_capacity,
+    types,
+    orders,
+    sizes,
+  ),
+);
+
 @ffi.Native<ffi.Void Function(VecVARP_t, VARP_t)>()
 external void mnn_expr_VecVARP_push_back(
   VecVARP_t self$1,
@@ -3060,11 +3940,337 @@ external VARP_t mnn_expr_ZerosLike(
   VARP_t input,
 );
 
+/// @brief Build an expression graph from op bytecode in one call
+///
+/// Registers [0, num_inputs) hold the inputs, each instruction appends its result as
+/// the next register. An instruction is encoded as
+/// `opcode, num_inputs, input registers..., num_attrs, attrs...`
+/// and may only read registers defined before it.
+///
+/// @param code Bytecode
+/// @param code_len Number of int32 words of code
+/// @param inputs Input variables, can be NULL if there is no input
+/// @param outputs Registers to return
+/// @param num_outputs Number of outputs
+/// @param out Output variables, must be freed by mnn_expr_VecVARP_free
+/// @param error_offset Word offset of the failing instruction, can be NULL
+/// @return Error code, MNNC_NOT_SUPPORT for unknown op codes and MNNC_INVALID_VALUE for
+/// malformed instructions
+@ffi.Native<
+  ffi.UnsignedInt Function(
+    ffi.Pointer<ffi.Int32>,
+    ffi.Size,
+    VecVARP_t,
+    ffi.Pointer<ffi.Int32>,
+    ffi.Size,
+    ffi.Pointer<VecVARP_t>,
+    ffi.Pointer<ffi.Size>,
+  )
+>(symbol: 'mnn_expr_build_graph')
+external int _mnn_expr_build_graph(
+  ffi.Pointer<ffi.Int32> code,
+  int code_len,
+  VecVARP_t inputs,
+  ffi.Pointer<ffi.Int32> outputs,
+  int num_outputs,
+  ffi.Pointer<VecVARP_t> out,
+  ffi.Pointer<ffi.Size> error_offset,
+);
+
+ErrorCode mnn_expr_build_graph(
+  ffi.Pointer<ffi.Int32> code,
+  int code_len,
+  VecVARP_t inputs,
+  ffi.Pointer<ffi.Int32> outputs,
+  int num_outputs,
+  ffi.Pointer<VecVARP_t> out,
+  ffi.Pointer<ffi.Size> error_offset,
+) => ErrorCode.fromValue(
+  _mnn_expr_build_graph(
+    code,
+    code_len,
+    inputs,
+    outputs,
+    num_outputs,
+    out,
+    error_offset,
+  ),
+);
+
+/// @brief Get the size threshold of eager evaluation on the calling thread
+/// @return Maximum number of elements, 0 means disabled
+@ffi.Native<ffi.Size Function()>()
+external int mnn_expr_get_eager_threshold();
+
+/// @brief Cholesky factors of a float variable of matrices
+/// @param a Variable, [..., n, n]
+/// @param out Output variable, [..., n, n]
+/// @return Error code, MNNC_INVALID_VALUE if any matrix is not positive-definite
+@ffi.Native<ffi.UnsignedInt Function(VARP_t, ffi.Pointer<VARP_t>)>(symbol: 'mnn_expr_linalg_cholesky')
+external int _mnn_expr_linalg_cholesky(
+  VARP_t a,
+  ffi.Pointer<VARP_t> out,
+);
+
+ErrorCode mnn_expr_linalg_cholesky(
+  VARP_t a,
+  ffi.Pointer<VARP_t> out,
+) => ErrorCode.fromValue(_mnn_expr_linalg_cholesky(a, out));
+
+/// @brief Determinants of a float variable of matrices
+/// @param a Variable, [..., n, n]
+/// @param out Output variable, [...]
+/// @return Error code
+@ffi.Native<ffi.UnsignedInt Function(VARP_t, ffi.Pointer<VARP_t>)>(symbol: 'mnn_expr_linalg_det')
+external int _mnn_expr_linalg_det(
+  VARP_t a,
+  ffi.Pointer<VARP_t> out,
+);
+
+ErrorCode mnn_expr_linalg_det(
+  VARP_t a,
+  ffi.Pointer<VARP_t> out,
+) => ErrorCode.fromValue(_mnn_expr_linalg_det(a, out));
+
+/// @brief Inverses of a float variable of matrices
+/// @param a Variable, [..., n, n]
+/// @param out Output variable, [..., n, n]
+/// @return Error code, MNNC_INVALID_VALUE if any matrix is singular
+@ffi.Native<ffi.UnsignedInt Function(VARP_t, ffi.Pointer<VARP_t>)>(symbol: 'mnn_expr_linalg_inv')
+external int _mnn_expr_linalg_inv(
+  VARP_t a,
+  ffi.Pointer<VARP_t> out,
+);
+
+ErrorCode mnn_expr_linalg_inv(
+  VARP_t a,
+  ffi.Pointer<VARP_t> out,
+) => ErrorCode.fromValue(_mnn_expr_linalg_inv(a, out));
+
+/// @brief Reduced QR decompositions of a float variable of matrices
+/// @param a Variable, [..., m, n]
+/// @param q Output variable, [..., m, min(m, n)]
+/// @param r Output variable, [..., min(m, n), n]
+/// @return Error code
+@ffi.Native<ffi.UnsignedInt Function(VARP_t, ffi.Pointer<VARP_t>, ffi.Pointer<VARP_t>)>(
+  symbol: 'mnn_expr_linalg_qr',
+)
+external int _mnn_expr_linalg_qr(
+  VARP_t a,
+  ffi.Pointer<VARP_t> q,
+  ffi.Pointer<VARP_t> r,
+);
+
+ErrorCode mnn_expr_linalg_qr(
+  VARP_t a,
+  ffi.Pointer<VARP_t> q,
+  ffi.Pointer<VARP_t> r,
+) => ErrorCode.fromValue(_mnn_expr_linalg_qr(a, q, r));
+
+/// @brief Solve a x = b for a float variable of matrices
+/// @param a Variable, [..., n, n]
+/// @param b Variable, [..., n, k], or [..., n] for a single right-hand side
+/// @param out Output variable of the shape of b
+/// @return Error code, MNNC_INVALID_VALUE if any matrix is singular
+@ffi.Native<ffi.UnsignedInt Function(VARP_t, VARP_t, ffi.Pointer<VARP_t>)>(symbol: 'mnn_expr_linalg_solve')
+external int _mnn_expr_linalg_solve(
+  VARP_t a,
+  VARP_t b,
+  ffi.Pointer<VARP_t> out,
+);
+
+ErrorCode mnn_expr_linalg_solve(
+  VARP_t a,
+  VARP_t b,
+  ffi.Pointer<VARP_t> out,
+) => ErrorCode.fromValue(_mnn_expr_linalg_solve(a, b, out));
+
+/// @brief Create a custom op expression
+/// @param name Op type registered by mnn_plugin_register_cpu_op
+/// @param inputs Input variables
+/// @param attrs Attributes, copied into the op
+/// @param num_attrs Number of attributes
+/// @param num_outputs Number of outputs
+/// @param out Output variables, must be freed by mnn_expr_VecVARP_free
+/// @return Error code, MNNC_INVALID_VALUE if the op is not registered
+@ffi.Native<
+  ffi.UnsignedInt Function(
+    ffi.Pointer<ffi.Char>,
+    VecVARP_t,
+    ffi.Pointer<mnn_plugin_attr_t>,
+    ffi.Size,
+    ffi.Int,
+    ffi.Pointer<VecVARP_t>,
+  )
+>(symbol: 'mnn_expr_plugin_op')
+external int _mnn_expr_plugin_op(
+  ffi.Pointer<ffi.Char> name,
+  VecVARP_t inputs,
+  ffi.Pointer<mnn_plugin_attr_t> attrs,
+  int num_attrs,
+  int num_outputs,
+  ffi.Pointer<VecVARP_t> out,
+);
+
+ErrorCode mnn_expr_plugin_op(
+  ffi.Pointer<ffi.Char> name,
+  VecVARP_t inputs,
+  ffi.Pointer<mnn_plugin_attr_t> attrs,
+  int num_attrs,
+  int num_outputs,
+  ffi.Pointer<VecVARP_t> out,
+) => ErrorCode.fromValue(_mnn_expr_plugin_op(name, inputs, attrs, num_attrs, num_outputs, out));
+
+/// @brief Open an expression scope on the calling thread
+///
+/// Until the scope ends, VARP_t and EXPRP_t handles returned on this thread are
+/// allocated from slabs of the scope instead of one heap object each, and are all
+/// released by mnn_expr_scope_end. mnn_expr_VARP_free and mnn_expr_Expr_free do
+/// nothing for them. Scopes nest, new handles belong to the innermost one.
+///
+/// @return Scope handle
+@ffi.Native<mnn_expr_scope_t Function()>()
+external mnn_expr_scope_t mnn_expr_scope_begin();
+
+/// @brief End a scope and release all its handles, inner scopes still open are ended too
+/// @param self Scope opened on the calling thread
+/// @return Error code, MNNC_INVALID_VALUE if the scope is not open on the calling thread
+@ffi.Native<ffi.UnsignedInt Function(mnn_expr_scope_t)>(symbol: 'mnn_expr_scope_end')
+external int _mnn_expr_scope_end(
+  mnn_expr_scope_t self$1,
+);
+
+ErrorCode mnn_expr_scope_end(
+  mnn_expr_scope_t self$1,
+) => ErrorCode.fromValue(
+  _mnn_expr_scope_end(
+    self$1,
+  ),
+);
+
+/// @brief Copy a handle out of any scope
+/// @param self Expression
+/// @return Heap handle, must be freed by mnn_expr_Expr_free
+@ffi.Native<EXPRP_t Function(EXPRP_t)>()
+external EXPRP_t mnn_expr_scope_escape_EXPRP(
+  EXPRP_t self$1,
+);
+
+/// @brief Copy a handle out of any scope, e.g., a result that outlives the scope
+/// @param self Variable
+/// @return Heap handle, must be freed by mnn_expr_VARP_free
+@ffi.Native<VARP_t Function(VARP_t)>()
+external VARP_t mnn_expr_scope_escape_VARP(
+  VARP_t self$1,
+);
+
+/// @brief Get the number of handles owned by a scope
+/// @param self Scope
+/// @return Handle count
+@ffi.Native<ffi.Size Function(mnn_expr_scope_t)>()
+external int mnn_expr_scope_size(
+  mnn_expr_scope_t self$1,
+);
+
+/// @brief Set the size threshold of eager evaluation on the calling thread
+///
+/// When all inputs of an elementwise, broadcast or reduction op are float32 or int32
+/// constants with at most `max_elements` elements, mnn_expr_Add, mnn_expr_VARP_op_add,
+/// mnn_expr_ReduceSum and the like compute the result on host memory and return a
+/// constant instead of adding a node to the expression graph.
+///
+/// The threshold is per thread and only affects ops created on the calling thread.
+///
+/// @param max_elements Maximum number of elements of each input, 0 disables eager evaluation
+@ffi.Native<ffi.Void Function(ffi.Size)>()
+external void mnn_expr_set_eager_threshold(
+  int max_elements,
+);
+
 /// @brief Get MNN version
 /// @return Version string
 @ffi.Native<ffi.Pointer<ffi.Char> Function()>()
 external ffi.Pointer<ffi.Char> mnn_get_version();
 
+/// @brief Remove all compiled graphs
+/// @param self Graph cache
+@ffi.Native<ffi.Void Function(mnn_graph_cache_t)>()
+external void mnn_graph_cache_clear(
+  mnn_graph_cache_t self$1,
+);
+
+/// @brief Create a graph cache
+/// @param capacity Maximum number of compiled graphs, least recently used ones are evicted,
+/// 0 means unlimited
+/// @return Graph cache
+@ffi.Native<mnn_graph_cache_t Function(ffi.Size)>()
+external mnn_graph_cache_t mnn_graph_cache_create(
+  int capacity,
+);
+
+/// @brief Destroy a graph cache and all compiled graphs in it
+/// @param self Graph cache
+@ffi.Native<ffi.Void Function(mnn_graph_cache_t)>()
+external void mnn_graph_cache_destroy(
+  mnn_graph_cache_t self$1,
+);
+
+/// @brief Evaluate a graph through the cache
+///
+/// The key covers the ops and attributes of the graph from `inputs` to `outputs`, the
+/// shapes and types of the inputs and the data of all other leaves. The data of `inputs`
+/// is not part of the key, so they should be placeholders created by mnn_expr_Input.
+/// On a miss the graph is compiled with mnn_module_extract, later calls with the same
+/// structure rebind the inputs and run the compiled module. The graph is serialized and
+/// hashed on every call, constants included.
+///
+/// @param self Graph cache
+/// @param inputs Input variables of the graph
+/// @param outputs Output variables of the graph
+/// @param results Computed outputs, must be freed by mnn_expr_VecVARP_free
+/// @param hit Whether a compiled graph was reused, can be NULL
+/// @return Error code
+@ffi.Native<
+  ffi.UnsignedInt Function(
+    mnn_graph_cache_t,
+    VecVARP_t,
+    VecVARP_t,
+    ffi.Pointer<VecVARP_t>,
+    ffi.Pointer<ffi.Bool>,
+  )
+>(symbol: 'mnn_graph_cache_run')
+external int _mnn_graph_cache_run(
+  mnn_graph_cache_t self$1,
+  VecVARP_t inputs,
+  VecVARP_t outputs,
+  ffi.Pointer<VecVARP_t> results,
+  ffi.Pointer<ffi.Bool> hit,
+);
+
+ErrorCode mnn_graph_cache_run(
+  mnn_graph_cache_t self$1,
+  VecVARP_t inputs,
+  VecVARP_t outputs,
+  ffi.Pointer<VecVARP_t> results,
+  ffi.Pointer<ffi.Bool> hit,
+) => ErrorCode.fromValue(
+  _mnn_graph_cache_run(
+    self$1,
+    inputs,
+    outputs,
+    results,
+    hit,
+  ),
+);
+
+/// @brief Get the number of compiled graphs
+/// @param self Graph cache
+/// @return Number of compiled graphs
+@ffi.Native<ffi.Size Function(mnn_graph_cache_t)>()
+external int mnn_graph_cache_size(
+  mnn_graph_cache_t self$1,
+);
+
 /// @brief Get biz code from interpreter
 /// @param self Interpreter instance
 /// @return Biz code string or NULL if failed
@@ -3547,6 +4753,194 @@ external ffi.Pointer<ffi.Char> mnn_interpreter_uuid(
   mnn_interpreter_t self$1,
 );
 
+/// @brief Cholesky factors of a batch of symmetric positive-definite matrices
+/// @param a Matrices, [batch, n, n], only the lower triangles are read
+/// @param batch Number of matrices
+/// @param n Size of the matrices
+/// @param l Output lower triangular factors, a = l l^T, [batch, n, n], NaN if not definite
+/// @param info Output 0 for each factored matrix, 1 if it is not definite, [batch], can be NULL
+/// @param num_threads Number of threads, <= 0 means using all available threads
+/// @return Error code, MNNC_INVALID_VALUE if any matrix is not positive-definite
+@ffi.Native<
+  ffi.UnsignedInt Function(
+    ffi.Pointer<ffi.Float>,
+    ffi.Size,
+    ffi.Int,
+    ffi.Pointer<ffi.Float>,
+    ffi.Pointer<ffi.Int32>,
+    ffi.Int,
+  )
+>(symbol: 'mnn_linalg_cholesky')
+external int _mnn_linalg_cholesky(
+  ffi.Pointer<ffi.Float> a,
+  int batch,
+  int n,
+  ffi.Pointer<ffi.Float> l,
+  ffi.Pointer<ffi.Int32> info,
+  int num_threads,
+);
+
+ErrorCode mnn_linalg_cholesky(
+  ffi.Pointer<ffi.Float> a,
+  int batch,
+  int n,
+  ffi.Pointer<ffi.Float> l,
+  ffi.Pointer<ffi.Int32> info,
+  int num_threads,
+) => ErrorCode.fromValue(_mnn_linalg_cholesky(a, batch, n, l, info, num_threads));
+
+/// @brief Determinants of a batch of square matrices
+/// @param a Matrices, [batch, n, n]
+/// @param batch Number of matrices
+/// @param n Size of the matrices
+/// @param det Output determinants, [batch]
+/// @param num_threads Number of threads, <= 0 means using all available threads
+/// @return Error code
+@ffi.Native<
+  ffi.UnsignedInt Function(
+    ffi.Pointer<ffi.Float>,
+    ffi.Size,
+    ffi.Int,
+    ffi.Pointer<ffi.Float>,
+    ffi.Int,
+  )
+>(symbol: 'mnn_linalg_det')
+external int _mnn_linalg_det(
+  ffi.Pointer<ffi.Float> a,
+  int batch,
+  int n,
+  ffi.Pointer<ffi.Float> det,
+  int num_threads,
+);
+
+ErrorCode mnn_linalg_det(
+  ffi.Pointer<ffi.Float> a,
+  int batch,
+  int n,
+  ffi.Pointer<ffi.Float> det,
+  int num_threads,
+) => ErrorCode.fromValue(_mnn_linalg_det(a, batch, n, det, num_threads));
+
+/// @brief Inverses of a batch of square matrices
+/// @param a Matrices, [batch, n, n]
+/// @param batch Number of matrices
+/// @param n Size of the matrices
+/// @param inv Output inverses, [batch, n, n], NaN for singular matrices
+/// @param info Output 0 for each inverted matrix, 1 if it is singular, [batch], can be NULL
+/// @param num_threads Number of threads, <= 0 means using all available threads
+/// @return Error code, MNNC_INVALID_VALUE if any matrix is singular
+@ffi.Native<
+  ffi.UnsignedInt Function(
+    ffi.Pointer<ffi.Float>,
+    ffi.Size,
+    ffi.Int,
+    ffi.Pointer<ffi.Float>,
+    ffi.Pointer<ffi.Int32>,
+    ffi.Int,
+  )
+>(symbol: 'mnn_linalg_inv')
+external int _mnn_linalg_inv(
+  ffi.Pointer<ffi.Float> a,
+  int batch,
+  int n,
+  ffi.Pointer<ffi.Float> inv,
+  ffi.Pointer<ffi.Int32> info,
+  int num_threads,
+);
+
+ErrorCode mnn_linalg_inv(
+  ffi.Pointer<ffi.Float> a,
+  int batch,
+  int n,
+  ffi.Pointer<ffi.Float> inv,
+  ffi.Pointer<ffi.Int32> info,
+  int num_threads,
+) => ErrorCode.fromValue(_mnn_linalg_inv(a, batch, n, inv, info, num_threads));
+
+/// @brief Reduced QR decompositions of a batch of matrices by Householder reflections
+/// @param a Matrices, [batch, m, n]
+/// @param batch Number of matrices
+/// @param m Number of rows
+/// @param n Number of columns
+/// @param q Output orthonormal columns, [batch, m, min(m, n)]
+/// @param r Output upper triangular factors, [batch, min(m, n), n]
+/// @param num_threads Number of threads, <= 0 means using all available threads
+/// @return Error code
+@ffi.Native<
+  ffi.UnsignedInt Function(
+    ffi.Pointer<ffi.Float>,
+    ffi.Size,
+    ffi.Int,
+    ffi.Int,
+    ffi.Pointer<ffi.Float>,
+    ffi.Pointer<ffi.Float>,
+    ffi.Int,
+  )
+>(symbol: 'mnn_linalg_qr')
+external int _mnn_linalg_qr(
+  ffi.Pointer<ffi.Float> a,
+  int batch,
+  int m,
+  int n,
+  ffi.Pointer<ffi.Float> q,
+  ffi.Pointer<ffi.Float> r,
+  int num_threads,
+);
+
+ErrorCode mnn_linalg_qr(
+  ffi.Pointer<ffi.Float> a,
+  int batch,
+  int m,
+  int n,
+  ffi.Pointer<ffi.Float> q,
+  ffi.Pointer<ffi.Float> r,
+  int num_threads,
+) => ErrorCode.fromValue(_mnn_linalg_qr(a, batch, m, n, q, r, num_threads));
+
+/// @brief Solve a x = b for a batch of square matrices
+/// @param a Matrices, [batch, n, n]
+/// @param b Right-hand sides, [batch, n, nrhs]
+/// @param batch Number of systems
+/// @param n Size of the matrices
+/// @param nrhs Number of right-hand sides
+/// @param x Output solutions, [batch, n, nrhs], NaN for singular matrices
+/// @param info Output 0 for each solved system, 1 if its matrix is singular, [batch], can be NULL
+/// @param num_threads Number of threads, <= 0 means using all available threads
+/// @return Error code, MNNC_INVALID_VALUE if any matrix is singular
+@ffi.Native<
+  ffi.UnsignedInt Function(
+    ffi.Pointer<ffi.Float>,
+    ffi.Pointer<ffi.Float>,
+    ffi.Size,
+    ffi.Int,
+    ffi.Int,
+    ffi.Pointer<ffi.Float>,
+    ffi.Pointer<ffi.Int32>,
+    ffi.Int,
+  )
+>(symbol: 'mnn_linalg_solve')
+external int _mnn_linalg_solve(
+  ffi.Pointer<ffi.Float> a,
+  ffi.Pointer<ffi.Float> b,
+  int batch,
+  int n,
+  int nrhs,
+  ffi.Pointer<ffi.Float> x,
+  ffi.Pointer<ffi.Int32> info,
+  int num_threads,
+);
+
+ErrorCode mnn_linalg_solve(
+  ffi.Pointer<ffi.Float> a,
+  ffi.Pointer<ffi.Float> b,
+  int batch,
+  int n,
+  int nrhs,
+  ffi.Pointer<ffi.Float> x,
+  ffi.Pointer<ffi.Int32> info,
+  int num_threads,
+) => ErrorCode.fromValue(_mnn_linalg_solve(a, b, batch, n, nrhs, x, info, num_threads));
+
 @ffi.Native<ffi.Int Function(mnn_module_t, VARP_t)>()
 external int mnn_module_add_parameter(
   mnn_module_t self$1,
@@ -3600,6 +4994,48 @@ ErrorCode mnn_module_forward(
   ),
 );
 
+/// @brief Run onForward and write the outputs into caller buffers
+///
+/// Outputs are computed together, NC4HW4 outputs are converted to NCHW, and each output is
+/// copied once into its buffer as contiguous host data. No output wrappers are allocated,
+/// so a loop reusing the same inputs and buffers only allocates inside the module.
+///
+/// @param self Module
+/// @param inputs Input variables
+/// @param outputs Host buffers, one per output of the module
+/// @param sizes Sizes of the buffers in bytes
+/// @param num_outputs Number of buffers
+/// @param written Output bytes written to each buffer, can be NULL
+/// @return Error code, MNNC_INVALID_VALUE if num_outputs is not the number of outputs or a
+/// buffer is too small
+@ffi.Native<
+  ffi.UnsignedInt Function(
+    mnn_module_t,
+    VecVARP_t,
+    ffi.Pointer<ffi.Pointer<ffi.Void>>,
+    ffi.Pointer<ffi.Size>,
+    ffi.Size,
+    ffi.Pointer<ffi.Size>,
+  )
+>(symbol: 'mnn_module_forward_into')
+external int _mnn_module_forward_into(
+  mnn_module_t self$1,
+  VecVARP_t inputs,
+  ffi.Pointer<ffi.Pointer<ffi.Void>> outputs,
+  ffi.Pointer<ffi.Size> sizes,
+  int num_outputs,
+  ffi.Pointer<ffi.Size> written,
+);
+
+ErrorCode mnn_module_forward_into(
+  mnn_module_t self$1,
+  VecVARP_t inputs,
+  ffi.Pointer<ffi.Pointer<ffi.Void>> outputs,
+  ffi.Pointer<ffi.Size> sizes,
+  int num_outputs,
+  ffi.Pointer<ffi.Size> written,
+) => ErrorCode.fromValue(_mnn_module_forward_into(self$1, inputs, outputs, sizes, num_outputs, written));
+
 @ffi.Native<mnn_module_info_t Function(mnn_module_t)>(isLeaf: true)
 external mnn_module_info_t mnn_module_get_info(
   mnn_module_t self$1,
@@ -3751,44 +5187,612 @@ external int _mnn_module_on_forward(
   mnn_callback_0 callback,
 );
 
-ErrorCode mnn_module_on_forward(
-  mnn_module_t self$1,
-  VecVARP_t inputs,
-  ffi.Pointer<VecVARP_t> outputs,
-  mnn_callback_0 callback,
+ErrorCode mnn_module_on_forward(
+  mnn_module_t self$1,
+  VecVARP_t inputs,
+  ffi.Pointer<VecVARP_t> outputs,
+  mnn_callback_0 callback,
+) => ErrorCode.fromValue(
+  _mnn_module_on_forward(
+    self$1,
+    inputs,
+    outputs,
+    callback,
+  ),
+);
+
+/// @brief Create a pool of clones of a module sharing its parameters
+/// @param master Module to clone, must outlive the pool
+/// @param type Forward type of the executors, MNNForwardType
+/// @param config Backend config of the executors
+/// @param num_thread Number of threads of each executor
+/// @param size Number of workers, 0 means one per hardware thread
+/// @return Module pool, NULL if a clone failed
+@ffi.Native<mnn_module_pool_t Function(mnn_module_t, ffi.Int, mnn_backend_config_t, ffi.Int, ffi.Size)>()
+external mnn_module_pool_t mnn_module_pool_create(
+  mnn_module_t master,
+  int type,
+  mnn_backend_config_t config,
+  int num_thread,
+  int size,
+);
+
+/// @brief Destroy a module pool, queued requests are served first
+/// @param self Module pool
+@ffi.Native<ffi.Void Function(mnn_module_pool_t)>()
+external void mnn_module_pool_destroy(
+  mnn_module_pool_t self$1,
+);
+
+/// @brief Run onForward of a clone on the pool
+///
+/// The inputs are referenced until the request is served and must not be written meanwhile.
+/// The outputs are computed on the worker.
+///
+/// @param self Module pool
+/// @param inputs Input variables
+/// @param outputs Output variables, must be freed by mnn_expr_VecVARP_free, set to NULL if
+/// forward fails
+/// @param callback If NULL, block until the outputs are ready, otherwise return after
+/// queueing and call it from the worker once outputs is written
+/// @return Error code, MNNC_UNKNOWN_ERROR if a blocking forward fails
+@ffi.Native<ffi.UnsignedInt Function(mnn_module_pool_t, VecVARP_t, ffi.Pointer<VecVARP_t>, mnn_callback_0)>(
+  symbol: 'mnn_module_pool_forward',
+)
+external int _mnn_module_pool_forward(
+  mnn_module_pool_t self$1,
+  VecVARP_t inputs,
+  ffi.Pointer<VecVARP_t> outputs,
+  mnn_callback_0 callback,
+);
+
+ErrorCode mnn_module_pool_forward(
+  mnn_module_pool_t self$1,
+  VecVARP_t inputs,
+  ffi.Pointer<VecVARP_t> outputs,
+  mnn_callback_0 callback,
+) => ErrorCode.fromValue(_mnn_module_pool_forward(self$1, inputs, outputs, callback));
+
+/// @brief Get the usage statistics of a worker, utilization is busy_ns / alive_ns
+/// @param self Module pool
+/// @param index Index of the worker
+/// @param stats Output statistics
+/// @return Error code, MNNC_INVALID_VALUE if index is out of range
+@ffi.Native<ffi.UnsignedInt Function(mnn_module_pool_t, ffi.Size, ffi.Pointer<mnn_module_pool_stats_t>)>(
+  symbol: 'mnn_module_pool_get_stats',
+)
+external int _mnn_module_pool_get_stats(
+  mnn_module_pool_t self$1,
+  int index,
+  ffi.Pointer<mnn_module_pool_stats_t> stats,
+);
+
+ErrorCode mnn_module_pool_get_stats(
+  mnn_module_pool_t self$1,
+  int index,
+  ffi.Pointer<mnn_module_pool_stats_t> stats,
+) => ErrorCode.fromValue(_mnn_module_pool_get_stats(self$1, index, stats));
+
+/// @brief Get the number of queued requests that no worker has started
+/// @param self Module pool
+/// @return Number of pending requests
+@ffi.Native<ffi.Size Function(mnn_module_pool_t)>()
+external int mnn_module_pool_pending(
+  mnn_module_pool_t self$1,
+);
+
+/// @brief Get the number of workers
+/// @param self Module pool
+/// @return Number of workers
+@ffi.Native<ffi.Size Function(mnn_module_pool_t)>()
+external int mnn_module_pool_size(
+  mnn_module_pool_t self$1,
+);
+
+@ffi.Native<ffi.Void Function(mnn_module_t, ffi.Bool)>(isLeaf: true)
+external void mnn_module_set_is_training(
+  mnn_module_t self$1,
+  bool is_training,
+);
+
+@ffi.Native<ffi.Void Function(mnn_module_t, ffi.Pointer<ffi.Char>)>(isLeaf: true)
+external void mnn_module_set_name(
+  mnn_module_t self$1,
+  ffi.Pointer<ffi.Char> name,
+);
+
+@ffi.Native<ffi.Void Function(mnn_module_t, VARP_t, ffi.Int)>(isLeaf: true)
+external void mnn_module_set_parameter(
+  mnn_module_t self$1,
+  VARP_t parameter,
+  int index,
+);
+
+@ffi.Native<ffi.Void Function(mnn_module_t, ffi.Pointer<ffi.Char>)>(isLeaf: true)
+external void mnn_module_set_type(
+  mnn_module_t self$1,
+  ffi.Pointer<ffi.Char> type,
+);
+
+/// @brief Batched multi-class NMS
+///
+/// Each class of each image is suppressed independently, or all classes of an image
+/// together if class_agnostic, in parallel. Candidates are sorted by score and indexed by
+/// x0, so a kept box only visits the candidates whose x ranges can overlap it, which
+/// scales to tens of thousands of candidates.
+///
+/// @param boxes Boxes shared by all classes, [batch, num_boxes, 4] as x0, y0, x1, y1,
+/// or [batch, num_boxes, 5] as cx, cy, w, h, angle if rotated
+/// @param scores Scores, [batch, num_boxes, num_classes]
+/// @param batch Batch size
+/// @param num_boxes Number of boxes of each image
+/// @param num_classes Number of classes
+/// @param params NMS parameters
+/// @param results Output kept boxes, [batch, max_detections], sorted by score in each image
+/// @param counts Output number of kept boxes of each image, [batch]
+/// @param num_threads Number of threads, <= 0 means using all available threads
+/// @return Error code
+@ffi.Native<
+  ffi.UnsignedInt Function(
+    ffi.Pointer<ffi.Float>,
+    ffi.Pointer<ffi.Float>,
+    ffi.Int,
+    ffi.Int,
+    ffi.Int,
+    ffi.Pointer<mnn_nms_params_t>,
+    ffi.Pointer<mnn_nms_result_t>,
+    ffi.Pointer<ffi.Int32>,
+    ffi.Int,
+  )
+>(symbol: 'mnn_nms_batched')
+external int _mnn_nms_batched(
+  ffi.Pointer<ffi.Float> boxes,
+  ffi.Pointer<ffi.Float> scores,
+  int batch,
+  int num_boxes,
+  int num_classes,
+  ffi.Pointer<mnn_nms_params_t> params,
+  ffi.Pointer<mnn_nms_result_t> results,
+  ffi.Pointer<ffi.Int32> counts,
+  int num_threads,
+);
+
+ErrorCode mnn_nms_batched(
+  ffi.Pointer<ffi.Float> boxes,
+  ffi.Pointer<ffi.Float> scores,
+  int batch,
+  int num_boxes,
+  int num_classes,
+  ffi.Pointer<mnn_nms_params_t> params,
+  ffi.Pointer<mnn_nms_result_t> results,
+  ffi.Pointer<ffi.Int32> counts,
+  int num_threads,
+) => ErrorCode.fromValue(
+  _mnn_nms_batched(boxes, scores, batch, num_boxes, num_classes, params, results, counts, num_threads),
+);
+
+/// @brief Destroy an archive, all tensors obtained from it become invalid
+/// @param self Archive
+@ffi.Native<ffi.Void Function(mnn_npy_archive_t)>()
+external void mnn_npy_archive_destroy(
+  mnn_npy_archive_t self$1,
+);
+
+/// @brief Find a tensor by name
+/// @param self Archive
+/// @param name Tensor name
+/// @return Tensor index, or -1 if not found
+@ffi.Native<ffi.Int Function(mnn_npy_archive_t, ffi.Pointer<ffi.Char>)>()
+external int mnn_npy_archive_find(
+  mnn_npy_archive_t self$1,
+  ffi.Pointer<ffi.Char> name,
+);
+
+/// @brief Get the i-th tensor
+/// @param self Archive
+/// @param index Tensor index
+/// @return Tensor owned by the archive, or NULL if out of range
+@ffi.Native<mnn_tensor_t Function(mnn_npy_archive_t, ffi.Size)>()
+external mnn_tensor_t mnn_npy_archive_get(
+  mnn_npy_archive_t self$1,
+  int index,
+);
+
+/// @brief Get the name of the i-th tensor
+/// @param self Archive
+/// @param index Tensor index
+/// @return Name owned by the archive, or NULL if out of range
+@ffi.Native<ffi.Pointer<ffi.Char> Function(mnn_npy_archive_t, ffi.Size)>()
+external ffi.Pointer<ffi.Char> mnn_npy_archive_name(
+  mnn_npy_archive_t self$1,
+  int index,
+);
+
+/// @brief Open an archive or a single .npy file
+///
+/// Tensors of the archive reference the file data directly, no copy is made.
+/// With use_mmap the file is mapped copy-on-write, so writing to a tensor never
+/// modifies the file; otherwise the whole file is read into memory once.
+///
+/// @param path File path, a plain .npy file is opened as an archive with one entry named ""
+/// @param use_mmap Whether to memory-map the file
+/// @return Archive handle or NULL on failure
+@ffi.Native<mnn_npy_archive_t Function(ffi.Pointer<ffi.Char>, ffi.Bool)>()
+external mnn_npy_archive_t mnn_npy_archive_open(
+  ffi.Pointer<ffi.Char> path,
+  bool use_mmap,
+);
+
+/// @brief Get the number of tensors in the archive
+/// @param self Archive
+/// @return Tensor count
+@ffi.Native<ffi.Size Function(mnn_npy_archive_t)>()
+external int mnn_npy_archive_size(
+  mnn_npy_archive_t self$1,
+);
+
+/// @brief Save multiple host tensors to an archive file
+///
+/// The archive stores each tensor as a complete .npy blob aligned to 64 bytes,
+/// preceded by an index of names and offsets, so it can be memory-mapped.
+///
+/// @param path File path
+/// @param names Tensor names, must be unique
+/// @param tensors Host tensors
+/// @param count Number of tensors
+/// @return Error code
+@ffi.Native<
+  ffi.UnsignedInt Function(
+    ffi.Pointer<ffi.Char>,
+    ffi.Pointer<ffi.Pointer<ffi.Char>>,
+    ffi.Pointer<mnn_tensor_t>,
+    ffi.Size,
+  )
+>(symbol: 'mnn_npy_save_archive')
+external int _mnn_npy_save_archive(
+  ffi.Pointer<ffi.Char> path,
+  ffi.Pointer<ffi.Pointer<ffi.Char>> names,
+  ffi.Pointer<mnn_tensor_t> tensors,
+  int count,
+);
+
+ErrorCode mnn_npy_save_archive(
+  ffi.Pointer<ffi.Char> path,
+  ffi.Pointer<ffi.Pointer<ffi.Char>> names,
+  ffi.Pointer<mnn_tensor_t> tensors,
+  int count,
+) => ErrorCode.fromValue(
+  _mnn_npy_save_archive(
+    path,
+    names,
+    tensors,
+    count,
+  ),
+);
+
+/// @brief Float attribute of the op
+/// @param ctx Context
+/// @param key Attribute name
+/// @param value Output value
+/// @return Error code, MNNC_INVALID_VALUE if there is no such attribute
+@ffi.Native<ffi.UnsignedInt Function(mnn_plugin_context_t, ffi.Pointer<ffi.Char>, ffi.Pointer<ffi.Float>)>(
+  symbol: 'mnn_plugin_context_attr_float',
+  isLeaf: true,
+)
+external int _mnn_plugin_context_attr_float(
+  mnn_plugin_context_t ctx,
+  ffi.Pointer<ffi.Char> key,
+  ffi.Pointer<ffi.Float> value,
+);
+
+ErrorCode mnn_plugin_context_attr_float(
+  mnn_plugin_context_t ctx,
+  ffi.Pointer<ffi.Char> key,
+  ffi.Pointer<ffi.Float> value,
+) => ErrorCode.fromValue(_mnn_plugin_context_attr_float(ctx, key, value));
+
+/// @brief Float list attribute of the op
+/// @param ctx Context
+/// @param key Attribute name
+/// @param values Output values, owned by the graph
+/// @param count Output number of values
+/// @return Error code, MNNC_INVALID_VALUE if there is no such attribute
+@ffi.Native<
+  ffi.UnsignedInt Function(
+    mnn_plugin_context_t,
+    ffi.Pointer<ffi.Char>,
+    ffi.Pointer<ffi.Pointer<ffi.Float>>,
+    ffi.Pointer<ffi.Size>,
+  )
+>(
+  symbol: 'mnn_plugin_context_attr_floats',
+  isLeaf: true,
+)
+external int _mnn_plugin_context_attr_floats(
+  mnn_plugin_context_t ctx,
+  ffi.Pointer<ffi.Char> key,
+  ffi.Pointer<ffi.Pointer<ffi.Float>> values,
+  ffi.Pointer<ffi.Size> count,
+);
+
+ErrorCode mnn_plugin_context_attr_floats(
+  mnn_plugin_context_t ctx,
+  ffi.Pointer<ffi.Char> key,
+  ffi.Pointer<ffi.Pointer<ffi.Float>> values,
+  ffi.Pointer<ffi.Size> count,
+) => ErrorCode.fromValue(_mnn_plugin_context_attr_floats(ctx, key, values, count));
+
+/// @brief Integer attribute of the op
+/// @param ctx Context
+/// @param key Attribute name
+/// @param value Output value
+/// @return Error code, MNNC_INVALID_VALUE if there is no such attribute
+@ffi.Native<ffi.UnsignedInt Function(mnn_plugin_context_t, ffi.Pointer<ffi.Char>, ffi.Pointer<ffi.Int32>)>(
+  symbol: 'mnn_plugin_context_attr_int',
+  isLeaf: true,
+)
+external int _mnn_plugin_context_attr_int(
+  mnn_plugin_context_t ctx,
+  ffi.Pointer<ffi.Char> key,
+  ffi.Pointer<ffi.Int32> value,
+);
+
+ErrorCode mnn_plugin_context_attr_int(
+  mnn_plugin_context_t ctx,
+  ffi.Pointer<ffi.Char> key,
+  ffi.Pointer<ffi.Int32> value,
+) => ErrorCode.fromValue(_mnn_plugin_context_attr_int(ctx, key, value));
+
+/// @brief Integer list attribute of the op
+/// @param ctx Context
+/// @param key Attribute name
+/// @param values Output values, owned by the graph
+/// @param count Output number of values
+/// @return Error code, MNNC_INVALID_VALUE if there is no such attribute
+@ffi.Native<
+  ffi.UnsignedInt Function(
+    mnn_plugin_context_t,
+    ffi.Pointer<ffi.Char>,
+    ffi.Pointer<ffi.Pointer<ffi.Int32>>,
+    ffi.Pointer<ffi.Size>,
+  )
+>(
+  symbol: 'mnn_plugin_context_attr_ints',
+  isLeaf: true,
+)
+external int _mnn_plugin_context_attr_ints(
+  mnn_plugin_context_t ctx,
+  ffi.Pointer<ffi.Char> key,
+  ffi.Pointer<ffi.Pointer<ffi.Int32>> values,
+  ffi.Pointer<ffi.Size> count,
+);
+
+ErrorCode mnn_plugin_context_attr_ints(
+  mnn_plugin_context_t ctx,
+  ffi.Pointer<ffi.Char> key,
+  ffi.Pointer<ffi.Pointer<ffi.Int32>> values,
+  ffi.Pointer<ffi.Size> count,
+) => ErrorCode.fromValue(_mnn_plugin_context_attr_ints(ctx, key, values, count));
+
+/// @brief String attribute of the op
+/// @param ctx Context
+/// @param key Attribute name
+/// @param value Output string, owned by the graph
+/// @return Error code, MNNC_INVALID_VALUE if there is no such attribute
+@ffi.Native<
+  ffi.UnsignedInt Function(
+    mnn_plugin_context_t,
+    ffi.Pointer<ffi.Char>,
+    ffi.Pointer<ffi.Pointer<ffi.Char>>,
+  )
+>(
+  symbol: 'mnn_plugin_context_attr_string',
+  isLeaf: true,
+)
+external int _mnn_plugin_context_attr_string(
+  mnn_plugin_context_t ctx,
+  ffi.Pointer<ffi.Char> key,
+  ffi.Pointer<ffi.Pointer<ffi.Char>> value,
+);
+
+ErrorCode mnn_plugin_context_attr_string(
+  mnn_plugin_context_t ctx,
+  ffi.Pointer<ffi.Char> key,
+  ffi.Pointer<ffi.Pointer<ffi.Char>> value,
+) => ErrorCode.fromValue(_mnn_plugin_context_attr_string(ctx, key, value));
+
+/// @brief Input tensor, owned by the graph, NULL if index is out of range
+@ffi.Native<mnn_tensor_t Function(mnn_plugin_context_t, ffi.Int)>(isLeaf: true)
+external mnn_tensor_t mnn_plugin_context_input(
+  mnn_plugin_context_t ctx,
+  int index,
+);
+
+/// @brief Number of inputs of the op
+@ffi.Native<ffi.Int Function(mnn_plugin_context_t)>(isLeaf: true)
+external int mnn_plugin_context_num_inputs(
+  mnn_plugin_context_t ctx,
+);
+
+/// @brief Number of outputs of the op
+@ffi.Native<ffi.Int Function(mnn_plugin_context_t)>(isLeaf: true)
+external int mnn_plugin_context_num_outputs(
+  mnn_plugin_context_t ctx,
+);
+
+/// @brief Output tensor, owned by the graph, NULL if index is out of range
+@ffi.Native<mnn_tensor_t Function(mnn_plugin_context_t, ffi.Int)>(isLeaf: true)
+external mnn_tensor_t mnn_plugin_context_output(
+  mnn_plugin_context_t ctx,
+  int index,
+);
+
+/// @brief Set the shape and type of an output, for shape inference
+/// @param ctx Context
+/// @param index Output index
+/// @param shape Shape of the output
+/// @param ndim Number of dimensions
+/// @param type Element type
+/// @return Error code
+@ffi.Native<
+  ffi.UnsignedInt Function(
+    mnn_plugin_context_t,
+    ffi.Int,
+    ffi.Pointer<ffi.Int>,
+    ffi.Int,
+    halide_type_c_t,
+  )
+>(
+  symbol: 'mnn_plugin_context_set_output',
+  isLeaf: true,
+)
+external int _mnn_plugin_context_set_output(
+  mnn_plugin_context_t ctx,
+  int index,
+  ffi.Pointer<ffi.Int> shape,
+  int ndim,
+  halide_type_c_t type,
+);
+
+ErrorCode mnn_plugin_context_set_output(
+  mnn_plugin_context_t ctx,
+  int index,
+  ffi.Pointer<ffi.Int> shape,
+  int ndim,
+  halide_type_c_t type,
+) => ErrorCode.fromValue(_mnn_plugin_context_set_output(ctx, index, shape, ndim, type));
+
+/// @brief Register a custom CPU op, registering a name again replaces the op
+///
+/// Registrations live as long as the process and must happen before graphs using the op
+/// are computed, the registry is not synchronized with running graphs.
+///
+/// @param name Op type, referenced by mnn_expr_plugin_op
+/// @param op Functions of the op, copied
+/// @return Error code
+@ffi.Native<ffi.UnsignedInt Function(ffi.Pointer<ffi.Char>, ffi.Pointer<mnn_plugin_op_t>)>(
+  symbol: 'mnn_plugin_register_cpu_op',
+)
+external int _mnn_plugin_register_cpu_op(
+  ffi.Pointer<ffi.Char> name,
+  ffi.Pointer<mnn_plugin_op_t> op,
+);
+
+ErrorCode mnn_plugin_register_cpu_op(
+  ffi.Pointer<ffi.Char> name,
+  ffi.Pointer<mnn_plugin_op_t> op,
+) => ErrorCode.fromValue(_mnn_plugin_register_cpu_op(name, op));
+
+/// @brief Whether custom ops are supported, i.e., MNN is built with MNN_WITH_PLUGIN
+@ffi.Native<ffi.Bool Function()>()
+external bool mnn_plugin_supported();
+
+/// @brief Quantize float32 buffer to int8/uint8/int16 buffer
+/// @param src Source float buffer
+/// @param dst Destination buffer, element type is given by dst_type
+/// @param dst_type Destination type, one of int8, uint8, int16
+/// @param shape Logical shape of the buffer
+/// @param ndim Shape array size
+/// @param params Quantization parameters
+/// @return Error code
+@ffi.Native<
+  ffi.UnsignedInt Function(
+    ffi.Pointer<ffi.Float>,
+    ffi.Pointer<ffi.Void>,
+    halide_type_c_t,
+    ffi.Pointer<ffi.Int>,
+    ffi.Int,
+    ffi.Pointer<mnn_quant_params_t>,
+  )
+>(symbol: 'mnn_quantize_f32')
+external int _mnn_quantize_f32(
+  ffi.Pointer<ffi.Float> src,
+  ffi.Pointer<ffi.Void> dst,
+  halide_type_c_t dst_type,
+  ffi.Pointer<ffi.Int> shape,
+  int ndim,
+  ffi.Pointer<mnn_quant_params_t> params,
+);
+
+ErrorCode mnn_quantize_f32(
+  ffi.Pointer<ffi.Float> src,
+  ffi.Pointer<ffi.Void> dst,
+  halide_type_c_t dst_type,
+  ffi.Pointer<ffi.Int> shape,
+  int ndim,
+  ffi.Pointer<mnn_quant_params_t> params,
 ) => ErrorCode.fromValue(
-  _mnn_module_on_forward(
-    self$1,
-    inputs,
-    outputs,
-    callback,
+  _mnn_quantize_f32(
+    src,
+    dst,
+    dst_type,
+    shape,
+    ndim,
+    params,
   ),
 );
 
-@ffi.Native<ffi.Void Function(mnn_module_t, ffi.Bool)>(isLeaf: true)
-external void mnn_module_set_is_training(
-  mnn_module_t self$1,
-  bool is_training,
+/// @brief Create a variable filled with samples
+/// @param params Distribution, seed and offset
+/// @param shape Shape of the variable
+/// @param ndim Number of dimensions
+/// @param num_threads Number of threads, <= 0 means using all available threads
+/// @param out Output variable, float or int32 by the distribution, NCHW
+/// @return Error code
+@ffi.Native<
+  ffi.UnsignedInt Function(
+    ffi.Pointer<mnn_rng_params_t>,
+    ffi.Pointer<ffi.Int>,
+    ffi.Size,
+    ffi.Int,
+    ffi.Pointer<VARP_t>,
+  )
+>(symbol: 'mnn_rng_create_var')
+external int _mnn_rng_create_var(
+  ffi.Pointer<mnn_rng_params_t> params,
+  ffi.Pointer<ffi.Int> shape,
+  int ndim,
+  int num_threads,
+  ffi.Pointer<VARP_t> out,
 );
 
-@ffi.Native<ffi.Void Function(mnn_module_t, ffi.Pointer<ffi.Char>)>(isLeaf: true)
-external void mnn_module_set_name(
-  mnn_module_t self$1,
-  ffi.Pointer<ffi.Char> name,
+ErrorCode mnn_rng_create_var(
+  ffi.Pointer<mnn_rng_params_t> params,
+  ffi.Pointer<ffi.Int> shape,
+  int ndim,
+  int num_threads,
+  ffi.Pointer<VARP_t> out,
+) => ErrorCode.fromValue(_mnn_rng_create_var(params, shape, ndim, num_threads, out));
+
+/// @brief Fill a host buffer with samples
+/// @param params Distribution, seed and offset
+/// @param out Output buffer, float for uniform and normal, int32 for integer and Bernoulli
+/// @param count Number of samples
+/// @param num_threads Number of threads, <= 0 means using all available threads
+/// @return Error code, MNNC_INVALID_VALUE if the distribution parameters are invalid
+@ffi.Native<
+  ffi.UnsignedInt Function(ffi.Pointer<mnn_rng_params_t>, ffi.Pointer<ffi.Void>, ffi.Size, ffi.Int)
+>(symbol: 'mnn_rng_fill')
+external int _mnn_rng_fill(
+  ffi.Pointer<mnn_rng_params_t> params,
+  ffi.Pointer<ffi.Void> out,
+  int count,
+  int num_threads,
 );
 
-@ffi.Native<ffi.Void Function(mnn_module_t, VARP_t, ffi.Int)>(isLeaf: true)
-external void mnn_module_set_parameter(
-  mnn_module_t self$1,
-  VARP_t parameter,
-  int index,
-);
+ErrorCode mnn_rng_fill(
+  ffi.Pointer<mnn_rng_params_t> params,
+  ffi.Pointer<ffi.Void> out,
+  int count,
+  int num_threads,
+) => ErrorCode.fromValue(_mnn_rng_fill(params, out, count, num_threads));
 
-@ffi.Native<ffi.Void Function(mnn_module_t, ffi.Pointer<ffi.Char>)>(isLeaf: true)
-external void mnn_module_set_type(
-  mnn_module_t self$1,
-  ffi.Pointer<ffi.Char> type,
-);
+/// @brief Intersection over union of two rotated boxes
+/// @param a Box [cx, cy, w, h, angle] with angle in radians
+/// @param b Box [cx, cy, w, h, angle] with angle in radians
+/// @return IoU in [0, 1]
+@ffi.Native<ffi.Float Function(ffi.Pointer<ffi.Float>, ffi.Pointer<ffi.Float>)>()
+external double mnn_rotated_iou(ffi.Pointer<ffi.Float> a, ffi.Pointer<ffi.Float> b);
 
 /// @brief Destroy runtime info
 /// @param runtime Runtime info to destroy
@@ -3865,6 +5869,205 @@ external void mnn_runtime_manager_update_cache(
   mnn_runtime_manager_t self$1,
 );
 
+/// @brief Create a sampler
+/// @param config Sampler config
+/// @return Sampler, NULL if the config is invalid
+@ffi.Native<mnn_sampler_t Function(ffi.Pointer<mnn_sampler_config_t>)>()
+external mnn_sampler_t mnn_sampler_create(
+  ffi.Pointer<mnn_sampler_config_t> config,
+);
+
+/// @brief Destroy a sampler
+/// @param self Sampler
+@ffi.Native<ffi.Void Function(mnn_sampler_t)>()
+external void mnn_sampler_destroy(
+  mnn_sampler_t self$1,
+);
+
+/// @brief Sample the next token from a row of logits
+///
+/// With top_k, the logits are scanned once by a bounded heap and only the k candidates are
+/// exponentiated. Otherwise the softmax of the whole row is computed into a buffer reused
+/// across calls. The random generator advances by one draw per call, greedy decoding, also
+/// with top_k 1, does not advance it.
+///
+/// @param self Sampler
+/// @param logits Logits, [vocab]
+/// @param vocab Vocabulary size
+/// @param history Previous tokens the repetition penalty applies to, can be NULL
+/// @param num_history Number of previous tokens
+/// @param token Output sampled token
+/// @param prob Output probability of the token after all transforms, can be NULL
+/// @return Error code, MNNC_INVALID_VALUE if all logits are NaN or a token is out of range
+@ffi.Native<
+  ffi.UnsignedInt Function(
+    mnn_sampler_t,
+    ffi.Pointer<ffi.Float>,
+    ffi.Size,
+    ffi.Pointer<ffi.Int32>,
+    ffi.Size,
+    ffi.Pointer<ffi.Int32>,
+    ffi.Pointer<ffi.Float>,
+  )
+>(symbol: 'mnn_sampler_sample')
+external int _mnn_sampler_sample(
+  mnn_sampler_t self$1,
+  ffi.Pointer<ffi.Float> logits,
+  int vocab,
+  ffi.Pointer<ffi.Int32> history,
+  int num_history,
+  ffi.Pointer<ffi.Int32> token,
+  ffi.Pointer<ffi.Float> prob,
+);
+
+ErrorCode mnn_sampler_sample(
+  mnn_sampler_t self$1,
+  ffi.Pointer<ffi.Float> logits,
+  int vocab,
+  ffi.Pointer<ffi.Int32> history,
+  int num_history,
+  ffi.Pointer<ffi.Int32> token,
+  ffi.Pointer<ffi.Float> prob,
+) => ErrorCode.fromValue(_mnn_sampler_sample(self$1, logits, vocab, history, num_history, token, prob));
+
+/// @brief Sample the next token from the last row of a float host tensor
+/// @param self Sampler
+/// @param logits Host tensor, [..., vocab], NC4HW4 tensors are not supported
+/// @param history Previous tokens the repetition penalty applies to, can be NULL
+/// @param num_history Number of previous tokens
+/// @param token Output sampled token
+/// @param prob Output probability of the token, can be NULL
+/// @return Error code
+@ffi.Native<
+  ffi.UnsignedInt Function(
+    mnn_sampler_t,
+    mnn_tensor_t,
+    ffi.Pointer<ffi.Int32>,
+    ffi.Size,
+    ffi.Pointer<ffi.Int32>,
+    ffi.Pointer<ffi.Float>,
+  )
+>(symbol: 'mnn_sampler_sample_tensor')
+external int _mnn_sampler_sample_tensor(
+  mnn_sampler_t self$1,
+  mnn_tensor_t logits,
+  ffi.Pointer<ffi.Int32> history,
+  int num_history,
+  ffi.Pointer<ffi.Int32> token,
+  ffi.Pointer<ffi.Float> prob,
+);
+
+ErrorCode mnn_sampler_sample_tensor(
+  mnn_sampler_t self$1,
+  mnn_tensor_t logits,
+  ffi.Pointer<ffi.Int32> history,
+  int num_history,
+  ffi.Pointer<ffi.Int32> token,
+  ffi.Pointer<ffi.Float> prob,
+) => ErrorCode.fromValue(_mnn_sampler_sample_tensor(self$1, logits, history, num_history, token, prob));
+
+/// @brief Sample the next token from the last row of a float variable
+/// @param self Sampler
+/// @param logits Variable, [..., vocab], it will be computed if needed
+/// @param history Previous tokens the repetition penalty applies to, can be NULL
+/// @param num_history Number of previous tokens
+/// @param token Output sampled token
+/// @param prob Output probability of the token, can be NULL
+/// @return Error code
+@ffi.Native<
+  ffi.UnsignedInt Function(
+    mnn_sampler_t,
+    VARP_t,
+    ffi.Pointer<ffi.Int32>,
+    ffi.Size,
+    ffi.Pointer<ffi.Int32>,
+    ffi.Pointer<ffi.Float>,
+  )
+>(symbol: 'mnn_sampler_sample_var')
+external int _mnn_sampler_sample_var(
+  mnn_sampler_t self$1,
+  VARP_t logits,
+  ffi.Pointer<ffi.Int32> history,
+  int num_history,
+  ffi.Pointer<ffi.Int32> token,
+  ffi.Pointer<ffi.Float> prob,
+);
+
+ErrorCode mnn_sampler_sample_var(
+  mnn_sampler_t self$1,
+  VARP_t logits,
+  ffi.Pointer<ffi.Int32> history,
+  int num_history,
+  ffi.Pointer<ffi.Int32> token,
+  ffi.Pointer<ffi.Float> prob,
+) => ErrorCode.fromValue(_mnn_sampler_sample_var(self$1, logits, history, num_history, token, prob));
+
+/// @brief Replace the config of a sampler, the random generator is reseeded
+/// @param self Sampler
+/// @param config Sampler config
+/// @return Error code
+@ffi.Native<ffi.UnsignedInt Function(mnn_sampler_t, ffi.Pointer<mnn_sampler_config_t>)>(
+  symbol: 'mnn_sampler_set_config',
+)
+external int _mnn_sampler_set_config(
+  mnn_sampler_t self$1,
+  ffi.Pointer<mnn_sampler_config_t> config,
+);
+
+ErrorCode mnn_sampler_set_config(
+  mnn_sampler_t self$1,
+  ffi.Pointer<mnn_sampler_config_t> config,
+) => ErrorCode.fromValue(_mnn_sampler_set_config(self$1, config));
+
+/// @brief Reseed the random generator, the same seed and inputs draw the same tokens
+/// @param self Sampler
+/// @param seed Seed
+@ffi.Native<ffi.Void Function(mnn_sampler_t, ffi.Uint64)>()
+external void mnn_sampler_set_seed(
+  mnn_sampler_t self$1,
+  int seed,
+);
+
+/// @brief Compute statistics of a raw buffer
+/// @param data Buffer pointer
+/// @param type Element type, one of float32/float64/int8/uint8/int16/uint16/int32
+/// @param count Element count
+/// @param config Scan options, NULL means default options
+/// @param stats Output statistics
+/// @return Error code
+@ffi.Native<
+  ffi.UnsignedInt Function(
+    ffi.Pointer<ffi.Void>,
+    halide_type_c_t,
+    ffi.Size,
+    ffi.Pointer<mnn_stats_config_t>,
+    ffi.Pointer<mnn_tensor_stats_t>,
+  )
+>(symbol: 'mnn_stats_compute')
+external int _mnn_stats_compute(
+  ffi.Pointer<ffi.Void> data,
+  halide_type_c_t type,
+  int count,
+  ffi.Pointer<mnn_stats_config_t> config,
+  ffi.Pointer<mnn_tensor_stats_t> stats,
+);
+
+ErrorCode mnn_stats_compute(
+  ffi.Pointer<ffi.Void> data,
+  halide_type_c_t type,
+  int count,
+  ffi.Pointer<mnn_stats_config_t> config,
+  ffi.Pointer<mnn_tensor_stats_t> stats,
+) => ErrorCode.fromValue(
+  _mnn_stats_compute(
+    data,
+    type,
+    count,
+    config,
+    stats,
+  ),
+);
+
 /// @brief Get tensor batch
 /// @param self Tensor
 /// @return Batch
@@ -3919,6 +6122,41 @@ ErrorCode mnn_tensor_copy_from_host(
   ),
 );
 
+/// @brief Copy data from host tensor, using multiple threads for large tensors
+///
+/// If both tensors are accessible from host, the copy and the NCHW/NHWC/NC4HW4
+/// layout conversion are split across a thread pool; otherwise it falls back to
+/// mnn_tensor_copy_from_host.
+///
+/// @param self Target tensor
+/// @param host_tensor Source tensor
+/// @param num_threads Number of threads, <= 0 means using all available threads
+/// @param threshold Tensors smaller than threshold bytes use mnn_tensor_copy_from_host
+/// @return Error code, same as mnn_tensor_copy_from_host, MNNC_BOOL_TRUE if copied in parallel
+@ffi.Native<ffi.UnsignedInt Function(mnn_tensor_t, mnn_tensor_t, ffi.Int, ffi.Size)>(
+  symbol: 'mnn_tensor_copy_from_host_parallel',
+)
+external int _mnn_tensor_copy_from_host_parallel(
+  mnn_tensor_t self$1,
+  mnn_tensor_t host_tensor,
+  int num_threads,
+  int threshold,
+);
+
+ErrorCode mnn_tensor_copy_from_host_parallel(
+  mnn_tensor_t self$1,
+  mnn_tensor_t host_tensor,
+  int num_threads,
+  int threshold,
+) => ErrorCode.fromValue(
+  _mnn_tensor_copy_from_host_parallel(
+    self$1,
+    host_tensor,
+    num_threads,
+    threshold,
+  ),
+);
+
 /// @brief Copy data to host tensor
 /// @param self Source tensor
 /// @param host_tensor Target tensor
@@ -3939,6 +6177,41 @@ ErrorCode mnn_tensor_copy_to_host(
   ),
 );
 
+/// @brief Copy data to host tensor, using multiple threads for large tensors
+///
+/// If both tensors are accessible from host, the copy and the NCHW/NHWC/NC4HW4
+/// layout conversion are split across a thread pool; otherwise it falls back to
+/// mnn_tensor_copy_to_host.
+///
+/// @param self Source tensor
+/// @param host_tensor Target tensor
+/// @param num_threads Number of threads, <= 0 means using all available threads
+/// @param threshold Tensors smaller than threshold bytes use mnn_tensor_copy_to_host
+/// @return Error code, same as mnn_tensor_copy_to_host, MNNC_BOOL_TRUE if copied in parallel
+@ffi.Native<ffi.UnsignedInt Function(mnn_tensor_t, mnn_tensor_t, ffi.Int, ffi.Size)>(
+  symbol: 'mnn_tensor_copy_to_host_parallel',
+)
+external int _mnn_tensor_copy_to_host_parallel(
+  mnn_tensor_t self$1,
+  mnn_tensor_t host_tensor,
+  int num_threads,
+  int threshold,
+);
+
+ErrorCode mnn_tensor_copy_to_host_parallel(
+  mnn_tensor_t self$1,
+  mnn_tensor_t host_tensor,
+  int num_threads,
+  int threshold,
+) => ErrorCode.fromValue(
+  _mnn_tensor_copy_to_host_parallel(
+    self$1,
+    host_tensor,
+    num_threads,
+    threshold,
+  ),
+);
+
 /// @brief Create tensor with dimension size and type
 /// @param dim_size Dimension size
 /// @param type Dimension type
@@ -4047,6 +6320,32 @@ mnn_tensor_t mnn_tensor_create_with_data(
   dim_type.value,
 );
 
+/// @brief Dequantize the host memory of a quantized tensor into a float32 buffer
+/// @param self Host tensor with int8/uint8/int16 type
+/// @param dst Destination float buffer, element count must equal the tensor's
+/// @param params Quantization parameters, axis refers to the tensor's shape
+/// @return Error code
+@ffi.Native<
+  ffi.UnsignedInt Function(mnn_tensor_t, ffi.Pointer<ffi.Float>, ffi.Pointer<mnn_quant_params_t>)
+>(symbol: 'mnn_tensor_dequantize_to_f32', isLeaf: true)
+external int _mnn_tensor_dequantize_to_f32(
+  mnn_tensor_t self$1,
+  ffi.Pointer<ffi.Float> dst,
+  ffi.Pointer<mnn_quant_params_t> params,
+);
+
+ErrorCode mnn_tensor_dequantize_to_f32(
+  mnn_tensor_t self$1,
+  ffi.Pointer<ffi.Float> dst,
+  ffi.Pointer<mnn_quant_params_t> params,
+) => ErrorCode.fromValue(
+  _mnn_tensor_dequantize_to_f32(
+    self$1,
+    dst,
+    params,
+  ),
+);
+
 /// @brief Destroy tensor
 /// @param tensor Tensor to destroy
 @ffi.Native<ffi.Void Function(mnn_tensor_t)>(isLeaf: true)
@@ -4110,6 +6409,29 @@ HandleDataType mnn_tensor_get_handle_data_type(
   ),
 );
 
+/// @brief Get the memory layout of a tensor
+/// @param self Tensor
+/// @param layout Output layout
+/// @return Error code
+@ffi.Native<ffi.UnsignedInt Function(mnn_tensor_t, ffi.Pointer<mnn_tensor_layout_t>)>(
+  symbol: 'mnn_tensor_get_layout',
+  isLeaf: true,
+)
+external int _mnn_tensor_get_layout(
+  mnn_tensor_t self$1,
+  ffi.Pointer<mnn_tensor_layout_t> layout,
+);
+
+ErrorCode mnn_tensor_get_layout(
+  mnn_tensor_t self$1,
+  ffi.Pointer<mnn_tensor_layout_t> layout,
+) => ErrorCode.fromValue(
+  _mnn_tensor_get_layout(
+    self$1,
+    layout,
+  ),
+);
+
 /// @brief Get data type
 /// @param self Tensor
 /// @return Data type
@@ -4144,6 +6466,28 @@ external int mnn_tensor_length(
   int index,
 );
 
+/// @brief Load a .npy file into a new host tensor, the data is copied
+/// @param path File path
+/// @param out Output tensor, must be destroyed by mnn_tensor_destroy
+/// @return Error code
+@ffi.Native<ffi.UnsignedInt Function(ffi.Pointer<ffi.Char>, ffi.Pointer<mnn_tensor_t>)>(
+  symbol: 'mnn_tensor_load_npy',
+)
+external int _mnn_tensor_load_npy(
+  ffi.Pointer<ffi.Char> path,
+  ffi.Pointer<mnn_tensor_t> out,
+);
+
+ErrorCode mnn_tensor_load_npy(
+  ffi.Pointer<ffi.Char> path,
+  ffi.Pointer<mnn_tensor_t> out,
+) => ErrorCode.fromValue(
+  _mnn_tensor_load_npy(
+    path,
+    out,
+  ),
+);
+
 /// @brief Map tensor for access
 /// @param self Tensor
 /// @param mtype Map type
@@ -4179,6 +6523,54 @@ external void mnn_tensor_print_shape(
   mnn_tensor_t self$1,
 );
 
+/// @brief Quantize float32 data into the host memory of a quantized tensor
+/// @param self Host tensor with int8/uint8/int16 type
+/// @param src Source float buffer, element count must equal the tensor's
+/// @param params Quantization parameters, axis refers to the tensor's shape
+/// @return Error code
+@ffi.Native<
+  ffi.UnsignedInt Function(mnn_tensor_t, ffi.Pointer<ffi.Float>, ffi.Pointer<mnn_quant_params_t>)
+>(symbol: 'mnn_tensor_quantize_from_f32', isLeaf: true)
+external int _mnn_tensor_quantize_from_f32(
+  mnn_tensor_t self$1,
+  ffi.Pointer<ffi.Float> src,
+  ffi.Pointer<mnn_quant_params_t> params,
+);
+
+ErrorCode mnn_tensor_quantize_from_f32(
+  mnn_tensor_t self$1,
+  ffi.Pointer<ffi.Float> src,
+  ffi.Pointer<mnn_quant_params_t> params,
+) => ErrorCode.fromValue(
+  _mnn_tensor_quantize_from_f32(
+    self$1,
+    src,
+    params,
+  ),
+);
+
+/// @brief Save a host tensor to .npy file
+/// @param self Host tensor, NC4HW4 tensors are not supported
+/// @param path File path
+/// @return Error code
+@ffi.Native<ffi.UnsignedInt Function(mnn_tensor_t, ffi.Pointer<ffi.Char>)>(
+  symbol: 'mnn_tensor_save_npy',
+)
+external int _mnn_tensor_save_npy(
+  mnn_tensor_t self$1,
+  ffi.Pointer<ffi.Char> path,
+);
+
+ErrorCode mnn_tensor_save_npy(
+  mnn_tensor_t self$1,
+  ffi.Pointer<ffi.Char> path,
+) => ErrorCode.fromValue(
+  _mnn_tensor_save_npy(
+    self$1,
+    path,
+  ),
+);
+
 /// @brief Set device pointer
 /// @param self Tensor
 /// @param device_ptr Device pointer
@@ -4302,6 +6694,32 @@ external int mnn_tensor_size(
   mnn_tensor_t self$1,
 );
 
+/// @brief Compute statistics of a host tensor
+/// @param self Host tensor, NC4HW4 tensors are not supported
+/// @param config Scan options, NULL means default options
+/// @param stats Output statistics
+/// @return Error code
+@ffi.Native<
+  ffi.UnsignedInt Function(mnn_tensor_t, ffi.Pointer<mnn_stats_config_t>, ffi.Pointer<mnn_tensor_stats_t>)
+>(symbol: 'mnn_tensor_stats', isLeaf: true)
+external int _mnn_tensor_stats(
+  mnn_tensor_t self$1,
+  ffi.Pointer<mnn_stats_config_t> config,
+  ffi.Pointer<mnn_tensor_stats_t> stats,
+);
+
+ErrorCode mnn_tensor_stats(
+  mnn_tensor_t self$1,
+  ffi.Pointer<mnn_stats_config_t> config,
+  ffi.Pointer<mnn_tensor_stats_t> stats,
+) => ErrorCode.fromValue(
+  _mnn_tensor_stats(
+    self$1,
+    config,
+    stats,
+  ),
+);
+
 /// @brief Get tensor stride
 /// @param self Tensor
 /// @param index Dimension index
@@ -4312,6 +6730,38 @@ external int mnn_tensor_stride(
   int index,
 );
 
+/// @brief Select the top k entries along the last dimension of a float host tensor
+/// @param self Host tensor, NC4HW4 tensors are not supported
+/// @param config Selection options
+/// @param values Output values, [element count / last dim, k]
+/// @param indices Output indices, [element count / last dim, k]
+/// @param probs Output softmax over the selected values, can be NULL
+/// @return Error code
+@ffi.Native<
+  ffi.UnsignedInt Function(
+    mnn_tensor_t,
+    ffi.Pointer<mnn_topk_config_t>,
+    ffi.Pointer<ffi.Float>,
+    ffi.Pointer<ffi.Int32>,
+    ffi.Pointer<ffi.Float>,
+  )
+>(symbol: 'mnn_tensor_topk')
+external int _mnn_tensor_topk(
+  mnn_tensor_t self$1,
+  ffi.Pointer<mnn_topk_config_t> config,
+  ffi.Pointer<ffi.Float> values,
+  ffi.Pointer<ffi.Int32> indices,
+  ffi.Pointer<ffi.Float> probs,
+);
+
+ErrorCode mnn_tensor_topk(
+  mnn_tensor_t self$1,
+  ffi.Pointer<mnn_topk_config_t> config,
+  ffi.Pointer<ffi.Float> values,
+  ffi.Pointer<ffi.Int32> indices,
+  ffi.Pointer<ffi.Float> probs,
+) => ErrorCode.fromValue(_mnn_tensor_topk(self$1, config, values, indices, probs));
+
 /// @brief Unmap tensor
 /// @param self Tensor
 /// @param mtype Map type
@@ -4415,6 +6865,51 @@ external void mnn_timer_reset(
   mnn_timer_t timer,
 );
 
+/// @brief Select the top k entries of each row of a float buffer
+///
+/// Rows are split into chunks selected in parallel with a bounded heap, or quickselect
+/// when k is a large part of the chunk, and the candidates of the chunks are merged.
+/// NaN entries are never selected.
+///
+/// @param data Float buffer, [rows, cols]
+/// @param rows Number of rows
+/// @param cols Row length
+/// @param config Selection options
+/// @param values Output values, [rows, k], best first
+/// @param indices Output column indices, [rows, k], ties resolve to the smallest index
+/// @param probs Output softmax over the selected values of each row, [rows, k], can be NULL
+/// @return Error code, MNNC_INVALID_VALUE if a row has less than k entries that are not NaN
+@ffi.Native<
+  ffi.UnsignedInt Function(
+    ffi.Pointer<ffi.Float>,
+    ffi.Size,
+    ffi.Size,
+    ffi.Pointer<mnn_topk_config_t>,
+    ffi.Pointer<ffi.Float>,
+    ffi.Pointer<ffi.Int32>,
+    ffi.Pointer<ffi.Float>,
+  )
+>(symbol: 'mnn_topk_compute')
+external int _mnn_topk_compute(
+  ffi.Pointer<ffi.Float> data,
+  int rows,
+  int cols,
+  ffi.Pointer<mnn_topk_config_t> config,
+  ffi.Pointer<ffi.Float> values,
+  ffi.Pointer<ffi.Int32> indices,
+  ffi.Pointer<ffi.Float> probs,
+);
+
+ErrorCode mnn_topk_compute(
+  ffi.Pointer<ffi.Float> data,
+  int rows,
+  int cols,
+  ffi.Pointer<mnn_topk_config_t> config,
+  ffi.Pointer<ffi.Float> values,
+  ffi.Pointer<ffi.Int32> indices,
+  ffi.Pointer<ffi.Float> probs,
+) => ErrorCode.fromValue(_mnn_topk_compute(data, rows, cols, config, values, indices, probs));
+
 /// indicate whether we should process iphone images back to canonical format,
 /// or just pass them through "as-is"
 @ffi.Native<ffi.Void Function(ffi.Int)>()
@@ -6446,8 +8941,12 @@ class _SymbolAddresses {
   get mnn_cv_image_process_destroy => ffi.Native.addressOf(self.mnn_cv_image_process_destroy);
   ffi.Pointer<ffi.NativeFunction<ffi.Void Function(mnn_cv_matrix_t)>> get mnn_cv_matrix_destroy =>
       ffi.Native.addressOf(self.mnn_cv_matrix_destroy);
+  ffi.Pointer<ffi.NativeFunction<ffi.Void Function(mnn_dynamic_batcher_t)>> get mnn_dynamic_batcher_destroy =>
+      ffi.Native.addressOf(self.mnn_dynamic_batcher_destroy);
   ffi.Pointer<ffi.NativeFunction<ffi.Void Function(mnn_executor_t)>> get mnn_executor_destroy =>
       ffi.Native.addressOf(self.mnn_executor_destroy);
+  ffi.Pointer<ffi.NativeFunction<ffi.Void Function(mnn_executor_pool_t)>> get mnn_executor_pool_destroy =>
+      ffi.Native.addressOf(self.mnn_executor_pool_destroy);
   ffi.Pointer<ffi.NativeFunction<ffi.Void Function(mnn_executor_scope_t)>> get mnn_executor_scope_destroy =>
       ffi.Native.addressOf(self.mnn_executor_scope_destroy);
   ffi.Pointer<ffi.NativeFunction<ffi.Void Function(EXPRP_t)>> get mnn_expr_Expr_free =>
@@ -6462,16 +8961,24 @@ class _SymbolAddresses {
       ffi.Native.addressOf(self.mnn_expr_VecVARP_free);
   ffi.Pointer<ffi.NativeFunction<ffi.Void Function(VecWeakEXPRP_t)>> get mnn_expr_VecWeakEXPRP_free =>
       ffi.Native.addressOf(self.mnn_expr_VecWeakEXPRP_free);
+  ffi.Pointer<ffi.NativeFunction<ffi.Void Function(mnn_graph_cache_t)>> get mnn_graph_cache_destroy =>
+      ffi.Native.addressOf(self.mnn_graph_cache_destroy);
   ffi.Pointer<ffi.NativeFunction<ffi.Void Function(mnn_interpreter_t)>> get mnn_interpreter_destroy =>
       ffi.Native.addressOf(self.mnn_interpreter_destroy);
   ffi.Pointer<ffi.NativeFunction<ffi.Void Function(mnn_module_t)>> get mnn_module_destroy =>
       ffi.Native.addressOf(self.mnn_module_destroy);
   ffi.Pointer<ffi.NativeFunction<ffi.Void Function(mnn_module_info_t)>> get mnn_module_info_destroy =>
       ffi.Native.addressOf(self.mnn_module_info_destroy);
+  ffi.Pointer<ffi.NativeFunction<ffi.Void Function(mnn_module_pool_t)>> get mnn_module_pool_destroy =>
+      ffi.Native.addressOf(self.mnn_module_pool_destroy);
+  ffi.Pointer<ffi.NativeFunction<ffi.Void Function(mnn_npy_archive_t)>> get mnn_npy_archive_destroy =>
+      ffi.Native.addressOf(self.mnn_npy_archive_destroy);
   ffi.Pointer<ffi.NativeFunction<ffi.Void Function(mnn_runtime_info_t)>> get mnn_runtime_info_destroy =>
       ffi.Native.addressOf(self.mnn_runtime_info_destroy);
   ffi.Pointer<ffi.NativeFunction<ffi.Void Function(mnn_runtime_manager_t)>> get mnn_runtime_manager_destroy =>
       ffi.Native.addressOf(self.mnn_runtime_manager_destroy);
+  ffi.Pointer<ffi.NativeFunction<ffi.Void Function(mnn_sampler_t)>> get mnn_sampler_destroy =>
+      ffi.Native.addressOf(self.mnn_sampler_destroy);
   ffi.Pointer<ffi.NativeFunction<ffi.Void Function(mnn_tensor_t)>> get mnn_tensor_destroy =>
       ffi.Native.addressOf(self.mnn_tensor_destroy);
   ffi.Pointer<ffi.NativeFunction<ffi.Void Function(mnn_timer_t)>> get mnn_timer_destroy =>
@@ -6504,6 +9011,28 @@ class _SymbolAddresses {
       ffi.Native.addressOf(self.std_VecU8_free);
 }
 
+enum DetectFormat {
+  /// Anchor-free YOLO (v8, v11), channels [cx, cy, w, h, class scores...]
+  MNN_DETECT_YOLO(0),
+
+  /// YOLO with objectness (v5, v7), channels [cx, cy, w, h, obj, class scores...]
+  MNN_DETECT_YOLO_OBJ(1),
+
+  /// SSD, channels [dx, dy, dw, dh] decoded against priors, class scores in a second input
+  MNN_DETECT_SSD(2)
+  ;
+
+  final int value;
+  const DetectFormat(this.value);
+
+  static DetectFormat fromValue(int value) => switch (value) {
+    0 => MNN_DETECT_YOLO,
+    1 => MNN_DETECT_YOLO_OBJ,
+    2 => MNN_DETECT_SSD,
+    _ => throw ArgumentError('Unknown value for DetectFormat: $value'),
+  };
+}
+
 enum DimensionType {
   MNN_TENSORFLOW(0),
   MNN_CAFFE(1),
@@ -6587,6 +9116,151 @@ enum ErrorCode {
   };
 }
 
+/// Op codes of the graph bytecode, attributes are listed after each op.
+/// "rest" means all remaining attributes, f32 attributes are stored as float bits.
+enum ExprOpcode {
+  /// attrs: value(f32)
+  MNN_EXPR_OP_SCALAR_F32(0),
+
+  /// attrs: value
+  MNN_EXPR_OP_SCALAR_I32(1),
+
+  /// attrs: ndim, dims[ndim], values(f32)[rest]
+  MNN_EXPR_OP_CONST_F32(2),
+
+  /// attrs: ndim, dims[ndim], values[rest]
+  MNN_EXPR_OP_CONST_I32(3),
+
+  /// binary ops, 2 inputs, no attrs
+  MNN_EXPR_OP_ADD(10),
+  MNN_EXPR_OP_SUB(11),
+  MNN_EXPR_OP_MUL(12),
+  MNN_EXPR_OP_DIV(13),
+  MNN_EXPR_OP_POW(14),
+  MNN_EXPR_OP_MAXIMUM(15),
+  MNN_EXPR_OP_MINIMUM(16),
+  MNN_EXPR_OP_GREATER(17),
+  MNN_EXPR_OP_GREATER_EQUAL(18),
+  MNN_EXPR_OP_LESS(19),
+  MNN_EXPR_OP_LESS_EQUAL(20),
+  MNN_EXPR_OP_EQUAL(21),
+
+  /// unary ops, 1 input, no attrs
+  MNN_EXPR_OP_NEG(30),
+  MNN_EXPR_OP_ABS(31),
+  MNN_EXPR_OP_EXP(32),
+  MNN_EXPR_OP_LOG(33),
+  MNN_EXPR_OP_SQRT(34),
+  MNN_EXPR_OP_SQUARE(35),
+  MNN_EXPR_OP_SIGMOID(36),
+  MNN_EXPR_OP_TANH(37),
+  MNN_EXPR_OP_RELU(38),
+  MNN_EXPR_OP_FLOOR(39),
+  MNN_EXPR_OP_CEIL(40),
+
+  /// reductions, 1 input, attrs: keep_dims, axes[rest], no axes means all
+  MNN_EXPR_OP_REDUCE_SUM(50),
+  MNN_EXPR_OP_REDUCE_MEAN(51),
+  MNN_EXPR_OP_REDUCE_MAX(52),
+  MNN_EXPR_OP_REDUCE_MIN(53),
+
+  /// 1 input, attrs: axis
+  MNN_EXPR_OP_ARGMAX(54),
+  MNN_EXPR_OP_ARGMIN(55),
+  MNN_EXPR_OP_SOFTMAX(56),
+
+  /// 1 input, attrs: dims[rest]
+  MNN_EXPR_OP_RESHAPE(60),
+
+  /// 1 input, attrs: perm[rest]
+  MNN_EXPR_OP_TRANSPOSE(61),
+
+  /// 1 input, attrs: axes[rest]
+  MNN_EXPR_OP_SQUEEZE(62),
+  MNN_EXPR_OP_UNSQUEEZE(63),
+
+  /// 1 input, attrs: format
+  MNN_EXPR_OP_CONVERT(64),
+
+  /// 1 input, attrs: halide type code, bits
+  MNN_EXPR_OP_CAST(65),
+
+  /// 1 input, attrs: n, begin[n], end[n], strides[n],
+  /// begin_mask, end_mask, ellipsis_mask, new_axis_mask, shrink_axis_mask
+  MNN_EXPR_OP_STRIDED_SLICE(70),
+
+  /// 2 inputs (params, indices), attrs: axis
+  MNN_EXPR_OP_GATHER(71),
+
+  /// any number of inputs, attrs: axis
+  MNN_EXPR_OP_STACK(72),
+  MNN_EXPR_OP_CONCAT(73),
+
+  /// 3 inputs (condition, x, y)
+  MNN_EXPR_OP_SELECT(74),
+
+  /// 2 inputs, attrs: transpose_a, transpose_b
+  MNN_EXPR_OP_MATMUL(75),
+
+  /// 2 inputs (boxes, scores), attrs: max_detections, iou_threshold(f32), score_threshold(f32)
+  MNN_EXPR_OP_NMS(76)
+  ;
+
+  final int value;
+  const ExprOpcode(this.value);
+
+  static ExprOpcode fromValue(int value) => switch (value) {
+    0 => MNN_EXPR_OP_SCALAR_F32,
+    1 => MNN_EXPR_OP_SCALAR_I32,
+    2 => MNN_EXPR_OP_CONST_F32,
+    3 => MNN_EXPR_OP_CONST_I32,
+    10 => MNN_EXPR_OP_ADD,
+    11 => MNN_EXPR_OP_SUB,
+    12 => MNN_EXPR_OP_MUL,
+    13 => MNN_EXPR_OP_DIV,
+    14 => MNN_EXPR_OP_POW,
+    15 => MNN_EXPR_OP_MAXIMUM,
+    16 => MNN_EXPR_OP_MINIMUM,
+    17 => MNN_EXPR_OP_GREATER,
+    18 => MNN_EXPR_OP_GREATER_EQUAL,
+    19 => MNN_EXPR_OP_LESS,
+    20 => MNN_EXPR_OP_LESS_EQUAL,
+    21 => MNN_EXPR_OP_EQUAL,
+    30 => MNN_EXPR_OP_NEG,
+    31 => MNN_EXPR_OP_ABS,
+    32 => MNN_EXPR_OP_EXP,
+    33 => MNN_EXPR_OP_LOG,
+    34 => MNN_EXPR_OP_SQRT,
+    35 => MNN_EXPR_OP_SQUARE,
+    36 => MNN_EXPR_OP_SIGMOID,
+    37 => MNN_EXPR_OP_TANH,
+    38 => MNN_EXPR_OP_RELU,
+    39 => MNN_EXPR_OP_FLOOR,
+    40 => MNN_EXPR_OP_CEIL,
+    50 => MNN_EXPR_OP_REDUCE_SUM,
+    51 => MNN_EXPR_OP_REDUCE_MEAN,
+    52 => MNN_EXPR_OP_REDUCE_MAX,
+    53 => MNN_EXPR_OP_REDUCE_MIN,
+    54 => MNN_EXPR_OP_ARGMAX,
+    55 => MNN_EXPR_OP_ARGMIN,
+    56 => MNN_EXPR_OP_SOFTMAX,
+    60 => MNN_EXPR_OP_RESHAPE,
+    61 => MNN_EXPR_OP_TRANSPOSE,
+    62 => MNN_EXPR_OP_SQUEEZE,
+    63 => MNN_EXPR_OP_UNSQUEEZE,
+    64 => MNN_EXPR_OP_CONVERT,
+    65 => MNN_EXPR_OP_CAST,
+    70 => MNN_EXPR_OP_STRIDED_SLICE,
+    71 => MNN_EXPR_OP_GATHER,
+    72 => MNN_EXPR_OP_STACK,
+    73 => MNN_EXPR_OP_CONCAT,
+    74 => MNN_EXPR_OP_SELECT,
+    75 => MNN_EXPR_OP_MATMUL,
+    76 => MNN_EXPR_OP_NMS,
+    _ => throw ArgumentError('Unknown value for ExprOpcode: $value'),
+  };
+}
+
 typedef FILE = _iobuf;
 
 /// Types in the halide type system. They can be ints, unsigned ints,
@@ -6701,9 +9375,78 @@ enum MapType {
 }
 
 typedef Net_t = ffi.Pointer<ffi.Void>;
+enum NmsMethod {
+  /// Greedy NMS, boxes overlapping a kept one by more than iou_threshold are removed
+  MNN_NMS_HARD(0),
+
+  /// Soft-NMS, scores of overlapping boxes decay by (1 - iou) above iou_threshold
+  MNN_NMS_SOFT_LINEAR(1),
+
+  /// Soft-NMS, scores of overlapping boxes decay by exp(-iou^2 / sigma)
+  MNN_NMS_SOFT_GAUSSIAN(2)
+  ;
+
+  final int value;
+  const NmsMethod(this.value);
+
+  static NmsMethod fromValue(int value) => switch (value) {
+    0 => MNN_NMS_HARD,
+    1 => MNN_NMS_SOFT_LINEAR,
+    2 => MNN_NMS_SOFT_GAUSSIAN,
+    _ => throw ArgumentError('Unknown value for NmsMethod: $value'),
+  };
+}
+
 typedef OpT_t = ffi.Pointer<ffi.Void>;
 typedef Op_t = ffi.Pointer<ffi.Void>;
 
+enum PluginAttrType {
+  MNN_PLUGIN_ATTR_INT(0),
+  MNN_PLUGIN_ATTR_FLOAT(1),
+  MNN_PLUGIN_ATTR_STRING(2),
+  MNN_PLUGIN_ATTR_INTS(3),
+  MNN_PLUGIN_ATTR_FLOATS(4)
+  ;
+
+  final int value;
+  const PluginAttrType(this.value);
+
+  static PluginAttrType fromValue(int value) => switch (value) {
+    0 => MNN_PLUGIN_ATTR_INT,
+    1 => MNN_PLUGIN_ATTR_FLOAT,
+    2 => MNN_PLUGIN_ATTR_STRING,
+    3 => MNN_PLUGIN_ATTR_INTS,
+    4 => MNN_PLUGIN_ATTR_FLOATS,
+    _ => throw ArgumentError('Unknown value for PluginAttrType: $value'),
+  };
+}
+
+enum RngDistribution {
+  /// float in [a, b)
+  MNN_RNG_UNIFORM(0),
+
+  /// float from a normal distribution with mean a and standard deviation b
+  MNN_RNG_NORMAL(1),
+
+  /// int32 in [a, b)
+  MNN_RNG_INTEGER(2),
+
+  /// int32, 1 with probability a, otherwise 0
+  MNN_RNG_BERNOULLI(3)
+  ;
+
+  final int value;
+  const RngDistribution(this.value);
+
+  static RngDistribution fromValue(int value) => switch (value) {
+    0 => MNN_RNG_UNIFORM,
+    1 => MNN_RNG_NORMAL,
+    2 => MNN_RNG_INTEGER,
+    3 => MNN_RNG_BERNOULLI,
+    _ => throw ArgumentError('Unknown value for RngDistribution: $value'),
+  };
+}
+
 final class STBIR_RESIZE extends ffi.Struct {
   external ffi.Pointer<ffi.Void> user_data;
 
@@ -6834,6 +9577,28 @@ const int STBI_rgb = 3;
 
 const int STBI_rgb_alpha = 4;
 
+enum ScoreActivation {
+  /// Scores are probabilities already
+  MNN_SCORE_NONE(0),
+
+  /// Class scores and objectness are logits of independent sigmoids
+  MNN_SCORE_SIGMOID(1),
+
+  /// Class scores are logits of a softmax over all classes
+  MNN_SCORE_SOFTMAX(2)
+  ;
+
+  final int value;
+  const ScoreActivation(this.value);
+
+  static ScoreActivation fromValue(int value) => switch (value) {
+    0 => MNN_SCORE_NONE,
+    1 => MNN_SCORE_SIGMOID,
+    2 => MNN_SCORE_SOFTMAX,
+    _ => throw ArgumentError('Unknown value for ScoreActivation: $value'),
+  };
+}
+
 enum StbirDataType {
   STBIR_TYPE_UINT8(0),
   STBIR_TYPE_UINT8_SRGB(1),
@@ -7391,7 +10156,103 @@ final class mnn_cv_size2i_t extends ffi.Struct {
   external int height;
 }
 
+final class mnn_detect_params_t extends ffi.Struct {
+  /// mnn_detect_format_t
+  @ffi.Int32()
+  external int format;
+
+  /// mnn_score_activation_t
+  @ffi.Int32()
+  external int activation;
+
+  @ffi.Float()
+  external double score_threshold;
+
+  @ffi.Float()
+  external double iou_threshold;
+
+  /// Highest scoring candidates kept per image before NMS, <= 0 keeps all
+  @ffi.Int32()
+  external int top_k;
+
+  /// Maximum number of detections per image
+  @ffi.Int32()
+  external int max_detections;
+
+  /// Whether boxes of different classes suppress each other
+  @ffi.Bool()
+  external bool class_agnostic;
+
+  /// Class never reported, e.g., 0 for SSD, -1 for none
+  @ffi.Int32()
+  external int background_class;
+
+  /// SSD only, scales of dx, dy, dw and dh
+  @ffi.Array.multi([4])
+  external ffi.Array<ffi.Float> variances;
+}
+
+final class mnn_detection_t extends ffi.Struct {
+  @ffi.Float()
+  external double x0;
+
+  @ffi.Float()
+  external double y0;
+
+  @ffi.Float()
+  external double x1;
+
+  @ffi.Float()
+  external double y1;
+
+  @ffi.Float()
+  external double score;
+
+  @ffi.Int32()
+  external int class_id;
+}
+
+final class mnn_dynamic_batcher_stats_t extends ffi.Struct {
+  /// Number of requests served
+  @ffi.Uint64()
+  external int requests;
+
+  /// Number of forward runs
+  @ffi.Uint64()
+  external int batches;
+
+  /// Total time requests waited in the queue, in nanoseconds
+  @ffi.Uint64()
+  external int queue_delay_ns;
+
+  /// Longest time a request waited in the queue, in nanoseconds
+  @ffi.Uint64()
+  external int max_queue_delay_ns;
+}
+
+typedef mnn_dynamic_batcher_t = ffi.Pointer<ffi.Void>;
+
+typedef mnn_executor_pool_t = ffi.Pointer<ffi.Void>;
+
 typedef mnn_executor_scope_t = ffi.Pointer<ffi.Void>;
+final class mnn_executor_stats_t extends ffi.Struct {
+  /// Number of bindings and parallel tasks served
+  @ffi.Uint64()
+  external int tasks;
+
+  /// Total time the executor was leased, in nanoseconds
+  @ffi.Uint64()
+  external int busy_ns;
+
+  /// Number of gc runs through the pool
+  @ffi.Uint64()
+  external int gc_count;
+
+  /// Whether the executor is currently leased
+  @ffi.Bool()
+  external bool in_use;
+}
+
 typedef mnn_executor_t = ffi.Pointer<ffi.Void>;
 typedef mnn_expr_Expr_t = ffi.Pointer<ffi.Void>;
 
@@ -7410,11 +10271,21 @@ final class mnn_expr_Variable_Info extends ffi.Struct {
   external int size;
 }
 
+typedef mnn_expr_scope_t = ffi.Pointer<ffi.Void>;
+
+typedef mnn_expr_write_callback_t = ffi.Pointer<ffi.NativeFunction<mnn_expr_write_callback_tFunction>>;
+typedef mnn_expr_write_callback_tFunction =
+    ffi.Size Function(ffi.Pointer<ffi.Void> user_data, ffi.Pointer<ffi.Void> data, ffi.Size size);
+typedef Dartmnn_expr_write_callback_tFunction =
+    int Function(ffi.Pointer<ffi.Void> user_data, ffi.Pointer<ffi.Void> data, int size);
+
 /// Forward type enum */
 /// // typedef mnn_forward_type mnn_forward_type_t;
 typedef mnn_forward_type_t = ffi.Int;
 typedef Dartmnn_forward_type_t = int;
 
+typedef mnn_graph_cache_t = ffi.Pointer<ffi.Void>;
+
 final class mnn_image_process_config_t extends ffi.Struct {
   /// data filter
   @ffi.Int()
@@ -7442,6 +10313,26 @@ final class mnn_image_process_config_t extends ffi.Struct {
 
 typedef mnn_interpreter_t = ffi.Pointer<ffi.Void>;
 
+/// Mapping from network input coordinates back to the original image,
+/// x_original = (x - pad_x) / scale.
+final class mnn_letterbox_t extends ffi.Struct {
+  @ffi.Float()
+  external double scale;
+
+  @ffi.Float()
+  external double pad_x;
+
+  @ffi.Float()
+  external double pad_y;
+
+  /// Size of the original image to clip boxes to, <= 0 disables clipping
+  @ffi.Float()
+  external double width;
+
+  @ffi.Float()
+  external double height;
+}
+
 /// Config struct equivalent for C
 final class mnn_module_config_t extends ffi.Struct {
   /// Load module as dynamic, default static
@@ -7467,10 +10358,207 @@ final class mnn_module_config_t extends ffi.Struct {
 }
 
 typedef mnn_module_info_t = ffi.Pointer<ffi.Void>;
+
+final class mnn_module_pool_stats_t extends ffi.Struct {
+  /// Number of requests served
+  @ffi.Uint64()
+  external int requests;
+
+  /// Number of served requests taken from the queue of another worker
+  @ffi.Uint64()
+  external int stolen;
+
+  /// Total time spent in forward, in nanoseconds
+  @ffi.Uint64()
+  external int busy_ns;
+
+  /// Time since the worker started, in nanoseconds
+  @ffi.Uint64()
+  external int alive_ns;
+
+  /// Number of requests waiting in the queue of the worker
+  @ffi.Uint64()
+  external int queued;
+
+  /// Whether the worker is running a request
+  @ffi.Bool()
+  external bool in_use;
+}
+
+typedef mnn_module_pool_t = ffi.Pointer<ffi.Void>;
 typedef mnn_module_t = ffi.Pointer<ffi.Void>;
+final class mnn_nms_params_t extends ffi.Struct {
+  /// mnn_nms_method_t
+  @ffi.Int32()
+  external int method;
+
+  @ffi.Float()
+  external double iou_threshold;
+
+  /// Candidates below it are dropped, also after Soft-NMS decay
+  @ffi.Float()
+  external double score_threshold;
+
+  /// Gaussian Soft-NMS only
+  @ffi.Float()
+  external double sigma;
+
+  /// Maximum number of boxes kept per class and image, <= 0 means no limit
+  @ffi.Int32()
+  external int max_per_class;
+
+  /// Maximum number of boxes kept per image
+  @ffi.Int32()
+  external int max_detections;
+
+  /// Whether boxes of different classes suppress each other
+  @ffi.Bool()
+  external bool class_agnostic;
+
+  /// Whether boxes are rotated [cx, cy, w, h, angle] with angle in radians
+  @ffi.Bool()
+  external bool rotated;
+}
+
+final class mnn_nms_result_t extends ffi.Struct {
+  @ffi.Int32()
+  external int box_index;
+
+  @ffi.Int32()
+  external int class_id;
+
+  /// Score after Soft-NMS decay
+  @ffi.Float()
+  external double score;
+}
+
+typedef mnn_npy_archive_t = ffi.Pointer<ffi.Void>;
+
+final class mnn_plugin_attr_t extends ffi.Struct {
+  external ffi.Pointer<ffi.Char> key;
+
+  /// mnn_plugin_attr_type_t
+  @ffi.Int32()
+  external int type;
+
+  @ffi.Int32()
+  external int i;
+
+  @ffi.Float()
+  external double f;
+
+  /// Value of MNN_PLUGIN_ATTR_STRING
+  external ffi.Pointer<ffi.Char> s;
+
+  /// Values of MNN_PLUGIN_ATTR_INTS and MNN_PLUGIN_ATTR_FLOATS
+  external ffi.Pointer<ffi.Int32> ints;
+
+  external ffi.Pointer<ffi.Float> floats;
+
+  @ffi.Size()
+  external int count;
+}
+
+typedef mnn_plugin_context_t = ffi.Pointer<ffi.Void>;
+
+/// Shape inference or compute function of an op, returns false on failure. Called on the
+/// thread running the graph, inputs and outputs are host tensors in the layout chosen by
+/// MNN, see mnn_tensor_get_dimension_type.
+typedef mnn_plugin_kernel_fn = ffi.Pointer<ffi.NativeFunction<mnn_plugin_kernel_fnFunction>>;
+typedef mnn_plugin_kernel_fnFunction =
+    ffi.Bool Function(mnn_plugin_context_t ctx, ffi.Pointer<ffi.Void> userdata);
+typedef Dartmnn_plugin_kernel_fnFunction =
+    bool Function(mnn_plugin_context_t ctx, ffi.Pointer<ffi.Void> userdata);
+
+final class mnn_plugin_op_t extends ffi.Struct {
+  /// Set shapes and types of the outputs, NULL copies them from input 0
+  external mnn_plugin_kernel_fn infer_shape;
+
+  /// Fill the outputs
+  external mnn_plugin_kernel_fn compute;
+
+  /// Called when the input shapes change, before compute, can be NULL
+  external mnn_plugin_kernel_fn resize;
+
+  /// Passed to the functions, must outlive the registration
+  external ffi.Pointer<ffi.Void> userdata;
+}
+
+/// Affine quantization parameters, q = clamp(round(x / scale) + zero_point, qmin, qmax)
+///
+/// If count == 1 the parameters are applied per-tensor, otherwise count must
+/// equal the length of dimension `axis` and the parameters are applied per-channel.
+final class mnn_quant_params_t extends ffi.Struct {
+  /// scale array, length is count
+  external ffi.Pointer<ffi.Float> scale;
+
+  /// zero point array, length is count, NULL means all zero
+  external ffi.Pointer<ffi.Int32> zero_point;
+
+  /// 1 for per-tensor, channel count for per-channel
+  @ffi.Size()
+  external int count;
+
+  /// channel axis for per-channel parameters
+  @ffi.Int()
+  external int axis;
+
+  /// clamp range, qmin >= qmax means using the full range of the quantized type
+  @ffi.Int32()
+  external int qmin;
+
+  @ffi.Int32()
+  external int qmax;
+}
+
+final class mnn_rng_params_t extends ffi.Struct {
+  /// mnn_rng_distribution_t
+  @ffi.Int32()
+  external int distribution;
+
+  /// Key of the generator
+  @ffi.Uint64()
+  external int seed;
+
+  /// Index of the first sample in the stream of the seed
+  @ffi.Uint64()
+  external int offset;
+
+  /// Parameters of the distribution, see mnn_rng_distribution_t
+  @ffi.Double()
+  external double a;
+
+  @ffi.Double()
+  external double b;
+}
+
 typedef mnn_runtime_info_t = ffi.Pointer<ffi.Void>;
 typedef mnn_runtime_manager_t = ffi.Pointer<ffi.Void>;
 
+final class mnn_sampler_config_t extends ffi.Struct {
+  /// Logits are divided by it, <= 0 means greedy decoding
+  @ffi.Float()
+  external double temperature;
+
+  /// Number of most likely tokens kept, <= 0 keeps all
+  @ffi.Int32()
+  external int top_k;
+
+  /// Smallest set of most likely tokens whose probability reaches it is kept, >= 1 keeps all
+  @ffi.Float()
+  external double top_p;
+
+  /// Logits of tokens in the history are divided by it if positive, multiplied otherwise
+  @ffi.Float()
+  external double repetition_penalty;
+
+  /// Seed of the random generator
+  @ffi.Uint64()
+  external int seed;
+}
+
+typedef mnn_sampler_t = ffi.Pointer<ffi.Void>;
+
 /// Schedule config structure
 final class mnn_schedule_config_t extends ffi.Struct {
   @mnn_forward_type_t()
@@ -7486,6 +10574,27 @@ final class mnn_schedule_config_t extends ffi.Struct {
 
 typedef mnn_session_t = ffi.Pointer<ffi.Void>;
 
+/// Options of the statistics scan
+final class mnn_stats_config_t extends ffi.Struct {
+  /// number of histogram bins, 0 disables the histogram
+  @ffi.Int()
+  external int bins;
+
+  /// histogram range, hist_min >= hist_max means using [min, max] of the data
+  @ffi.Double()
+  external double hist_min;
+
+  @ffi.Double()
+  external double hist_max;
+
+  /// output histogram, length is bins, values out of range are not counted
+  external ffi.Pointer<ffi.Uint64> histogram;
+
+  /// number of threads, <= 0 means using all available threads
+  @ffi.Int()
+  external int num_threads;
+}
+
 enum mnn_tensor_dtype {
   MNN_T_D_TYPE_F32_F64(0),
   MNN_T_D_TYPE_BF16(1),
@@ -7511,9 +10620,85 @@ enum mnn_tensor_dtype {
   };
 }
 
+/// Memory layout of data viewed as [batch, channel, area], area is the product of the
+/// spatial dims. Element (n, c, a) is at
+/// n * batch_stride + (c / pack) * channel_stride + a * area_stride + c % pack,
+/// all strides are in elements. NC4HW4 is [C/4][N][area][4] as in MNN, so its
+/// channel_stride spans all batches and batch_stride is area * 4.
+final class mnn_tensor_layout_t extends ffi.Struct {
+  @ffi.UnsignedInt()
+  external int dim_typeAsInt;
+
+  DimensionType get dim_type => DimensionType.fromValue(dim_typeAsInt);
+
+  @ffi.Int()
+  external int batch;
+
+  @ffi.Int()
+  external int channel;
+
+  @ffi.Int()
+  external int area;
+
+  /// channels stored together, 4 for NC4HW4 and 1 otherwise
+  @ffi.Int()
+  external int pack;
+
+  @ffi.Size()
+  external int batch_stride;
+
+  @ffi.Size()
+  external int channel_stride;
+
+  @ffi.Size()
+  external int area_stride;
+}
+
+/// Statistics result, min/max/mean/variance only take finite values into account
+/// and are NaN if there is no finite value.
+final class mnn_tensor_stats_t extends ffi.Struct {
+  /// total element count
+  @ffi.Size()
+  external int count;
+
+  @ffi.Size()
+  external int nan_count;
+
+  @ffi.Size()
+  external int inf_count;
+
+  @ffi.Double()
+  external double min;
+
+  @ffi.Double()
+  external double max;
+
+  @ffi.Double()
+  external double mean;
+
+  /// population variance
+  @ffi.Double()
+  external double variance;
+}
+
 typedef mnn_tensor_t = ffi.Pointer<ffi.Void>;
 typedef mnn_timer_t = ffi.Pointer<ffi.Void>;
 
+/// Options of the top-k selection
+final class mnn_topk_config_t extends ffi.Struct {
+  /// number of selected entries of each row, 1 <= k <= row length
+  @ffi.Int()
+  external int k;
+
+  /// select the largest entries if true, otherwise the smallest
+  @ffi.Bool()
+  external bool largest;
+
+  /// number of threads, <= 0 means using all available threads
+  @ffi.Int()
+  external int num_threads;
+}
+
 /// load image by filename, open file, or memory buffer
 final class stbi_io_callbacks extends ffi.Struct {
   /// fill 'data' with 'size' bytes.  return number of bytes actually read
@@ -183,6 +183,107 @@ class ExecutorScope extends NativeObject {
   }
 }
 
+/// Usage statistics of an executor in an [ExecutorPool].
+typedef ExecutorStats = ({int tasks, Duration busy, int gcCount, bool inUse});
+
+/// A pool of executors leased to threads, so that concurrent expression work from several
+/// isolates or native threads does not contend on the global executor.
+class ExecutorPool extends NativeObject {
+  static final _finalizer = ffi.NativeFinalizer(C.addresses.mnn_executor_pool_destroy);
+  ExecutorPool.fromPointer(C.mnn_executor_pool_t ptr, {super.attach, super.externalSize})
+    : super(ptr.cast());
+
+  /// Create [size] executors, 0 means one per hardware thread.
+  factory ExecutorPool.create({
+    ForwardType type = ForwardType.MNN_FORWARD_CPU,
+    BackendConfig? config,
+    int numThreads = 1,
+    int size = 0,
+  }) {
+    final cfg = config ?? BackendConfig.create();
+    final p = C.mnn_executor_pool_create(type.value, cfg.ref, numThreads, size);
+    if (config == null) cfg.dispose();
+    return ExecutorPool.fromPointer(p);
+  }
+
+  int get size => C.mnn_executor_pool_size(ptr);
+
+  Executor operator [](int index) {
+    MnnAssert(index >= 0 && index < size, 'index $index out of range [0, $size)');
+    return Executor.fromPointer(C.mnn_executor_pool_get(ptr, index));
+  }
+
+  // Leases are keyed by the native thread, and an isolate may resume on another thread
+  // after an `await`, so binding is only exposed through the synchronous [run].
+  void _bind() => mnnRun(() => C.mnn_executor_pool_bind(ptr, ffi.nullptr));
+
+  void _unbind() => mnnRun(() => C.mnn_executor_pool_unbind(ptr));
+
+  /// Run [fn] with expressions created and computed on an executor leased to the current
+  /// thread, blocks while all executors are leased. Nested runs reuse the executor.
+  ///
+  /// [fn] must be synchronous, the lease is returned as soon as it returns.
+  T run<T>(T Function() fn) {
+    MnnAssert(fn is! Future<Object?> Function(), 'ExecutorPool.run does not accept async functions');
+    _bind();
+    try {
+      return fn();
+    } finally {
+      _unbind();
+    }
+  }
+
+  /// Compute variables whose graphs share no op nodes concurrently on the executors of this
+  /// pool, see [VARP.computeParallel]. Returns the number of independent groups.
+  ///
+  /// May be called inside [run], the current thread then computes on its bound executor.
+  int compute(List<VARP> vars, {bool forceCPU = false, int maxWorkers = 0}) {
+    final vec = VecVARP.of(vars);
+    final pGroups = calloc<ffi.Size>();
+    try {
+      mnnRun(() => C.mnn_executor_pool_compute(ptr, vec.ptr, forceCPU, maxWorkers, pGroups));
+      return pGroups.value;
+    } finally {
+      calloc.free(pGroups);
+      vec.dispose();
+    }
+  }
+
+  ExecutorStats stats(int index) {
+    final p = calloc<C.mnn_executor_stats_t>();
+    try {
+      mnnRun(() => C.mnn_executor_pool_get_stats(ptr, index, p));
+      return (
+        tasks: p.ref.tasks,
+        busy: Duration(microseconds: p.ref.busy_ns ~/ 1000),
+        gcCount: p.ref.gc_count,
+        inUse: p.ref.in_use,
+      );
+    } finally {
+      calloc.free(p);
+    }
+  }
+
+  /// Run gc on executors that are not leased, returns the number of collected executors.
+  int gc([GCFlag flag = GCFlag.FULL]) => C.mnn_executor_pool_gc(ptr, flag.value);
+
+  @override
+  ffi.NativeFinalizer get finalizer => _finalizer;
+
+  @override
+  void release() {
+    C.mnn_executor_pool_destroy(ptr);
+  }
+
+  @override
+  List<Object?> get props => [ptr.address];
+
+  @override
+  String toString() {
+    return "ExecutorPool(address=0x${ptr.address.toRadixString(16)}, size=$size)";
+  }
+}
+
 class RuntimeManager extends NativeObject {
   static final _finalizer = ffi.NativeFinalizer(C.addresses.mnn_runtime_manager_destroy);
   RuntimeManager.fromPointer(C.mnn_runtime_manager_t ptr, {super.attach, super.externalSize})
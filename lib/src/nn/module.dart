@@ -5,6 +5,7 @@ import 'package:ffi/ffi.dart';
 
 import '../core/backend.dart';
 import '../core/base.dart';
+import '../core/exception.dart';
 import '../core/schedule.dart';
 import '../expr/expr.dart';
 import '../g/mnn.g.dart' as C;
@@ -177,6 +178,31 @@ class Module extends NativeObject {
     );
   }
 
+  /// Run onForward and copy each output into a native buffer of [outputs] with [sizes] bytes,
+  /// returns the number of bytes written to each buffer.
+  ///
+  /// NC4HW4 outputs are written as NCHW. Reusing [inputs] and the buffers across calls avoids
+  /// allocating output variables and reading them back with [VARP.data].
+  List<int> forwardInto(VecVARP inputs, List<ffi.Pointer<ffi.Void>> outputs, List<int> sizes) {
+    MnnAssert(outputs.length == sizes.length, 'outputs and sizes must have the same length');
+    final n = outputs.length;
+    final pOutputs = calloc<ffi.Pointer<ffi.Void>>(n);
+    final pSizes = calloc<ffi.Size>(n);
+    final pWritten = calloc<ffi.Size>(n);
+    try {
+      for (var i = 0; i < n; i++) {
+        pOutputs[i] = outputs[i];
+        pSizes[i] = sizes[i];
+      }
+      mnnRun(() => C.mnn_module_forward_into(ptr, inputs.ptr, pOutputs, pSizes, n, pWritten));
+      return List.generate(n, (i) => pWritten[i]);
+    } finally {
+      calloc.free(pOutputs);
+      calloc.free(pSizes);
+      calloc.free(pWritten);
+    }
+  }
+
   VecVARP onForward(VecVARP inputs) {
     final p = calloc<C.VecVARP_t>();
     mnnRun(() => C.mnn_module_on_forward(ptr, inputs.ptr, p, ffi.nullptr));
@@ -225,3 +251,288 @@ class Module extends NativeObject {
     C.mnn_module_destroy(ptr);
   }
 }
+
+/// Caches expression graphs compiled into static modules, keyed by a hash of the serialized graph.
+///
+/// Graphs rebuilt per request, e.g., postprocessing, are compiled once with
+/// [Module.extract] and later runs with the same structure rebind the inputs
+/// and run the compiled module, skipping shape inference and scheduling.
+///
+/// Inputs should be placeholders created by `expr.input`, their data is not
+/// part of the key, while the data of constants is.
+class GraphCache extends NativeObject {
+  static final _finalizer = ffi.NativeFinalizer(C.addresses.mnn_graph_cache_destroy);
+
+  GraphCache.fromPointer(C.mnn_graph_cache_t ptr, {super.attach, super.externalSize}) : super(ptr.cast());
+
+  /// @param capacity maximum number of compiled graphs, 0 means unlimited.
+  factory GraphCache.create({int capacity = 64}) {
+    MnnAssert(capacity >= 0, 'capacity must be >= 0, got $capacity');
+    return GraphCache.fromPointer(C.mnn_graph_cache_create(capacity));
+  }
+
+  /// number of compiled graphs
+  int get size => C.mnn_graph_cache_size(ptr);
+
+  void clear() => C.mnn_graph_cache_clear(ptr);
+
+  /// @brief Evaluate the graph from [inputs] to [outputs] through the cache.
+  ///
+  /// @return computed outputs and whether a compiled graph was reused.
+  (List<VARP>, bool) run(List<VARP> inputs, List<VARP> outputs) {
+    final vInputs = inputs.toNativeVec();
+    final vOutputs = outputs.toNativeVec();
+    final pResults = calloc<C.VecVARP_t>();
+    final pHit = calloc<ffi.Bool>();
+    try {
+      mnnRun(() => C.mnn_graph_cache_run(ptr, vInputs.ptr, vOutputs.ptr, pResults, pHit));
+      final results = VecVARP.fromPointer(pResults.value);
+      final rval = results.toList();
+      results.dispose();
+      return (rval, pHit.value);
+    } finally {
+      vInputs.dispose();
+      vOutputs.dispose();
+      calloc.free(pResults);
+      calloc.free(pHit);
+    }
+  }
+
+  @override
+  ffi.NativeFinalizer get finalizer => _finalizer;
+
+  @override
+  List<Object?> get props => [ptr.address];
+
+  @override
+  void release() {
+    C.mnn_graph_cache_destroy(ptr);
+  }
+
+  @override
+  String toString() {
+    return 'GraphCache(address=0x${ptr.address.toRadixString(16)}, size=$size)';
+  }
+}
+
+List<VARP> _takeOutputs(ffi.Pointer<C.VecVARP_t> p) {
+  final outputs = VecVARP.fromPointer(p.value);
+  final rval = outputs.toList();
+  outputs.dispose();
+  return rval;
+}
+
+typedef ModulePoolStats = ({int requests, int stolen, Duration busy, Duration alive, int queued, bool inUse});
+
+/// Clones of one master module sharing its parameters, each served by its own thread and
+/// executor, so independent requests run concurrently with a single copy of the weights.
+///
+/// Requests are queued round-robin on the workers and idle workers steal queued requests
+/// from busy ones, utilization of a worker is `busy / alive` of [stats].
+class ModulePool extends NativeObject {
+  static final _finalizer = ffi.NativeFinalizer(C.addresses.mnn_module_pool_destroy);
+
+  ModulePool.fromPointer(C.mnn_module_pool_t ptr, {super.attach, super.externalSize}) : super(ptr.cast());
+
+  /// Clone [master] into [size] workers, 0 means one per hardware thread.
+  ///
+  /// [master] must outlive the pool.
+  factory ModulePool.create(
+    Module master, {
+    ForwardType type = ForwardType.MNN_FORWARD_CPU,
+    BackendConfig? config,
+    int numThreads = 1,
+    int size = 0,
+  }) {
+    final cfg = config ?? BackendConfig.create();
+    final p = C.mnn_module_pool_create(master.ptr, type.value, cfg.ref, numThreads, size);
+    if (config == null) cfg.dispose();
+    MnnAssert(p != ffi.nullptr, 'failed to clone module');
+    return ModulePool.fromPointer(p);
+  }
+
+  /// number of workers
+  int get size => C.mnn_module_pool_size(ptr);
+
+  /// number of queued requests that no worker has started
+  int get pending => C.mnn_module_pool_pending(ptr);
+
+  /// Run onForward on an idle clone, blocking until the outputs are computed.
+  List<VARP> forward(List<VARP> inputs) {
+    final vInputs = inputs.toNativeVec();
+    final p = calloc<C.VecVARP_t>();
+    try {
+      mnnRun(() => C.mnn_module_pool_forward(ptr, vInputs.ptr, p, ffi.nullptr));
+      return _takeOutputs(p);
+    } finally {
+      vInputs.dispose();
+      calloc.free(p);
+    }
+  }
+
+  Future<List<VARP>> forwardAsync(List<VARP> inputs) async {
+    final vInputs = inputs.toNativeVec();
+    final p = calloc<C.VecVARP_t>();
+    try {
+      return await mnnRunAsync0(
+        (callback) => C.mnn_module_pool_forward(ptr, vInputs.ptr, p, callback),
+        (c) {
+          if (p.value == ffi.nullptr) return c.completeError(MNNException('module pool forward failed'));
+          return c.complete(_takeOutputs(p));
+        },
+      );
+    } finally {
+      vInputs.dispose();
+      calloc.free(p);
+    }
+  }
+
+  ModulePoolStats stats(int index) {
+    final p = calloc<C.mnn_module_pool_stats_t>();
+    try {
+      mnnRun(() => C.mnn_module_pool_get_stats(ptr, index, p));
+      return (
+        requests: p.ref.requests,
+        stolen: p.ref.stolen,
+        busy: Duration(microseconds: p.ref.busy_ns ~/ 1000),
+        alive: Duration(microseconds: p.ref.alive_ns ~/ 1000),
+        queued: p.ref.queued,
+        inUse: p.ref.in_use,
+      );
+    } finally {
+      calloc.free(p);
+    }
+  }
+
+  @override
+  ffi.NativeFinalizer get finalizer => _finalizer;
+
+  @override
+  List<Object?> get props => [ptr.address];
+
+  @override
+  void release() {
+    C.mnn_module_pool_destroy(ptr);
+  }
+
+  @override
+  String toString() {
+    return 'ModulePool(address=0x${ptr.address.toRadixString(16)}, size=$size)';
+  }
+}
+
+typedef DynamicBatcherStats = ({
+  int requests,
+  int batches,
+  Duration queueDelay,
+  Duration maxQueueDelay,
+  List<int> histogram,
+});
+
+/// Batches requests from any isolate into one forward of a clone of a module.
+///
+/// Requests are gathered until [maxBatch] rows are queued or the oldest request has waited
+/// `maxDelay`, inputs with matching count, type, format and shape except axis 0 are
+/// concatenated along axis 0, and outputs with the batch on axis 0 are split back.
+class DynamicBatcher extends NativeObject {
+  static final _finalizer = ffi.NativeFinalizer(C.addresses.mnn_dynamic_batcher_destroy);
+
+  DynamicBatcher.fromPointer(C.mnn_dynamic_batcher_t ptr, {super.attach, super.externalSize})
+    : super(ptr.cast());
+
+  /// [module] must outlive the batcher, its inputs and outputs must have the batch on axis 0.
+  factory DynamicBatcher.create(
+    Module module, {
+    int maxBatch = 8,
+    Duration maxDelay = const Duration(milliseconds: 2),
+    ForwardType type = ForwardType.MNN_FORWARD_CPU,
+    BackendConfig? config,
+    int numThreads = 1,
+  }) {
+    MnnAssert(maxBatch >= 1, 'maxBatch must be >= 1, got $maxBatch');
+    final cfg = config ?? BackendConfig.create();
+    final p = C.mnn_dynamic_batcher_create(
+      module.ptr,
+      type.value,
+      cfg.ref,
+      numThreads,
+      maxBatch,
+      maxDelay.inMicroseconds,
+    );
+    if (config == null) cfg.dispose();
+    MnnAssert(p != ffi.nullptr, 'failed to clone module');
+    return DynamicBatcher.fromPointer(p);
+  }
+
+  int get maxBatch => C.mnn_dynamic_batcher_max_batch(ptr);
+
+  /// number of queued requests
+  int get pending => C.mnn_dynamic_batcher_pending(ptr);
+
+  /// Queue [inputs] for the next batch, blocking until the outputs are computed.
+  List<VARP> forward(List<VARP> inputs) {
+    final vInputs = inputs.toNativeVec();
+    final p = calloc<C.VecVARP_t>();
+    try {
+      mnnRun(() => C.mnn_dynamic_batcher_forward(ptr, vInputs.ptr, p, ffi.nullptr));
+      return _takeOutputs(p);
+    } finally {
+      vInputs.dispose();
+      calloc.free(p);
+    }
+  }
+
+  Future<List<VARP>> forwardAsync(List<VARP> inputs) async {
+    final vInputs = inputs.toNativeVec();
+    final p = calloc<C.VecVARP_t>();
+    try {
+      return await mnnRunAsync0(
+        (callback) => C.mnn_dynamic_batcher_forward(ptr, vInputs.ptr, p, callback),
+        (c) {
+          if (p.value == ffi.nullptr) return c.completeError(MNNException('batched forward failed'));
+          return c.complete(_takeOutputs(p));
+        },
+      );
+    } finally {
+      vInputs.dispose();
+      calloc.free(p);
+    }
+  }
+
+  /// Statistics, `histogram[i]` is the number of forwards of `i + 1` rows.
+  DynamicBatcherStats get stats {
+    final n = maxBatch;
+    final p = calloc<C.mnn_dynamic_batcher_stats_t>();
+    final pCounts = calloc<ffi.Uint64>(n);
+    try {
+      mnnRun(() => C.mnn_dynamic_batcher_get_stats(ptr, p));
+      mnnRun(() => C.mnn_dynamic_batcher_get_histogram(ptr, pCounts, n));
+      return (
+        requests: p.ref.requests,
+        batches: p.ref.batches,
+        queueDelay: Duration(microseconds: p.ref.queue_delay_ns ~/ 1000),
+        maxQueueDelay: Duration(microseconds: p.ref.max_queue_delay_ns ~/ 1000),
+        histogram: pCounts.asTypedList(n).toList(),
+      );
+    } finally {
+      calloc.free(p);
+      calloc.free(pCounts);
+    }
+  }
+
+  @override
+  ffi.NativeFinalizer get finalizer => _finalizer;
+
+  @override
+  List<Object?> get props => [ptr.address];
+
+  @override
+  void release() {
+    C.mnn_dynamic_batcher_destroy(ptr);
+  }
+
+  @override
+  String toString() {
+    return 'DynamicBatcher(address=0x${ptr.address.toRadixString(16)}, maxBatch=$maxBatch)';
+  }
+}
@@ -0,0 +1,154 @@
+import 'dart:ffi' as ffi;
+
+import 'package:ffi/ffi.dart';
+
+import '../core/base.dart';
+import '../core/exception.dart';
+import '../core/tensor.dart';
+import '../expr/expr.dart';
+import '../g/mnn.g.dart' as C;
+
+/// A sampled token and its probability after all transforms of the [Sampler].
+typedef SampledToken = ({int token, double prob});
+
+/// Token sampler of generative decoding loops.
+///
+/// Repetition penalty, temperature, top-k, top-p and the draw run natively in a fused
+/// pass over the logits, only the sampled token is returned to Dart. Draws come from a
+/// seeded generator, so the same seed and logits give the same tokens on every platform.
+class Sampler extends NativeObject {
+  static final _finalizer = ffi.NativeFinalizer(C.addresses.mnn_sampler_destroy);
+
+  Sampler.fromPointer(C.mnn_sampler_t ptr, {super.attach, super.externalSize}) : super(ptr.cast());
+
+  /// @param temperature logits are divided by it, <= 0 means greedy decoding
+  ///
+  /// @param topK number of most likely tokens kept, <= 0 keeps all
+  ///
+  /// @param topP smallest set of most likely tokens whose probability reaches it is kept,
+  /// >= 1 keeps all
+  ///
+  /// @param repetitionPenalty logits of tokens in the history are divided by it if positive,
+  /// multiplied otherwise, 1 disables it
+  ///
+  /// @param seed seed of the random generator
+  factory Sampler.create({
+    double temperature = 1.0,
+    int topK = 0,
+    double topP = 1.0,
+    double repetitionPenalty = 1.0,
+    int seed = 0,
+  }) {
+    final cfg = _config(temperature, topK, topP, repetitionPenalty, seed);
+    try {
+      final p = C.mnn_sampler_create(cfg);
+      if (p == ffi.nullptr) {
+        throw MNNException(
+          'Invalid sampler config: temperature=$temperature, topP=$topP, '
+          'repetitionPenalty=$repetitionPenalty',
+        );
+      }
+      return Sampler.fromPointer(p);
+    } finally {
+      calloc.free(cfg);
+    }
+  }
+
+  /// Greedy decoding, the most likely token after the repetition penalty.
+  factory Sampler.greedy({double repetitionPenalty = 1.0}) =>
+      Sampler.create(temperature: 0, repetitionPenalty: repetitionPenalty);
+
+  static ffi.Pointer<C.mnn_sampler_config_t> _config(
+    double temperature,
+    int topK,
+    double topP,
+    double repetitionPenalty,
+    int seed,
+  ) {
+    return calloc<C.mnn_sampler_config_t>()
+      ..ref.temperature = temperature
+      ..ref.top_k = topK
+      ..ref.top_p = topP
+      ..ref.repetition_penalty = repetitionPenalty
+      ..ref.seed = seed;
+  }
+
+  /// Replace the config, the random generator is reseeded with [seed].
+  void configure({
+    double temperature = 1.0,
+    int topK = 0,
+    double topP = 1.0,
+    double repetitionPenalty = 1.0,
+    int seed = 0,
+  }) {
+    final cfg = _config(temperature, topK, topP, repetitionPenalty, seed);
+    try {
+      mnnRun(() => C.mnn_sampler_set_config(ptr, cfg));
+    } finally {
+      calloc.free(cfg);
+    }
+  }
+
+  /// Reseed the random generator, the following draws repeat those after the last reseed.
+  void reseed(int seed) => C.mnn_sampler_set_seed(ptr, seed);
+
+  SampledToken _sample(
+    List<int> history,
+    C.ErrorCode Function(
+      ffi.Pointer<ffi.Int32> history,
+      ffi.Pointer<ffi.Int32> token,
+      ffi.Pointer<ffi.Float> prob,
+    )
+    func,
+  ) {
+    final pHistory = history.isEmpty ? ffi.nullptr.cast<ffi.Int32>() : calloc<ffi.Int32>(history.length);
+    final pToken = calloc<ffi.Int32>();
+    final pProb = calloc<ffi.Float>();
+    try {
+      if (history.isNotEmpty) pHistory.asTypedList(history.length).setAll(0, history);
+      mnnRun(() => func(pHistory, pToken, pProb));
+      return (token: pToken.value, prob: pProb.value);
+    } finally {
+      if (history.isNotEmpty) calloc.free(pHistory);
+      calloc.free(pToken);
+      calloc.free(pProb);
+    }
+  }
+
+  /// Sample the next token from the last row of [logits], [..., vocab].
+  ///
+  /// @param history previous tokens the repetition penalty applies to
+  SampledToken sample(VARP logits, {List<int> history = const []}) => _sample(
+    history,
+    (h, token, prob) => C.mnn_sampler_sample_var(ptr, logits.ptr, h, history.length, token, prob),
+  );
+
+  /// Sample the next token from the last row of a float host tensor, [..., vocab].
+  SampledToken sampleTensor(Tensor logits, {List<int> history = const []}) => _sample(
+    history,
+    (h, token, prob) => C.mnn_sampler_sample_tensor(ptr, logits.ptr, h, history.length, token, prob),
+  );
+
+  /// Sample the next token from [vocab] float logits in native memory.
+  SampledToken sampleLogits(ffi.Pointer<ffi.Float> logits, int vocab, {List<int> history = const []}) =>
+      _sample(
+        history,
+        (h, token, prob) => C.mnn_sampler_sample(ptr, logits, vocab, h, history.length, token, prob),
+      );
+
+  @override
+  ffi.NativeFinalizer get finalizer => _finalizer;
+
+  @override
+  void release() {
+    C.mnn_sampler_destroy(ptr);
+  }
+
+  @override
+  List<Object?> get props => [ptr.address];
+
+  @override
+  String toString() {
+    return "Sampler(address=0x${ptr.address.toRadixString(16)})";
+  }
+}
@@ -1,6 +1,11 @@
+import 'dart:ffi' as ffi;
+
+import 'package:ffi/ffi.dart';
+
 import '../core/base.dart';
 import '../expr/expr.dart';
 import '../expr/op.dart' as F;
+import '../g/mnn.g.dart' as C;
 import 'numpy.dart' as np;
 
 // Linear algebra
@@ -66,6 +71,39 @@ VARP norm(VARP x, {dynamic ord, dynamic axis, bool keepDims = false}) {
   return (res[1], res[0], res[2]);
 }
 
-VARP solve(VARP a, VARP b) {
-  throw UnimplementedError('solve not supported');
+VARP _linalg(C.ErrorCode Function(ffi.Pointer<C.VARP_t> out) fn) {
+  final pOut = calloc<C.VARP_t>();
+  try {
+    mnnRun(() => fn(pOut));
+    return VARP.fromPointer(pOut.value);
+  } finally {
+    calloc.free(pOut);
+  }
+}
+
+/// Determinants of float matrices [..., n, n], computed natively in double precision.
+VARP det(VARP a) => _linalg((out) => C.mnn_expr_linalg_det(a.ptr, out));
+
+/// Inverses of float matrices [..., n, n], throws if any matrix is singular.
+VARP inv(VARP a) => _linalg((out) => C.mnn_expr_linalg_inv(a.ptr, out));
+
+/// Solve `a @ x = b` for float matrices [..., n, n], [b] is [..., n, k] or [..., n],
+/// throws if any matrix is singular.
+VARP solve(VARP a, VARP b) => _linalg((out) => C.mnn_expr_linalg_solve(a.ptr, b.ptr, out));
+
+/// Lower Cholesky factors of symmetric positive-definite float matrices [..., n, n],
+/// throws if any matrix is not positive-definite.
+VARP cholesky(VARP a) => _linalg((out) => C.mnn_expr_linalg_cholesky(a.ptr, out));
+
+/// Reduced QR decompositions of float matrices [..., m, n], with the signs of numpy.
+(VARP, VARP) qr(VARP a) {
+  final pQ = calloc<C.VARP_t>();
+  final pR = calloc<C.VARP_t>();
+  try {
+    mnnRun(() => C.mnn_expr_linalg_qr(a.ptr, pQ, pR));
+    return (VARP.fromPointer(pQ.value), VARP.fromPointer(pR.value));
+  } finally {
+    calloc.free(pQ);
+    calloc.free(pR);
+  }
 }
@@ -915,6 +915,7 @@ VARP vdot(VARP a, VARP b) => dot(a, b);
 VARP inner(VARP a, VARP b) => dot(a, b);
 VARP outer(VARP a, VARP b) => throw UnimplementedError();
 VARP matmul(VARP a, VARP b) => dot(a, b);
+VARP einsum(String subscripts, List<VARP> operands) => F.einsum(subscripts, operands);
 
 VARP all(VARP a, {List<int> axis = const [], bool keepDims = false}) {
   return F.reduceAll(a, axis: axis, keepDims: keepDims);
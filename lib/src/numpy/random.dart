@@ -1,6 +1,104 @@
+import 'dart:ffi' as ffi;
+import 'dart:math' as math;
+
+import 'package:ffi/ffi.dart';
+
 import '../core/base.dart';
 import '../expr/expr.dart';
-import '../expr/op.dart' as F;
+import '../expr/utils.dart';
+import '../g/mnn.g.dart' as C;
+
+/// Counter-based random generator, Philox4x32-10.
+///
+/// Each sample is a pure function of [seed] and its index in the stream, so results are
+/// the same for any number of threads. Every call continues the stream from [offset].
+class Generator {
+  Generator(this.seed, {this.offset = 0, this.numThreads = 0});
+
+  /// Generator with a random seed.
+  factory Generator.secure({int numThreads = 0}) {
+    final r = math.Random.secure();
+    return Generator((r.nextInt(1 << 32) << 32) | r.nextInt(1 << 32), numThreads: numThreads);
+  }
+
+  /// key of the generator, 64 bits
+  final int seed;
+
+  /// index of the next sample in the stream
+  int offset;
+
+  /// number of threads, <= 0 means using all available threads
+  final int numThreads;
+
+  ffi.Pointer<C.mnn_rng_params_t> _params(C.RngDistribution distribution, double a, double b) {
+    return calloc<C.mnn_rng_params_t>()
+      ..ref.distribution = distribution.value
+      ..ref.seed = seed
+      ..ref.offset = offset
+      ..ref.a = a
+      ..ref.b = b;
+  }
+
+  VARP _create(List<int> shape, C.RngDistribution distribution, double a, double b) {
+    final count = shape.fold<int>(1, (p, e) => p * e);
+    final pParams = _params(distribution, a, b);
+    final (pShape, ndim) = shape.toNativeArrayI32();
+    final pOut = calloc<C.VARP_t>();
+    try {
+      mnnRun(() => C.mnn_rng_create_var(pParams, pShape.cast(), ndim, numThreads, pOut));
+      offset += count;
+      return VARP.fromPointer(pOut.value);
+    } finally {
+      calloc.free(pParams);
+      calloc.free(pShape);
+      calloc.free(pOut);
+    }
+  }
+
+  /// Fill [count] samples of [distribution] into native memory, float for uniform and normal,
+  /// int32 for integer and Bernoulli, see [C.RngDistribution] for [a] and [b].
+  void fill(ffi.Pointer<ffi.Void> out, int count, C.RngDistribution distribution, double a, double b) {
+    final pParams = _params(distribution, a, b);
+    try {
+      mnnRun(() => C.mnn_rng_fill(pParams, out, count, numThreads));
+      offset += count;
+    } finally {
+      calloc.free(pParams);
+    }
+  }
+
+  /// float32 samples in [low, high).
+  VARP uniform(List<int> shape, {double low = 0.0, double high = 1.0}) =>
+      _create(shape, C.RngDistribution.MNN_RNG_UNIFORM, low, high);
+
+  /// float32 samples in [0, 1).
+  VARP random(List<int> shape) => uniform(shape);
+
+  /// float32 samples of a normal distribution.
+  VARP normal(List<int> shape, {double loc = 0.0, double scale = 1.0}) =>
+      _create(shape, C.RngDistribution.MNN_RNG_NORMAL, loc, scale);
+
+  /// int32 samples in [low, high), or [0, low) if [high] is null.
+  VARP integers(int low, {int? high, List<int> size = const []}) {
+    final low_ = high == null ? 0 : low;
+    high ??= low;
+    return _create(size, C.RngDistribution.MNN_RNG_INTEGER, low_.toDouble(), high.toDouble());
+  }
+
+  /// int32 samples, 1 with probability [p], otherwise 0.
+  VARP bernoulli(double p, List<int> shape) => _create(shape, C.RngDistribution.MNN_RNG_BERNOULLI, p, 0);
+
+  @override
+  String toString() => 'Generator(seed=$seed, offset=$offset)';
+}
+
+/// Counter-based generator like numpy.random.default_rng, a random seed if [seed] is null.
+Generator defaultRng([int? seed]) => seed == null ? Generator.secure() : Generator(seed);
+
+// seed0 and seed1 are the low and high 32 bits of the key, both 0 means a random seed.
+Generator _generator(int seed0, int seed1) => seed0 == 0 && seed1 == 0
+    ? Generator.secure()
+    : Generator(((seed1 & 0xFFFFFFFF) << 32) | (seed0 & 0xFFFFFFFF));
 
 VARP random(
   List<int> shape, {
@@ -9,13 +107,7 @@ VARP random(
   int seed0 = 0,
   int seed1 = 0,
 }) {
-  return F.randomUniform<float32>(
-    F.constant<int32>(shape, [shape.length], format: DimensionFormat.NCHW),
-    low: low,
-    high: high,
-    seed0: seed0,
-    seed1: seed1,
-  );
+  return _generator(seed0, seed1).uniform(shape, low: low, high: high);
 }
 
 VARP randint(
@@ -25,15 +117,9 @@ VARP randint(
   int seed0 = 0,
   int seed1 = 0,
 }) {
-  final low_ = high == null ? 0 : low;
-  high ??= low;
-  return F.cast<int32>(
-    F.randomUniform<float32>(
-      F.constant<int32>(size, [size.length], format: DimensionFormat.NCHW),
-      low: low_.toDouble(),
-      high: high.toDouble(),
-      seed0: seed0,
-      seed1: seed1,
-    ),
-  );
+  return _generator(seed0, seed1).integers(low, high: high, size: size);
+}
+
+VARP randn(List<int> shape, {double loc = 0.0, double scale = 1.0, int seed0 = 0, int seed1 = 0}) {
+  return _generator(seed0, seed1).normal(shape, loc: loc, scale: scale);
 }
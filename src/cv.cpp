@@ -4,6 +4,7 @@
 
 #include "mnn_c/cv.h"
 #include "cv/cv.hpp"
+#include "expr_arena.hpp"
 #include "mnn_c/mnn_stb_image.h"
 #include <set>
 
@@ -52,10 +53,10 @@ VARP_t mnn_cv_buildImgVARP(uint8_t *img, int height, int width, int channel, int
   case IMREAD_COLOR: res = MNN::CV::cvtColor(rgb, MNN::CV::COLOR_RGB2BGR); break;
   case IMREAD_GRAYSCALE: res = MNN::CV::cvtColor(rgb, MNN::CV::COLOR_RGB2GRAY); break;
   case IMREAD_ANYDEPTH: res = MNN::Express::_Cast<float>(rgb); break;
-  case IMREAD_COLOR_RGB: return new MNN::Express::VARP(rgb); break;
-  default: MNN_ERROR("Don't support imread flags!"); return new MNN::Express::VARP(rgb);
+  case IMREAD_COLOR_RGB: return mnnc::make_varp(rgb); break;
+  default: MNN_ERROR("Don't support imread flags!"); return mnnc::make_varp(rgb);
   }
-  return new MNN::Express::VARP(res);
+  return mnnc::make_varp(res);
 }
 
 MNN_C_API VARP_t mnn_cv_buildImgVarpYuvNV21(uint8_t *src, int height, int width, int flags) {
@@ -102,12 +103,12 @@ MNN_C_API VARP_t mnn_cv_buildImgVarpYuvNV21(uint8_t *src, int height, int width,
 // core
 bool mnn_cv_solve(VARP_t src1, VARP_t src2, int flags, VARP_t *out) {
   auto v = MNN::CV::solve(*src1, *src2, flags);
-  *out   = new MNN::Express::VARP(v.second);
+  *out   = mnnc::make_varp(v.second);
   return v.first;
 }
 
 // calib3d
-VARP_t mnn_cv_Rodrigues(VARP_t src) { return new MNN::Express::VARP(MNN::CV::Rodrigues(*src)); }
+VARP_t mnn_cv_Rodrigues(VARP_t src) { return mnnc::make_varp(MNN::CV::Rodrigues(*src)); }
 
 void mnn_cv_solvePnP(
     VARP_t  objectPoints,
@@ -120,8 +121,8 @@ void mnn_cv_solvePnP(
 ) {
   auto v =
       MNN::CV::solvePnP(*objectPoints, *imagePoints, *cameraMatrix, *distCoeffs, useExtrinsicGuess);
-  *out1 = new MNN::Express::VARP(v.first);
-  *out2 = new MNN::Express::VARP(v.second);
+  *out1 = mnnc::make_varp(v.first);
+  *out2 = mnnc::make_varp(v.second);
 }
 
 // imgcodecs.hpp
@@ -265,20 +266,20 @@ MNN_C_API VARP_t mnn_cv_boxPoints(mnn_cv_rotated_rect_t box) {
   _box.size   = MNN::CV::Size2f{box.width, box.height};
   _box.angle  = box.angle;
   auto v      = MNN::CV::boxPoints(_box);
-  return new MNN::Express::VARP(v);
+  return mnnc::make_varp(v);
 }
 
 // miscellaneous.hpp
 MNN_C_API VARP_t mnn_cv_adaptiveThreshold(
     VARP_t src, double max_value, int adaptiveMethod, int thresholdType, int blockSize, double C
 ) {
-  return new MNN::Express::VARP(
+  return mnnc::make_varp(
       MNN::CV::adaptiveThreshold(*src, max_value, adaptiveMethod, thresholdType, blockSize, C)
   );
 }
 
 MNN_C_API VARP_t mnn_cv_blendLinear(VARP_t src1, VARP_t src2, VARP_t weight1, VARP_t weight2) {
-  return new MNN::Express::VARP(MNN::CV::blendLinear(*src1, *src2, *weight1, *weight2));
+  return mnnc::make_varp(MNN::CV::blendLinear(*src1, *src2, *weight1, *weight2));
 }
 
 // MNN_C_API void mnn_cv_distanceTransform(
@@ -297,14 +298,14 @@ MNN_C_API VARP_t mnn_cv_blendLinear(VARP_t src1, VARP_t src2, VARP_t weight1, VA
 //   return new MNN::Express::VARP(MNN::CV::integral(*src, sdepth));
 // }
 MNN_C_API VARP_t mnn_cv_threshold(VARP_t src, double thresh, double maxval, int type) {
-  return new MNN::Express::VARP(MNN::CV::threshold(*src, thresh, maxval, type));
+  return mnnc::make_varp(MNN::CV::threshold(*src, thresh, maxval, type));
 }
 
 // histograms.hpp
 MNN_C_API VARP_t mnn_cv_calcHist(
     VecVARP_t images, VecI32 channels, VARP_t mask, VecI32 hist_size, VecF32 ranges, bool accumulate
 ) {
-  return new MNN::Express::VARP(
+  return mnnc::make_varp(
       MNN::CV::calcHist(*images, *channels, *mask, *hist_size, *ranges, accumulate)
   );
 }
@@ -348,7 +349,7 @@ MNN_C_API VARP_t
 mnn_cv_getRectSubPix(VARP_t image, mnn_cv_size2i_t patchSize, mnn_cv_point_t center) {
   MNN::CV::Size  _patchSize = {patchSize.width, patchSize.height};
   MNN::CV::Point _center    = {center.x, center.y};
-  return new MNN::Express::VARP(MNN::CV::getRectSubPix(*image, _patchSize, _center));
+  return mnnc::make_varp(MNN::CV::getRectSubPix(*image, _patchSize, _center));
 }
 
 MNN_C_API mnn_cv_matrix_t
@@ -364,7 +365,7 @@ MNN_C_API mnn_cv_matrix_t mnn_cv_invertAffineTransform(mnn_cv_matrix_t M) {
 MNN_C_API VARP_t mnn_cv_remap(
     VARP_t src, VARP_t map1, VARP_t map2, int interpolation, int borderMode, int borderValue
 ) {
-  return new MNN::Express::VARP(
+  return mnnc::make_varp(
       MNN::CV::remap(*src, *map1, *map2, interpolation, borderMode, borderValue)
   );
 }
@@ -380,7 +381,7 @@ MNN_C_API VARP_t mnn_cv_resize(
     VecF32          norm
 ) {
   MNN::CV::Size _dsize = {dsize.width, dsize.height};
-  return new MNN::Express::VARP(
+  return mnnc::make_varp(
       MNN::CV::resize(*src, _dsize, fx, fy, interpolation, code, *mean, *norm)
   );
 }
@@ -397,7 +398,7 @@ MNN_C_API VARP_t mnn_cv_warpAffine(
     VecF32          norm
 ) {
   MNN::CV::Size _dsize = {dsize.width, dsize.height};
-  return new MNN::Express::VARP(
+  return mnnc::make_varp(
       MNN::CV::warpAffine(*src, *M, _dsize, flags, borderMode, borderValue, code, *mean, *norm)
   );
 }
@@ -406,52 +407,52 @@ MNN_C_API VARP_t mnn_cv_warpPerspective(
     VARP_t src, mnn_cv_matrix_t M, mnn_cv_size2i_t dsize, int flags, int borderMode, int borderValue
 ) {
   MNN::CV::Size _dsize = {dsize.width, dsize.height};
-  return new MNN::Express::VARP(
+  return mnnc::make_varp(
       MNN::CV::warpPerspective(*src, *M, _dsize, flags, borderMode, borderValue)
   );
 }
 
 MNN_C_API VARP_t mnn_cv_undistortPoints(VARP_t src, VARP_t cameraMatrix, VARP_t distCoeffs) {
-  return new MNN::Express::VARP(MNN::CV::undistortPoints(*src, *cameraMatrix, *distCoeffs));
+  return mnnc::make_varp(MNN::CV::undistortPoints(*src, *cameraMatrix, *distCoeffs));
 }
 
 // filter.hpp
 MNN_C_API VARP_t
 mnn_cv_bilateralFilter(VARP_t src, int d, double sigmaColor, double sigmaSpace, int borderType) {
-  return new MNN::Express::VARP(
+  return mnnc::make_varp(
       MNN::CV::bilateralFilter(*src, d, sigmaColor, sigmaSpace, borderType)
   );
 }
 
 MNN_C_API VARP_t mnn_cv_blur(VARP_t src, mnn_cv_size2i_t ksize, int borderType) {
   MNN::CV::Size _ksize = {ksize.width, ksize.height};
-  return new MNN::Express::VARP(MNN::CV::blur(*src, _ksize, borderType));
+  return mnnc::make_varp(MNN::CV::blur(*src, _ksize, borderType));
 }
 
 MNN_C_API VARP_t
 mnn_cv_boxFilter(VARP_t src, int ddepth, mnn_cv_size2i_t ksize, bool normalize, int borderType) {
   MNN::CV::Size _ksize = {ksize.width, ksize.height};
-  return new MNN::Express::VARP(MNN::CV::boxFilter(*src, ddepth, _ksize, normalize, borderType));
+  return mnnc::make_varp(MNN::CV::boxFilter(*src, ddepth, _ksize, normalize, borderType));
 }
 
 MNN_C_API VARP_t mnn_cv_dilate(VARP_t src, VARP_t kernel, int iterations, int borderType) {
-  return new MNN::Express::VARP(MNN::CV::dilate(*src, *kernel, iterations, borderType));
+  return mnnc::make_varp(MNN::CV::dilate(*src, *kernel, iterations, borderType));
 }
 
 MNN_C_API VARP_t mnn_cv_erode(VARP_t src, VARP_t kernel, int iterations, int borderType) {
-  return new MNN::Express::VARP(MNN::CV::erode(*src, *kernel, iterations, borderType));
+  return mnnc::make_varp(MNN::CV::erode(*src, *kernel, iterations, borderType));
 }
 
 MNN_C_API VARP_t
 mnn_cv_filter2D(VARP_t src, int ddepth, VARP_t kernel, double delta, int borderType) {
-  return new MNN::Express::VARP(MNN::CV::filter2D(*src, ddepth, *kernel, delta, borderType));
+  return mnnc::make_varp(MNN::CV::filter2D(*src, ddepth, *kernel, delta, borderType));
 }
 
 MNN_C_API VARP_t mnn_cv_GaussianBlur(
     VARP_t src, mnn_cv_size2i_t ksize, double sigmaX, double sigmaY, int borderType
 ) {
   MNN::CV::Size _ksize = {ksize.width, ksize.height};
-  return new MNN::Express::VARP(MNN::CV::GaussianBlur(*src, _ksize, sigmaX, sigmaY, borderType));
+  return mnnc::make_varp(MNN::CV::GaussianBlur(*src, _ksize, sigmaX, sigmaY, borderType));
 }
 
 // MNN_C_API std::pair<VARP_t, VARP_t> getDerivKernels(int dx, int dy, int ksize,
@@ -460,42 +461,42 @@ MNN_C_API VARP_t mnn_cv_getGaborKernel(
     mnn_cv_size2i_t ksize, double sigma, double theta, double lambd, double gamma, double psi
 ) {
   MNN::CV::Size _ksize = {ksize.width, ksize.height};
-  return new MNN::Express::VARP(MNN::CV::getGaborKernel(_ksize, sigma, theta, lambd, gamma, psi));
+  return mnnc::make_varp(MNN::CV::getGaborKernel(_ksize, sigma, theta, lambd, gamma, psi));
 }
 
 MNN_C_API VARP_t mnn_cv_getGaussianKernel(int n, double sigma) {
-  return new MNN::Express::VARP(MNN::CV::getGaussianKernel(n, sigma));
+  return mnnc::make_varp(MNN::CV::getGaussianKernel(n, sigma));
 }
 
 MNN_C_API VARP_t mnn_cv_getStructuringElement(int shape, mnn_cv_size2i_t ksize) {
   MNN::CV::Size _ksize = {ksize.width, ksize.height};
-  return new MNN::Express::VARP(MNN::CV::getStructuringElement(shape, _ksize));
+  return mnnc::make_varp(MNN::CV::getStructuringElement(shape, _ksize));
 }
 
 MNN_C_API VARP_t
 mnn_cv_Laplacian(VARP_t src, int ddepth, int ksize, double scale, double delta, int borderType) {
-  return new MNN::Express::VARP(MNN::CV::Laplacian(*src, ddepth, ksize, scale, delta, borderType));
+  return mnnc::make_varp(MNN::CV::Laplacian(*src, ddepth, ksize, scale, delta, borderType));
 }
 
 MNN_C_API VARP_t mnn_cv_pyrDown(VARP_t src, mnn_cv_size2i_t dstsize, int borderType) {
   MNN::CV::Size _dstsize = {dstsize.width, dstsize.height};
-  return new MNN::Express::VARP(MNN::CV::pyrDown(*src, _dstsize, borderType));
+  return mnnc::make_varp(MNN::CV::pyrDown(*src, _dstsize, borderType));
 }
 
 MNN_C_API VARP_t mnn_cv_pyrUp(VARP_t src, mnn_cv_size2i_t dstsize, int borderType) {
   MNN::CV::Size _dstsize = {dstsize.width, dstsize.height};
-  return new MNN::Express::VARP(MNN::CV::pyrUp(*src, _dstsize, borderType));
+  return mnnc::make_varp(MNN::CV::pyrUp(*src, _dstsize, borderType));
 }
 
 MNN_C_API VARP_t
 mnn_cv_Scharr(VARP_t src, int ddepth, int dx, int dy, double scale, double delta, int borderType) {
-  return new MNN::Express::VARP(MNN::CV::Scharr(*src, ddepth, dx, dy, scale, delta, borderType));
+  return mnnc::make_varp(MNN::CV::Scharr(*src, ddepth, dx, dy, scale, delta, borderType));
 }
 
 MNN_C_API VARP_t mnn_cv_sepFilter2D(
     VARP_t src, int ddepth, VARP_t kernelX, VARP_t kernelY, double delta, int borderType
 ) {
-  return new MNN::Express::VARP(
+  return mnnc::make_varp(
       MNN::CV::sepFilter2D(*src, ddepth, *kernelX, *kernelY, delta, borderType)
   );
 }
@@ -503,7 +504,7 @@ MNN_C_API VARP_t mnn_cv_sepFilter2D(
 MNN_C_API VARP_t mnn_cv_Sobel(
     VARP_t src, int ddepth, int dx, int dy, int ksize, double scale, double delta, int borderType
 ) {
-  return new MNN::Express::VARP(
+  return mnnc::make_varp(
       MNN::CV::Sobel(*src, ddepth, dx, dy, ksize, scale, delta, borderType)
   );
 }
@@ -513,7 +514,7 @@ MNN_C_API VARP_t mnn_cv_Sobel(
 MNN_C_API VARP_t
 mnn_cv_sqrBoxFilter(VARP_t src, int ddepth, mnn_cv_size2i_t ksize, bool normalize, int borderType) {
   MNN::CV::Size _ksize = {ksize.width, ksize.height};
-  return new MNN::Express::VARP(MNN::CV::sqrBoxFilter(*src, ddepth, _ksize, normalize, borderType));
+  return mnnc::make_varp(MNN::CV::sqrBoxFilter(*src, ddepth, _ksize, normalize, borderType));
 }
 
 // draw.hpp
@@ -639,11 +640,11 @@ MNN_C_API void mnn_cv_fillPoly(
 
 // color.hpp
 MNN_C_API VARP_t mnn_cv_cvtColor(VARP_t src, int code, int dstCn) {
-  return new MNN::Express::VARP(MNN::CV::cvtColor(*src, code, dstCn));
+  return mnnc::make_varp(MNN::CV::cvtColor(*src, code, dstCn));
 }
 
 MNN_C_API VARP_t mnn_cv_cvtColorTwoPlane(VARP_t src1, VARP_t src2, int code) {
-  return new MNN::Express::VARP(MNN::CV::cvtColorTwoPlane(*src1, *src2, code));
+  return mnnc::make_varp(MNN::CV::cvtColorTwoPlane(*src1, *src2, code));
 }
 
 // MNN_C_API VARP_t mnn_cv_demosaicing(VARP_t src, int code, int dstCn) {
@@ -0,0 +1,517 @@
+/*
+ * detection.cpp
+ * MNN C API for fused detector postprocessing
+ *
+ * Author: Rainyl
+ * License: Apache License 2.0
+ */
+
+#include "mnn_c/detection.h"
+#include "parallel.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace {
+
+// Anchors scanned together, per-anchor state lives on the stack.
+const int kTile = 256;
+
+struct Candidate {
+  float score;
+  int   anchor;
+  int   cls;
+};
+
+struct Box {
+  float x0, y0, x1, y1;
+};
+
+inline const float *channel_ptr(const float *base, const mnn_tensor_layout_t &l, int c) {
+  return base + (size_t)(c / l.pack) * l.channel_stride + c % l.pack;
+}
+
+inline float read_at(const float *base, const mnn_tensor_layout_t &l, int c, int a) {
+  return channel_ptr(base, l, c)[(size_t)a * l.area_stride];
+}
+
+inline float sigmoid(float x) { return 1.0f / (1.0f + std::exp(-x)); }
+
+bool valid_layout(const mnn_tensor_layout_t *l) {
+  return l->batch >= 0 && l->channel >= 0 && l->area >= 0 && l->pack >= 1;
+}
+
+inline float iou(const Box &a, const Box &b) {
+  const float w = std::min(a.x1, b.x1) - std::max(a.x0, b.x0);
+  const float h = std::min(a.y1, b.y1) - std::max(a.y0, b.y0);
+  if (w <= 0.0f || h <= 0.0f) return 0.0f;
+  const float inter = w * h;
+  const float uni   = (a.x1 - a.x0) * (a.y1 - a.y0) + (b.x1 - b.x0) * (b.y1 - b.y0) - inter;
+  return uni > 0.0f ? inter / uni : 0.0f;
+}
+
+// Higher score first, ties keep the anchor order so results are deterministic.
+inline bool by_score(const Candidate &a, const Candidate &b) {
+  return a.score > b.score || (a.score == b.score && a.anchor < b.anchor);
+}
+
+// Decoded inputs of one image, scores and head share anchors.
+struct Image {
+  const float               *head;
+  const float               *scores;
+  const mnn_tensor_layout_t &head_layout;
+  const mnn_tensor_layout_t &score_layout;
+  const float               *priors;
+};
+
+// Best class of every anchor whose score passes the threshold.
+void scan_scores(
+    const Image &img, const mnn_detect_params_t &p, int cls0, int classes,
+    std::vector<Candidate> &out
+) {
+  const mnn_tensor_layout_t &l   = img.score_layout;
+  const float               *src = img.scores;
+  const int                  obj = p.format == MNN_DETECT_YOLO_OBJ ? cls0 - 1 : -1;
+  const float                inf = std::numeric_limits<float>::infinity();
+  // sigmoid is monotonic, filter the logits without computing exp
+  float cut = p.score_threshold;
+  if (p.activation == MNN_SCORE_SIGMOID && obj < 0) {
+    const float t = p.score_threshold;
+    cut           = t <= 0.0f ? -inf : t >= 1.0f ? inf : std::log(t / (1.0f - t));
+  }
+  for (int a0 = 0; a0 < l.area; a0 += kTile) {
+    const int len = std::min(kTile, l.area - a0);
+    float     best[kTile], top[kTile], sum[kTile];
+    int       arg[kTile];
+    std::fill(best, best + len, -inf);
+    std::fill(top, top + len, -inf);
+    std::fill(arg, arg + len, -1);
+    for (int c = 0; c < classes; c++) {
+      const float *q = channel_ptr(src, l, cls0 + c) + (size_t)a0 * l.area_stride;
+      for (int k = 0; k < len; k++) {
+        const float v = q[k * l.area_stride];
+        top[k]        = std::max(top[k], v);
+        if (c != p.background_class && v > best[k]) {
+          best[k] = v;
+          arg[k]  = c;
+        }
+      }
+    }
+    if (p.activation == MNN_SCORE_SOFTMAX) {
+      std::fill(sum, sum + len, 0.0f);
+      for (int c = 0; c < classes; c++) {
+        const float *q = channel_ptr(src, l, cls0 + c) + (size_t)a0 * l.area_stride;
+        for (int k = 0; k < len; k++) sum[k] += std::exp(q[k * l.area_stride] - top[k]);
+      }
+    }
+    for (int k = 0; k < len; k++) {
+      if (arg[k] < 0) continue;
+      float score = best[k];
+      switch (p.activation) {
+      case MNN_SCORE_SIGMOID:
+        if (obj < 0) {
+          if (!(score > cut)) continue;
+          score = sigmoid(score);
+        } else {
+          score = sigmoid(score) * sigmoid(read_at(src, l, obj, a0 + k));
+        }
+        break;
+      case MNN_SCORE_SOFTMAX:
+        score = std::exp(best[k] - top[k]) / sum[k];
+        if (obj >= 0) score *= read_at(src, l, obj, a0 + k);
+        break;
+      default:
+        if (obj >= 0) score *= read_at(src, l, obj, a0 + k);
+        break;
+      }
+      if (score > p.score_threshold) out.push_back({score, a0 + k, arg[k]});
+    }
+  }
+}
+
+Box decode(const Image &img, const mnn_detect_params_t &p, int a) {
+  const mnn_tensor_layout_t &l = img.head_layout;
+  const float                x = read_at(img.head, l, 0, a);
+  const float                y = read_at(img.head, l, 1, a);
+  float                      w = read_at(img.head, l, 2, a);
+  float                      h = read_at(img.head, l, 3, a);
+  float                      cx = x, cy = y;
+  if (p.format == MNN_DETECT_SSD) {
+    const float *prior = img.priors + (size_t)a * 4;
+    cx                 = prior[0] + x * p.variances[0] * prior[2];
+    cy                 = prior[1] + y * p.variances[1] * prior[3];
+    w                  = prior[2] * std::exp(w * p.variances[2]);
+    h                  = prior[3] * std::exp(h * p.variances[3]);
+  }
+  return {cx - 0.5f * w, cy - 0.5f * h, cx + 0.5f * w, cy + 0.5f * h};
+}
+
+// Greedy NMS over candidates sorted by score, stops at max_detections.
+int detect_image(
+    const Image &img, const mnn_detect_params_t &p, int cls0, int classes,
+    const mnn_letterbox_t *letterbox, mnn_detection_t *dets
+) {
+  std::vector<Candidate> cands;
+  scan_scores(img, p, cls0, classes, cands);
+  if (p.top_k > 0 && cands.size() > (size_t)p.top_k) {
+    std::nth_element(cands.begin(), cands.begin() + p.top_k, cands.end(), by_score);
+    cands.resize(p.top_k);
+  }
+  std::sort(cands.begin(), cands.end(), by_score);
+
+  std::vector<Box> kept;
+  std::vector<int> kept_cls;
+  kept.reserve(p.max_detections);
+  kept_cls.reserve(p.max_detections);
+  for (const auto &cand : cands) {
+    if ((int)kept.size() >= p.max_detections) break;
+    const Box box        = decode(img, p, cand.anchor);
+    bool      suppressed = false;
+    for (size_t j = 0; j < kept.size() && !suppressed; j++) {
+      if (!p.class_agnostic && kept_cls[j] != cand.cls) continue;
+      suppressed = iou(box, kept[j]) > p.iou_threshold;
+    }
+    if (suppressed) continue;
+    mnn_detection_t &d = dets[kept.size()];
+    kept.push_back(box);
+    kept_cls.push_back(cand.cls);
+    d = {box.x0, box.y0, box.x1, box.y1, cand.score, cand.cls};
+    if (letterbox) {
+      const mnn_letterbox_t &lb = *letterbox;
+      d.x0                      = (d.x0 - lb.pad_x) / lb.scale;
+      d.x1                      = (d.x1 - lb.pad_x) / lb.scale;
+      d.y0                      = (d.y0 - lb.pad_y) / lb.scale;
+      d.y1                      = (d.y1 - lb.pad_y) / lb.scale;
+      if (lb.width > 0.0f) {
+        d.x0 = std::min(std::max(d.x0, 0.0f), lb.width);
+        d.x1 = std::min(std::max(d.x1, 0.0f), lb.width);
+      }
+      if (lb.height > 0.0f) {
+        d.y0 = std::min(std::max(d.y0, 0.0f), lb.height);
+        d.y1 = std::min(std::max(d.y1, 0.0f), lb.height);
+      }
+    }
+  }
+  return (int)kept.size();
+}
+
+
+struct Point {
+  float x, y;
+};
+
+inline float cross(const Point &o, const Point &a, const Point &b) {
+  return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+}
+
+void rotated_corners(const float *r, Point *pts) {
+  const float c = std::cos(r[4]), s = std::sin(r[4]);
+  const float dx[4] = {-0.5f, 0.5f, 0.5f, -0.5f}, dy[4] = {-0.5f, -0.5f, 0.5f, 0.5f};
+  for (int i = 0; i < 4; i++) {
+    const float x = dx[i] * r[2], y = dy[i] * r[3];
+    pts[i]        = {r[0] + c * x - s * y, r[1] + s * x + c * y};
+  }
+}
+
+// Area of the intersection of two convex quads by Sutherland-Hodgman clipping.
+float rotated_intersection(const Point *a, const Point *b) {
+  Point poly[16], next[16];
+  int   n = 4;
+  std::copy(a, a + 4, poly);
+  // corners are in the same winding for both boxes, flip the test if it is clockwise
+  const float orient = cross(b[0], b[1], b[2]) >= 0.0f ? 1.0f : -1.0f;
+  for (int e = 0; e < 4 && n > 0; e++) {
+    const Point &p0 = b[e], &p1 = b[(e + 1) % 4];
+    int          m  = 0;
+    for (int i = 0; i < n; i++) {
+      const Point &cur = poly[i], &prev = poly[(i + n - 1) % n];
+      const float  dc = orient * cross(p0, p1, cur), dp = orient * cross(p0, p1, prev);
+      if ((dc >= 0.0f) != (dp >= 0.0f)) {
+        const float t = dp / (dp - dc);
+        next[m++]     = {prev.x + t * (cur.x - prev.x), prev.y + t * (cur.y - prev.y)};
+      }
+      if (dc >= 0.0f) next[m++] = cur;
+    }
+    n = m;
+    std::copy(next, next + m, poly);
+  }
+  float area = 0.0f;
+  for (int i = 0; i < n; i++) {
+    const Point &p = poly[i], &q = poly[(i + 1) % n];
+    area += p.x * q.y - q.x * p.y;
+  }
+  return std::abs(area) * 0.5f;
+}
+
+float rotated_iou(const float *a, const float *b) {
+  const float area_a = a[2] * a[3], area_b = b[2] * b[3];
+  if (!(area_a > 0.0f) || !(area_b > 0.0f)) return 0.0f;
+  Point pa[4], pb[4];
+  rotated_corners(a, pa);
+  rotated_corners(b, pb);
+  const float inter = rotated_intersection(pa, pb);
+  const float uni   = area_a + area_b - inter;
+  return uni > 0.0f ? std::min(1.0f, inter / uni) : 0.0f;
+}
+
+// Boxes of the candidates in score order, as a structure of arrays, with an index sorted
+// by x0 so that only boxes whose x ranges can overlap are visited.
+struct NmsBoxes {
+  std::vector<float> x0, y0, x1, y1, area;
+  // rotated boxes, x0..y1 hold their axis-aligned bounds
+  std::vector<float> rot;
+  // bounds again in x0 order, scanned sequentially
+  std::vector<int>   by_x;
+  std::vector<float> sx0, sx1, sy0, sy1;
+  float              max_w = 0.0f;
+
+  NmsBoxes(const float *boxes, const std::vector<Candidate> &cands, bool rotated) {
+    const size_t m = cands.size();
+    x0.resize(m), y0.resize(m), x1.resize(m), y1.resize(m), area.resize(m);
+    if (rotated) rot.resize(m * 5);
+    for (size_t i = 0; i < m; i++) {
+      if (rotated) {
+        const float *r = boxes + (size_t)cands[i].anchor * 5;
+        std::copy(r, r + 5, &rot[i * 5]);
+        Point pts[4];
+        rotated_corners(r, pts);
+        x0[i] = x1[i] = pts[0].x;
+        y0[i] = y1[i] = pts[0].y;
+        for (int k = 1; k < 4; k++) {
+          x0[i] = std::min(x0[i], pts[k].x), x1[i] = std::max(x1[i], pts[k].x);
+          y0[i] = std::min(y0[i], pts[k].y), y1[i] = std::max(y1[i], pts[k].y);
+        }
+        area[i] = r[2] * r[3];
+      } else {
+        const float *b = boxes + (size_t)cands[i].anchor * 4;
+        x0[i]          = std::min(b[0], b[2]);
+        y0[i]          = std::min(b[1], b[3]);
+        x1[i]          = std::max(b[0], b[2]);
+        y1[i]          = std::max(b[1], b[3]);
+        area[i]        = (x1[i] - x0[i]) * (y1[i] - y0[i]);
+      }
+      max_w = std::max(max_w, x1[i] - x0[i]);
+    }
+    by_x.resize(m);
+    for (size_t i = 0; i < m; i++) by_x[i] = (int)i;
+    std::sort(by_x.begin(), by_x.end(), [this](int a, int b) { return x0[a] < x0[b]; });
+    sx0.resize(m), sx1.resize(m), sy0.resize(m), sy1.resize(m);
+    for (size_t k = 0; k < m; k++) {
+      const int j = by_x[k];
+      sx0[k] = x0[j], sx1[k] = x1[j], sy0[k] = y0[j], sy1[k] = y1[j];
+    }
+  }
+
+  float iou(size_t i, size_t j) const {
+    const float w = std::min(x1[i], x1[j]) - std::max(x0[i], x0[j]);
+    const float h = std::min(y1[i], y1[j]) - std::max(y0[i], y0[j]);
+    if (w <= 0.0f || h <= 0.0f) return 0.0f;
+    if (!rot.empty()) return rotated_iou(&rot[i * 5], &rot[j * 5]);
+    const float inter = w * h, uni = area[i] + area[j] - inter;
+    return uni > 0.0f ? inter / uni : 0.0f;
+  }
+
+  // Call fn(j) for every box j != i whose bounds can overlap box i.
+  template <typename F>
+  void for_neighbors(size_t i, F fn) const {
+    const float bx0 = x0[i], bx1 = x1[i], by0 = y0[i], by1 = y1[i];
+    const auto  lo  = std::upper_bound(sx0.begin(), sx0.end(), bx0 - max_w) - sx0.begin();
+    const auto  hi  = std::lower_bound(sx0.begin() + lo, sx0.end(), bx1) - sx0.begin();
+    for (auto k = lo; k < hi; k++) {
+      // one rarely taken branch instead of three unpredictable ones
+      const bool hit = (sx1[k] > bx0) & (sy0[k] < by1) & (sy1[k] > by0);
+      if (hit && (size_t)by_x[k] != i) fn((size_t)by_x[k]);
+    }
+  }
+};
+
+// NMS over the candidates of one class, or of all classes if agnostic, of one image.
+void nms_unit(
+    const float *boxes, std::vector<Candidate> &cands, const mnn_nms_params_t &p, int classes,
+    std::vector<mnn_nms_result_t> &out
+) {
+  std::sort(cands.begin(), cands.end(), by_score);
+  const size_t         m = cands.size();
+  const NmsBoxes       nb(boxes, cands, p.rotated);
+  std::vector<uint8_t> alive(m, 1);
+  std::vector<int>     per_class(classes, 0);
+  int                  limit = p.max_detections;
+  if (!p.class_agnostic && p.max_per_class > 0) limit = std::min(limit, p.max_per_class);
+
+  auto accept = [&](size_t i, float score) {
+    const int cls = cands[i].cls;
+    if (p.max_per_class > 0 && per_class[cls] >= p.max_per_class) return false;
+    per_class[cls]++;
+    out.push_back({cands[i].anchor, cls, score});
+    return true;
+  };
+  if (p.method == MNN_NMS_HARD) {
+    for (size_t i = 0; i < m && (int)out.size() < limit; i++) {
+      if (!alive[i] || !accept(i, cands[i].score)) continue;
+      nb.for_neighbors(i, [&](size_t j) {
+        if (j > i && alive[j] && nb.iou(i, j) > p.iou_threshold) alive[j] = 0;
+      });
+    }
+    return;
+  }
+  std::vector<float> score(m);
+  for (size_t i = 0; i < m; i++) score[i] = cands[i].score;
+  while ((int)out.size() < limit) {
+    // decayed scores lose their order, pick the best remaining one each round
+    size_t best = m;
+    for (size_t i = 0; i < m; i++) {
+      if (alive[i] && (best == m || score[i] > score[best])) best = i;
+    }
+    if (best == m) break;
+    alive[best] = 0;
+    if (!accept(best, score[best])) continue;
+    // boxes that do not overlap keep their scores under both decays
+    nb.for_neighbors(best, [&](size_t j) {
+      if (!alive[j]) return;
+      const float v = nb.iou(best, j);
+      if (p.method == MNN_NMS_SOFT_LINEAR) {
+        if (v > p.iou_threshold) score[j] *= 1.0f - v;
+      } else {
+        score[j] *= std::exp(-v * v / p.sigma);
+      }
+      if (!(score[j] > p.score_threshold)) alive[j] = 0;
+    });
+  }
+}
+
+} // namespace
+
+mnn_error_code_t mnn_detect_postprocess(
+    const float               *head,
+    const mnn_tensor_layout_t *head_layout,
+    const float               *scores,
+    const mnn_tensor_layout_t *score_layout,
+    const float               *priors,
+    const mnn_detect_params_t *params,
+    const mnn_letterbox_t     *letterbox,
+    size_t                     num_letterbox,
+    mnn_detection_t           *dets,
+    int32_t                   *counts,
+    int                        num_threads
+) {
+  if (!head || !head_layout || !params || !dets || !counts) return MNNC_INVALID_PTR;
+  if (num_letterbox > 0 && !letterbox) return MNNC_INVALID_PTR;
+  const mnn_detect_params_t &p = *params;
+  const mnn_tensor_layout_t &hl = *head_layout;
+  if (!valid_layout(head_layout) || p.max_detections <= 0) return MNNC_INVALID_VALUE;
+  if (p.activation < MNN_SCORE_NONE || p.activation > MNN_SCORE_SOFTMAX) return MNNC_INVALID_VALUE;
+  if (num_letterbox > 1 && num_letterbox != (size_t)hl.batch) return MNNC_INVALID_VALUE;
+  for (size_t i = 0; i < num_letterbox; i++) {
+    if (!(letterbox[i].scale > 0.0f)) return MNNC_INVALID_VALUE;
+  }
+
+  const mnn_tensor_layout_t *sl = head_layout;
+  const float               *sd = head;
+  int                        cls0;
+  switch (p.format) {
+  case MNN_DETECT_YOLO: cls0 = 4; break;
+  case MNN_DETECT_YOLO_OBJ: cls0 = 5; break;
+  case MNN_DETECT_SSD:
+    if (!scores || !score_layout || !priors) return MNNC_INVALID_PTR;
+    if (!valid_layout(score_layout) || hl.channel != 4) return MNNC_INVALID_VALUE;
+    if (score_layout->batch != hl.batch || score_layout->area != hl.area) {
+      return MNNC_INVALID_VALUE;
+    }
+    sl   = score_layout;
+    sd   = scores;
+    cls0 = 0;
+    break;
+  default: return MNNC_INVALID_VALUE;
+  }
+  const int classes = sl->channel - cls0;
+  if (classes <= 0 || hl.channel < 4) return MNNC_INVALID_VALUE;
+  if (p.background_class < -1 || p.background_class >= classes) return MNNC_INVALID_VALUE;
+
+  try {
+    const int tasks = mnnc::parallel_tasks((size_t)hl.batch, 1, num_threads);
+
+    auto ok = mnnc::parallel_for((size_t)hl.batch, tasks, [&](size_t begin, size_t end, int) {
+      for (size_t n = begin; n < end; n++) {
+        const Image img{head + n * hl.batch_stride, sd + n * sl->batch_stride, hl, *sl, priors};
+        const mnn_letterbox_t *lb = num_letterbox == 0   ? nullptr
+                                    : num_letterbox == 1 ? letterbox
+                                                         : letterbox + n;
+        counts[n] = detect_image(img, p, cls0, classes, lb, dets + n * p.max_detections);
+      }
+    });
+    return ok ? MNNC_NO_ERROR : MNNC_UNKNOWN_ERROR;
+  } catch (...) { return MNNC_UNKNOWN_ERROR; }
+}
+
+mnn_error_code_t mnn_nms_batched(
+    const float            *boxes,
+    const float            *scores,
+    int                     batch,
+    int                     num_boxes,
+    int                     num_classes,
+    const mnn_nms_params_t *params,
+    mnn_nms_result_t       *results,
+    int32_t                *counts,
+    int                     num_threads
+) {
+  if (!boxes || !scores || !params || !results || !counts) return MNNC_INVALID_PTR;
+  const mnn_nms_params_t &p = *params;
+  if (batch < 0 || num_boxes < 0 || num_classes <= 0 || p.max_detections <= 0) {
+    return MNNC_INVALID_VALUE;
+  }
+  if (p.method < MNN_NMS_HARD || p.method > MNN_NMS_SOFT_GAUSSIAN) return MNNC_INVALID_VALUE;
+  if (p.method == MNN_NMS_SOFT_GAUSSIAN && !(p.sigma > 0.0f)) return MNNC_INVALID_VALUE;
+  try {
+    const int    groups = p.class_agnostic ? 1 : num_classes;
+    const size_t units  = (size_t)batch * groups;
+    const size_t dim    = p.rotated ? 5 : 4;
+    // every class of every image is an independent unit
+    std::vector<std::vector<mnn_nms_result_t>> kept(units);
+    const size_t work  = (size_t)batch * num_boxes * num_classes;
+    const int    tasks = mnnc::parallel_tasks(units, 1, work < (1 << 14) ? 1 : num_threads);
+
+    auto ok = mnnc::parallel_for(units, tasks, [&](size_t begin, size_t end, int) {
+      std::vector<Candidate> cands;
+      for (size_t u = begin; u < end; u++) {
+        const size_t n  = u / groups;
+        const int    c0 = p.class_agnostic ? 0 : (int)(u % groups);
+        const int    c1 = p.class_agnostic ? num_classes : c0 + 1;
+        const float *s  = scores + n * num_boxes * num_classes;
+        cands.clear();
+        for (int b = 0; b < num_boxes; b++) {
+          for (int c = c0; c < c1; c++) {
+            const float v = s[(size_t)b * num_classes + c];
+            if (v > p.score_threshold) cands.push_back({v, b, c});
+          }
+        }
+        nms_unit(boxes + n * num_boxes * dim, cands, p, num_classes, kept[u]);
+      }
+    });
+    if (!ok) return MNNC_UNKNOWN_ERROR;
+    for (int n = 0; n < batch; n++) {
+      std::vector<mnn_nms_result_t> merged;
+      for (int g = 0; g < groups; g++) {
+        const auto &k = kept[(size_t)n * groups + g];
+        merged.insert(merged.end(), k.begin(), k.end());
+      }
+      const size_t count = std::min(merged.size(), (size_t)p.max_detections);
+      std::partial_sort(
+          merged.begin(),
+          merged.begin() + count,
+          merged.end(),
+          [](const mnn_nms_result_t &a, const mnn_nms_result_t &b) {
+            return a.score > b.score || (a.score == b.score && a.box_index < b.box_index);
+          }
+      );
+      std::copy(merged.begin(), merged.begin() + count, results + (size_t)n * p.max_detections);
+      counts[n] = (int32_t)count;
+    }
+    return MNNC_NO_ERROR;
+  } catch (...) { return MNNC_UNKNOWN_ERROR; }
+}
+
+float mnn_rotated_iou(const float *a, const float *b) {
+  if (!a || !b) return 0.0f;
+  return rotated_iou(a, b);
+}
@@ -0,0 +1,318 @@
+/*
+ * dynamic_batcher.cpp
+ * MNN C API for dynamic batching of module requests
+ *
+ * Author: Rainyl
+ * License: Apache License 2.0
+ */
+
+#include "mnn_c/dynamic_batcher.h"
+#include "MNN/expr/Executor.hpp"
+#include "MNN/expr/ExecutorScope.hpp"
+#include "MNN/expr/Expr.hpp"
+#include "MNN/expr/Module.hpp"
+#include "MNN/expr/NeuralNetWorkOp.hpp"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using MNN::Express::Executor;
+using MNN::Express::ExecutorScope;
+using MNN::Express::Module;
+using MNN::Express::VARP;
+using MNN::Express::Variable;
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+uint64_t elapsed_ns(Clock::time_point from, Clock::time_point to) {
+  return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(to - from).count();
+}
+
+struct Request {
+  std::vector<VARP>              inputs;
+  // format, type and shape except axis 0 of every input, requests batch when equal
+  std::vector<int>               signature;
+  int                            rows;
+  Clock::time_point              enqueued;
+  VecVARP_t                     *outputs;
+  mnn_callback_0                 callback;
+  std::promise<mnn_error_code_t> done;
+};
+
+// Rows of all inputs along axis 0 and the batching signature, rows is 0 if the inputs can
+// not be batched.
+int inspect(const std::vector<VARP> &inputs, std::vector<int> &signature) {
+  int rows = 0;
+  for (const auto &input : inputs) {
+    auto info = input.get() ? input->getInfo() : nullptr;
+    if (!info || info->dim.empty()) return 0;
+    if (rows != 0 && info->dim[0] != rows) return 0;
+    rows = info->dim[0];
+    signature.push_back((int)info->order);
+    signature.push_back((int)info->type.code);
+    signature.push_back((int)info->type.bits);
+    signature.push_back((int)info->dim.size());
+    signature.insert(signature.end(), info->dim.begin() + 1, info->dim.end());
+  }
+  return rows;
+}
+
+} // namespace
+
+struct mnn_dynamic_batcher {
+  mnn_dynamic_batcher(int max_batch, uint64_t max_delay_us)
+      : max_batch(max_batch),
+        max_delay(std::chrono::microseconds(max_delay_us)),
+        histogram(max_batch, 0) {}
+
+  ~mnn_dynamic_batcher() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopped = true;
+    }
+    cv.notify_all();
+    if (worker.joinable()) worker.join();
+  }
+
+  void push(std::unique_ptr<Request> request) {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      queue.push_back(std::move(request));
+    }
+    cv.notify_one();
+  }
+
+  // Rows queued that can join the batch of the oldest request, with the lock held.
+  int batchable_rows() const {
+    int rows = 0;
+    for (const auto &r : queue) {
+      if (r->signature == queue.front()->signature) rows += r->rows;
+      if (rows >= max_batch) break;
+    }
+    return rows;
+  }
+
+  // Wait until the batch of the oldest request is full or its delay expires, then take the
+  // compatible requests in arrival order. Empty once stopped and drained.
+  std::vector<std::unique_ptr<Request>> next_batch() {
+    std::unique_lock<std::mutex> lock(mutex);
+    cv.wait(lock, [this] { return !queue.empty() || stopped; });
+    std::vector<std::unique_ptr<Request>> batch;
+    if (queue.empty()) return batch;
+    const Clock::time_point deadline = queue.front()->enqueued + max_delay;
+    while (!stopped && batchable_rows() < max_batch) {
+      if (cv.wait_until(lock, deadline) == std::cv_status::timeout) break;
+    }
+    const std::vector<int> signature = queue.front()->signature;
+    int                    rows      = 0;
+    for (auto it = queue.begin(); it != queue.end() && rows < max_batch;) {
+      if ((*it)->signature == signature && rows + (*it)->rows <= max_batch) {
+        rows += (*it)->rows;
+        batch.push_back(std::move(*it));
+        it = queue.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    return batch;
+  }
+
+  // One onForward over the concatenated inputs, outputs with the batch on axis 0 are split
+  // back, the others are shared by every request.
+  bool forward(Module *clone, std::vector<std::unique_ptr<Request>> &batch, int rows) {
+    std::vector<VARP> inputs = batch[0]->inputs;
+    if (batch.size() > 1) {
+      for (size_t i = 0; i < inputs.size(); i++) {
+        std::vector<VARP> parts;
+        for (const auto &r : batch) parts.push_back(r->inputs[i]);
+        inputs[i] = MNN::Express::_Concat(parts, 0);
+      }
+    }
+    auto outputs = clone->onForward(inputs);
+    if (outputs.empty()) return false;
+    std::vector<int>               splits;
+    std::vector<std::vector<VARP>> results(batch.size());
+    std::vector<VARP>              all;
+    for (const auto &r : batch) splits.push_back(r->rows);
+    for (auto &output : outputs) {
+      auto info = output.get() ? output->getInfo() : nullptr;
+      if (!info) return false;
+      if (batch.size() > 1 && !info->dim.empty() && info->dim[0] == rows) {
+        auto parts = MNN::Express::_Split(output, splits, 0);
+        for (size_t k = 0; k < batch.size(); k++) results[k].push_back(parts[k]);
+        all.insert(all.end(), parts.begin(), parts.end());
+      } else {
+        for (auto &result : results) result.push_back(output);
+        all.push_back(output);
+      }
+    }
+    Variable::compute(all);
+    for (size_t k = 0; k < batch.size(); k++) {
+      *batch[k]->outputs = new std::vector<VARP>(std::move(results[k]));
+    }
+    return true;
+  }
+
+  void serve(Module *clone, std::vector<std::unique_ptr<Request>> &batch) {
+    const Clock::time_point start = Clock::now();
+    int                     rows  = 0;
+    for (auto &r : batch) {
+      rows += r->rows;
+      *r->outputs = nullptr;
+    }
+    mnn_error_code_t code = MNNC_UNKNOWN_ERROR;
+    try {
+      if (forward(clone, batch, rows)) code = MNNC_NO_ERROR;
+    } catch (...) {}
+    if (code != MNNC_NO_ERROR) {
+      for (auto &r : batch) {
+        mnn_expr_VecVARP_free(*r->outputs);
+        *r->outputs = nullptr;
+      }
+    }
+    {
+      std::lock_guard<std::mutex> lock(stats_mutex);
+      for (auto &r : batch) {
+        const uint64_t delay = elapsed_ns(r->enqueued, start);
+        stats.queue_delay_ns += delay;
+        if (delay > stats.max_queue_delay_ns) stats.max_queue_delay_ns = delay;
+      }
+      stats.requests += batch.size();
+      stats.batches++;
+      histogram[std::min(rows, max_batch) - 1]++;
+    }
+    for (auto &r : batch) {
+      r->inputs.clear();
+      if (r->callback) {
+        r->callback();
+      } else {
+        r->done.set_value(code);
+      }
+    }
+  }
+
+  void run(Module *master, std::shared_ptr<Executor> executor, std::promise<bool> *ready) {
+    ExecutorScope scope(executor);
+    Module       *clone = Module::clone(master, true);
+    ready->set_value(clone != nullptr);
+    if (!clone) return;
+    for (;;) {
+      auto batch = next_batch();
+      if (batch.empty()) break;
+      serve(clone, batch);
+    }
+    Module::destroy(clone);
+  }
+
+  const int                            max_batch;
+  const Clock::duration                max_delay;
+  std::mutex                           mutex;
+  std::condition_variable              cv;
+  std::deque<std::unique_ptr<Request>> queue;
+  bool                                 stopped = false;
+  std::mutex                           stats_mutex;
+  mnn_dynamic_batcher_stats_t          stats = {0, 0, 0, 0};
+  std::vector<uint64_t>                histogram;
+  std::thread                          worker;
+};
+
+mnn_dynamic_batcher_t mnn_dynamic_batcher_create(
+    mnn_module_t         module,
+    int                  type,
+    mnn_backend_config_t config,
+    int                  num_thread,
+    int                  max_batch,
+    uint64_t             max_delay_us
+) {
+  if (!module || max_batch < 1) return nullptr;
+  MNN::BackendConfig _config;
+  _config.memory        = static_cast<MNN::BackendConfig::MemoryMode>(config.memory);
+  _config.power         = static_cast<MNN::BackendConfig::PowerMode>(config.power);
+  _config.precision     = static_cast<MNN::BackendConfig::PrecisionMode>(config.precision);
+  _config.sharedContext = config.sharedContext;
+  _config.flags         = config.flags;
+  try {
+    std::unique_ptr<mnn_dynamic_batcher> self(new mnn_dynamic_batcher(max_batch, max_delay_us));
+    auto executor = Executor::newExecutor(static_cast<MNNForwardType>(type), _config, num_thread);
+    std::promise<bool> ready;
+    auto               cloned = ready.get_future();
+    self->worker = std::thread(&mnn_dynamic_batcher::run, self.get(), module, executor, &ready);
+    if (!cloned.get()) return nullptr;
+    return self.release();
+  } catch (...) { return nullptr; }
+}
+
+void mnn_dynamic_batcher_destroy(mnn_dynamic_batcher_t self) {
+  if (self) {
+    delete self;
+    self = nullptr;
+  }
+}
+
+int mnn_dynamic_batcher_max_batch(mnn_dynamic_batcher_t self) {
+  return self ? self->max_batch : 0;
+}
+
+mnn_error_code_t mnn_dynamic_batcher_forward(
+    mnn_dynamic_batcher_t self, VecVARP_t inputs, VecVARP_t *outputs, mnn_callback_0 callback
+) {
+  mnn_error_code_t code = MNNC_NO_ERROR;
+  try {
+    if (!self || !inputs || !outputs) {
+      code = MNNC_INVALID_PTR;
+    } else {
+      *outputs = nullptr;
+      std::unique_ptr<Request> request(new Request());
+      request->inputs   = *inputs;
+      request->rows     = inspect(request->inputs, request->signature);
+      request->outputs  = outputs;
+      request->callback = callback;
+      if (request->rows < 1 || request->rows > self->max_batch) {
+        code = MNNC_INVALID_VALUE;
+      } else {
+        request->enqueued = Clock::now();
+        if (callback) {
+          self->push(std::move(request));
+          return MNNC_NO_ERROR;
+        }
+        auto done = request->done.get_future();
+        self->push(std::move(request));
+        return done.get();
+      }
+    }
+  } catch (...) { code = MNNC_UNKNOWN_ERROR; }
+  if (callback) callback();
+  return code;
+}
+
+size_t mnn_dynamic_batcher_pending(mnn_dynamic_batcher_t self) {
+  if (!self) return 0;
+  std::lock_guard<std::mutex> lock(self->mutex);
+  return self->queue.size();
+}
+
+mnn_error_code_t
+mnn_dynamic_batcher_get_stats(mnn_dynamic_batcher_t self, mnn_dynamic_batcher_stats_t *stats) {
+  if (!self || !stats) return MNNC_INVALID_PTR;
+  std::lock_guard<std::mutex> lock(self->stats_mutex);
+  *stats = self->stats;
+  return MNNC_NO_ERROR;
+}
+
+mnn_error_code_t
+mnn_dynamic_batcher_get_histogram(mnn_dynamic_batcher_t self, uint64_t *counts, size_t size) {
+  if (!self || (!counts && size > 0)) return MNNC_INVALID_PTR;
+  std::lock_guard<std::mutex> lock(self->stats_mutex);
+  for (size_t i = 0; i < size; i++) {
+    counts[i] = i < self->histogram.size() ? self->histogram[i] : 0;
+  }
+  return MNNC_NO_ERROR;
+}
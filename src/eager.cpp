@@ -0,0 +1,315 @@
+/*
+ * eager.cpp
+ * MNN C API for eager evaluation of small tensors
+ *
+ * Author: Rainyl
+ * License: Apache License 2.0
+ */
+
+#include "mnn_c/eager.h"
+#include "MNN/expr/ExprCreator.hpp"
+#include "eager.hpp"
+#include "mnn_c/expr_graph.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+using namespace MNN::Express;
+
+namespace {
+
+// per thread, so scoped changes on one thread never leak into another
+thread_local size_t t_threshold = 0;
+
+enum DType { kOther, kF32, kI32 };
+
+struct Operand {
+  const void     *data;
+  INTS            dims;
+  Dimensionformat order;
+  DType           type;
+  size_t          size;
+};
+
+DType dtype_of(halide_type_t t) {
+  if (t.lanes != 1) return kOther;
+  if (t.code == halide_type_float && t.bits == 32) return kF32;
+  if (t.code == halide_type_int && t.bits == 32) return kI32;
+  return kOther;
+}
+
+// Only constants hold their data on host without evaluating the graph.
+bool load(const VARP &v, Operand &o) {
+  const size_t limit = t_threshold;
+  if (limit == 0 || v.get() == nullptr) return false;
+  auto expr = v->expr().first;
+  if (!expr || expr->get() != nullptr || expr->inputType() != VARP::CONSTANT) return false;
+  auto info = v->getInfo();
+  if (!info || info->order == NC4HW4 || info->size == 0 || info->size > limit) return false;
+  o.type = dtype_of(info->type);
+  if (o.type == kOther) return false;
+  o.data = v->readMap<void>();
+  if (!o.data) return false;
+  o.dims  = info->dim;
+  o.order = info->order;
+  o.size  = info->size;
+  return true;
+}
+
+std::vector<int> contiguous_strides(const INTS &dims) {
+  std::vector<int> strides(dims.size(), 1);
+  for (int i = (int)dims.size() - 2; i >= 0; i--) strides[i] = strides[i + 1] * dims[i + 1];
+  return strides;
+}
+
+// numpy-style broadcast of two shapes, strides are in elements and 0 on broadcast dims
+struct Broadcast {
+  INTS             dims;
+  std::vector<int> sa, sb;
+  size_t           size = 1;
+
+  bool init(const INTS &a, const INTS &b) {
+    const int nd = (int)std::max(a.size(), b.size());
+    dims.assign(nd, 1);
+    sa.assign(nd, 0);
+    sb.assign(nd, 0);
+    auto ca = contiguous_strides(a), cb = contiguous_strides(b);
+    for (int i = 0; i < nd; i++) {
+      const int ia = i - (nd - (int)a.size()), ib = i - (nd - (int)b.size());
+      const int da = ia >= 0 ? a[ia] : 1, db = ib >= 0 ? b[ib] : 1;
+      if (da != db && da != 1 && db != 1) return false;
+      dims[i] = std::max(da, db);
+      if (da != 1) sa[i] = ca[ia];
+      if (db != 1) sb[i] = cb[ib];
+      size *= dims[i];
+    }
+    return true;
+  }
+};
+
+// The contiguous paths are plain loops the compiler vectorizes.
+template <typename T, typename R, typename F>
+void binary_loop(const T *a, const T *b, R *o, const Broadcast &bc, size_t na, size_t nb, F f) {
+  const size_t n = bc.size;
+  if (na == n && nb == n) {
+    for (size_t i = 0; i < n; i++) o[i] = f(a[i], b[i]);
+    return;
+  }
+  if (na == n && nb == 1) {
+    const T v = b[0];
+    for (size_t i = 0; i < n; i++) o[i] = f(a[i], v);
+    return;
+  }
+  if (na == 1 && nb == n) {
+    const T v = a[0];
+    for (size_t i = 0; i < n; i++) o[i] = f(v, b[i]);
+    return;
+  }
+  const int        nd    = (int)bc.dims.size();
+  const int        inner = bc.dims[nd - 1];
+  const int        ia = bc.sa[nd - 1], ib = bc.sb[nd - 1];
+  std::vector<int> idx(nd, 0);
+  for (size_t base = 0; base < n; base += inner) {
+    size_t offa = 0, offb = 0;
+    for (int d = 0; d < nd - 1; d++) {
+      offa += (size_t)idx[d] * bc.sa[d];
+      offb += (size_t)idx[d] * bc.sb[d];
+    }
+    for (int j = 0; j < inner; j++) o[base + j] = f(a[offa + j * ia], b[offb + j * ib]);
+    for (int d = nd - 2; d >= 0 && ++idx[d] == bc.dims[d]; d--) idx[d] = 0;
+  }
+}
+
+template <typename R, typename T, typename F>
+VARP binary_const(
+    const Operand &x, const Operand &y, const Broadcast &bc, Dimensionformat order, F f
+) {
+  std::vector<R> o(bc.size);
+  binary_loop((const T *)x.data, (const T *)y.data, o.data(), bc, x.size, y.size, f);
+  return _Const(o.data(), bc.dims, order, halide_type_of<R>());
+}
+
+template <typename T>
+VARP binary_compare(
+    int op, const Operand &x, const Operand &y, const Broadcast &bc, Dimensionformat order
+) {
+  switch (op) {
+  case MNN_EXPR_OP_GREATER:
+    return binary_const<int32_t, T>(x, y, bc, order, [](T p, T q) { return (int32_t)(p > q); });
+  case MNN_EXPR_OP_GREATER_EQUAL:
+    return binary_const<int32_t, T>(x, y, bc, order, [](T p, T q) { return (int32_t)(p >= q); });
+  case MNN_EXPR_OP_LESS:
+    return binary_const<int32_t, T>(x, y, bc, order, [](T p, T q) { return (int32_t)(p < q); });
+  case MNN_EXPR_OP_LESS_EQUAL:
+    return binary_const<int32_t, T>(x, y, bc, order, [](T p, T q) { return (int32_t)(p <= q); });
+  case MNN_EXPR_OP_EQUAL:
+    return binary_const<int32_t, T>(x, y, bc, order, [](T p, T q) { return (int32_t)(p == q); });
+  default: return nullptr;
+  }
+}
+
+VARP binary_f32(
+    int op, const Operand &x, const Operand &y, const Broadcast &bc, Dimensionformat order
+) {
+  typedef float T;
+  switch (op) {
+  case MNN_EXPR_OP_ADD: return binary_const<T, T>(x, y, bc, order, [](T p, T q) { return p + q; });
+  case MNN_EXPR_OP_SUB: return binary_const<T, T>(x, y, bc, order, [](T p, T q) { return p - q; });
+  case MNN_EXPR_OP_MUL: return binary_const<T, T>(x, y, bc, order, [](T p, T q) { return p * q; });
+  case MNN_EXPR_OP_DIV: return binary_const<T, T>(x, y, bc, order, [](T p, T q) { return p / q; });
+  case MNN_EXPR_OP_POW:
+    return binary_const<T, T>(x, y, bc, order, [](T p, T q) { return std::pow(p, q); });
+  case MNN_EXPR_OP_MAXIMUM:
+    return binary_const<T, T>(x, y, bc, order, [](T p, T q) { return p > q ? p : q; });
+  case MNN_EXPR_OP_MINIMUM:
+    return binary_const<T, T>(x, y, bc, order, [](T p, T q) { return p < q ? p : q; });
+  default: return binary_compare<T>(op, x, y, bc, order);
+  }
+}
+
+// integer division and power follow MNN's own rounding rules, they are left to the graph
+VARP binary_i32(
+    int op, const Operand &x, const Operand &y, const Broadcast &bc, Dimensionformat order
+) {
+  typedef int32_t  T;
+  typedef uint32_t U;
+  switch (op) {
+  case MNN_EXPR_OP_ADD:
+    return binary_const<T, T>(x, y, bc, order, [](T p, T q) { return (T)((U)p + (U)q); });
+  case MNN_EXPR_OP_SUB:
+    return binary_const<T, T>(x, y, bc, order, [](T p, T q) { return (T)((U)p - (U)q); });
+  case MNN_EXPR_OP_MUL:
+    return binary_const<T, T>(x, y, bc, order, [](T p, T q) { return (T)((U)p * (U)q); });
+  case MNN_EXPR_OP_MAXIMUM:
+    return binary_const<T, T>(x, y, bc, order, [](T p, T q) { return p > q ? p : q; });
+  case MNN_EXPR_OP_MINIMUM:
+    return binary_const<T, T>(x, y, bc, order, [](T p, T q) { return p < q ? p : q; });
+  default: return binary_compare<T>(op, x, y, bc, order);
+  }
+}
+
+template <typename T, typename F>
+VARP unary_const(const Operand &x, F f) {
+  const T       *a = (const T *)x.data;
+  std::vector<T> o(x.size);
+  for (size_t i = 0; i < x.size; i++) o[i] = f(a[i]);
+  return _Const(o.data(), x.dims, x.order, halide_type_of<T>());
+}
+
+VARP unary_f32(int op, const Operand &x) {
+  typedef float T;
+  switch (op) {
+  case MNN_EXPR_OP_NEG: return unary_const<T>(x, [](T v) { return -v; });
+  case MNN_EXPR_OP_ABS: return unary_const<T>(x, [](T v) { return std::fabs(v); });
+  case MNN_EXPR_OP_EXP: return unary_const<T>(x, [](T v) { return std::exp(v); });
+  case MNN_EXPR_OP_LOG: return unary_const<T>(x, [](T v) { return std::log(v); });
+  case MNN_EXPR_OP_SQRT: return unary_const<T>(x, [](T v) { return std::sqrt(v); });
+  case MNN_EXPR_OP_SQUARE: return unary_const<T>(x, [](T v) { return v * v; });
+  case MNN_EXPR_OP_SIGMOID:
+    return unary_const<T>(x, [](T v) { return 1.f / (1.f + std::exp(-v)); });
+  case MNN_EXPR_OP_TANH: return unary_const<T>(x, [](T v) { return std::tanh(v); });
+  case MNN_EXPR_OP_RELU: return unary_const<T>(x, [](T v) { return v > 0.f ? v : 0.f; });
+  case MNN_EXPR_OP_FLOOR: return unary_const<T>(x, [](T v) { return std::floor(v); });
+  case MNN_EXPR_OP_CEIL: return unary_const<T>(x, [](T v) { return std::ceil(v); });
+  default: return nullptr;
+  }
+}
+
+VARP unary_i32(int op, const Operand &x) {
+  typedef int32_t  T;
+  typedef uint32_t U;
+  switch (op) {
+  case MNN_EXPR_OP_NEG: return unary_const<T>(x, [](T v) { return (T)(0u - (U)v); });
+  case MNN_EXPR_OP_ABS: return unary_const<T>(x, [](T v) { return v < 0 ? (T)(0u - (U)v) : v; });
+  case MNN_EXPR_OP_SQUARE: return unary_const<T>(x, [](T v) { return (T)((U)v * (U)v); });
+  default: return nullptr;
+  }
+}
+
+template <typename T>
+VARP reduce_typed(int op, const Operand &x, const std::vector<bool> &reduced, bool keep_dims) {
+  const int        nd = (int)x.dims.size();
+  INTS             out_dims;
+  std::vector<int> out_strides(nd, 0);
+  size_t           m = 1;
+  for (int d = nd - 1; d >= 0; d--) {
+    if (reduced[d]) continue;
+    out_strides[d] = (int)m;
+    m *= x.dims[d];
+  }
+  for (int d = 0; d < nd; d++) {
+    if (!reduced[d]) out_dims.push_back(x.dims[d]);
+    else if (keep_dims) out_dims.push_back(1);
+  }
+
+  T init = 0;
+  if (op == MNN_EXPR_OP_REDUCE_MAX) init = std::numeric_limits<T>::lowest();
+  if (op == MNN_EXPR_OP_REDUCE_MIN) init = std::numeric_limits<T>::max();
+  std::vector<T>   o(m, init);
+  const T         *a = (const T *)x.data;
+  std::vector<int> idx(nd, 0);
+  for (size_t i = 0; i < x.size; i++) {
+    size_t off = 0;
+    for (int d = 0; d < nd; d++) off += (size_t)idx[d] * out_strides[d];
+    const T v = a[i];
+    switch (op) {
+    case MNN_EXPR_OP_REDUCE_MAX: o[off] = std::max(o[off], v); break;
+    case MNN_EXPR_OP_REDUCE_MIN: o[off] = std::min(o[off], v); break;
+    default: o[off] += v; break;
+    }
+    for (int d = nd - 1; d >= 0 && ++idx[d] == x.dims[d]; d--) idx[d] = 0;
+  }
+  if (op == MNN_EXPR_OP_REDUCE_MEAN) {
+    const T count = (T)(x.size / m);
+    for (size_t i = 0; i < m; i++) o[i] /= count;
+  }
+  return _Const(o.data(), out_dims, x.order, halide_type_of<T>());
+}
+
+} // namespace
+
+void mnn_expr_set_eager_threshold(size_t max_elements) {
+  t_threshold = max_elements;
+}
+
+size_t mnn_expr_get_eager_threshold() { return t_threshold; }
+
+namespace mnnc {
+
+VARP eager_binary(int op, const VARP &x, const VARP &y) {
+  Operand a, b;
+  if (!load(x, a) || !load(y, b) || a.type != b.type) return nullptr;
+  Dimensionformat order = a.order;
+  if (a.dims.empty()) order = b.order;
+  else if (!b.dims.empty() && a.order != b.order) return nullptr;
+  Broadcast bc;
+  if (!bc.init(a.dims, b.dims)) return nullptr;
+  return a.type == kF32 ? binary_f32(op, a, b, bc, order) : binary_i32(op, a, b, bc, order);
+}
+
+VARP eager_unary(int op, const VARP &x) {
+  Operand a;
+  if (!load(x, a)) return nullptr;
+  return a.type == kF32 ? unary_f32(op, a) : unary_i32(op, a);
+}
+
+VARP eager_reduce(int op, const VARP &x, const std::vector<int> &axes, bool keep_dims) {
+  if (op < MNN_EXPR_OP_REDUCE_SUM || op > MNN_EXPR_OP_REDUCE_MIN) return nullptr;
+  Operand a;
+  if (!load(x, a)) return nullptr;
+  const int         nd = (int)a.dims.size();
+  std::vector<bool> reduced(nd, axes.empty());
+  for (int axis : axes) {
+    if (axis < 0) axis += nd;
+    if (axis < 0 || axis >= nd) return nullptr;
+    reduced[axis] = true;
+  }
+  if (a.type == kF32) return reduce_typed<float>(op, a, reduced, keep_dims);
+  // integer mean rounds as MNN does, leave it to the graph
+  if (op == MNN_EXPR_OP_REDUCE_MEAN) return nullptr;
+  return reduce_typed<int32_t>(op, a, reduced, keep_dims);
+}
+
+} // namespace mnnc
@@ -0,0 +1,29 @@
+/*
+ * eager.hpp
+ * Internal host kernels evaluating ops on small constant variables
+ *
+ * Author: Rainyl
+ * License: Apache License 2.0
+ */
+
+#ifndef MNN_C_EAGER_HPP
+#define MNN_C_EAGER_HPP
+
+#include "MNN/expr/Expr.hpp"
+#include <vector>
+
+namespace mnnc {
+
+// Each function returns a constant computed on host memory, or an empty VARP if eager
+// evaluation is disabled or the inputs are not eligible, `op` is a mnn_expr_opcode_t.
+
+MNN::Express::VARP eager_binary(int op, const MNN::Express::VARP &x, const MNN::Express::VARP &y);
+
+MNN::Express::VARP eager_unary(int op, const MNN::Express::VARP &x);
+
+MNN::Express::VARP
+eager_reduce(int op, const MNN::Express::VARP &x, const std::vector<int> &axes, bool keep_dims);
+
+} // namespace mnnc
+
+#endif // MNN_C_EAGER_HPP
@@ -0,0 +1,517 @@
+/*
+ * einsum.cpp
+ * MNN C API for Einstein summation over expression variables
+ *
+ * Author: Rainyl
+ * License: Apache License 2.0
+ */
+
+#include "mnn_c/einsum.h"
+#include "MNN/expr/Expr.hpp"
+#include "MNN/expr/MathOp.hpp"
+#include "MNN/expr/NeuralNetWorkOp.hpp"
+#include "expr_arena.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+using MNN::Express::VARP;
+
+namespace {
+
+// Labels are letters, the dims covered by an ellipsis get labels from kEllipsis on,
+// aligned to the right like numpy broadcasting.
+const int kEllipsis = 256;
+
+typedef std::vector<int> Labels;
+
+struct Term {
+  VARP             var;
+  Labels           labels;
+  std::vector<int> dims;
+};
+
+bool is_label(char c) { return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z'); }
+
+// Split "ab...,c->..." into the input terms and the output term, the output is empty
+// and has_output false if there is no arrow.
+bool split_subscripts(
+    const std::string &s, std::vector<std::string> &inputs, std::string &output, bool &has_output
+) {
+  std::string spec;
+  for (char c : s) {
+    if (c != ' ') spec.push_back(c);
+  }
+  size_t arrow = spec.find("->");
+  has_output   = arrow != std::string::npos;
+  std::string lhs = has_output ? spec.substr(0, arrow) : spec;
+  output          = has_output ? spec.substr(arrow + 2) : "";
+  if (output.find("->") != std::string::npos) return false;
+  inputs.clear();
+  size_t start = 0;
+  for (;;) {
+    size_t comma = lhs.find(',', start);
+    inputs.push_back(lhs.substr(start, comma == std::string::npos ? comma : comma - start));
+    if (comma == std::string::npos) break;
+    start = comma + 1;
+  }
+  return true;
+}
+
+// Parse one term into labels, `ndim` < 0 for the output. Returns the number of ellipsis
+// dims through `ellipsis` (-1 if there is no ellipsis).
+bool parse_term(
+    const std::string &term, int ndim, int max_ellipsis, Labels &labels, int &ellipsis
+) {
+  labels.clear();
+  ellipsis = -1;
+  int letters = 0;
+  for (size_t i = 0; i < term.size(); i++) {
+    if (term[i] == '.') {
+      if (ellipsis >= 0 || term.compare(i, 3, "...") != 0) return false;
+      ellipsis = 0;
+      i += 2;
+    } else if (is_label(term[i])) {
+      letters++;
+    } else {
+      return false;
+    }
+  }
+  if (ellipsis >= 0) {
+    ellipsis = ndim >= 0 ? ndim - letters : max_ellipsis;
+    if (ellipsis < 0) return false;
+  } else if (ndim >= 0 && letters != ndim) {
+    return false;
+  }
+  for (size_t i = 0; i < term.size(); i++) {
+    if (term[i] == '.') {
+      for (int k = 0; k < ellipsis; k++) labels.push_back(kEllipsis + max_ellipsis - ellipsis + k);
+      i += 2;
+    } else {
+      labels.push_back((int)(unsigned char)term[i]);
+    }
+  }
+  return true;
+}
+
+bool contains(const Labels &labels, int l) {
+  return std::find(labels.begin(), labels.end(), l) != labels.end();
+}
+
+Labels concat(Labels a, const Labels &b) {
+  a.insert(a.end(), b.begin(), b.end());
+  return a;
+}
+
+int64_t product(const std::vector<int> &dims) {
+  int64_t n = 1;
+  for (int d : dims) n *= d;
+  return n;
+}
+
+VARP transpose_to(const Term &t, const Labels &order) {
+  std::vector<int> perm;
+  bool             identity = true;
+  for (size_t i = 0; i < order.size(); i++) {
+    int axis = (int)(std::find(t.labels.begin(), t.labels.end(), order[i]) - t.labels.begin());
+    perm.push_back(axis);
+    identity = identity && axis == (int)i;
+  }
+  return identity ? t.var : MNN::Express::_Transpose(t.var, perm);
+}
+
+VARP reshape_to(const VARP &x, const std::vector<int> &from, const std::vector<int> &to) {
+  return from == to ? x : MNN::Express::_Reshape(x, to, MNN::Express::NCHW);
+}
+
+// Sum the axes whose labels are not in `keep`.
+void reduce_except(Term &t, const Labels &keep) {
+  std::vector<int> axes;
+  Labels           labels;
+  std::vector<int> dims;
+  for (size_t i = 0; i < t.labels.size(); i++) {
+    if (contains(keep, t.labels[i])) {
+      labels.push_back(t.labels[i]);
+      dims.push_back(t.dims[i]);
+    } else {
+      axes.push_back((int)i);
+    }
+  }
+  if (axes.empty()) return;
+  t.var    = MNN::Express::_ReduceSum(t.var, axes, false);
+  t.labels = labels;
+  t.dims   = dims;
+}
+
+// Take the diagonal of repeated labels, e.g., "ii" -> "i".
+void take_diagonals(Term &t) {
+  for (;;) {
+    size_t p = 0, q = 0;
+    for (p = 0; p < t.labels.size(); p++) {
+      q = std::find(t.labels.begin() + p + 1, t.labels.end(), t.labels[p]) - t.labels.begin();
+      if (q < t.labels.size()) break;
+    }
+    if (p >= t.labels.size()) return;
+    const int        label = t.labels[p];
+    const int        n     = t.dims[p];
+    Labels           order;
+    std::vector<int> dims;
+    for (size_t i = 0; i < t.labels.size(); i++) {
+      if (i == p || i == q) continue;
+      order.push_back(t.labels[i]);
+      dims.push_back(t.dims[i]);
+    }
+    // move the pair to the end, flatten it and gather every (n + 1)th element
+    std::vector<int> perm;
+    for (size_t i = 0; i < t.labels.size(); i++) {
+      if (i != p && i != q) perm.push_back((int)i);
+    }
+    perm.push_back((int)p);
+    perm.push_back((int)q);
+    VARP x = MNN::Express::_Transpose(t.var, perm);
+    dims.push_back(n * n);
+    x = MNN::Express::_Reshape(x, dims, MNN::Express::NCHW);
+    std::vector<int> index(n);
+    for (int i = 0; i < n; i++) index[i] = i * (n + 1);
+    auto indices =
+        MNN::Express::_Const(index.data(), {n}, MNN::Express::NCHW, halide_type_of<int>());
+    auto axis   = MNN::Express::_Scalar<int>((int)dims.size() - 1);
+    dims.back() = n;
+    order.push_back(label);
+    t.var    = MNN::Express::_GatherV2(x, indices, axis);
+    t.labels = order;
+    t.dims   = dims;
+  }
+}
+
+// Contract two terms, keeping the labels in `keep` and summing the shared others.
+Term contract(const Term &x, const Term &y, const Labels &keep) {
+  Labels           batch, xfree, shared, yfree;
+  std::vector<int> bdims, xdims, ydims;
+  int64_t          m = 1, k = 1, n = 1;
+  for (size_t i = 0; i < x.labels.size(); i++) {
+    const int l = x.labels[i];
+    if (!contains(y.labels, l)) {
+      xfree.push_back(l);
+      xdims.push_back(x.dims[i]);
+      m *= x.dims[i];
+    } else if (contains(keep, l)) {
+      batch.push_back(l);
+      bdims.push_back(x.dims[i]);
+    } else {
+      shared.push_back(l);
+      k *= x.dims[i];
+    }
+  }
+  for (size_t i = 0; i < y.labels.size(); i++) {
+    if (!contains(x.labels, y.labels[i])) {
+      yfree.push_back(y.labels[i]);
+      ydims.push_back(y.dims[i]);
+      n *= y.dims[i];
+    }
+  }
+  const int64_t b = product(bdims);
+
+  // pick the operand layouts that need no transpose if possible
+  auto join = [](const Labels &a, const Labels &b, const Labels &c) {
+    return concat(concat(a, b), c);
+  };
+  Labels xorder = join(batch, xfree, shared);
+  bool   adj_x  = false;
+  if (x.labels != xorder && x.labels == join(batch, shared, xfree)) {
+    xorder = join(batch, shared, xfree);
+    adj_x  = true;
+  }
+  Labels yorder = join(batch, shared, yfree);
+  bool   adj_y  = false;
+  if (y.labels != yorder && y.labels == join(batch, yfree, shared)) {
+    yorder = join(batch, yfree, shared);
+    adj_y  = true;
+  }
+  VARP xv = transpose_to(x, xorder);
+  VARP yv = transpose_to(y, yorder);
+
+  Term r;
+  if (batch.empty()) {
+    std::vector<int> xs = adj_x ? std::vector<int>{(int)k, (int)m}
+                                : std::vector<int>{(int)m, (int)k};
+    std::vector<int> ys = adj_y ? std::vector<int>{(int)n, (int)k}
+                                : std::vector<int>{(int)k, (int)n};
+    xv    = MNN::Express::_Reshape(xv, xs, MNN::Express::NCHW);
+    yv    = MNN::Express::_Reshape(yv, ys, MNN::Express::NCHW);
+    r.var = MNN::Express::_MatMul(xv, yv, adj_x, adj_y);
+  } else {
+    std::vector<int> xs = adj_x ? std::vector<int>{(int)b, (int)k, (int)m}
+                                : std::vector<int>{(int)b, (int)m, (int)k};
+    std::vector<int> ys = adj_y ? std::vector<int>{(int)b, (int)n, (int)k}
+                                : std::vector<int>{(int)b, (int)k, (int)n};
+    xv    = MNN::Express::_Reshape(xv, xs, MNN::Express::NCHW);
+    yv    = MNN::Express::_Reshape(yv, ys, MNN::Express::NCHW);
+    r.var = MNN::Express::_BatchMatMul(xv, yv, adj_x, adj_y);
+  }
+  r.labels = join(batch, xfree, yfree);
+  r.dims   = bdims;
+  r.dims.insert(r.dims.end(), xdims.begin(), xdims.end());
+  r.dims.insert(r.dims.end(), ydims.begin(), ydims.end());
+  std::vector<int> flat = batch.empty() ? std::vector<int>{(int)m, (int)n}
+                                        : std::vector<int>{(int)b, (int)m, (int)n};
+  r.var = reshape_to(r.var, flat, r.dims);
+  return r;
+}
+
+// Pairwise contraction order as a list of (i, j) merges, the result of each merge is
+// appended to the list of terms.
+class Planner {
+public:
+  Planner(const std::vector<Labels> &terms, const Labels &output, const std::map<int, int> &sizes)
+      : _terms(terms), _output(output), _sizes(sizes) {}
+
+  std::vector<std::pair<int, int>> plan() {
+    const int n = (int)_terms.size();
+    return n <= 8 ? optimal(n) : greedy(n);
+  }
+
+private:
+  double size_of(const Labels &labels) const {
+    double s = 1;
+    for (int l : labels) s *= _sizes.at(l);
+    return s;
+  }
+
+  static Labels merge(const Labels &a, const Labels &b) {
+    Labels r = a;
+    for (int l : b) {
+      if (!contains(r, l)) r.push_back(l);
+    }
+    return r;
+  }
+
+  // Labels of a subset of the original terms that are still needed outside of it.
+  Labels kept(uint32_t subset) const {
+    Labels inside, outside = _output;
+    for (size_t i = 0; i < _terms.size(); i++) {
+      if (subset & (1u << i)) {
+        inside = merge(inside, _terms[i]);
+      } else {
+        outside = merge(outside, _terms[i]);
+      }
+    }
+    Labels r;
+    for (int l : inside) {
+      if (contains(outside, l)) r.push_back(l);
+    }
+    return r;
+  }
+
+  std::vector<std::pair<int, int>> optimal(int n) {
+    const uint32_t        full = (1u << n) - 1;
+    std::vector<double>   cost(full + 1, 0);
+    std::vector<uint32_t> split(full + 1, 0);
+    std::vector<Labels>   labels(full + 1);
+    for (uint32_t s = 1; s <= full; s++) labels[s] = kept(s);
+    for (uint32_t s = 1; s <= full; s++) {
+      if ((s & (s - 1)) == 0) continue;
+      cost[s]           = -1;
+      const uint32_t lo = s & (~s + 1);
+      // enumerate the subsets containing the lowest term to visit each split once
+      for (uint32_t a = (s - 1) & s; a > 0; a = (a - 1) & s) {
+        if (!(a & lo)) continue;
+        const uint32_t b = s ^ a;
+        double         c = cost[a] + cost[b] + size_of(merge(labels[a], labels[b]));
+        if (cost[s] < 0 || c < cost[s]) {
+          cost[s]  = c;
+          split[s] = a;
+        }
+      }
+    }
+    std::vector<std::pair<int, int>> steps;
+    int                              next = n;
+    emit(full, split, steps, next);
+    return steps;
+  }
+
+  // Returns the index of the term holding the result of `s`.
+  int emit(
+      uint32_t s, const std::vector<uint32_t> &split, std::vector<std::pair<int, int>> &steps,
+      int &next
+  ) {
+    if ((s & (s - 1)) == 0) {
+      int i = 0;
+      while (!(s & (1u << i))) i++;
+      return i;
+    }
+    int a = emit(split[s], split, steps, next);
+    int b = emit(s ^ split[s], split, steps, next);
+    steps.push_back({a, b});
+    return next++;
+  }
+
+  std::vector<std::pair<int, int>> greedy(int n) {
+    std::vector<Labels>              terms = _terms;
+    std::vector<bool>                alive(n, true);
+    std::vector<std::pair<int, int>> steps;
+    for (int left = n; left > 1; left--) {
+      int    bi = -1, bj = -1;
+      double best_delta = 0, best_flops = 0;
+      Labels best;
+      for (int i = 0; i < (int)terms.size(); i++) {
+        for (int j = i + 1; alive[i] && j < (int)terms.size(); j++) {
+          if (!alive[j]) continue;
+          Labels outside = _output;
+          for (int k = 0; k < (int)terms.size(); k++) {
+            if (alive[k] && k != i && k != j) outside = merge(outside, terms[k]);
+          }
+          Labels all = merge(terms[i], terms[j]), r;
+          for (int l : all) {
+            if (contains(outside, l)) r.push_back(l);
+          }
+          double delta = size_of(r) - size_of(terms[i]) - size_of(terms[j]);
+          double flops = size_of(all);
+          if (bi < 0 || delta < best_delta || (delta == best_delta && flops < best_flops)) {
+            bi         = i;
+            bj         = j;
+            best_delta = delta;
+            best_flops = flops;
+            best       = r;
+          }
+        }
+      }
+      alive[bi] = alive[bj] = false;
+      terms.push_back(best);
+      alive.push_back(true);
+      steps.push_back({bi, bj});
+    }
+    return steps;
+  }
+
+  const std::vector<Labels> &_terms;
+  const Labels              &_output;
+  const std::map<int, int>  &_sizes;
+};
+
+mnn_error_code_t
+einsum(const std::string &subscripts, const std::vector<VARP> &operands, VARP &out) {
+  std::vector<std::string> inputs;
+  std::string              output;
+  bool                     has_output = false;
+  if (!split_subscripts(subscripts, inputs, output, has_output)) return MNNC_INVALID_VALUE;
+  if (inputs.size() != operands.size() || operands.empty()) return MNNC_INVALID_VALUE;
+
+  std::vector<Term> terms(operands.size());
+  int               max_ellipsis = 0;
+  for (size_t i = 0; i < operands.size(); i++) {
+    if (operands[i].get() == nullptr) return MNNC_INVALID_PTR;
+    auto info = operands[i]->getInfo();
+    if (info == nullptr) return MNNC_COMPUTE_SIZE_ERROR;
+    terms[i].var  = operands[i];
+    terms[i].dims = info->dim;
+    int    ellipsis;
+    Labels labels;
+    if (!parse_term(inputs[i], (int)info->dim.size(), 0, labels, ellipsis)) {
+      return MNNC_INVALID_VALUE;
+    }
+    max_ellipsis = std::max(max_ellipsis, ellipsis);
+  }
+  std::map<int, int> sizes;
+  std::map<int, int> counts;
+  for (size_t i = 0; i < terms.size(); i++) {
+    int ellipsis;
+    parse_term(inputs[i], (int)terms[i].dims.size(), max_ellipsis, terms[i].labels, ellipsis);
+    for (size_t d = 0; d < terms[i].labels.size(); d++) {
+      const int l = terms[i].labels[d], dim = terms[i].dims[d];
+      counts[l]++;
+      auto it = sizes.find(l);
+      if (it == sizes.end() || it->second == 1) {
+        sizes[l] = dim;
+      } else if (dim != 1 && dim != it->second) {
+        return MNNC_INVALID_VALUE;
+      }
+    }
+  }
+  Labels out_labels;
+  if (has_output) {
+    int ellipsis;
+    if (!parse_term(output, -1, max_ellipsis, out_labels, ellipsis)) return MNNC_INVALID_VALUE;
+    for (size_t i = 0; i < out_labels.size(); i++) {
+      if (sizes.find(out_labels[i]) == sizes.end()) return MNNC_INVALID_VALUE;
+      if (std::count(out_labels.begin(), out_labels.end(), out_labels[i]) > 1) {
+        return MNNC_INVALID_VALUE;
+      }
+    }
+  } else {
+    // numpy: the ellipsis dims, then the labels used once in alphabetical order
+    for (int k = 0; k < max_ellipsis; k++) out_labels.push_back(kEllipsis + k);
+    for (const auto &c : counts) {
+      if (c.first < kEllipsis && c.second == 1) out_labels.push_back(c.first);
+    }
+  }
+  std::vector<int> out_dims;
+  for (int l : out_labels) out_dims.push_back(sizes[l]);
+
+  // drop broadcast dims and take diagonals, then sum the labels no one else needs
+  for (auto &t : terms) {
+    Labels           labels;
+    std::vector<int> dims;
+    for (size_t d = 0; d < t.labels.size(); d++) {
+      if (t.dims[d] == 1) continue;
+      labels.push_back(t.labels[d]);
+      dims.push_back(t.dims[d]);
+    }
+    if (dims != t.dims) t.var = MNN::Express::_Reshape(t.var, dims, MNN::Express::NCHW);
+    t.labels = labels;
+    t.dims   = dims;
+    take_diagonals(t);
+  }
+  for (size_t i = 0; i < terms.size(); i++) {
+    Labels keep = out_labels;
+    for (size_t j = 0; j < terms.size(); j++) {
+      if (j != i) keep = concat(keep, terms[j].labels);
+    }
+    reduce_except(terms[i], keep);
+  }
+
+  if (terms.size() > 1) {
+    std::vector<Labels> term_labels;
+    for (const auto &t : terms) term_labels.push_back(t.labels);
+    auto              steps = Planner(term_labels, out_labels, sizes).plan();
+    std::vector<bool> alive(terms.size(), true);
+    for (const auto &step : steps) {
+      alive[step.first] = alive[step.second] = false;
+      Labels keep                            = out_labels;
+      for (size_t j = 0; j < terms.size(); j++) {
+        if (alive[j]) keep = concat(keep, terms[j].labels);
+      }
+      Term x = terms[step.first], y = terms[step.second];
+      reduce_except(x, concat(keep, y.labels));
+      reduce_except(y, concat(keep, x.labels));
+      terms.push_back(contract(x, y, keep));
+      alive.push_back(true);
+    }
+  }
+  Term result = terms.back();
+  reduce_except(result, out_labels);
+  Labels present;
+  for (int l : out_labels) {
+    if (contains(result.labels, l)) present.push_back(l);
+  }
+  VARP             v = transpose_to(result, present);
+  std::vector<int> dims;
+  for (int l : present) dims.push_back(sizes[l]);
+  out = reshape_to(v, dims, out_dims);
+  return MNNC_NO_ERROR;
+}
+
+} // namespace
+
+mnn_error_code_t mnn_expr_Einsum(const char *subscripts, VecVARP_t operands, VARP_t *out) {
+  if (subscripts == nullptr || operands == nullptr || out == nullptr) return MNNC_INVALID_PTR;
+  try {
+    VARP result;
+    auto code = einsum(subscripts, *operands, result);
+    if (code != MNNC_NO_ERROR) return code;
+    *out = mnnc::make_varp(result);
+    return MNNC_NO_ERROR;
+  } catch (...) { return MNNC_UNKNOWN_ERROR; }
+}
@@ -0,0 +1,336 @@
+/*
+ * executor_pool.cpp
+ * MNN C API for pools of expression executors
+ *
+ * Author: Rainyl
+ * License: Apache License 2.0
+ */
+
+#include "mnn_c/executor_pool.h"
+#include "MNN/expr/Expr.hpp"
+#include "executor_pool.hpp"
+#include "parallel.hpp"
+#include <algorithm>
+#include <chrono>
+
+using MNN::Express::Executor;
+using MNN::Express::ExecutorScope;
+using MNN::Express::Expr;
+using MNN::Express::VARP;
+using MNN::Express::Variable;
+
+namespace mnnc {
+
+namespace {
+
+uint64_t now_ns() {
+  return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch()
+  )
+      .count();
+}
+
+int find_root(std::vector<int> &parent, int i) {
+  while (parent[i] != i) i = parent[i] = parent[parent[i]];
+  return i;
+}
+
+} // namespace
+
+ExecutorPool::ExecutorPool(
+    MNNForwardType type, const MNN::BackendConfig &config, int num_thread, size_t size
+) {
+  if (size == 0) size = (size_t)ThreadPool::instance().concurrency();
+  for (size_t i = 0; i < size; i++) {
+    _executors.push_back(Executor::newExecutor(type, config, num_thread));
+    _stats.emplace_back(new Stats());
+    _free.push_back(size - 1 - i);
+  }
+}
+
+ExecutorPool &ExecutorPool::instance() {
+  static ExecutorPool *pool = [] {
+    MNN::BackendConfig config;
+    return new ExecutorPool(MNN_FORWARD_CPU, config, 1, 0);
+  }();
+  return *pool;
+}
+
+size_t ExecutorPool::acquire() {
+  std::unique_lock<std::mutex> lock(_mutex);
+  _cv.wait(lock, [this] { return !_free.empty(); });
+  size_t i = _free.back();
+  _free.pop_back();
+  _stats[i]->in_use.store(true);
+  return i;
+}
+
+void ExecutorPool::release(size_t i) {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stats[i]->in_use.store(false);
+    _free.push_back(i);
+  }
+  _cv.notify_one();
+}
+
+size_t ExecutorPool::bind() {
+  const auto id = std::this_thread::get_id();
+  size_t     index;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto                        it = _bindings.find(id);
+    if (it != _bindings.end()) {
+      it->second.scopes.emplace_back(new ExecutorScope(_executors[it->second.index]));
+      return it->second.index;
+    }
+  }
+  index = acquire();
+  std::unique_ptr<ExecutorScope> scope(new ExecutorScope(_executors[index]));
+  std::lock_guard<std::mutex>    lock(_mutex);
+  Binding                       &binding = _bindings[id];
+  binding.index                          = index;
+  binding.start_ns                       = now_ns();
+  binding.scopes.push_back(std::move(scope));
+  _stats[index]->tasks.fetch_add(1);
+  return index;
+}
+
+bool ExecutorPool::unbind() {
+  std::unique_ptr<ExecutorScope> scope;
+  size_t                         index;
+  uint64_t                       start_ns;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto                        it = _bindings.find(std::this_thread::get_id());
+    if (it == _bindings.end() || it->second.scopes.empty()) return false;
+    scope = std::move(it->second.scopes.back());
+    it->second.scopes.pop_back();
+    if (!it->second.scopes.empty() || it->second.runs > 0) return true;
+    index    = it->second.index;
+    start_ns = it->second.start_ns;
+    _bindings.erase(it);
+  }
+  // scopes are thread local, leave it before the executor can be leased again
+  scope.reset();
+  _stats[index]->busy_ns.fetch_add(now_ns() - start_ns);
+  release(index);
+  return true;
+}
+
+bool ExecutorPool::serve(
+    bool wait, int tasks, std::atomic<int> &next, const std::function<void(int)> &fn
+) {
+  const auto id    = std::this_thread::get_id();
+  bool       owned = false;
+  bool       ok    = true;
+  size_t     index;
+  {
+    std::unique_lock<std::mutex> lock(_mutex);
+    auto                         it = _bindings.find(id);
+    if (it == _bindings.end()) {
+      if (!wait && _free.empty()) return true;
+      _cv.wait(lock, [this] { return !_free.empty(); });
+      index = _free.back();
+      _free.pop_back();
+      _stats[index]->in_use.store(true);
+      it                  = _bindings.emplace(id, Binding()).first;
+      it->second.index    = index;
+      it->second.start_ns = now_ns();
+      owned               = true;
+    }
+    index = it->second.index;
+    it->second.runs++;
+  }
+  {
+    ExecutorScope scope(_executors[index]);
+    for (int i = next.fetch_add(1); i < tasks; i = next.fetch_add(1)) {
+      try {
+        fn(i);
+      } catch (...) { ok = false; }
+      _stats[index]->tasks.fetch_add(1);
+    }
+  }
+  uint64_t start_ns = 0;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto                        it = _bindings.find(id);
+    it->second.runs--;
+    // a bind() left open by fn keeps the lease until its unbind()
+    owned = owned && it->second.runs == 0 && it->second.scopes.empty();
+    if (owned) {
+      start_ns = it->second.start_ns;
+      _bindings.erase(it);
+    }
+  }
+  if (owned) {
+    _stats[index]->busy_ns.fetch_add(now_ns() - start_ns);
+    release(index);
+  }
+  return ok;
+}
+
+bool ExecutorPool::run(int tasks, int max_workers, const std::function<void(int)> &fn) {
+  if (tasks <= 0) return true;
+  int workers = max_workers > 0 ? std::min<int>(max_workers, (int)size()) : (int)size();
+  workers     = std::min(workers, std::min(tasks, ThreadPool::instance().concurrency()));
+  std::atomic<int>  next{0};
+  std::atomic<bool> failed{false};
+  // Workers never wait for an executor, a thread that is already bound, e.g., the caller
+  // or a worker of an outer run(), reuses its own and the others leave if all are leased.
+  bool ok = ThreadPool::instance().run(workers, [&](int) {
+    if (!serve(false, tasks, next, fn)) failed.store(true);
+  });
+  // the caller waits for an executor to finish the tasks no worker could take
+  if (next.load() < tasks && !serve(true, tasks, next, fn)) failed.store(true);
+  return ok && !failed.load();
+}
+
+bool ExecutorPool::compute(
+    const std::vector<VARP> &vars, bool forceCPU, int max_workers, size_t *num_groups
+) {
+  const int n = (int)vars.size();
+  // union variables whose graphs share an op node
+  std::vector<int>                 parent(n);
+  std::unordered_map<Expr *, int>  owner;
+  std::unordered_map<Expr *, VARP> leaves;
+  for (int i = 0; i < n; i++) {
+    parent[i] = i;
+    for (const auto &expr : Variable::getExecuteOrder({vars[i]})) {
+      if (expr->get() == nullptr) {
+        if (leaves.find(expr.get()) == leaves.end()) {
+          leaves[expr.get()] = Variable::create(expr, 0);
+        }
+        continue;
+      }
+      auto it = owner.find(expr.get());
+      if (it == owner.end()) {
+        owner[expr.get()] = i;
+      } else {
+        parent[find_root(parent, i)] = find_root(parent, it->second);
+      }
+    }
+  }
+  std::vector<std::vector<VARP>>  groups;
+  std::unordered_map<int, size_t> group_of;
+  for (int i = 0; i < n; i++) {
+    int  root = find_root(parent, i);
+    auto it   = group_of.find(root);
+    if (it == group_of.end()) {
+      it = group_of.emplace(root, groups.size()).first;
+      groups.emplace_back();
+    }
+    groups[it->second].push_back(vars[i]);
+  }
+  if (num_groups) *num_groups = groups.size();
+  if (groups.size() <= 1) {
+    Variable::compute(vars, forceCPU);
+    return true;
+  }
+  // materialize shared leaves up front so that workers only read them
+  for (auto &leaf : leaves) {
+    if (leaf.second->getInfo() != nullptr) leaf.second->readMap<void>();
+  }
+  return run((int)groups.size(), max_workers, [&](int g) {
+    Variable::compute(groups[g], forceCPU);
+  });
+}
+
+size_t ExecutorPool::gc(Executor::GCFlag flag) {
+  std::vector<size_t> idle;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    idle.swap(_free);
+    for (size_t i : idle) _stats[i]->in_use.store(true);
+  }
+  for (size_t i : idle) {
+    _executors[i]->gc(flag);
+    _stats[i]->gc_count.fetch_add(1);
+    release(i);
+  }
+  return idle.size();
+}
+
+} // namespace mnnc
+
+struct mnn_executor_pool {
+  std::unique_ptr<mnnc::ExecutorPool> pool;
+};
+
+mnn_executor_pool_t mnn_executor_pool_create(
+    /*MNNForwardType*/ int type, mnn_backend_config_t config, int num_thread, size_t size
+) {
+  MNN::BackendConfig _config;
+  _config.memory        = static_cast<MNN::BackendConfig::MemoryMode>(config.memory);
+  _config.power         = static_cast<MNN::BackendConfig::PowerMode>(config.power);
+  _config.precision     = static_cast<MNN::BackendConfig::PrecisionMode>(config.precision);
+  _config.sharedContext = config.sharedContext;
+  _config.flags         = config.flags;
+  auto self             = new mnn_executor_pool();
+  self->pool.reset(
+      new mnnc::ExecutorPool(static_cast<MNNForwardType>(type), _config, num_thread, size)
+  );
+  return self;
+}
+
+void mnn_executor_pool_destroy(mnn_executor_pool_t self) {
+  if (self) {
+    delete self;
+    self = nullptr;
+  }
+}
+
+size_t mnn_executor_pool_size(mnn_executor_pool_t self) { return self ? self->pool->size() : 0; }
+
+mnn_executor_t mnn_executor_pool_get(mnn_executor_pool_t self, size_t index) {
+  if (!self || index >= self->pool->size()) return nullptr;
+  return new std::shared_ptr<Executor>(self->pool->executor(index));
+}
+
+mnn_error_code_t mnn_executor_pool_bind(mnn_executor_pool_t self, size_t *index) {
+  if (!self) return MNNC_INVALID_PTR;
+  try {
+    size_t i = self->pool->bind();
+    if (index) *index = i;
+    return MNNC_NO_ERROR;
+  } catch (...) { return MNNC_UNKNOWN_ERROR; }
+}
+
+mnn_error_code_t mnn_executor_pool_unbind(mnn_executor_pool_t self) {
+  if (!self) return MNNC_INVALID_PTR;
+  try {
+    return self->pool->unbind() ? MNNC_NO_ERROR : MNNC_INVALID_VALUE;
+  } catch (...) { return MNNC_UNKNOWN_ERROR; }
+}
+
+mnn_error_code_t mnn_executor_pool_compute(
+    mnn_executor_pool_t self, VecVARP_t vars, bool forceCPU, int max_workers, size_t *num_groups
+) {
+  if (!self || !vars) return MNNC_INVALID_PTR;
+  try {
+    for (const auto &v : *vars) {
+      if (v.get() == nullptr) return MNNC_INVALID_PTR;
+    }
+    bool ok = self->pool->compute(*vars, forceCPU, max_workers, num_groups);
+    return ok ? MNNC_NO_ERROR : MNNC_UNKNOWN_ERROR;
+  } catch (...) { return MNNC_UNKNOWN_ERROR; }
+}
+
+mnn_error_code_t
+mnn_executor_pool_get_stats(mnn_executor_pool_t self, size_t index, mnn_executor_stats_t *stats) {
+  if (!self || !stats) return MNNC_INVALID_PTR;
+  if (index >= self->pool->size()) return MNNC_INVALID_VALUE;
+  const auto &s   = self->pool->stats(index);
+  stats->tasks    = s.tasks.load();
+  stats->busy_ns  = s.busy_ns.load();
+  stats->gc_count = s.gc_count.load();
+  stats->in_use   = s.in_use.load();
+  return MNNC_NO_ERROR;
+}
+
+size_t mnn_executor_pool_gc(mnn_executor_pool_t self, /*GCFlag*/ int flag) {
+  if (!self) return 0;
+  try {
+    return self->pool->gc(static_cast<Executor::GCFlag>(flag));
+  } catch (...) { return 0; }
+}
@@ -0,0 +1,97 @@
+/*
+ * executor_pool.hpp
+ * Internal pool of expression executors leased to worker threads
+ *
+ * Author: Rainyl
+ * License: Apache License 2.0
+ */
+
+#ifndef MNN_C_EXECUTOR_POOL_HPP
+#define MNN_C_EXECUTOR_POOL_HPP
+
+#include "MNN/expr/Executor.hpp"
+#include "MNN/expr/ExecutorScope.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace mnnc {
+
+// Executors are not reentrant, each one is leased to at most one thread at a time.
+class ExecutorPool {
+public:
+  struct Stats {
+    std::atomic<uint64_t> tasks{0};
+    std::atomic<uint64_t> busy_ns{0};
+    std::atomic<uint64_t> gc_count{0};
+    std::atomic<bool>     in_use{false};
+  };
+
+  // size == 0 means one executor per thread of the ThreadPool.
+  ExecutorPool(MNNForwardType type, const MNN::BackendConfig &config, int num_thread, size_t size);
+
+  // Shared CPU pool sized to the thread pool, leaked for the same reason as ThreadPool.
+  static ExecutorPool &instance();
+
+  size_t size() const { return _executors.size(); }
+
+  const std::shared_ptr<MNN::Express::Executor> &executor(size_t i) const {
+    return _executors[i];
+  }
+
+  const Stats &stats(size_t i) const { return *_stats[i]; }
+
+  // Borrow an executor exclusively, blocks while all of them are in use.
+  size_t acquire();
+  void   release(size_t i);
+
+  // Lease an executor to the calling thread and enter its ExecutorScope, nested calls on
+  // the same thread reuse the executor. Returns the index of the executor.
+  size_t bind();
+  // Leave the scope entered by the matching bind() on the calling thread.
+  bool unbind();
+
+  // Run fn(0..tasks-1) on at most `max_workers` threads of the ThreadPool, each worker
+  // evaluates its tasks under an ExecutorScope of the executor bound to its thread, or of
+  // one leased for the run. max_workers <= 0 means the size of the pool. Callable from a
+  // bound thread or from fn itself. Returns false if any task threw.
+  bool run(int tasks, int max_workers, const std::function<void(int)> &fn);
+
+  // Partition vars into groups sharing no op nodes and compute the groups with run().
+  bool compute(
+      const std::vector<MNN::Express::VARP> &vars, bool forceCPU, int max_workers, size_t *groups
+  );
+
+  // Run gc on all executors that are not leased, returns the number of collected ones.
+  size_t gc(MNN::Express::Executor::GCFlag flag);
+
+private:
+  struct Binding {
+    size_t                                                    index;
+    uint64_t                                                  start_ns;
+    std::vector<std::unique_ptr<MNN::Express::ExecutorScope>> scopes;
+    // number of run() workers on the thread using the executor
+    int runs = 0;
+  };
+
+  // Take tasks from `next` on the executor bound to the calling thread, or on one leased
+  // until they run out. Without `wait` returns at once if no executor is free.
+  bool serve(bool wait, int tasks, std::atomic<int> &next, const std::function<void(int)> &fn);
+
+  std::vector<std::shared_ptr<MNN::Express::Executor>> _executors;
+  std::vector<std::unique_ptr<Stats>>                  _stats;
+  std::vector<size_t>                                  _free;
+  std::unordered_map<std::thread::id, Binding>         _bindings;
+  std::mutex                                           _mutex;
+  std::condition_variable                              _cv;
+};
+
+} // namespace mnnc
+
+#endif // MNN_C_EXECUTOR_POOL_HPP
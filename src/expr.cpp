@@ -5,10 +5,21 @@
 
 #include "mnn_c/expr.h"
 #include "MNN/expr/Expr.hpp"
+#include "eager.hpp"
+#include "executor_pool.hpp"
+#include "expr_arena.hpp"
+#include "mmap_file.hpp"
 #include "mnn_c/base.h"
+#include "mnn_c/expr_graph.h"
+#include <algorithm>
+#include <cerrno>
 #include <cstdlib>
 #include <cstring>
 
+#ifdef _WIN32
+  #include <io.h>
+#endif
+
 VecVARP_t mnn_expr_VecVARP_create(size_t length, VARP_t value) {
   if (value) return new std::vector<MNN::Express::VARP>(length, *value);
   return new std::vector<MNN::Express::VARP>(length);
@@ -19,7 +30,7 @@ void mnn_expr_VecVARP_free(VecVARP_t self) {
   delete static_cast<VecVARP_t>(self);
   self = nullptr;
 }
-VARP_t mnn_expr_VecVARP_at(VecVARP_t self, int i) { return new MNN::Express::VARP(self->at(i)); }
+VARP_t mnn_expr_VecVARP_at(VecVARP_t self, int i) { return mnnc::make_varp(self->at(i)); }
 VARP_t mnn_expr_VecVARP_at_ref(VecVARP_t self, int i) { return &self->at(i); }
 void   mnn_expr_VecVARP_set(VecVARP_t self, int i, VARP_t value) { self->at(i) = *value; }
 void   mnn_expr_VecVARP_push_back(VecVARP_t self, VARP_t value) { return self->push_back(*value); }
@@ -33,7 +44,7 @@ void mnn_expr_VecWeakEXPRP_free(VecWeakEXPRP_t self) {
 MNN_C_API EXPRP_t mnn_expr_VecWeakEXPRP_at(VecWeakEXPRP_t self, int i) {
   auto _varp = self->at(i);
   if (_varp.expired()) return nullptr;
-  return new MNN::Express::EXPRP(_varp.lock());
+  return mnnc::make_exprp(_varp.lock());
 }
 MNN_C_API void mnn_expr_VecWeakEXPRP_set(VecWeakEXPRP_t self, int i, EXPRP_t value) {
   self->at(i) = *value;
@@ -72,7 +83,7 @@ MNN_C_API char **mnn_expr_VARMAP_keys(VARMAP_t self) {
 }
 MNN_C_API VARP_t mnn_expr_VARMAP_get(VARMAP_t self, char *key) {
   auto it = self->find(key);
-  if (it != self->end()) return new MNN::Express::VARP(self->at(key));
+  if (it != self->end()) return mnnc::make_varp(self->at(key));
   return nullptr;
 }
 MNN_C_API VARP_t mnn_expr_VARMAP_get_ref(VARMAP_t self, char *key) {
@@ -84,31 +95,39 @@ MNN_C_API void mnn_expr_VARMAP_set(VARMAP_t self, char *key, VARP_t value) {
   (*self)[key] = *value;
 }
 
-VARP_t mnn_expr_VARP_create_empty() { return new MNN::Express::VARP(); }
-VARP_t mnn_expr_VARP_create_VARP(VARP_t other) { return new MNN::Express::VARP(*other); }
+VARP_t mnn_expr_VARP_create_empty() { return mnnc::make_varp(); }
+VARP_t mnn_expr_VARP_create_VARP(VARP_t other) { return mnnc::make_varp(*other); }
 void   mnn_expr_VARP_free(VARP_t self) {
   // std::cout << "Releasing VARP at " << self << std::endl;
   if (self == nullptr) return;
+  // owned by an open scope, released by mnn_expr_scope_end
+  if (mnnc::arena_owns(self)) return;
   delete self;
   self = nullptr;
 }
 VARP_t mnn_expr_VARP_op_add(VARP_t self, VARP_t other) {
-  return new MNN::Express::VARP((*self) + (*other));
+  auto eager = mnnc::eager_binary(MNN_EXPR_OP_ADD, *self, *other);
+  return mnnc::make_varp(eager.get() ? eager : (*self) + (*other));
 }
 VARP_t mnn_expr_VARP_op_sub(VARP_t self, VARP_t other) {
-  return new MNN::Express::VARP((*self) - (*other));
+  auto eager = mnnc::eager_binary(MNN_EXPR_OP_SUB, *self, *other);
+  return mnnc::make_varp(eager.get() ? eager : (*self) - (*other));
 }
 VARP_t mnn_expr_VARP_op_mul(VARP_t self, VARP_t other) {
-  return new MNN::Express::VARP((*self) * (*other));
+  auto eager = mnnc::eager_binary(MNN_EXPR_OP_MUL, *self, *other);
+  return mnnc::make_varp(eager.get() ? eager : (*self) * (*other));
 }
 VARP_t mnn_expr_VARP_op_div(VARP_t self, VARP_t other) {
-  return new MNN::Express::VARP((*self) / (*other));
+  auto eager = mnnc::eager_binary(MNN_EXPR_OP_DIV, *self, *other);
+  return mnnc::make_varp(eager.get() ? eager : (*self) / (*other));
 }
 VARP_t mnn_expr_VARP_mean(VARP_t self, VecI32 dims) {
-  return new MNN::Express::VARP(self->mean(*dims));
+  auto eager = mnnc::eager_reduce(MNN_EXPR_OP_REDUCE_MEAN, *self, *dims, false);
+  return mnnc::make_varp(eager.get() ? eager : self->mean(*dims));
 }
 VARP_t mnn_expr_VARP_sum(VARP_t self, VecI32 dims) {
-  return new MNN::Express::VARP(self->sum(*dims));
+  auto eager = mnnc::eager_reduce(MNN_EXPR_OP_REDUCE_SUM, *self, *dims, false);
+  return mnnc::make_varp(eager.get() ? eager : self->sum(*dims));
 }
 bool mnn_expr_VARP_op_eqeq(VARP_t self, VARP_t other) { return (*self) == (*other); }
 bool mnn_expr_VARP_op_less(VARP_t self, VARP_t other) { return (*self) < (*other); }
@@ -155,7 +174,7 @@ struct Variable_expr_pair *mnn_expr_VARP_getExpr(VARP_t self) {
   auto _expr  = (*self)->expr();
   auto pair   = static_cast<Variable_expr_pair *>(malloc(sizeof(Variable_expr_pair)));
   pair->index = _expr.second;
-  pair->expr  = new MNN::Express::EXPRP{_expr.first};
+  pair->expr  = mnnc::make_exprp(_expr.first);
   return pair;
 }
 
@@ -168,7 +187,7 @@ void mnn_expr_VARP_static_replace(VARP_t dst, VARP_t src) {
   MNN::Express::Variable::replace(*dst, *src);
 }
 VARP_t mnn_expr_VARP_static_create_EXPRP(EXPRP_t expr, int index) {
-  return new MNN::Express::VARP(MNN::Express::Variable::create(*expr, index));
+  return mnnc::make_varp(MNN::Express::Variable::create(*expr, index));
 }
 VecVARP_t mnn_expr_VARP_static_load(const char *fileName) {
   auto v    = MNN::Express::Variable::load(fileName);
@@ -203,12 +222,91 @@ void mnn_expr_VARP_static_saveNet(VecVARP_t vars, Net_t dest) {
   MNN::Express::Variable::save(*vars, dest);
 }
 
+mnn_error_code_t mnn_expr_VARP_static_save_fd(VecVARP_t vars, int fd) {
+  if (vars == nullptr) return MNNC_INVALID_PTR;
+  if (fd < 0) return MNNC_INVALID_VALUE;
+  try {
+    auto        buffer = MNN::Express::Variable::save(*vars);
+    const char *p      = (const char *)buffer.data();
+    size_t      remain = buffer.size();
+    while (remain > 0) {
+#ifdef _WIN32
+      int n = _write(fd, p, (unsigned int)std::min<size_t>(remain, 1 << 30));
+#else
+      ssize_t n = write(fd, p, remain);
+      if (n < 0 && errno == EINTR) continue;
+#endif
+      if (n <= 0) return MNNC_FILE_CREATE_FAILED;
+      p += n;
+      remain -= (size_t)n;
+    }
+    return MNNC_NO_ERROR;
+  } catch (...) { return MNNC_UNKNOWN_ERROR; }
+}
+
+mnn_error_code_t mnn_expr_VARP_static_save_callback(
+    VecVARP_t vars, mnn_expr_write_callback_t writer, void *user_data, size_t chunk_size
+) {
+  if (vars == nullptr || writer == nullptr) return MNNC_INVALID_PTR;
+  try {
+    auto        buffer = MNN::Express::Variable::save(*vars);
+    const char *p      = (const char *)buffer.data();
+    size_t      remain = buffer.size();
+    if (chunk_size == 0) chunk_size = remain;
+    while (remain > 0) {
+      size_t n = std::min(remain, chunk_size);
+      if (writer(user_data, p, n) < n) return MNNC_CALL_BACK_STOP;
+      p += n;
+      remain -= n;
+    }
+    return MNNC_NO_ERROR;
+  } catch (...) { return MNNC_UNKNOWN_ERROR; }
+}
+
+mnn_error_code_t mnn_expr_VARP_static_load_mmap(const char *fileName, VecVARP_t *out) {
+  if (fileName == nullptr || out == nullptr) return MNNC_INVALID_PTR;
+  try {
+    mnnc::MappedFile file;
+    auto             code = file.open(fileName);
+    if (code != MNNC_NO_ERROR) return code;
+    auto vars = MNN::Express::Variable::load(file.data(), file.size());
+    *out      = new std::vector<MNN::Express::VARP>(std::move(vars));
+    return MNNC_NO_ERROR;
+  } catch (...) { return MNNC_UNKNOWN_ERROR; }
+}
+
+mnn_error_code_t mnn_expr_VARP_static_loadMap_mmap(const char *fileName, VARMAP_t *out) {
+  if (fileName == nullptr || out == nullptr) return MNNC_INVALID_PTR;
+  try {
+    mnnc::MappedFile file;
+    auto             code = file.open(fileName);
+    if (code != MNNC_NO_ERROR) return code;
+    auto varmap = MNN::Express::Variable::loadMap(file.data(), file.size());
+    *out        = new std::map<std::string, MNN::Express::VARP>(std::move(varmap));
+    return MNNC_NO_ERROR;
+  } catch (...) { return MNNC_UNKNOWN_ERROR; }
+}
+
 void mnn_expr_VARP_static_prepareCompute(VecVARP_t vars, bool forceCPU) {
   MNN::Express::Variable::prepareCompute(*vars, forceCPU);
 }
 void mnn_expr_VARP_static_compute(VecVARP_t vars, bool forceCPU) {
   MNN::Express::Variable::compute(*vars, forceCPU);
 }
+
+mnn_error_code_t mnn_expr_VARP_static_compute_parallel(
+    VecVARP_t vars, bool forceCPU, int max_workers, size_t *num_groups
+) {
+  if (vars == nullptr) return MNNC_INVALID_PTR;
+  try {
+    for (const auto &v : *vars) {
+      if (v.get() == nullptr) return MNNC_INVALID_PTR;
+    }
+    bool ok = mnnc::ExecutorPool::instance().compute(*vars, forceCPU, max_workers, num_groups);
+    return ok ? MNNC_NO_ERROR : MNNC_UNKNOWN_ERROR;
+  } catch (...) { return MNNC_UNKNOWN_ERROR; }
+}
+
 size_t               mnn_expr_VARP_linkNumber(VARP_t self) { return (*self)->linkNumber(); }
 const VecWeakEXPRP_t mnn_expr_VARP_toExprs(VARP_t self) {
   auto exprs = (*self)->toExprs();
@@ -219,9 +317,9 @@ const mnn_tensor_t mnn_expr_VARP_getTensor(VARP_t self) {
   return new MNN::Tensor((*self)->getTensor());
 }
 
-EXPRP_t mnn_expr_Expr_create_empty() { return new std::shared_ptr<MNN::Express::Expr>(); }
+EXPRP_t mnn_expr_Expr_create_empty() { return mnnc::make_exprp(); }
 EXPRP_t mnn_expr_Expr_static_create(mnn_tensor_t tensor, bool own) {
-  return new MNN::Express::EXPRP(MNN::Express::Expr::create(tensor, own));
+  return mnnc::make_exprp(MNN::Express::Expr::create(tensor, own));
 }
 EXPRP_t mnn_expr_Expr_static_create_1(
     struct mnn_expr_Variable_Info *info, const void *ptr, int type, int memoryType
@@ -232,7 +330,7 @@ EXPRP_t mnn_expr_Expr_static_create_1(
   _info.type =
       halide_type_t((halide_type_code_t)info->type.code, info->type.bits, info->type.lanes);
   _info.size = info->size;
-  return new MNN::Express::EXPRP(
+  return mnnc::make_exprp(
       MNN::Express::Expr::create(
           std::move(_info),
           ptr,
@@ -242,11 +340,12 @@ EXPRP_t mnn_expr_Expr_static_create_1(
   );
 }
 EXPRP_t mnn_expr_Expr_static_create_2(OpT_t op, VecVARP_t inputs, int outputSize) {
-  return new MNN::Express::EXPRP(MNN::Express::Expr::create(op, *inputs, outputSize));
+  return mnnc::make_exprp(MNN::Express::Expr::create(op, *inputs, outputSize));
 }
 
 void mnn_expr_Expr_free(EXPRP_t self) {
   if (self == nullptr) return;
+  if (mnnc::arena_owns(self)) return;
   delete self;
   self = nullptr;
 }
@@ -287,3 +386,168 @@ struct mnn_expr_Variable_Info *mnn_expr_Expr_outputInfo(EXPRP_t self, int index)
   info->size = _info->size;
   return info;
 }
+
+// Expression scope
+struct mnn_expr_scope : public mnnc::ExprArena {};
+
+namespace {
+thread_local mnnc::ExprArena *t_arena = nullptr;
+} // namespace
+
+mnnc::ExprArena *mnnc::current_arena() { return t_arena; }
+
+bool mnnc::arena_owns(const void *handle) {
+  for (ExprArena *a = t_arena; a; a = a->parent) {
+    if (a->varps.owns(handle) || a->exprs.owns(handle)) return true;
+  }
+  return false;
+}
+
+mnn_expr_scope_t mnn_expr_scope_begin() {
+  auto *scope   = new mnn_expr_scope();
+  scope->parent = t_arena;
+  t_arena       = scope;
+  return scope;
+}
+
+mnn_error_code_t mnn_expr_scope_end(mnn_expr_scope_t self) {
+  if (self == nullptr) return MNNC_INVALID_PTR;
+  bool open = false;
+  for (mnnc::ExprArena *a = t_arena; a; a = a->parent) {
+    if (a == self) {
+      open = true;
+      break;
+    }
+  }
+  if (!open) return MNNC_INVALID_VALUE;
+  try {
+    bool last = false;
+    while (!last) {
+      auto *a = static_cast<mnn_expr_scope *>(t_arena);
+      last    = a == self;
+      t_arena = a->parent;
+      delete a;
+    }
+    return MNNC_NO_ERROR;
+  } catch (...) { return MNNC_UNKNOWN_ERROR; }
+}
+
+size_t mnn_expr_scope_size(mnn_expr_scope_t self) {
+  if (self == nullptr) return 0;
+  return self->varps.size() + self->exprs.size();
+}
+
+VARP_t mnn_expr_scope_escape_VARP(VARP_t self) {
+  if (self == nullptr) return nullptr;
+  return new MNN::Express::VARP(*self);
+}
+
+EXPRP_t mnn_expr_scope_escape_EXPRP(EXPRP_t self) {
+  if (self == nullptr) return nullptr;
+  return new MNN::Express::EXPRP(*self);
+}
+
+// Info query without allocation
+namespace {
+// Returns false if the dims do not fit, everything else is written regardless.
+bool fill_info(
+    const MNN::Express::VARP &v,
+    int32_t                  *ndim,
+    int32_t                  *dims,
+    size_t                    dims_capacity,
+    halide_type_c_t          *type,
+    int32_t                  *order,
+    size_t                   *size
+) {
+  auto info = v.get() ? v->getInfo() : nullptr;
+  if (info == nullptr) {
+    *ndim = -1;
+    if (type) *type = {0, 0, 0};
+    if (order) *order = 0;
+    if (size) *size = 0;
+    return true;
+  }
+  *ndim = (int32_t)info->dim.size();
+  if (type) *type = {static_cast<uint8_t>(info->type.code), info->type.bits, info->type.lanes};
+  if (order) *order = static_cast<int32_t>(info->order);
+  if (size) *size = info->size;
+  if (info->dim.size() > dims_capacity) return false;
+  if (!info->dim.empty()) memcpy(dims, info->dim.data(), sizeof(int32_t) * info->dim.size());
+  return true;
+}
+} // namespace
+
+mnn_error_code_t mnn_expr_VARP_get_info_into(
+    VARP_t           self,
+    int32_t         *ndim,
+    int32_t         *dims,
+    size_t           dims_capacity,
+    halide_type_c_t *type,
+    int32_t         *order,
+    size_t          *size
+) {
+  if (self == nullptr || ndim == nullptr || (dims == nullptr && dims_capacity > 0)) {
+    return MNNC_INVALID_PTR;
+  }
+  try {
+    bool fits = fill_info(*self, ndim, dims, dims_capacity, type, order, size);
+    return fits ? MNNC_NO_ERROR : MNNC_INVALID_VALUE;
+  } catch (...) { return MNNC_UNKNOWN_ERROR; }
+}
+
+mnn_error_code_t mnn_expr_VecVARP_get_info(
+    VecVARP_t        self,
+    int32_t         *ndims,
+    int32_t         *dims,
+    size_t           dims_capacity,
+    halide_type_c_t *types,
+    int32_t         *orders,
+    size_t          *sizes
+) {
+  if (self == nullptr || ndims == nullptr || (dims == nullptr && dims_capacity > 0)) {
+    return MNNC_INVALID_PTR;
+  }
+  try {
+    size_t used = 0;
+    bool   fits = true;
+    for (size_t i = 0; i < self->size(); i++) {
+      const size_t remain = fits ? dims_capacity - used : 0;
+      fits = fill_info(
+                 (*self)[i],
+                 ndims + i,
+                 fits ? dims + used : nullptr,
+                 remain,
+                 types ? types + i : nullptr,
+                 orders ? orders + i : nullptr,
+                 sizes ? sizes + i : nullptr
+             ) &&
+             fits;
+      if (ndims[i] > 0) used += ndims[i];
+    }
+    return fits ? MNNC_NO_ERROR : MNNC_INVALID_VALUE;
+  } catch (...) { return MNNC_UNKNOWN_ERROR; }
+}
+
+// Pinned read map
+mnn_error_code_t mnn_expr_VARP_readMap_pinned(
+    VARP_t self, const void **data, size_t *size, halide_type_c_t *type, VARP_t *pin
+) {
+  if (self == nullptr || self->get() == nullptr || data == nullptr || size == nullptr ||
+      pin == nullptr) {
+    return MNNC_INVALID_PTR;
+  }
+  try {
+    // a fresh variable on the same expression keeps it alive once `self` is freed
+    auto expr   = (*self)->expr();
+    auto pinned = MNN::Express::Variable::create(expr.first, expr.second);
+    auto info   = pinned->getInfo();
+    if (info == nullptr) return MNNC_COMPUTE_SIZE_ERROR;
+    const void *ptr = pinned->readMap<void>();
+    if (ptr == nullptr && info->size > 0) return MNNC_COMPUTE_SIZE_ERROR;
+    *data = ptr;
+    *size = info->size;
+    if (type) *type = {static_cast<uint8_t>(info->type.code), info->type.bits, info->type.lanes};
+    *pin = new MNN::Express::VARP(pinned);
+    return MNNC_NO_ERROR;
+  } catch (...) { return MNNC_UNKNOWN_ERROR; }
+}
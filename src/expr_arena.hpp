@@ -0,0 +1,96 @@
+/*
+ * expr_arena.hpp
+ * Internal slab allocator for VARP_t / EXPRP_t handles created inside an expression scope
+ *
+ * Author: Rainyl
+ * License: Apache License 2.0
+ */
+
+#ifndef MNN_C_EXPR_ARENA_HPP
+#define MNN_C_EXPR_ARENA_HPP
+
+#include "MNN/expr/Expr.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace mnnc {
+
+// Objects are constructed in blocks of kBlock and destroyed together by clear().
+template <typename T>
+class Slab {
+public:
+  Slab() = default;
+  Slab(const Slab &)            = delete;
+  Slab &operator=(const Slab &) = delete;
+  ~Slab() { clear(); }
+
+  template <typename... Args>
+  T *create(Args &&...args) {
+    if (_used == _blocks.size() * kBlock) {
+      _blocks.push_back(static_cast<T *>(::operator new(sizeof(T) * kBlock)));
+    }
+    T *p = _blocks[_used / kBlock] + _used % kBlock;
+    new (p) T(std::forward<Args>(args)...);
+    _used++;
+    return p;
+  }
+
+  bool owns(const void *p) const {
+    const uintptr_t addr = (uintptr_t)p;
+    for (T *b : _blocks) {
+      if (addr >= (uintptr_t)b && addr < (uintptr_t)(b + kBlock)) return true;
+    }
+    return false;
+  }
+
+  void clear() {
+    // reverse order, later handles are more likely to reference earlier ones
+    while (_used > 0) {
+      _used--;
+      _blocks[_used / kBlock][_used % kBlock].~T();
+    }
+    for (T *b : _blocks) ::operator delete(b);
+    _blocks.clear();
+  }
+
+  size_t size() const { return _used; }
+
+private:
+  static const size_t kBlock = 256;
+  std::vector<T *>    _blocks;
+  size_t              _used = 0;
+};
+
+// One expression scope, scopes of a thread form a stack through `parent`.
+struct ExprArena {
+  Slab<MNN::Express::VARP>  varps;
+  Slab<MNN::Express::EXPRP> exprs;
+  ExprArena                *parent = nullptr;
+};
+
+// Innermost scope of the calling thread, or nullptr if no scope is open.
+ExprArena *current_arena();
+
+// Whether the handle lives in one of the open scopes of the calling thread.
+bool arena_owns(const void *handle);
+
+// Allocate a VARP_t, from the innermost scope if one is open.
+template <typename... Args>
+MNN::Express::VARP *make_varp(Args &&...args) {
+  if (ExprArena *arena = current_arena()) return arena->varps.create(std::forward<Args>(args)...);
+  return new MNN::Express::VARP(std::forward<Args>(args)...);
+}
+
+// Allocate an EXPRP_t, from the innermost scope if one is open.
+template <typename... Args>
+MNN::Express::EXPRP *make_exprp(Args &&...args) {
+  if (ExprArena *arena = current_arena()) return arena->exprs.create(std::forward<Args>(args)...);
+  return new MNN::Express::EXPRP(std::forward<Args>(args)...);
+}
+
+} // namespace mnnc
+
+#endif // MNN_C_EXPR_ARENA_HPP
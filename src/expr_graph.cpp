@@ -0,0 +1,225 @@
+/*
+ * expr_graph.cpp
+ * MNN C API for building expression graphs in bulk
+ *
+ * Author: Rainyl
+ * License: Apache License 2.0
+ */
+
+#include "mnn_c/expr_graph.h"
+#include "MNN/expr/Expr.hpp"
+#include "MNN/expr/MathOp.hpp"
+#include "MNN/expr/NeuralNetWorkOp.hpp"
+#include <cstring>
+#include <vector>
+
+using MNN::Express::VARP;
+using MNN::Express::VARPS;
+
+namespace {
+
+// Reads one instruction, all accessors are bounds checked by decode().
+struct Instr {
+  int32_t        op;
+  const int32_t *in;
+  int32_t        num_in;
+  const int32_t *attr;
+  int32_t        num_attr;
+
+  float f32(int i) const {
+    float v;
+    memcpy(&v, &attr[i], sizeof(v));
+    return v;
+  }
+  std::vector<int> ints(int begin, int end) const {
+    return std::vector<int>(attr + begin, attr + end);
+  }
+};
+
+bool decode(const int32_t *code, size_t len, size_t &pc, Instr &ins) {
+  if (len - pc < 3) return false;
+  ins.op     = code[pc];
+  ins.num_in = code[pc + 1];
+  if (ins.num_in < 0 || (size_t)ins.num_in > len - pc - 3) return false;
+  ins.in       = code + pc + 2;
+  ins.num_attr = code[pc + 2 + ins.num_in];
+  ins.attr     = code + pc + 3 + ins.num_in;
+  if (ins.num_attr < 0 || (size_t)ins.num_attr > len - pc - 3 - ins.num_in) return false;
+  pc += 3 + ins.num_in + ins.num_attr;
+  return true;
+}
+
+// Returns MNNC_NO_ERROR and sets `out`, or an error code for a malformed instruction.
+mnn_error_code_t execute(const Instr &ins, const std::vector<VARP> &regs, VARP &out) {
+  for (int i = 0; i < ins.num_in; i++) {
+    if (ins.in[i] < 0 || (size_t)ins.in[i] >= regs.size()) return MNNC_INVALID_VALUE;
+  }
+  auto in = [&](int i) { return regs[ins.in[i]]; };
+#define EXPECT(n_in, min_attr)                                                                     \
+  if (ins.num_in != (n_in) || ins.num_attr < (min_attr)) return MNNC_INVALID_VALUE
+  using namespace MNN::Express;
+  switch (ins.op) {
+  case MNN_EXPR_OP_SCALAR_F32: EXPECT(0, 1); out = _Scalar<float>(ins.f32(0)); break;
+  case MNN_EXPR_OP_SCALAR_I32: EXPECT(0, 1); out = _Scalar<int>(ins.attr[0]); break;
+  case MNN_EXPR_OP_CONST_F32:
+  case MNN_EXPR_OP_CONST_I32: {
+    EXPECT(0, 1);
+    const int ndim = ins.attr[0];
+    if (ndim < 0 || ndim >= ins.num_attr) return MNNC_INVALID_VALUE;
+    auto   shape = ins.ints(1, 1 + ndim);
+    size_t count = 1;
+    for (int d : shape) {
+      if (d < 0) return MNNC_INVALID_VALUE;
+      count *= (size_t)d;
+    }
+    if (count != (size_t)(ins.num_attr - 1 - ndim)) return MNNC_INVALID_VALUE;
+    // float values are stored as bits, both types are copied as raw 4-byte words
+    auto type = ins.op == MNN_EXPR_OP_CONST_F32 ? halide_type_of<float>() : halide_type_of<int>();
+    out       = _Const(ins.attr + 1 + ndim, shape, NCHW, type);
+    break;
+  }
+
+  case MNN_EXPR_OP_ADD: EXPECT(2, 0); out = _Add(in(0), in(1)); break;
+  case MNN_EXPR_OP_SUB: EXPECT(2, 0); out = _Subtract(in(0), in(1)); break;
+  case MNN_EXPR_OP_MUL: EXPECT(2, 0); out = _Multiply(in(0), in(1)); break;
+  case MNN_EXPR_OP_DIV: EXPECT(2, 0); out = _Divide(in(0), in(1)); break;
+  case MNN_EXPR_OP_POW: EXPECT(2, 0); out = _Pow(in(0), in(1)); break;
+  case MNN_EXPR_OP_MAXIMUM: EXPECT(2, 0); out = _Maximum(in(0), in(1)); break;
+  case MNN_EXPR_OP_MINIMUM: EXPECT(2, 0); out = _Minimum(in(0), in(1)); break;
+  case MNN_EXPR_OP_GREATER: EXPECT(2, 0); out = _Greater(in(0), in(1)); break;
+  case MNN_EXPR_OP_GREATER_EQUAL: EXPECT(2, 0); out = _GreaterEqual(in(0), in(1)); break;
+  case MNN_EXPR_OP_LESS: EXPECT(2, 0); out = _Less(in(0), in(1)); break;
+  case MNN_EXPR_OP_LESS_EQUAL: EXPECT(2, 0); out = _LessEqual(in(0), in(1)); break;
+  case MNN_EXPR_OP_EQUAL: EXPECT(2, 0); out = _Equal(in(0), in(1)); break;
+
+  case MNN_EXPR_OP_NEG: EXPECT(1, 0); out = _Negative(in(0)); break;
+  case MNN_EXPR_OP_ABS: EXPECT(1, 0); out = _Abs(in(0)); break;
+  case MNN_EXPR_OP_EXP: EXPECT(1, 0); out = _Exp(in(0)); break;
+  case MNN_EXPR_OP_LOG: EXPECT(1, 0); out = _Log(in(0)); break;
+  case MNN_EXPR_OP_SQRT: EXPECT(1, 0); out = _Sqrt(in(0)); break;
+  case MNN_EXPR_OP_SQUARE: EXPECT(1, 0); out = _Square(in(0)); break;
+  case MNN_EXPR_OP_SIGMOID: EXPECT(1, 0); out = _Sigmoid(in(0)); break;
+  case MNN_EXPR_OP_TANH: EXPECT(1, 0); out = _Tanh(in(0)); break;
+  case MNN_EXPR_OP_RELU: EXPECT(1, 0); out = _Relu(in(0)); break;
+  case MNN_EXPR_OP_FLOOR: EXPECT(1, 0); out = _Floor(in(0)); break;
+  case MNN_EXPR_OP_CEIL: EXPECT(1, 0); out = _Ceil(in(0)); break;
+
+  case MNN_EXPR_OP_REDUCE_SUM:
+  case MNN_EXPR_OP_REDUCE_MEAN:
+  case MNN_EXPR_OP_REDUCE_MAX:
+  case MNN_EXPR_OP_REDUCE_MIN: {
+    EXPECT(1, 1);
+    const bool keep = ins.attr[0] != 0;
+    auto       axes = ins.ints(1, ins.num_attr);
+    if (ins.op == MNN_EXPR_OP_REDUCE_SUM) out = _ReduceSum(in(0), axes, keep);
+    else if (ins.op == MNN_EXPR_OP_REDUCE_MEAN) out = _ReduceMean(in(0), axes, keep);
+    else if (ins.op == MNN_EXPR_OP_REDUCE_MAX) out = _ReduceMax(in(0), axes, keep);
+    else out = _ReduceMin(in(0), axes, keep);
+    break;
+  }
+  case MNN_EXPR_OP_ARGMAX: EXPECT(1, 1); out = _ArgMax(in(0), ins.attr[0]); break;
+  case MNN_EXPR_OP_ARGMIN: EXPECT(1, 1); out = _ArgMin(in(0), ins.attr[0]); break;
+  case MNN_EXPR_OP_SOFTMAX: EXPECT(1, 1); out = _Softmax(in(0), ins.attr[0]); break;
+
+  case MNN_EXPR_OP_RESHAPE: EXPECT(1, 0); out = _Reshape(in(0), ins.ints(0, ins.num_attr)); break;
+  case MNN_EXPR_OP_TRANSPOSE:
+    EXPECT(1, 0);
+    out = _Transpose(in(0), ins.ints(0, ins.num_attr));
+    break;
+  case MNN_EXPR_OP_SQUEEZE: EXPECT(1, 0); out = _Squeeze(in(0), ins.ints(0, ins.num_attr)); break;
+  case MNN_EXPR_OP_UNSQUEEZE:
+    EXPECT(1, 0);
+    out = _Unsqueeze(in(0), ins.ints(0, ins.num_attr));
+    break;
+  case MNN_EXPR_OP_CONVERT:
+    EXPECT(1, 1);
+    out = _Convert(in(0), static_cast<Dimensionformat>(ins.attr[0]));
+    break;
+  case MNN_EXPR_OP_CAST:
+    EXPECT(1, 2);
+    out = _Cast(in(0), halide_type_t((halide_type_code_t)ins.attr[0], ins.attr[1]));
+    break;
+
+  case MNN_EXPR_OP_STRIDED_SLICE: {
+    EXPECT(1, 1);
+    const int n = ins.attr[0];
+    if (n < 0 || ins.num_attr != 1 + 3 * n + 5) return MNNC_INVALID_VALUE;
+    const int32_t *a       = ins.attr + 1;
+    const int32_t *m       = a + 3 * n;
+    auto           begin   = _Const(a, {n}, NCHW, halide_type_of<int>());
+    auto           end     = _Const(a + n, {n}, NCHW, halide_type_of<int>());
+    auto           strides = _Const(a + 2 * n, {n}, NCHW, halide_type_of<int>());
+    out = _StridedSlice(in(0), begin, end, strides, m[0], m[1], m[2], m[3], m[4]);
+    break;
+  }
+  case MNN_EXPR_OP_GATHER:
+    EXPECT(2, 1);
+    out = _GatherV2(in(0), in(1), _Scalar<int>(ins.attr[0]));
+    break;
+  case MNN_EXPR_OP_STACK:
+  case MNN_EXPR_OP_CONCAT: {
+    if (ins.num_in < 1 || ins.num_attr < 1) return MNNC_INVALID_VALUE;
+    VARPS values;
+    values.reserve(ins.num_in);
+    for (int i = 0; i < ins.num_in; i++) values.push_back(in(i));
+    if (ins.op == MNN_EXPR_OP_STACK) out = _Stack(values, ins.attr[0]);
+    else out = _Concat(values, ins.attr[0]);
+    break;
+  }
+  case MNN_EXPR_OP_SELECT: EXPECT(3, 0); out = _Select(in(0), in(1), in(2)); break;
+  case MNN_EXPR_OP_MATMUL:
+    EXPECT(2, 2);
+    out = _MatMul(in(0), in(1), ins.attr[0] != 0, ins.attr[1] != 0);
+    break;
+  case MNN_EXPR_OP_NMS:
+    EXPECT(2, 3);
+    out = _Nms(in(0), in(1), ins.attr[0], ins.f32(1), ins.f32(2));
+    break;
+  default: return MNNC_NOT_SUPPORT;
+  }
+#undef EXPECT
+  return out.get() ? MNNC_NO_ERROR : MNNC_INVALID_VALUE;
+}
+
+} // namespace
+
+mnn_error_code_t mnn_expr_build_graph(
+    const int32_t *code,
+    size_t         code_len,
+    VecVARP_t      inputs,
+    const int32_t *outputs,
+    size_t         num_outputs,
+    VecVARP_t     *out,
+    size_t        *error_offset
+) {
+  if ((!code && code_len > 0) || (!outputs && num_outputs > 0) || !out) return MNNC_INVALID_PTR;
+  try {
+    std::vector<VARP> regs;
+    if (inputs) regs = *inputs;
+    size_t pc = 0;
+    while (pc < code_len) {
+      const size_t     start = pc;
+      Instr            ins;
+      VARP             result;
+      mnn_error_code_t code_ = decode(code, code_len, pc, ins) ? execute(ins, regs, result)
+                                                               : MNNC_INVALID_VALUE;
+      if (code_ != MNNC_NO_ERROR) {
+        if (error_offset) *error_offset = start;
+        return code_;
+      }
+      regs.push_back(result);
+    }
+    auto *result = new VARPS();
+    result->reserve(num_outputs);
+    for (size_t i = 0; i < num_outputs; i++) {
+      if (outputs[i] < 0 || (size_t)outputs[i] >= regs.size()) {
+        delete result;
+        if (error_offset) *error_offset = code_len;
+        return MNNC_INVALID_VALUE;
+      }
+      result->push_back(regs[outputs[i]]);
+    }
+    *out = result;
+    return MNNC_NO_ERROR;
+  } catch (...) { return MNNC_UNKNOWN_ERROR; }
+}
@@ -0,0 +1,196 @@
+/*
+ * graph_cache.cpp
+ * MNN C API for caching compiled expression graphs
+ *
+ * Author: Rainyl
+ * License: Apache License 2.0
+ */
+
+#include "mnn_c/graph_cache.h"
+#include "MNN/expr/Expr.hpp"
+#include "MNN/expr/Module.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+using MNN::Express::Module;
+using MNN::Express::VARP;
+using MNN::Express::VARPS;
+using MNN::Express::Variable;
+
+namespace {
+
+// Graphs are keyed by two independent 64-bit hashes and the length of the serialized graph,
+// so that entries keep neither the serialized bytes nor a copy of the constant data.
+struct GraphKey {
+  uint64_t             fnv;
+  uint64_t             mix;
+  uint64_t             size;
+  std::vector<int32_t> bindings;
+
+  bool operator==(const GraphKey &other) const {
+    return fnv == other.fnv && mix == other.mix && size == other.size &&
+           bindings == other.bindings;
+  }
+};
+
+struct GraphKeyHash {
+  size_t operator()(const GraphKey &key) const { return (size_t)key.fnv; }
+};
+
+uint64_t fnv1a(const int8_t *data, size_t size) {
+  uint64_t h = 14695981039346656037ull;
+  for (size_t i = 0; i < size; i++) {
+    h ^= (uint8_t)data[i];
+    h *= 1099511628211ull;
+  }
+  return h;
+}
+
+// multiply-xorshift over 8 byte words, independent of fnv1a
+uint64_t mix64(const int8_t *data, size_t size) {
+  uint64_t h = 0x9e3779b97f4a7c15ull ^ size;
+  size_t   i = 0;
+  for (; i + 8 <= size; i += 8) {
+    uint64_t w;
+    memcpy(&w, data + i, 8);
+    h = (h ^ w) * 0xff51afd7ed558ccdull;
+    h ^= h >> 32;
+  }
+  uint64_t tail = 0;
+  if (i < size) memcpy(&tail, data + i, size - i);
+  h = (h ^ tail) * 0xc4ceb9fe1a85ec53ull;
+  return h ^ (h >> 29);
+}
+
+// The serialized graph covers ops, attributes, input shapes and constant data but not
+// the data of placeholders, the positions of `inputs` in the execution order are
+// added so that the same graph bound to different inputs gets another key.
+GraphKey graph_key(const VARPS &inputs, const VARPS &outputs) {
+  auto     buffer = Variable::save(outputs);
+  GraphKey key;
+  key.fnv   = fnv1a(buffer.data(), buffer.size());
+  key.mix   = mix64(buffer.data(), buffer.size());
+  key.size  = buffer.size();
+
+  auto order = Variable::getExecuteOrder(outputs);
+  for (const auto &input : inputs) {
+    auto expr = input->expr();
+    key.bindings.push_back(
+        (int32_t)(std::find(order.begin(), order.end(), expr.first) - order.begin())
+    );
+    key.bindings.push_back((int32_t)expr.second);
+  }
+  return key;
+}
+
+} // namespace
+
+struct mnn_graph_cache {
+  struct Entry {
+    std::shared_ptr<Module> module;
+    // a compiled module is not reentrant
+    std::mutex lock;
+  };
+  typedef std::unordered_map<GraphKey, std::shared_ptr<Entry>, GraphKeyHash> Map;
+  // most recently used first, points to the keys of `entries`
+  typedef std::list<const GraphKey *>                         Lru;
+  typedef std::unordered_map<const GraphKey *, Lru::iterator> LruPos;
+
+  size_t     capacity = 0;
+  std::mutex lock;
+  Map        entries;
+  Lru        lru;
+  LruPos     lru_pos;
+
+  std::shared_ptr<Entry> find(const GraphKey &key) {
+    std::lock_guard<std::mutex> guard(lock);
+    auto                        it = entries.find(key);
+    if (it == entries.end()) return nullptr;
+    lru.splice(lru.begin(), lru, lru_pos[&it->first]);
+    return it->second;
+  }
+
+  std::shared_ptr<Entry> insert(const GraphKey &key, std::shared_ptr<Entry> entry) {
+    std::lock_guard<std::mutex> guard(lock);
+    auto                        res = entries.emplace(key, entry);
+    // compiled concurrently by another caller, keep the first one
+    if (!res.second) return res.first->second;
+    lru.push_front(&res.first->first);
+    lru_pos[&res.first->first] = lru.begin();
+    while (capacity > 0 && entries.size() > capacity) {
+      const GraphKey *last = lru.back();
+      lru.pop_back();
+      lru_pos.erase(last);
+      entries.erase(entries.find(*last));
+    }
+    return entry;
+  }
+};
+
+mnn_graph_cache_t mnn_graph_cache_create(size_t capacity) {
+  auto cache      = new mnn_graph_cache();
+  cache->capacity = capacity;
+  return cache;
+}
+
+void mnn_graph_cache_destroy(mnn_graph_cache_t self) {
+  if (self) {
+    delete self;
+    self = nullptr;
+  }
+}
+
+mnn_error_code_t mnn_graph_cache_run(
+    mnn_graph_cache_t self, VecVARP_t inputs, VecVARP_t outputs, VecVARP_t *results, bool *hit
+) {
+  if (!self || !inputs || !outputs || !results) return MNNC_INVALID_PTR;
+  try {
+    for (const auto &v : *inputs) {
+      if (v.get() == nullptr) return MNNC_INVALID_PTR;
+    }
+    for (const auto &v : *outputs) {
+      if (v.get() == nullptr) return MNNC_INVALID_PTR;
+    }
+    const GraphKey key   = graph_key(*inputs, *outputs);
+    auto           entry = self->find(key);
+    if (hit) *hit = entry != nullptr;
+    if (!entry) {
+      // compile outside the cache lock, extraction is the slow part
+      std::shared_ptr<Module> module(
+          Module::extract(*inputs, *outputs, false), [](Module *m) { Module::destroy(m); }
+      );
+      if (!module) return MNNC_NOT_SUPPORT;
+      entry         = std::make_shared<mnn_graph_cache::Entry>();
+      entry->module = module;
+      entry         = self->insert(key, entry);
+    }
+    VARPS _outputs;
+    {
+      std::lock_guard<std::mutex> guard(entry->lock);
+      _outputs = entry->module->onForward(*inputs);
+    }
+    if (_outputs.size() != outputs->size()) return MNNC_UNKNOWN_ERROR;
+    *results = new VARPS(_outputs);
+    return MNNC_NO_ERROR;
+  } catch (...) { return MNNC_UNKNOWN_ERROR; }
+}
+
+size_t mnn_graph_cache_size(mnn_graph_cache_t self) {
+  if (!self) return 0;
+  std::lock_guard<std::mutex> guard(self->lock);
+  return self->entries.size();
+}
+
+void mnn_graph_cache_clear(mnn_graph_cache_t self) {
+  if (!self) return;
+  std::lock_guard<std::mutex> guard(self->lock);
+  self->lru.clear();
+  self->lru_pos.clear();
+  self->entries.clear();
+}
@@ -0,0 +1,198 @@
+/*
+ * detection.h
+ * MNN C API for fused detector postprocessing
+ *
+ * Decodes raw detection heads, filters them by score, runs NMS and maps the boxes back
+ * to the original image in a single call, reading the head in its own layout. Batched
+ * multi-class NMS, Soft-NMS and rotated boxes are available on their own as well.
+ *
+ * Author: Rainyl
+ * License: Apache License 2.0
+ */
+
+#ifndef MNN_DETECTION_H
+#define MNN_DETECTION_H
+
+#include "mnn_c/base.h"
+#include "mnn_c/error_code.h"
+#include "mnn_c/postprocess.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+  /** Anchor-free YOLO (v8, v11), channels [cx, cy, w, h, class scores...] */
+  MNN_DETECT_YOLO = 0,
+  /** YOLO with objectness (v5, v7), channels [cx, cy, w, h, obj, class scores...] */
+  MNN_DETECT_YOLO_OBJ = 1,
+  /** SSD, channels [dx, dy, dw, dh] decoded against priors, class scores in a second input */
+  MNN_DETECT_SSD = 2,
+} mnn_detect_format_t;
+
+typedef enum {
+  /** Scores are probabilities already */
+  MNN_SCORE_NONE = 0,
+  /** Class scores and objectness are logits of independent sigmoids */
+  MNN_SCORE_SIGMOID = 1,
+  /** Class scores are logits of a softmax over all classes */
+  MNN_SCORE_SOFTMAX = 2,
+} mnn_score_activation_t;
+
+typedef struct mnn_detect_params_t {
+  /** mnn_detect_format_t */
+  int32_t format;
+  /** mnn_score_activation_t */
+  int32_t activation;
+  float   score_threshold;
+  float   iou_threshold;
+  /** Highest scoring candidates kept per image before NMS, <= 0 keeps all */
+  int32_t top_k;
+  /** Maximum number of detections per image */
+  int32_t max_detections;
+  /** Whether boxes of different classes suppress each other */
+  bool class_agnostic;
+  /** Class never reported, e.g., 0 for SSD, -1 for none */
+  int32_t background_class;
+  /** SSD only, scales of dx, dy, dw and dh */
+  float variances[4];
+} mnn_detect_params_t;
+
+/**
+ * Mapping from network input coordinates back to the original image,
+ * x_original = (x - pad_x) / scale.
+ */
+typedef struct mnn_letterbox_t {
+  float scale;
+  float pad_x;
+  float pad_y;
+  /** Size of the original image to clip boxes to, <= 0 disables clipping */
+  float width;
+  float height;
+} mnn_letterbox_t;
+
+typedef struct mnn_detection_t {
+  float   x0;
+  float   y0;
+  float   x1;
+  float   y1;
+  float   score;
+  int32_t class_id;
+} mnn_detection_t;
+
+/**
+ * @brief Decode, score filter, NMS and letterbox un-mapping of a detection head
+ *
+ * The head is viewed as [batch, channel, anchors] by its layout, so [1, 84, 8400] and
+ * [1, 8400, 84] outputs are both read in place. Each anchor keeps its best class, boxes
+ * are decoded only for the candidates that pass score_threshold and top_k, and NMS stops
+ * once max_detections boxes are kept. Images of the batch are processed in parallel.
+ *
+ * @param head Float data of the head, box regressions for SSD
+ * @param head_layout Layout of head, channel is 4 for SSD
+ * @param scores SSD class scores, NULL for YOLO
+ * @param score_layout Layout of scores, channel is the number of classes, NULL for YOLO
+ * @param priors SSD priors [anchors, 4] as cx, cy, w, h in input pixels, NULL for YOLO
+ * @param params Postprocess parameters
+ * @param letterbox Letterbox of each image, can be NULL
+ * @param num_letterbox 0 for no mapping, 1 to share one letterbox, or the batch size
+ * @param dets Output detections, [batch, max_detections], sorted by score in each image
+ * @param counts Output number of detections of each image, [batch]
+ * @param num_threads Number of threads, <= 0 means using all available threads
+ * @return Error code
+ */
+MNN_C_API mnn_error_code_t mnn_detect_postprocess(
+    const float               *head,
+    const mnn_tensor_layout_t *head_layout,
+    const float               *scores,
+    const mnn_tensor_layout_t *score_layout,
+    const float               *priors,
+    const mnn_detect_params_t *params,
+    const mnn_letterbox_t     *letterbox,
+    size_t                     num_letterbox,
+    mnn_detection_t           *dets,
+    int32_t                   *counts,
+    int                        num_threads
+);
+
+typedef enum {
+  /** Greedy NMS, boxes overlapping a kept one by more than iou_threshold are removed */
+  MNN_NMS_HARD = 0,
+  /** Soft-NMS, scores of overlapping boxes decay by (1 - iou) above iou_threshold */
+  MNN_NMS_SOFT_LINEAR = 1,
+  /** Soft-NMS, scores of overlapping boxes decay by exp(-iou^2 / sigma) */
+  MNN_NMS_SOFT_GAUSSIAN = 2,
+} mnn_nms_method_t;
+
+typedef struct mnn_nms_params_t {
+  /** mnn_nms_method_t */
+  int32_t method;
+  float   iou_threshold;
+  /** Candidates below it are dropped, also after Soft-NMS decay */
+  float score_threshold;
+  /** Gaussian Soft-NMS only */
+  float sigma;
+  /** Maximum number of boxes kept per class and image, <= 0 means no limit */
+  int32_t max_per_class;
+  /** Maximum number of boxes kept per image */
+  int32_t max_detections;
+  /** Whether boxes of different classes suppress each other */
+  bool class_agnostic;
+  /** Whether boxes are rotated [cx, cy, w, h, angle] with angle in radians */
+  bool rotated;
+} mnn_nms_params_t;
+
+typedef struct mnn_nms_result_t {
+  int32_t box_index;
+  int32_t class_id;
+  /** Score after Soft-NMS decay */
+  float score;
+} mnn_nms_result_t;
+
+/**
+ * @brief Batched multi-class NMS
+ *
+ * Each class of each image is suppressed independently, or all classes of an image
+ * together if class_agnostic, in parallel. Candidates are sorted by score and indexed by
+ * x0, so a kept box only visits the candidates whose x ranges can overlap it, which
+ * scales to tens of thousands of candidates.
+ *
+ * @param boxes Boxes shared by all classes, [batch, num_boxes, 4] as x0, y0, x1, y1,
+ * or [batch, num_boxes, 5] as cx, cy, w, h, angle if rotated
+ * @param scores Scores, [batch, num_boxes, num_classes]
+ * @param batch Batch size
+ * @param num_boxes Number of boxes of each image
+ * @param num_classes Number of classes
+ * @param params NMS parameters
+ * @param results Output kept boxes, [batch, max_detections], sorted by score in each image
+ * @param counts Output number of kept boxes of each image, [batch]
+ * @param num_threads Number of threads, <= 0 means using all available threads
+ * @return Error code
+ */
+MNN_C_API mnn_error_code_t mnn_nms_batched(
+    const float            *boxes,
+    const float            *scores,
+    int                     batch,
+    int                     num_boxes,
+    int                     num_classes,
+    const mnn_nms_params_t *params,
+    mnn_nms_result_t       *results,
+    int32_t                *counts,
+    int                     num_threads
+);
+
+/**
+ * @brief Intersection over union of two rotated boxes
+ * @param a Box [cx, cy, w, h, angle] with angle in radians
+ * @param b Box [cx, cy, w, h, angle] with angle in radians
+ * @return IoU in [0, 1]
+ */
+MNN_C_API float mnn_rotated_iou(const float *a, const float *b);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MNN_DETECTION_H
@@ -0,0 +1,131 @@
+/*
+ * dynamic_batcher.h
+ * MNN C API for dynamic batching of module requests
+ *
+ * A batcher owns a thread, an executor and a clone of a module sharing its weights.
+ * Requests queued from any thread are gathered until max_batch rows are queued or the
+ * oldest request has waited max_delay_us, compatible inputs are concatenated along axis 0,
+ * one onForward runs on the batch and the outputs are split back per request.
+ *
+ * Author: Rainyl
+ * License: Apache License 2.0
+ */
+
+#ifndef MNN_DYNAMIC_BATCHER_H
+#define MNN_DYNAMIC_BATCHER_H
+
+#include "mnn_c/base.h"
+#include "mnn_c/error_code.h"
+#include "mnn_c/expr.h"
+#include "mnn_c/module.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef __cplusplus
+typedef struct mnn_dynamic_batcher *mnn_dynamic_batcher_t;
+#else
+typedef void *mnn_dynamic_batcher_t;
+#endif
+
+typedef struct mnn_dynamic_batcher_stats_t {
+  /** Number of requests served */
+  uint64_t requests;
+  /** Number of forward runs */
+  uint64_t batches;
+  /** Total time requests waited in the queue, in nanoseconds */
+  uint64_t queue_delay_ns;
+  /** Longest time a request waited in the queue, in nanoseconds */
+  uint64_t max_queue_delay_ns;
+} mnn_dynamic_batcher_stats_t;
+
+/**
+ * @brief Create a dynamic batcher over a clone of a module sharing its parameters
+ * @param module Module to clone, must outlive the batcher, its inputs and outputs must have
+ * the batch on axis 0
+ * @param type Forward type of the executor, MNNForwardType
+ * @param config Backend config of the executor
+ * @param num_thread Number of threads of the executor
+ * @param max_batch Maximum number of rows along axis 0 in one forward
+ * @param max_delay_us Maximum time the oldest request waits for a batch to fill, in
+ * microseconds
+ * @return Dynamic batcher, NULL if max_batch < 1 or the clone failed
+ */
+MNN_C_API mnn_dynamic_batcher_t mnn_dynamic_batcher_create(
+    mnn_module_t         module,
+    int                  type,
+    mnn_backend_config_t config,
+    int                  num_thread,
+    int                  max_batch,
+    uint64_t             max_delay_us
+);
+
+/**
+ * @brief Destroy a dynamic batcher, queued requests are served first without waiting
+ * @param self Dynamic batcher
+ */
+MNN_C_API void mnn_dynamic_batcher_destroy(mnn_dynamic_batcher_t self);
+
+/**
+ * @brief Get the maximum number of rows in one forward
+ * @param self Dynamic batcher
+ * @return Maximum batch size
+ */
+MNN_C_API int mnn_dynamic_batcher_max_batch(mnn_dynamic_batcher_t self);
+
+/**
+ * @brief Queue a request for the next batch
+ *
+ * All inputs must have the same size on axis 0, between 1 and max_batch. Requests are
+ * batched with requests whose inputs match in count, type, format and shape except axis 0.
+ * The inputs are referenced until the request is served and must not be written meanwhile.
+ * Outputs with the batch size on axis 0 are split back, other outputs are shared by all
+ * requests of the batch.
+ *
+ * @param self Dynamic batcher
+ * @param inputs Input variables
+ * @param outputs Output variables, must be freed by mnn_expr_VecVARP_free, set to NULL if
+ * forward fails
+ * @param callback If NULL, block until the outputs are ready, otherwise return after
+ * queueing and call it from the batcher thread once outputs is written
+ * @return Error code, MNNC_INVALID_VALUE if the batch sizes of the inputs are invalid,
+ * MNNC_UNKNOWN_ERROR if a blocking forward fails
+ */
+MNN_C_API mnn_error_code_t mnn_dynamic_batcher_forward(
+    mnn_dynamic_batcher_t self, VecVARP_t inputs, VecVARP_t *outputs, mnn_callback_0 callback
+);
+
+/**
+ * @brief Get the number of queued requests
+ * @param self Dynamic batcher
+ * @return Number of pending requests
+ */
+MNN_C_API size_t mnn_dynamic_batcher_pending(mnn_dynamic_batcher_t self);
+
+/**
+ * @brief Get the request and queueing delay statistics
+ * @param self Dynamic batcher
+ * @param stats Output statistics
+ * @return Error code
+ */
+MNN_C_API mnn_error_code_t
+mnn_dynamic_batcher_get_stats(mnn_dynamic_batcher_t self, mnn_dynamic_batcher_stats_t *stats);
+
+/**
+ * @brief Get the histogram of batch sizes
+ * @param self Dynamic batcher
+ * @param counts Output counts, counts[i] is the number of forwards of i + 1 rows
+ * @param size Length of counts, entries past max_batch are set to 0
+ * @return Error code
+ */
+MNN_C_API mnn_error_code_t
+mnn_dynamic_batcher_get_histogram(mnn_dynamic_batcher_t self, uint64_t *counts, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MNN_DYNAMIC_BATCHER_H
@@ -0,0 +1,43 @@
+/*
+ * eager.h
+ * MNN C API for eager evaluation of small tensors
+ *
+ * Author: Rainyl
+ * License: Apache License 2.0
+ */
+
+#ifndef MNN_EAGER_H
+#define MNN_EAGER_H
+
+#include "mnn_c/base.h"
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Set the size threshold of eager evaluation on the calling thread
+ *
+ * When all inputs of an elementwise, broadcast or reduction op are float32 or int32
+ * constants with at most `max_elements` elements, mnn_expr_Add, mnn_expr_VARP_op_add,
+ * mnn_expr_ReduceSum and the like compute the result on host memory and return a
+ * constant instead of adding a node to the expression graph.
+ *
+ * The threshold is per thread and only affects ops created on the calling thread.
+ *
+ * @param max_elements Maximum number of elements of each input, 0 disables eager evaluation
+ */
+MNN_C_API void mnn_expr_set_eager_threshold(size_t max_elements);
+
+/**
+ * @brief Get the size threshold of eager evaluation on the calling thread
+ * @return Maximum number of elements, 0 means disabled
+ */
+MNN_C_API size_t mnn_expr_get_eager_threshold();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MNN_EAGER_H
@@ -0,0 +1,43 @@
+/*
+ * einsum.h
+ * MNN C API for Einstein summation over expression variables
+ *
+ * Author: Rainyl
+ * License: Apache License 2.0
+ */
+
+#ifndef MNN_EINSUM_H
+#define MNN_EINSUM_H
+
+#include "mnn_c/base.h"
+#include "mnn_c/error_code.h"
+#include "mnn_c/expr.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Evaluate an Einstein summation over the operands
+ *
+ * Supports the numpy subscript syntax, e.g., "ij,jk->ik", "bhqd,bhkd->bhqk", "ii->i",
+ * "...ij,...jk" and implicit outputs. Dimensions of size 1 broadcast. Labels used by a
+ * single operand are summed first, then operands are contracted pairwise in the order
+ * with the least multiply-adds, exhaustively for up to 8 operands and greedily beyond,
+ * each step lowered to Transpose, Reshape and MatMul or BatchMatMul. Shapes of all
+ * operands must be known.
+ *
+ * @param subscripts Subscripts of the operands and optionally of the output
+ * @param operands Operands
+ * @param out Result variable, must be freed by mnn_expr_VARP_free
+ * @return Error code, MNNC_INVALID_VALUE if the subscripts do not match the operands,
+ * MNNC_COMPUTE_SIZE_ERROR if a shape is unknown
+ */
+MNN_C_API mnn_error_code_t
+mnn_expr_Einsum(const char *subscripts, VecVARP_t operands, VARP_t *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MNN_EINSUM_H
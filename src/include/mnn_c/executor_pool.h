@@ -0,0 +1,145 @@
+/*
+ * executor_pool.h
+ * MNN C API for pools of expression executors
+ *
+ * Expression evaluation goes through the executor of the current ExecutorScope, which is
+ * the global executor unless a scope is entered, so concurrent expression work from
+ * several threads contends on one executor. A pool leases a dedicated executor to each
+ * thread that binds to it.
+ *
+ * Author: Rainyl
+ * License: Apache License 2.0
+ */
+
+#ifndef MNN_EXECUTOR_POOL_H
+#define MNN_EXECUTOR_POOL_H
+
+#include "mnn_c/base.h"
+#include "mnn_c/error_code.h"
+#include "mnn_c/expr.h"
+#include "mnn_c/module.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef __cplusplus
+typedef struct mnn_executor_pool *mnn_executor_pool_t;
+#else
+typedef void *mnn_executor_pool_t;
+#endif
+
+typedef struct mnn_executor_stats_t {
+  /** Number of bindings and parallel tasks served */
+  uint64_t tasks;
+  /** Total time the executor was leased, in nanoseconds */
+  uint64_t busy_ns;
+  /** Number of gc runs through the pool */
+  uint64_t gc_count;
+  /** Whether the executor is currently leased */
+  bool in_use;
+} mnn_executor_stats_t;
+
+/**
+ * @brief Create a pool of executors by mnn_executor_static_new_executor
+ * @param type Forward type, MNNForwardType
+ * @param config Backend config of each executor
+ * @param num_thread Number of threads of each executor
+ * @param size Number of executors, 0 means one per hardware thread
+ * @return Executor pool
+ */
+MNN_C_API mnn_executor_pool_t mnn_executor_pool_create(
+    /*MNNForwardType*/ int type, mnn_backend_config_t config, int num_thread, size_t size
+);
+
+/**
+ * @brief Destroy an executor pool, no thread may be bound to it
+ * @param self Executor pool
+ */
+MNN_C_API void mnn_executor_pool_destroy(mnn_executor_pool_t self);
+
+/**
+ * @brief Get the number of executors
+ * @param self Executor pool
+ * @return Number of executors
+ */
+MNN_C_API size_t mnn_executor_pool_size(mnn_executor_pool_t self);
+
+/**
+ * @brief Get an executor of the pool
+ * @param self Executor pool
+ * @param index Index of the executor
+ * @return Executor, must be freed by mnn_executor_destroy, NULL if index is out of range
+ */
+MNN_C_API mnn_executor_t mnn_executor_pool_get(mnn_executor_pool_t self, size_t index);
+
+/**
+ * @brief Bind the calling thread to an executor of the pool
+ *
+ * Leases a free executor to the thread, blocking while all of them are leased, and enters
+ * an ExecutorScope of it so that expressions created and computed on this thread use it.
+ * Nested binds on the same thread reuse the executor. Bindings of different pools on one
+ * thread must be unbound in reverse order.
+ * Bindings are keyed by the OS thread, the matching unbind must run on the same thread
+ * before any point where the caller may move to another one.
+ *
+ * @param self Executor pool
+ * @param index Output index of the bound executor, can be NULL
+ * @return Error code
+ */
+MNN_C_API mnn_error_code_t mnn_executor_pool_bind(mnn_executor_pool_t self, size_t *index);
+
+/**
+ * @brief Leave the scope entered by the last mnn_executor_pool_bind on the calling thread
+ *
+ * The executor is returned to the pool when the outermost bind is left.
+ *
+ * @param self Executor pool
+ * @return Error code, MNNC_INVALID_VALUE if the thread is not bound
+ */
+MNN_C_API mnn_error_code_t mnn_executor_pool_unbind(mnn_executor_pool_t self);
+
+/**
+ * @brief Compute variables whose graphs are independent concurrently on the pool
+ *
+ * The same as mnn_expr_VARP_static_compute_parallel with the executors of this pool.
+ *
+ * A thread bound to the pool computes its share on its own executor, other executors
+ * are only used while free, so it can be called between bind and unbind.
+ *
+ * @param self Executor pool
+ * @param vars Variables to compute
+ * @param forceCPU Whether to force computing on CPU
+ * @param max_workers Maximum number of concurrent groups, <= 0 means the size of the pool
+ * @param num_groups Output number of independent groups, can be NULL
+ * @return Error code
+ */
+MNN_C_API mnn_error_code_t mnn_executor_pool_compute(
+    mnn_executor_pool_t self, VecVARP_t vars, bool forceCPU, int max_workers, size_t *num_groups
+);
+
+/**
+ * @brief Get the usage statistics of an executor
+ * @param self Executor pool
+ * @param index Index of the executor
+ * @param stats Output statistics
+ * @return Error code, MNNC_INVALID_VALUE if index is out of range
+ */
+MNN_C_API mnn_error_code_t
+mnn_executor_pool_get_stats(mnn_executor_pool_t self, size_t index, mnn_executor_stats_t *stats);
+
+/**
+ * @brief Run gc on all executors that are not leased
+ * @param self Executor pool
+ * @param flag GCFlag, 0 for FULL and 1 for PART
+ * @return Number of collected executors
+ */
+MNN_C_API size_t mnn_executor_pool_gc(mnn_executor_pool_t self, /*GCFlag*/ int flag);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MNN_EXECUTOR_POOL_H
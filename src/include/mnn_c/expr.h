@@ -2,6 +2,7 @@
 #define MNN_EXPR_H
 
 #include "mnn_c/base.h"
+#include "mnn_c/error_code.h"
 #include "mnn_c/stdvec.h"
 #include "mnn_c/tensor.h"
 #include <stddef.h>
@@ -24,6 +25,7 @@ typedef std::pair<
     std::map<std::string, MNN::Express::VARP>>    *VARMAP_PAIR_t;
 typedef std::map<std::string, MNN::Express::VARP> *VARMAP_t;
 typedef MNN::NetT                                 *Net_t;
+typedef struct mnn_expr_scope                     *mnn_expr_scope_t;
 #else
 typedef void *VARP_t;
 typedef void *EXPRP_t;
@@ -35,6 +37,7 @@ typedef void *Op_t;
 typedef void *VARMAP_PAIR_t;
 typedef void *VARMAP_t;
 typedef void *Net_t;
+typedef void *mnn_expr_scope_t;
 #endif
 
 struct mnn_expr_Variable_Info {
@@ -115,6 +118,59 @@ MNN_C_API void  mnn_expr_VARP_static_save(VecVARP_t vars, const char *fileName);
 MNN_C_API VecI8 mnn_expr_VARP_static_saveBytes(VecVARP_t vars);
 MNN_C_API void  mnn_expr_VARP_static_saveNet(VecVARP_t vars, Net_t dest);
 
+// Streaming save and mapped load
+/**
+ * @brief Writer of mnn_expr_VARP_static_save_callback
+ * @param user_data User data passed to mnn_expr_VARP_static_save_callback
+ * @param data Chunk of the serialized variables, only valid during the call
+ * @param size Size of the chunk in bytes
+ * @return Number of bytes consumed, anything less than size stops the save
+ */
+typedef size_t (*mnn_expr_write_callback_t)(void *user_data, const void *data, size_t size);
+
+/**
+ * @brief Serialize variables directly to an open file descriptor
+ * @param vars Variables to save
+ * @param fd File descriptor opened for writing, not closed
+ * @return Error code, MNNC_FILE_CREATE_FAILED if writing fails
+ */
+MNN_C_API mnn_error_code_t mnn_expr_VARP_static_save_fd(VecVARP_t vars, int fd);
+
+/**
+ * @brief Serialize variables and pass the bytes to a writer chunk by chunk
+ *
+ * Unlike mnn_expr_VARP_static_saveBytes the serialized bytes are not copied into a
+ * returned vector, the writer consumes them in place.
+ *
+ * @param vars Variables to save
+ * @param writer Writer called on the calling thread
+ * @param user_data User data passed to writer
+ * @param chunk_size Maximum size of each chunk, 0 means the whole buffer at once
+ * @return Error code, MNNC_CALL_BACK_STOP if the writer stopped the save
+ */
+MNN_C_API mnn_error_code_t mnn_expr_VARP_static_save_callback(
+    VecVARP_t vars, mnn_expr_write_callback_t writer, void *user_data, size_t chunk_size
+);
+
+/**
+ * @brief Load variables from a memory-mapped file
+ *
+ * The file is mapped instead of read into a heap buffer and unmapped after loading.
+ *
+ * @param fileName Path of the file
+ * @param out Loaded variables, must be freed by mnn_expr_VecVARP_free
+ * @return Error code
+ */
+MNN_C_API mnn_error_code_t mnn_expr_VARP_static_load_mmap(const char *fileName, VecVARP_t *out);
+
+/**
+ * @brief Load named variables from a memory-mapped file
+ * @param fileName Path of the file
+ * @param out Loaded variables, must be freed by mnn_expr_VARMAP_free
+ * @return Error code
+ */
+MNN_C_API mnn_error_code_t mnn_expr_VARP_static_loadMap_mmap(const char *fileName, VARMAP_t *out);
+
 MNN_C_API void                 mnn_expr_VARP_static_prepareCompute(VecVARP_t vars, bool forceCPU);
 MNN_C_API void                 mnn_expr_VARP_static_compute(VecVARP_t vars, bool forceCPU);
 MNN_C_API size_t               mnn_expr_VARP_linkNumber(VARP_t self);
@@ -122,6 +178,24 @@ MNN_C_API const VecWeakEXPRP_t mnn_expr_VARP_toExprs(VARP_t self);
 MNN_C_API void                 mnn_expr_VARP_setExpr(VARP_t self, EXPRP_t expr, int index);
 MNN_C_API const mnn_tensor_t   mnn_expr_VARP_getTensor(VARP_t self);
 
+/**
+ * @brief Compute variables whose graphs are independent concurrently
+ *
+ * The variables are partitioned into groups that share no op nodes, leaves such as
+ * inputs and constants may be shared. Each group is computed by
+ * mnn_expr_VARP_static_compute on a worker thread under the ExecutorScope of an executor
+ * leased from a shared pool of CPU executors. Returns when all groups are computed.
+ *
+ * @param vars Variables to compute
+ * @param forceCPU Whether to force computing on CPU
+ * @param max_workers Maximum number of concurrent groups, <= 0 means the size of the pool
+ * @param num_groups Output number of independent groups, can be NULL
+ * @return Error code
+ */
+MNN_C_API mnn_error_code_t mnn_expr_VARP_static_compute_parallel(
+    VecVARP_t vars, bool forceCPU, int max_workers, size_t *num_groups
+);
+
 // MNN::Express::Expr
 MNN_C_API EXPRP_t mnn_expr_Expr_create_empty();
 MNN_C_API EXPRP_t mnn_expr_Expr_static_create(mnn_tensor_t tensor, bool own);
@@ -144,6 +218,116 @@ MNN_C_API int            mnn_expr_Expr_inputType(EXPRP_t self);
 // MNN_C_API void mnn_expr_Expr_visitOutputs();
 MNN_C_API struct mnn_expr_Variable_Info *mnn_expr_Expr_outputInfo(EXPRP_t self, int index);
 
+// Expression scope
+/**
+ * @brief Open an expression scope on the calling thread
+ *
+ * Until the scope ends, VARP_t and EXPRP_t handles returned on this thread are
+ * allocated from slabs of the scope instead of one heap object each, and are all
+ * released by mnn_expr_scope_end. mnn_expr_VARP_free and mnn_expr_Expr_free do
+ * nothing for them. Scopes nest, new handles belong to the innermost one.
+ *
+ * @return Scope handle
+ */
+MNN_C_API mnn_expr_scope_t mnn_expr_scope_begin();
+
+/**
+ * @brief End a scope and release all its handles, inner scopes still open are ended too
+ * @param self Scope opened on the calling thread
+ * @return Error code, MNNC_INVALID_VALUE if the scope is not open on the calling thread
+ */
+MNN_C_API mnn_error_code_t mnn_expr_scope_end(mnn_expr_scope_t self);
+
+/**
+ * @brief Get the number of handles owned by a scope
+ * @param self Scope
+ * @return Handle count
+ */
+MNN_C_API size_t mnn_expr_scope_size(mnn_expr_scope_t self);
+
+/**
+ * @brief Copy a handle out of any scope, e.g., a result that outlives the scope
+ * @param self Variable
+ * @return Heap handle, must be freed by mnn_expr_VARP_free
+ */
+MNN_C_API VARP_t mnn_expr_scope_escape_VARP(VARP_t self);
+
+/**
+ * @brief Copy a handle out of any scope
+ * @param self Expression
+ * @return Heap handle, must be freed by mnn_expr_Expr_free
+ */
+MNN_C_API EXPRP_t mnn_expr_scope_escape_EXPRP(EXPRP_t self);
+
+// Info query without allocation
+/**
+ * @brief Query the info of a variable into caller-provided storage
+ * @param self Variable
+ * @param ndim Output number of dims, -1 if the info can not be computed
+ * @param dims Output dims, can be NULL if dims_capacity is 0
+ * @param dims_capacity Capacity of dims in elements
+ * @param type Output data type, can be NULL
+ * @param order Output dimension format, can be NULL
+ * @param size Output number of elements, can be NULL
+ * @return Error code, MNNC_INVALID_VALUE if dims_capacity is too small, ndim is still set
+ */
+MNN_C_API mnn_error_code_t mnn_expr_VARP_get_info_into(
+    VARP_t           self,
+    int32_t         *ndim,
+    int32_t         *dims,
+    size_t           dims_capacity,
+    halide_type_c_t *type,
+    int32_t         *order,
+    size_t          *size
+);
+
+/**
+ * @brief Query the info of many variables in one call
+ *
+ * The dims of all variables are concatenated into `dims`, variables whose info can not
+ * be computed get ndim -1 and contribute no dims.
+ *
+ * @param self Variables
+ * @param ndims Output number of dims of each variable
+ * @param dims Output dims, can be NULL if dims_capacity is 0
+ * @param dims_capacity Capacity of dims in elements
+ * @param types Output data types, can be NULL
+ * @param orders Output dimension formats, can be NULL
+ * @param sizes Output numbers of elements, can be NULL
+ * @return Error code, MNNC_INVALID_VALUE if dims_capacity is too small, ndims are still set
+ */
+MNN_C_API mnn_error_code_t mnn_expr_VecVARP_get_info(
+    VecVARP_t        self,
+    int32_t         *ndims,
+    int32_t         *dims,
+    size_t           dims_capacity,
+    halide_type_c_t *types,
+    int32_t         *orders,
+    size_t          *sizes
+);
+
+// Pinned read map
+/**
+ * @brief Compute a variable and map its host data with a reference that keeps it alive
+ *
+ * The pin is a new variable bound to the same expression as `self`, it keeps the
+ * expression alive so the mapped memory stays valid after `self` is freed. The memory
+ * is not copied and is invalidated when the variable is resized, rebound by
+ * mnn_expr_VARP_input, written through mnn_expr_VARP_writeMap or recomputed after an
+ * upstream change. Release the pin with mnn_expr_VARP_free, which can be used directly
+ * as the finalizer of a view over the data.
+ *
+ * @param self Variable
+ * @param data Output pointer to the host data
+ * @param size Output number of elements
+ * @param type Output data type, can be NULL
+ * @param pin Output retained variable, must be freed by mnn_expr_VARP_free
+ * @return Error code, MNNC_COMPUTE_SIZE_ERROR if the info can not be computed
+ */
+MNN_C_API mnn_error_code_t mnn_expr_VARP_readMap_pinned(
+    VARP_t self, const void **data, size_t *size, halide_type_c_t *type, VARP_t *pin
+);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,138 @@
+/*
+ * expr_graph.h
+ * MNN C API for building expression graphs in bulk
+ *
+ * This file provides a compact op bytecode so that a whole expression DAG can be
+ * built with a single call instead of one call and one VARP_t handle per op.
+ *
+ * Author: Rainyl
+ * License: Apache License 2.0
+ */
+
+#ifndef MNN_EXPR_GRAPH_H
+#define MNN_EXPR_GRAPH_H
+
+#include "mnn_c/base.h"
+#include "mnn_c/error_code.h"
+#include "mnn_c/expr.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Op codes of the graph bytecode, attributes are listed after each op.
+ * "rest" means all remaining attributes, f32 attributes are stored as float bits.
+ */
+typedef enum {
+  /** attrs: value(f32) */
+  MNN_EXPR_OP_SCALAR_F32 = 0,
+  /** attrs: value */
+  MNN_EXPR_OP_SCALAR_I32 = 1,
+  /** attrs: ndim, dims[ndim], values(f32)[rest] */
+  MNN_EXPR_OP_CONST_F32 = 2,
+  /** attrs: ndim, dims[ndim], values[rest] */
+  MNN_EXPR_OP_CONST_I32 = 3,
+
+  /** binary ops, 2 inputs, no attrs */
+  MNN_EXPR_OP_ADD           = 10,
+  MNN_EXPR_OP_SUB           = 11,
+  MNN_EXPR_OP_MUL           = 12,
+  MNN_EXPR_OP_DIV           = 13,
+  MNN_EXPR_OP_POW           = 14,
+  MNN_EXPR_OP_MAXIMUM       = 15,
+  MNN_EXPR_OP_MINIMUM       = 16,
+  MNN_EXPR_OP_GREATER       = 17,
+  MNN_EXPR_OP_GREATER_EQUAL = 18,
+  MNN_EXPR_OP_LESS          = 19,
+  MNN_EXPR_OP_LESS_EQUAL    = 20,
+  MNN_EXPR_OP_EQUAL         = 21,
+
+  /** unary ops, 1 input, no attrs */
+  MNN_EXPR_OP_NEG     = 30,
+  MNN_EXPR_OP_ABS     = 31,
+  MNN_EXPR_OP_EXP     = 32,
+  MNN_EXPR_OP_LOG     = 33,
+  MNN_EXPR_OP_SQRT    = 34,
+  MNN_EXPR_OP_SQUARE  = 35,
+  MNN_EXPR_OP_SIGMOID = 36,
+  MNN_EXPR_OP_TANH    = 37,
+  MNN_EXPR_OP_RELU    = 38,
+  MNN_EXPR_OP_FLOOR   = 39,
+  MNN_EXPR_OP_CEIL    = 40,
+
+  /** reductions, 1 input, attrs: keep_dims, axes[rest], no axes means all */
+  MNN_EXPR_OP_REDUCE_SUM  = 50,
+  MNN_EXPR_OP_REDUCE_MEAN = 51,
+  MNN_EXPR_OP_REDUCE_MAX  = 52,
+  MNN_EXPR_OP_REDUCE_MIN  = 53,
+  /** 1 input, attrs: axis */
+  MNN_EXPR_OP_ARGMAX  = 54,
+  MNN_EXPR_OP_ARGMIN  = 55,
+  MNN_EXPR_OP_SOFTMAX = 56,
+
+  /** 1 input, attrs: dims[rest] */
+  MNN_EXPR_OP_RESHAPE = 60,
+  /** 1 input, attrs: perm[rest] */
+  MNN_EXPR_OP_TRANSPOSE = 61,
+  /** 1 input, attrs: axes[rest] */
+  MNN_EXPR_OP_SQUEEZE   = 62,
+  MNN_EXPR_OP_UNSQUEEZE = 63,
+  /** 1 input, attrs: format */
+  MNN_EXPR_OP_CONVERT = 64,
+  /** 1 input, attrs: halide type code, bits */
+  MNN_EXPR_OP_CAST = 65,
+
+  /**
+   * 1 input, attrs: n, begin[n], end[n], strides[n],
+   * begin_mask, end_mask, ellipsis_mask, new_axis_mask, shrink_axis_mask
+   */
+  MNN_EXPR_OP_STRIDED_SLICE = 70,
+  /** 2 inputs (params, indices), attrs: axis */
+  MNN_EXPR_OP_GATHER = 71,
+  /** any number of inputs, attrs: axis */
+  MNN_EXPR_OP_STACK  = 72,
+  MNN_EXPR_OP_CONCAT = 73,
+  /** 3 inputs (condition, x, y) */
+  MNN_EXPR_OP_SELECT = 74,
+  /** 2 inputs, attrs: transpose_a, transpose_b */
+  MNN_EXPR_OP_MATMUL = 75,
+  /** 2 inputs (boxes, scores), attrs: max_detections, iou_threshold(f32), score_threshold(f32) */
+  MNN_EXPR_OP_NMS = 76,
+} mnn_expr_opcode_t;
+
+/**
+ * @brief Build an expression graph from op bytecode in one call
+ *
+ * Registers [0, num_inputs) hold the inputs, each instruction appends its result as
+ * the next register. An instruction is encoded as
+ * `opcode, num_inputs, input registers..., num_attrs, attrs...`
+ * and may only read registers defined before it.
+ *
+ * @param code Bytecode
+ * @param code_len Number of int32 words of code
+ * @param inputs Input variables, can be NULL if there is no input
+ * @param outputs Registers to return
+ * @param num_outputs Number of outputs
+ * @param out Output variables, must be freed by mnn_expr_VecVARP_free
+ * @param error_offset Word offset of the failing instruction, can be NULL
+ * @return Error code, MNNC_NOT_SUPPORT for unknown op codes and MNNC_INVALID_VALUE for
+ * malformed instructions
+ */
+MNN_C_API mnn_error_code_t mnn_expr_build_graph(
+    const int32_t *code,
+    size_t         code_len,
+    VecVARP_t      inputs,
+    const int32_t *outputs,
+    size_t         num_outputs,
+    VecVARP_t     *out,
+    size_t        *error_offset
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MNN_EXPR_GRAPH_H
@@ -0,0 +1,84 @@
+/*
+ * graph_cache.h
+ * MNN C API for caching compiled expression graphs
+ *
+ * Dynamic expression graphs that are rebuilt per request, e.g., postprocessing,
+ * pay for shape inference and scheduling every time they are evaluated. The cache
+ * keys a graph by a hash of its serialized form and compiles it once into a static
+ * module.
+ *
+ * Author: Rainyl
+ * License: Apache License 2.0
+ */
+
+#ifndef MNN_GRAPH_CACHE_H
+#define MNN_GRAPH_CACHE_H
+
+#include "mnn_c/base.h"
+#include "mnn_c/error_code.h"
+#include "mnn_c/expr.h"
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef __cplusplus
+typedef struct mnn_graph_cache *mnn_graph_cache_t;
+#else
+typedef void *mnn_graph_cache_t;
+#endif
+
+/**
+ * @brief Create a graph cache
+ * @param capacity Maximum number of compiled graphs, least recently used ones are evicted,
+ * 0 means unlimited
+ * @return Graph cache
+ */
+MNN_C_API mnn_graph_cache_t mnn_graph_cache_create(size_t capacity);
+
+/**
+ * @brief Destroy a graph cache and all compiled graphs in it
+ * @param self Graph cache
+ */
+MNN_C_API void mnn_graph_cache_destroy(mnn_graph_cache_t self);
+
+/**
+ * @brief Evaluate a graph through the cache
+ *
+ * The key covers the ops and attributes of the graph from `inputs` to `outputs`, the
+ * shapes and types of the inputs and the data of all other leaves. The data of `inputs`
+ * is not part of the key, so they should be placeholders created by mnn_expr_Input.
+ * On a miss the graph is compiled with mnn_module_extract, later calls with the same
+ * structure rebind the inputs and run the compiled module. The graph is serialized and
+ * hashed on every call, constants included.
+ *
+ * @param self Graph cache
+ * @param inputs Input variables of the graph
+ * @param outputs Output variables of the graph
+ * @param results Computed outputs, must be freed by mnn_expr_VecVARP_free
+ * @param hit Whether a compiled graph was reused, can be NULL
+ * @return Error code
+ */
+MNN_C_API mnn_error_code_t mnn_graph_cache_run(
+    mnn_graph_cache_t self, VecVARP_t inputs, VecVARP_t outputs, VecVARP_t *results, bool *hit
+);
+
+/**
+ * @brief Get the number of compiled graphs
+ * @param self Graph cache
+ * @return Number of compiled graphs
+ */
+MNN_C_API size_t mnn_graph_cache_size(mnn_graph_cache_t self);
+
+/**
+ * @brief Remove all compiled graphs
+ * @param self Graph cache
+ */
+MNN_C_API void mnn_graph_cache_clear(mnn_graph_cache_t self);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MNN_GRAPH_CACHE_H
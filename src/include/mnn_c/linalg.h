@@ -0,0 +1,151 @@
+/*
+ * linalg.h
+ * MNN C API for batched small-matrix linear algebra
+ *
+ * Determinant, inverse, solve, Cholesky and QR of many small matrices in one call, e.g.,
+ * poses, homographies and covariances, without building a graph per matrix. Sizes 2 and 3
+ * use closed forms, sizes up to 4 are unrolled at compile time, and large matrices are
+ * factored in column blocks. Matrices are row-major and computed in double precision.
+ *
+ * Author: Rainyl
+ * License: Apache License 2.0
+ */
+
+#ifndef MNN_LINALG_H
+#define MNN_LINALG_H
+
+#include "mnn_c/base.h"
+#include "mnn_c/error_code.h"
+#include "mnn_c/expr.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Determinants of a batch of square matrices
+ * @param a Matrices, [batch, n, n]
+ * @param batch Number of matrices
+ * @param n Size of the matrices
+ * @param det Output determinants, [batch]
+ * @param num_threads Number of threads, <= 0 means using all available threads
+ * @return Error code
+ */
+MNN_C_API mnn_error_code_t
+mnn_linalg_det(const float *a, size_t batch, int n, float *det, int num_threads);
+
+/**
+ * @brief Inverses of a batch of square matrices
+ * @param a Matrices, [batch, n, n]
+ * @param batch Number of matrices
+ * @param n Size of the matrices
+ * @param inv Output inverses, [batch, n, n], NaN for singular matrices
+ * @param info Output 0 for each inverted matrix, 1 if it is singular, [batch], can be NULL
+ * @param num_threads Number of threads, <= 0 means using all available threads
+ * @return Error code, MNNC_INVALID_VALUE if any matrix is singular
+ */
+MNN_C_API mnn_error_code_t mnn_linalg_inv(
+    const float *a, size_t batch, int n, float *inv, int32_t *info, int num_threads
+);
+
+/**
+ * @brief Solve a x = b for a batch of square matrices
+ * @param a Matrices, [batch, n, n]
+ * @param b Right-hand sides, [batch, n, nrhs]
+ * @param batch Number of systems
+ * @param n Size of the matrices
+ * @param nrhs Number of right-hand sides
+ * @param x Output solutions, [batch, n, nrhs], NaN for singular matrices
+ * @param info Output 0 for each solved system, 1 if its matrix is singular, [batch], can be NULL
+ * @param num_threads Number of threads, <= 0 means using all available threads
+ * @return Error code, MNNC_INVALID_VALUE if any matrix is singular
+ */
+MNN_C_API mnn_error_code_t mnn_linalg_solve(
+    const float *a,
+    const float *b,
+    size_t       batch,
+    int          n,
+    int          nrhs,
+    float       *x,
+    int32_t     *info,
+    int          num_threads
+);
+
+/**
+ * @brief Cholesky factors of a batch of symmetric positive-definite matrices
+ * @param a Matrices, [batch, n, n], only the lower triangles are read
+ * @param batch Number of matrices
+ * @param n Size of the matrices
+ * @param l Output lower triangular factors, a = l l^T, [batch, n, n], NaN if not definite
+ * @param info Output 0 for each factored matrix, 1 if it is not definite, [batch], can be NULL
+ * @param num_threads Number of threads, <= 0 means using all available threads
+ * @return Error code, MNNC_INVALID_VALUE if any matrix is not positive-definite
+ */
+MNN_C_API mnn_error_code_t mnn_linalg_cholesky(
+    const float *a, size_t batch, int n, float *l, int32_t *info, int num_threads
+);
+
+/**
+ * @brief Reduced QR decompositions of a batch of matrices by Householder reflections
+ * @param a Matrices, [batch, m, n]
+ * @param batch Number of matrices
+ * @param m Number of rows
+ * @param n Number of columns
+ * @param q Output orthonormal columns, [batch, m, min(m, n)]
+ * @param r Output upper triangular factors, [batch, min(m, n), n]
+ * @param num_threads Number of threads, <= 0 means using all available threads
+ * @return Error code
+ */
+MNN_C_API mnn_error_code_t mnn_linalg_qr(
+    const float *a, size_t batch, int m, int n, float *q, float *r, int num_threads
+);
+
+/**
+ * @brief Determinants of a float variable of matrices
+ * @param a Variable, [..., n, n]
+ * @param out Output variable, [...]
+ * @return Error code
+ */
+MNN_C_API mnn_error_code_t mnn_expr_linalg_det(VARP_t a, VARP_t *out);
+
+/**
+ * @brief Inverses of a float variable of matrices
+ * @param a Variable, [..., n, n]
+ * @param out Output variable, [..., n, n]
+ * @return Error code, MNNC_INVALID_VALUE if any matrix is singular
+ */
+MNN_C_API mnn_error_code_t mnn_expr_linalg_inv(VARP_t a, VARP_t *out);
+
+/**
+ * @brief Solve a x = b for a float variable of matrices
+ * @param a Variable, [..., n, n]
+ * @param b Variable, [..., n, k], or [..., n] for a single right-hand side
+ * @param out Output variable of the shape of b
+ * @return Error code, MNNC_INVALID_VALUE if any matrix is singular
+ */
+MNN_C_API mnn_error_code_t mnn_expr_linalg_solve(VARP_t a, VARP_t b, VARP_t *out);
+
+/**
+ * @brief Cholesky factors of a float variable of matrices
+ * @param a Variable, [..., n, n]
+ * @param out Output variable, [..., n, n]
+ * @return Error code, MNNC_INVALID_VALUE if any matrix is not positive-definite
+ */
+MNN_C_API mnn_error_code_t mnn_expr_linalg_cholesky(VARP_t a, VARP_t *out);
+
+/**
+ * @brief Reduced QR decompositions of a float variable of matrices
+ * @param a Variable, [..., m, n]
+ * @param q Output variable, [..., m, min(m, n)]
+ * @param r Output variable, [..., min(m, n), n]
+ * @return Error code
+ */
+MNN_C_API mnn_error_code_t mnn_expr_linalg_qr(VARP_t a, VARP_t *q, VARP_t *r);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MNN_LINALG_H
@@ -161,6 +161,31 @@ MNN_C_API mnn_error_code_t mnn_module_on_forward(
 MNN_C_API mnn_error_code_t
 mnn_module_forward(mnn_module_t self, VARP_t input, VARP_t *output, mnn_callback_0 callback);
 
+/**
+ * @brief Run onForward and write the outputs into caller buffers
+ *
+ * Outputs are computed together, NC4HW4 outputs are converted to NCHW, and each output is
+ * copied once into its buffer as contiguous host data. No output wrappers are allocated,
+ * so a loop reusing the same inputs and buffers only allocates inside the module.
+ *
+ * @param self Module
+ * @param inputs Input variables
+ * @param outputs Host buffers, one per output of the module
+ * @param sizes Sizes of the buffers in bytes
+ * @param num_outputs Number of buffers
+ * @param written Output bytes written to each buffer, can be NULL
+ * @return Error code, MNNC_INVALID_VALUE if num_outputs is not the number of outputs or a
+ * buffer is too small
+ */
+MNN_C_API mnn_error_code_t mnn_module_forward_into(
+    mnn_module_t  self,
+    VecVARP_t     inputs,
+    void *const  *outputs,
+    const size_t *sizes,
+    size_t        num_outputs,
+    size_t       *written
+);
+
 // void registerModel(const std::vector<std::shared_ptr<Module>>& children);
 
 #ifdef __cplusplus
@@ -0,0 +1,115 @@
+/*
+ * module_pool.h
+ * MNN C API for pools of module clones
+ *
+ * A pool clones one master module into workers that share its weights, each worker owns a
+ * thread, an executor and a clone. Forward requests are queued round-robin on the workers
+ * and idle workers steal from the queues of busy ones, so independent requests keep all
+ * workers busy with a single copy of the weights.
+ *
+ * Author: Rainyl
+ * License: Apache License 2.0
+ */
+
+#ifndef MNN_MODULE_POOL_H
+#define MNN_MODULE_POOL_H
+
+#include "mnn_c/base.h"
+#include "mnn_c/error_code.h"
+#include "mnn_c/expr.h"
+#include "mnn_c/module.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef __cplusplus
+typedef struct mnn_module_pool *mnn_module_pool_t;
+#else
+typedef void *mnn_module_pool_t;
+#endif
+
+typedef struct mnn_module_pool_stats_t {
+  /** Number of requests served */
+  uint64_t requests;
+  /** Number of served requests taken from the queue of another worker */
+  uint64_t stolen;
+  /** Total time spent in forward, in nanoseconds */
+  uint64_t busy_ns;
+  /** Time since the worker started, in nanoseconds */
+  uint64_t alive_ns;
+  /** Number of requests waiting in the queue of the worker */
+  uint64_t queued;
+  /** Whether the worker is running a request */
+  bool in_use;
+} mnn_module_pool_stats_t;
+
+/**
+ * @brief Create a pool of clones of a module sharing its parameters
+ * @param master Module to clone, must outlive the pool
+ * @param type Forward type of the executors, MNNForwardType
+ * @param config Backend config of the executors
+ * @param num_thread Number of threads of each executor
+ * @param size Number of workers, 0 means one per hardware thread
+ * @return Module pool, NULL if a clone failed
+ */
+MNN_C_API mnn_module_pool_t mnn_module_pool_create(
+    mnn_module_t master, int type, mnn_backend_config_t config, int num_thread, size_t size
+);
+
+/**
+ * @brief Destroy a module pool, queued requests are served first
+ * @param self Module pool
+ */
+MNN_C_API void mnn_module_pool_destroy(mnn_module_pool_t self);
+
+/**
+ * @brief Get the number of workers
+ * @param self Module pool
+ * @return Number of workers
+ */
+MNN_C_API size_t mnn_module_pool_size(mnn_module_pool_t self);
+
+/**
+ * @brief Run onForward of a clone on the pool
+ *
+ * The inputs are referenced until the request is served and must not be written meanwhile.
+ * The outputs are computed on the worker.
+ *
+ * @param self Module pool
+ * @param inputs Input variables
+ * @param outputs Output variables, must be freed by mnn_expr_VecVARP_free, set to NULL if
+ * forward fails
+ * @param callback If NULL, block until the outputs are ready, otherwise return after
+ * queueing and call it from the worker once outputs is written
+ * @return Error code, MNNC_UNKNOWN_ERROR if a blocking forward fails
+ */
+MNN_C_API mnn_error_code_t mnn_module_pool_forward(
+    mnn_module_pool_t self, VecVARP_t inputs, VecVARP_t *outputs, mnn_callback_0 callback
+);
+
+/**
+ * @brief Get the number of queued requests that no worker has started
+ * @param self Module pool
+ * @return Number of pending requests
+ */
+MNN_C_API size_t mnn_module_pool_pending(mnn_module_pool_t self);
+
+/**
+ * @brief Get the usage statistics of a worker, utilization is busy_ns / alive_ns
+ * @param self Module pool
+ * @param index Index of the worker
+ * @param stats Output statistics
+ * @return Error code, MNNC_INVALID_VALUE if index is out of range
+ */
+MNN_C_API mnn_error_code_t
+mnn_module_pool_get_stats(mnn_module_pool_t self, size_t index, mnn_module_pool_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MNN_MODULE_POOL_H
@@ -0,0 +1,119 @@
+/*
+ * npy.h
+ * MNN C API for tensor persistence in .npy format
+ *
+ * This file provides functions to save/load host tensors as NumPy .npy files,
+ * and a multi-tensor archive that can be memory-mapped without copying.
+ *
+ * Author: Rainyl
+ * License: Apache License 2.0
+ */
+
+#ifndef MNN_NPY_H
+#define MNN_NPY_H
+
+#include "mnn_c/base.h"
+#include "mnn_c/error_code.h"
+#include "mnn_c/tensor.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef __cplusplus
+struct mnn_npy_archive;
+typedef mnn_npy_archive *mnn_npy_archive_t;
+#else
+typedef void *mnn_npy_archive_t;
+#endif
+
+/**
+ * @brief Save a host tensor to .npy file
+ * @param self Host tensor, NC4HW4 tensors are not supported
+ * @param path File path
+ * @return Error code
+ */
+MNN_C_API mnn_error_code_t mnn_tensor_save_npy(mnn_tensor_t self, const char *path);
+
+/**
+ * @brief Load a .npy file into a new host tensor, the data is copied
+ * @param path File path
+ * @param out Output tensor, must be destroyed by mnn_tensor_destroy
+ * @return Error code
+ */
+MNN_C_API mnn_error_code_t mnn_tensor_load_npy(const char *path, mnn_tensor_t *out);
+
+/**
+ * @brief Save multiple host tensors to an archive file
+ *
+ * The archive stores each tensor as a complete .npy blob aligned to 64 bytes,
+ * preceded by an index of names and offsets, so it can be memory-mapped.
+ *
+ * @param path File path
+ * @param names Tensor names, must be unique
+ * @param tensors Host tensors
+ * @param count Number of tensors
+ * @return Error code
+ */
+MNN_C_API mnn_error_code_t mnn_npy_save_archive(
+    const char *path, const char **names, const mnn_tensor_t *tensors, size_t count
+);
+
+/**
+ * @brief Open an archive or a single .npy file
+ *
+ * Tensors of the archive reference the file data directly, no copy is made.
+ * With use_mmap the file is mapped copy-on-write, so writing to a tensor never
+ * modifies the file; otherwise the whole file is read into memory once.
+ *
+ * @param path File path, a plain .npy file is opened as an archive with one entry named ""
+ * @param use_mmap Whether to memory-map the file
+ * @return Archive handle or NULL on failure
+ */
+MNN_C_API mnn_npy_archive_t mnn_npy_archive_open(const char *path, bool use_mmap);
+
+/**
+ * @brief Destroy an archive, all tensors obtained from it become invalid
+ * @param self Archive
+ */
+MNN_C_API void mnn_npy_archive_destroy(mnn_npy_archive_t self);
+
+/**
+ * @brief Get the number of tensors in the archive
+ * @param self Archive
+ * @return Tensor count
+ */
+MNN_C_API size_t mnn_npy_archive_size(mnn_npy_archive_t self);
+
+/**
+ * @brief Get the name of the i-th tensor
+ * @param self Archive
+ * @param index Tensor index
+ * @return Name owned by the archive, or NULL if out of range
+ */
+MNN_C_API const char *mnn_npy_archive_name(mnn_npy_archive_t self, size_t index);
+
+/**
+ * @brief Find a tensor by name
+ * @param self Archive
+ * @param name Tensor name
+ * @return Tensor index, or -1 if not found
+ */
+MNN_C_API int mnn_npy_archive_find(mnn_npy_archive_t self, const char *name);
+
+/**
+ * @brief Get the i-th tensor
+ * @param self Archive
+ * @param index Tensor index
+ * @return Tensor owned by the archive, or NULL if out of range
+ */
+MNN_C_API mnn_tensor_t mnn_npy_archive_get(mnn_npy_archive_t self, size_t index);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MNN_NPY_H
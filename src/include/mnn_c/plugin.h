@@ -0,0 +1,204 @@
+/*
+ * plugin.h
+ * MNN C API for custom CPU ops
+ *
+ * Registers ops with native shape inference and compute functions through the MNN plugin
+ * headers, so fused postprocessing or layers MNN does not support run inside the graph
+ * instead of splitting it and copying data out. Requires MNN built with MNN_WITH_PLUGIN,
+ * otherwise the functions return MNNC_NOT_SUPPORT.
+ *
+ * Author: Rainyl
+ * License: Apache License 2.0
+ */
+
+#ifndef MNN_PLUGIN_H
+#define MNN_PLUGIN_H
+
+#include "mnn_c/base.h"
+#include "mnn_c/error_code.h"
+#include "mnn_c/expr.h"
+#include "mnn_c/tensor.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+  #include "MNN/plugin/PluginContext.hpp"
+extern "C" {
+#endif
+
+/** Opaque pointer types */
+#ifdef __cplusplus
+typedef MNN::plugin::PluginContext *mnn_plugin_context_t;
+#else
+typedef void *mnn_plugin_context_t;
+#endif
+
+/**
+ * Shape inference or compute function of an op, returns false on failure. Called on the
+ * thread running the graph, inputs and outputs are host tensors in the layout chosen by
+ * MNN, see mnn_tensor_get_dimension_type.
+ */
+typedef bool (*mnn_plugin_kernel_fn)(mnn_plugin_context_t ctx, void *userdata);
+
+typedef enum {
+  MNN_PLUGIN_ATTR_INT    = 0,
+  MNN_PLUGIN_ATTR_FLOAT  = 1,
+  MNN_PLUGIN_ATTR_STRING = 2,
+  MNN_PLUGIN_ATTR_INTS   = 3,
+  MNN_PLUGIN_ATTR_FLOATS = 4,
+} mnn_plugin_attr_type_t;
+
+typedef struct mnn_plugin_op_t {
+  /** Set shapes and types of the outputs, NULL copies them from input 0 */
+  mnn_plugin_kernel_fn infer_shape;
+  /** Fill the outputs */
+  mnn_plugin_kernel_fn compute;
+  /** Called when the input shapes change, before compute, can be NULL */
+  mnn_plugin_kernel_fn resize;
+  /** Passed to the functions, must outlive the registration */
+  void *userdata;
+} mnn_plugin_op_t;
+
+typedef struct mnn_plugin_attr_t {
+  const char *key;
+  /** mnn_plugin_attr_type_t */
+  int32_t type;
+  int32_t i;
+  float   f;
+  /** Value of MNN_PLUGIN_ATTR_STRING */
+  const char *s;
+  /** Values of MNN_PLUGIN_ATTR_INTS and MNN_PLUGIN_ATTR_FLOATS */
+  const int32_t *ints;
+  const float   *floats;
+  size_t         count;
+} mnn_plugin_attr_t;
+
+/**
+ * @brief Whether custom ops are supported, i.e., MNN is built with MNN_WITH_PLUGIN
+ */
+MNN_C_API bool mnn_plugin_supported(void);
+
+/**
+ * @brief Register a custom CPU op, registering a name again replaces the op
+ *
+ * Registrations live as long as the process and must happen before graphs using the op
+ * are computed, the registry is not synchronized with running graphs.
+ *
+ * @param name Op type, referenced by mnn_expr_plugin_op
+ * @param op Functions of the op, copied
+ * @return Error code
+ */
+MNN_C_API mnn_error_code_t mnn_plugin_register_cpu_op(const char *name, const mnn_plugin_op_t *op);
+
+/**
+ * @brief Create a custom op expression
+ * @param name Op type registered by mnn_plugin_register_cpu_op
+ * @param inputs Input variables
+ * @param attrs Attributes, copied into the op
+ * @param num_attrs Number of attributes
+ * @param num_outputs Number of outputs
+ * @param out Output variables, must be freed by mnn_expr_VecVARP_free
+ * @return Error code, MNNC_INVALID_VALUE if the op is not registered
+ */
+MNN_C_API mnn_error_code_t mnn_expr_plugin_op(
+    const char              *name,
+    VecVARP_t                inputs,
+    const mnn_plugin_attr_t *attrs,
+    size_t                   num_attrs,
+    int                      num_outputs,
+    VecVARP_t               *out
+);
+
+/**
+ * @brief Number of inputs of the op
+ */
+MNN_C_API int mnn_plugin_context_num_inputs(mnn_plugin_context_t ctx);
+
+/**
+ * @brief Number of outputs of the op
+ */
+MNN_C_API int mnn_plugin_context_num_outputs(mnn_plugin_context_t ctx);
+
+/**
+ * @brief Input tensor, owned by the graph, NULL if index is out of range
+ */
+MNN_C_API mnn_tensor_t mnn_plugin_context_input(mnn_plugin_context_t ctx, int index);
+
+/**
+ * @brief Output tensor, owned by the graph, NULL if index is out of range
+ */
+MNN_C_API mnn_tensor_t mnn_plugin_context_output(mnn_plugin_context_t ctx, int index);
+
+/**
+ * @brief Set the shape and type of an output, for shape inference
+ * @param ctx Context
+ * @param index Output index
+ * @param shape Shape of the output
+ * @param ndim Number of dimensions
+ * @param type Element type
+ * @return Error code
+ */
+MNN_C_API mnn_error_code_t mnn_plugin_context_set_output(
+    mnn_plugin_context_t ctx, int index, const int *shape, int ndim, halide_type_c_t type
+);
+
+/**
+ * @brief Integer attribute of the op
+ * @param ctx Context
+ * @param key Attribute name
+ * @param value Output value
+ * @return Error code, MNNC_INVALID_VALUE if there is no such attribute
+ */
+MNN_C_API mnn_error_code_t
+mnn_plugin_context_attr_int(mnn_plugin_context_t ctx, const char *key, int32_t *value);
+
+/**
+ * @brief Float attribute of the op
+ * @param ctx Context
+ * @param key Attribute name
+ * @param value Output value
+ * @return Error code, MNNC_INVALID_VALUE if there is no such attribute
+ */
+MNN_C_API mnn_error_code_t
+mnn_plugin_context_attr_float(mnn_plugin_context_t ctx, const char *key, float *value);
+
+/**
+ * @brief String attribute of the op
+ * @param ctx Context
+ * @param key Attribute name
+ * @param value Output string, owned by the graph
+ * @return Error code, MNNC_INVALID_VALUE if there is no such attribute
+ */
+MNN_C_API mnn_error_code_t
+mnn_plugin_context_attr_string(mnn_plugin_context_t ctx, const char *key, const char **value);
+
+/**
+ * @brief Integer list attribute of the op
+ * @param ctx Context
+ * @param key Attribute name
+ * @param values Output values, owned by the graph
+ * @param count Output number of values
+ * @return Error code, MNNC_INVALID_VALUE if there is no such attribute
+ */
+MNN_C_API mnn_error_code_t mnn_plugin_context_attr_ints(
+    mnn_plugin_context_t ctx, const char *key, const int32_t **values, size_t *count
+);
+
+/**
+ * @brief Float list attribute of the op
+ * @param ctx Context
+ * @param key Attribute name
+ * @param values Output values, owned by the graph
+ * @param count Output number of values
+ * @return Error code, MNNC_INVALID_VALUE if there is no such attribute
+ */
+MNN_C_API mnn_error_code_t mnn_plugin_context_attr_floats(
+    mnn_plugin_context_t ctx, const char *key, const float **values, size_t *count
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MNN_PLUGIN_H
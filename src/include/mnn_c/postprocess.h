@@ -0,0 +1,117 @@
+/*
+ * postprocess.h
+ * MNN C API for fused output postprocessing
+ *
+ * This file provides a layout descriptor of host tensors and variables, including
+ * the packed NC4HW4 layout, and channel-wise kernels that read any layout directly,
+ * so outputs need not be converted to NCHW before postprocessing.
+ *
+ * Author: Rainyl
+ * License: Apache License 2.0
+ */
+
+#ifndef MNN_POSTPROCESS_H
+#define MNN_POSTPROCESS_H
+
+#include "mnn_c/base.h"
+#include "mnn_c/error_code.h"
+#include "mnn_c/expr.h"
+#include "mnn_c/tensor.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Memory layout of data viewed as [batch, channel, area], area is the product of the
+ * spatial dims. Element (n, c, a) is at
+ * n * batch_stride + (c / pack) * channel_stride + a * area_stride + c % pack,
+ * all strides are in elements. NC4HW4 is [C/4][N][area][4] as in MNN, so its
+ * channel_stride spans all batches and batch_stride is area * 4.
+ */
+typedef struct mnn_tensor_layout_t {
+  mnn_dimension_type_t dim_type;
+  int                  batch;
+  int                  channel;
+  int                  area;
+  /** channels stored together, 4 for NC4HW4 and 1 otherwise */
+  int    pack;
+  size_t batch_stride;
+  size_t channel_stride;
+  size_t area_stride;
+} mnn_tensor_layout_t;
+
+/**
+ * @brief Get the memory layout of a tensor
+ * @param self Tensor
+ * @param layout Output layout
+ * @return Error code
+ */
+MNN_C_API mnn_error_code_t mnn_tensor_get_layout(mnn_tensor_t self, mnn_tensor_layout_t *layout);
+
+/**
+ * @brief Get the memory layout of the data returned by mnn_expr_VARP_readMap
+ * @param self Variable
+ * @param layout Output layout
+ * @return Error code
+ */
+MNN_C_API mnn_error_code_t mnn_expr_VARP_get_layout(VARP_t self, mnn_tensor_layout_t *layout);
+
+/**
+ * @brief Channel-wise argmax, ties resolve to the smallest channel
+ * @param data Float data
+ * @param layout Data layout
+ * @param indices Output channel indices, shape [batch, area]
+ * @param scores Output max values, shape [batch, area], can be NULL
+ * @param num_threads Number of threads, <= 0 means using all available threads
+ * @return Error code
+ */
+MNN_C_API mnn_error_code_t mnn_channel_argmax(
+    const float               *data,
+    const mnn_tensor_layout_t *layout,
+    int32_t                   *indices,
+    float                     *scores,
+    int                        num_threads
+);
+
+/**
+ * @brief Channel-wise softmax
+ * @param data Float data
+ * @param layout Data layout
+ * @param dst Output probabilities in NCHW, shape [batch, channel, area]
+ * @param num_threads Number of threads, <= 0 means using all available threads
+ * @return Error code
+ */
+MNN_C_API mnn_error_code_t mnn_channel_softmax(
+    const float *data, const mnn_tensor_layout_t *layout, float *dst, int num_threads
+);
+
+/**
+ * @brief Element-wise sigmoid followed by a threshold
+ *
+ * sigmoid(x) > threshold is evaluated as x > logit(threshold), so no exp is computed.
+ *
+ * @param data Float data
+ * @param layout Data layout
+ * @param threshold Probability threshold in [0, 1]
+ * @param mask Output mask in NCHW, 1 if sigmoid(x) > threshold else 0, shape [batch, channel, area]
+ * @param count Output number of positive elements, can be NULL
+ * @param num_threads Number of threads, <= 0 means using all available threads
+ * @return Error code
+ */
+MNN_C_API mnn_error_code_t mnn_channel_sigmoid_threshold(
+    const float               *data,
+    const mnn_tensor_layout_t *layout,
+    float                      threshold,
+    uint8_t                   *mask,
+    size_t                    *count,
+    int                        num_threads
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MNN_POSTPROCESS_H
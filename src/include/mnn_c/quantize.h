@@ -0,0 +1,107 @@
+/*
+ * quantize.h
+ * MNN C API for host-side quantize/dequantize kernels
+ *
+ * This file provides affine float <-> int8/uint8/int16 conversion kernels that
+ * operate directly on host memory, without building an expression graph.
+ *
+ * Author: Rainyl
+ * License: Apache License 2.0
+ */
+
+#ifndef MNN_QUANTIZE_H
+#define MNN_QUANTIZE_H
+
+#include "mnn_c/base.h"
+#include "mnn_c/error_code.h"
+#include "mnn_c/tensor.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Affine quantization parameters, q = clamp(round(x / scale) + zero_point, qmin, qmax)
+ *
+ * If count == 1 the parameters are applied per-tensor, otherwise count must
+ * equal the length of dimension `axis` and the parameters are applied per-channel.
+ */
+typedef struct mnn_quant_params_t {
+  /** scale array, length is count */
+  const float *scale;
+  /** zero point array, length is count, NULL means all zero */
+  const int32_t *zero_point;
+  /** 1 for per-tensor, channel count for per-channel */
+  size_t count;
+  /** channel axis for per-channel parameters */
+  int axis;
+  /** clamp range, qmin >= qmax means using the full range of the quantized type */
+  int32_t qmin;
+  int32_t qmax;
+} mnn_quant_params_t;
+
+/**
+ * @brief Quantize float32 buffer to int8/uint8/int16 buffer
+ * @param src Source float buffer
+ * @param dst Destination buffer, element type is given by dst_type
+ * @param dst_type Destination type, one of int8, uint8, int16
+ * @param shape Logical shape of the buffer
+ * @param ndim Shape array size
+ * @param params Quantization parameters
+ * @return Error code
+ */
+MNN_C_API mnn_error_code_t mnn_quantize_f32(
+    const float              *src,
+    void                     *dst,
+    halide_type_c_t           dst_type,
+    const int                *shape,
+    int                       ndim,
+    const mnn_quant_params_t *params
+);
+
+/**
+ * @brief Dequantize int8/uint8/int16 buffer to float32 buffer
+ * @param src Source buffer, element type is given by src_type
+ * @param src_type Source type, one of int8, uint8, int16
+ * @param dst Destination float buffer
+ * @param shape Logical shape of the buffer
+ * @param ndim Shape array size
+ * @param params Quantization parameters
+ * @return Error code
+ */
+MNN_C_API mnn_error_code_t mnn_dequantize_f32(
+    const void               *src,
+    halide_type_c_t           src_type,
+    float                    *dst,
+    const int                *shape,
+    int                       ndim,
+    const mnn_quant_params_t *params
+);
+
+/**
+ * @brief Quantize float32 data into the host memory of a quantized tensor
+ * @param self Host tensor with int8/uint8/int16 type
+ * @param src Source float buffer, element count must equal the tensor's
+ * @param params Quantization parameters, axis refers to the tensor's shape
+ * @return Error code
+ */
+MNN_C_API mnn_error_code_t
+mnn_tensor_quantize_from_f32(mnn_tensor_t self, const float *src, const mnn_quant_params_t *params);
+
+/**
+ * @brief Dequantize the host memory of a quantized tensor into a float32 buffer
+ * @param self Host tensor with int8/uint8/int16 type
+ * @param dst Destination float buffer, element count must equal the tensor's
+ * @param params Quantization parameters, axis refers to the tensor's shape
+ * @return Error code
+ */
+MNN_C_API mnn_error_code_t
+mnn_tensor_dequantize_to_f32(mnn_tensor_t self, float *dst, const mnn_quant_params_t *params);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MNN_QUANTIZE_H
@@ -0,0 +1,81 @@
+/*
+ * rng.h
+ * MNN C API for counter-based random number generation
+ *
+ * Samples come from Philox4x32-10, each one is a pure function of the seed and its index
+ * in the stream, so buffers are filled in parallel with the same results for any number
+ * of threads, and a stream can be continued or split at any offset.
+ *
+ * Author: Rainyl
+ * License: Apache License 2.0
+ */
+
+#ifndef MNN_RNG_H
+#define MNN_RNG_H
+
+#include "mnn_c/base.h"
+#include "mnn_c/error_code.h"
+#include "mnn_c/expr.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+  /** float in [a, b) */
+  MNN_RNG_UNIFORM = 0,
+  /** float from a normal distribution with mean a and standard deviation b */
+  MNN_RNG_NORMAL = 1,
+  /** int32 in [a, b) */
+  MNN_RNG_INTEGER = 2,
+  /** int32, 1 with probability a, otherwise 0 */
+  MNN_RNG_BERNOULLI = 3,
+} mnn_rng_distribution_t;
+
+typedef struct mnn_rng_params_t {
+  /** mnn_rng_distribution_t */
+  int32_t distribution;
+  /** Key of the generator */
+  uint64_t seed;
+  /** Index of the first sample in the stream of the seed */
+  uint64_t offset;
+  /** Parameters of the distribution, see mnn_rng_distribution_t */
+  double a;
+  double b;
+} mnn_rng_params_t;
+
+/**
+ * @brief Fill a host buffer with samples
+ * @param params Distribution, seed and offset
+ * @param out Output buffer, float for uniform and normal, int32 for integer and Bernoulli
+ * @param count Number of samples
+ * @param num_threads Number of threads, <= 0 means using all available threads
+ * @return Error code, MNNC_INVALID_VALUE if the distribution parameters are invalid
+ */
+MNN_C_API mnn_error_code_t
+mnn_rng_fill(const mnn_rng_params_t *params, void *out, size_t count, int num_threads);
+
+/**
+ * @brief Create a variable filled with samples
+ * @param params Distribution, seed and offset
+ * @param shape Shape of the variable
+ * @param ndim Number of dimensions
+ * @param num_threads Number of threads, <= 0 means using all available threads
+ * @param out Output variable, float or int32 by the distribution, NCHW
+ * @return Error code
+ */
+MNN_C_API mnn_error_code_t mnn_rng_create_var(
+    const mnn_rng_params_t *params,
+    const int              *shape,
+    size_t                  ndim,
+    int                     num_threads,
+    VARP_t                 *out
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MNN_RNG_H
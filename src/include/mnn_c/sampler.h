@@ -0,0 +1,144 @@
+/*
+ * sampler.h
+ * MNN C API for token sampling
+ *
+ * This file provides the sampling step of generative decoding loops, i.e., repetition
+ * penalty, temperature, top-k, top-p and a draw from a seeded generator fused in a pass
+ * over the logits, so the vocabulary never leaves native memory.
+ *
+ * Author: Rainyl
+ * License: Apache License 2.0
+ */
+
+#ifndef MNN_SAMPLER_H
+#define MNN_SAMPLER_H
+
+#include "mnn_c/base.h"
+#include "mnn_c/error_code.h"
+#include "mnn_c/expr.h"
+#include "mnn_c/tensor.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef __cplusplus
+typedef struct mnn_sampler *mnn_sampler_t;
+#else
+typedef void *mnn_sampler_t;
+#endif
+
+typedef struct mnn_sampler_config_t {
+  /** Logits are divided by it, <= 0 means greedy decoding */
+  float temperature;
+  /** Number of most likely tokens kept, <= 0 keeps all */
+  int32_t top_k;
+  /** Smallest set of most likely tokens whose probability reaches it is kept, >= 1 keeps all */
+  float top_p;
+  /** Logits of tokens in the history are divided by it if positive, multiplied otherwise */
+  float repetition_penalty;
+  /** Seed of the random generator */
+  uint64_t seed;
+} mnn_sampler_config_t;
+
+/**
+ * @brief Create a sampler
+ * @param config Sampler config
+ * @return Sampler, NULL if the config is invalid
+ */
+MNN_C_API mnn_sampler_t mnn_sampler_create(const mnn_sampler_config_t *config);
+
+/**
+ * @brief Destroy a sampler
+ * @param self Sampler
+ */
+MNN_C_API void mnn_sampler_destroy(mnn_sampler_t self);
+
+/**
+ * @brief Replace the config of a sampler, the random generator is reseeded
+ * @param self Sampler
+ * @param config Sampler config
+ * @return Error code
+ */
+MNN_C_API mnn_error_code_t
+mnn_sampler_set_config(mnn_sampler_t self, const mnn_sampler_config_t *config);
+
+/**
+ * @brief Reseed the random generator, the same seed and inputs draw the same tokens
+ * @param self Sampler
+ * @param seed Seed
+ */
+MNN_C_API void mnn_sampler_set_seed(mnn_sampler_t self, uint64_t seed);
+
+/**
+ * @brief Sample the next token from a row of logits
+ *
+ * With top_k, the logits are scanned once by a bounded heap and only the k candidates are
+ * exponentiated. Otherwise the softmax of the whole row is computed into a buffer reused
+ * across calls. The random generator advances by one draw per call, greedy decoding, also
+ * with top_k 1, does not advance it.
+ *
+ * @param self Sampler
+ * @param logits Logits, [vocab]
+ * @param vocab Vocabulary size
+ * @param history Previous tokens the repetition penalty applies to, can be NULL
+ * @param num_history Number of previous tokens
+ * @param token Output sampled token
+ * @param prob Output probability of the token after all transforms, can be NULL
+ * @return Error code, MNNC_INVALID_VALUE if all logits are NaN or a token is out of range
+ */
+MNN_C_API mnn_error_code_t mnn_sampler_sample(
+    mnn_sampler_t  self,
+    const float   *logits,
+    size_t         vocab,
+    const int32_t *history,
+    size_t         num_history,
+    int32_t       *token,
+    float         *prob
+);
+
+/**
+ * @brief Sample the next token from the last row of a float host tensor
+ * @param self Sampler
+ * @param logits Host tensor, [..., vocab], NC4HW4 tensors are not supported
+ * @param history Previous tokens the repetition penalty applies to, can be NULL
+ * @param num_history Number of previous tokens
+ * @param token Output sampled token
+ * @param prob Output probability of the token, can be NULL
+ * @return Error code
+ */
+MNN_C_API mnn_error_code_t mnn_sampler_sample_tensor(
+    mnn_sampler_t  self,
+    mnn_tensor_t   logits,
+    const int32_t *history,
+    size_t         num_history,
+    int32_t       *token,
+    float         *prob
+);
+
+/**
+ * @brief Sample the next token from the last row of a float variable
+ * @param self Sampler
+ * @param logits Variable, [..., vocab], it will be computed if needed
+ * @param history Previous tokens the repetition penalty applies to, can be NULL
+ * @param num_history Number of previous tokens
+ * @param token Output sampled token
+ * @param prob Output probability of the token, can be NULL
+ * @return Error code
+ */
+MNN_C_API mnn_error_code_t mnn_sampler_sample_var(
+    mnn_sampler_t  self,
+    VARP_t         logits,
+    const int32_t *history,
+    size_t         num_history,
+    int32_t       *token,
+    float         *prob
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MNN_SAMPLER_H
@@ -0,0 +1,96 @@
+/*
+ * stats.h
+ * MNN C API for tensor statistics
+ *
+ * This file provides a single pass health and statistics scan over host tensors
+ * and expression variables, e.g., for NaN/Inf checks and drift detection.
+ *
+ * Author: Rainyl
+ * License: Apache License 2.0
+ */
+
+#ifndef MNN_STATS_H
+#define MNN_STATS_H
+
+#include "mnn_c/base.h"
+#include "mnn_c/error_code.h"
+#include "mnn_c/expr.h"
+#include "mnn_c/tensor.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Options of the statistics scan */
+typedef struct mnn_stats_config_t {
+  /** number of histogram bins, 0 disables the histogram */
+  int bins;
+  /** histogram range, hist_min >= hist_max means using [min, max] of the data */
+  double hist_min;
+  double hist_max;
+  /** output histogram, length is bins, values out of range are not counted */
+  uint64_t *histogram;
+  /** number of threads, <= 0 means using all available threads */
+  int num_threads;
+} mnn_stats_config_t;
+
+/**
+ * Statistics result, min/max/mean/variance only take finite values into account
+ * and are NaN if there is no finite value.
+ */
+typedef struct mnn_tensor_stats_t {
+  /** total element count */
+  size_t count;
+  size_t nan_count;
+  size_t inf_count;
+  double min;
+  double max;
+  double mean;
+  /** population variance */
+  double variance;
+} mnn_tensor_stats_t;
+
+/**
+ * @brief Compute statistics of a raw buffer
+ * @param data Buffer pointer
+ * @param type Element type, one of float32/float64/int8/uint8/int16/uint16/int32
+ * @param count Element count
+ * @param config Scan options, NULL means default options
+ * @param stats Output statistics
+ * @return Error code
+ */
+MNN_C_API mnn_error_code_t mnn_stats_compute(
+    const void               *data,
+    halide_type_c_t           type,
+    size_t                    count,
+    const mnn_stats_config_t *config,
+    mnn_tensor_stats_t       *stats
+);
+
+/**
+ * @brief Compute statistics of a host tensor
+ * @param self Host tensor, NC4HW4 tensors are not supported
+ * @param config Scan options, NULL means default options
+ * @param stats Output statistics
+ * @return Error code
+ */
+MNN_C_API mnn_error_code_t
+mnn_tensor_stats(mnn_tensor_t self, const mnn_stats_config_t *config, mnn_tensor_stats_t *stats);
+
+/**
+ * @brief Compute statistics of a variable, the variable will be computed if needed
+ * @param self Variable
+ * @param config Scan options, NULL means default options
+ * @param stats Output statistics
+ * @return Error code
+ */
+MNN_C_API mnn_error_code_t
+mnn_expr_VARP_stats(VARP_t self, const mnn_stats_config_t *config, mnn_tensor_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MNN_STATS_H
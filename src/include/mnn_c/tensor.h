@@ -122,6 +122,40 @@ MNN_C_API mnn_error_code_t mnn_tensor_copy_from_host(mnn_tensor_t self, mnn_tens
  */
 MNN_C_API mnn_error_code_t mnn_tensor_copy_to_host(mnn_tensor_t self, mnn_tensor_t host_tensor);
 
+/**
+ * @brief Copy data from host tensor, using multiple threads for large tensors
+ *
+ * If both tensors are accessible from host, the copy and the NCHW/NHWC/NC4HW4
+ * layout conversion are split across a thread pool; otherwise it falls back to
+ * mnn_tensor_copy_from_host.
+ *
+ * @param self Target tensor
+ * @param host_tensor Source tensor
+ * @param num_threads Number of threads, <= 0 means using all available threads
+ * @param threshold Tensors smaller than threshold bytes use mnn_tensor_copy_from_host
+ * @return Error code, same as mnn_tensor_copy_from_host, MNNC_BOOL_TRUE if copied in parallel
+ */
+MNN_C_API mnn_error_code_t mnn_tensor_copy_from_host_parallel(
+    mnn_tensor_t self, mnn_tensor_t host_tensor, int num_threads, size_t threshold
+);
+
+/**
+ * @brief Copy data to host tensor, using multiple threads for large tensors
+ *
+ * If both tensors are accessible from host, the copy and the NCHW/NHWC/NC4HW4
+ * layout conversion are split across a thread pool; otherwise it falls back to
+ * mnn_tensor_copy_to_host.
+ *
+ * @param self Source tensor
+ * @param host_tensor Target tensor
+ * @param num_threads Number of threads, <= 0 means using all available threads
+ * @param threshold Tensors smaller than threshold bytes use mnn_tensor_copy_to_host
+ * @return Error code, same as mnn_tensor_copy_to_host, MNNC_BOOL_TRUE if copied in parallel
+ */
+MNN_C_API mnn_error_code_t mnn_tensor_copy_to_host_parallel(
+    mnn_tensor_t self, mnn_tensor_t host_tensor, int num_threads, size_t threshold
+);
+
 /**
  * @brief Get tensor dimensions
  * @param self Tensor
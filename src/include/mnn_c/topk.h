@@ -0,0 +1,97 @@
+/*
+ * topk.h
+ * MNN C API for top-k selection
+ *
+ * This file provides partial selection of the k largest or smallest entries of each
+ * row of host tensors and expression variables without sorting whole rows, e.g., for
+ * large vocabulary or retrieval heads with 100k to 1M logits.
+ *
+ * Author: Rainyl
+ * License: Apache License 2.0
+ */
+
+#ifndef MNN_TOPK_H
+#define MNN_TOPK_H
+
+#include "mnn_c/base.h"
+#include "mnn_c/error_code.h"
+#include "mnn_c/expr.h"
+#include "mnn_c/tensor.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Options of the top-k selection */
+typedef struct mnn_topk_config_t {
+  /** number of selected entries of each row, 1 <= k <= row length */
+  int k;
+  /** select the largest entries if true, otherwise the smallest */
+  bool largest;
+  /** number of threads, <= 0 means using all available threads */
+  int num_threads;
+} mnn_topk_config_t;
+
+/**
+ * @brief Select the top k entries of each row of a float buffer
+ *
+ * Rows are split into chunks selected in parallel with a bounded heap, or quickselect
+ * when k is a large part of the chunk, and the candidates of the chunks are merged.
+ * NaN entries are never selected.
+ *
+ * @param data Float buffer, [rows, cols]
+ * @param rows Number of rows
+ * @param cols Row length
+ * @param config Selection options
+ * @param values Output values, [rows, k], best first
+ * @param indices Output column indices, [rows, k], ties resolve to the smallest index
+ * @param probs Output softmax over the selected values of each row, [rows, k], can be NULL
+ * @return Error code, MNNC_INVALID_VALUE if a row has less than k entries that are not NaN
+ */
+MNN_C_API mnn_error_code_t mnn_topk_compute(
+    const float             *data,
+    size_t                   rows,
+    size_t                   cols,
+    const mnn_topk_config_t *config,
+    float                   *values,
+    int32_t                 *indices,
+    float                   *probs
+);
+
+/**
+ * @brief Select the top k entries along the last dimension of a float host tensor
+ * @param self Host tensor, NC4HW4 tensors are not supported
+ * @param config Selection options
+ * @param values Output values, [element count / last dim, k]
+ * @param indices Output indices, [element count / last dim, k]
+ * @param probs Output softmax over the selected values, can be NULL
+ * @return Error code
+ */
+MNN_C_API mnn_error_code_t mnn_tensor_topk(
+    mnn_tensor_t             self,
+    const mnn_topk_config_t *config,
+    float                   *values,
+    int32_t                 *indices,
+    float                   *probs
+);
+
+/**
+ * @brief Select the top k entries along the last dimension of a float variable
+ * @param self Variable, it will be computed if needed
+ * @param config Selection options
+ * @param values Output values, [element count / last dim, k]
+ * @param indices Output indices, [element count / last dim, k]
+ * @param probs Output softmax over the selected values, can be NULL
+ * @return Error code
+ */
+MNN_C_API mnn_error_code_t mnn_expr_VARP_topk(
+    VARP_t self, const mnn_topk_config_t *config, float *values, int32_t *indices, float *probs
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MNN_TOPK_H
@@ -0,0 +1,548 @@
+/*
+ * linalg.cpp
+ * MNN C API for batched small-matrix linear algebra
+ *
+ * Author: Rainyl
+ * License: Apache License 2.0
+ */
+
+#include "mnn_c/linalg.h"
+#include "MNN/expr/Expr.hpp"
+#include "MNN/expr/NeuralNetWorkOp.hpp"
+#include "expr_arena.hpp"
+#include "parallel.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace {
+
+// Multiply-adds per task.
+const size_t kLinalgGrain = 1 << 15;
+// Column block of the LU of matrices from kBlockedMin, smaller ones are factored at once.
+const int kLuBlock    = 32;
+const int kBlockedMin = 96;
+
+const float kNaN = std::numeric_limits<float>::quiet_NaN();
+
+// N > 0 fixes the size at compile time so the loops below unroll, 0 uses the runtime n.
+template <int N>
+inline int dim(int n) {
+  return N > 0 ? N : n;
+}
+
+// In-place LU with partial pivoting of a row-major n x n matrix, a = P L U with unit L.
+// Columns are factored in panels of nb: the panel is eliminated, then the block row right
+// of it is solved and the trailing matrix updated with a rank-nb product, which keeps the
+// trailing rows in cache for large n. Rows swapped at step k are recorded in piv[k].
+// Returns false at the first zero pivot.
+template <int N>
+bool lu_factor(double *a, int n_, int nb, int *piv, int *sign) {
+  const int n = dim<N>(n_);
+  *sign       = 1;
+  for (int k0 = 0; k0 < n; k0 += nb) {
+    const int k1 = std::min(n, k0 + nb);
+    for (int k = k0; k < k1; k++) {
+      int    p    = k;
+      double best = std::fabs(a[k * n + k]);
+      for (int i = k + 1; i < n; i++) {
+        const double v = std::fabs(a[i * n + k]);
+        if (v > best) {
+          best = v;
+          p    = i;
+        }
+      }
+      piv[k] = p;
+      if (best == 0.0 || std::isnan(best)) return false;
+      if (p != k) {
+        std::swap_ranges(a + k * n, a + k * n + n, a + p * n);
+        *sign = -*sign;
+      }
+      const double inv = 1.0 / a[k * n + k];
+      for (int i = k + 1; i < n; i++) {
+        double *row = a + i * n;
+        row[k] *= inv;
+        const double l = row[k];
+        for (int j = k + 1; j < k1; j++) row[j] -= l * a[k * n + j];
+      }
+    }
+    if (k1 == n) break;
+    // U12 = L11^-1 A12
+    for (int k = k0; k < k1; k++) {
+      for (int i = k + 1; i < k1; i++) {
+        const double l = a[i * n + k];
+        for (int j = k1; j < n; j++) a[i * n + j] -= l * a[k * n + j];
+      }
+    }
+    // A22 -= L21 U12
+    for (int i = k1; i < n; i++) {
+      double *row = a + i * n;
+      for (int k = k0; k < k1; k++) {
+        const double l = row[k];
+        for (int j = k1; j < n; j++) row[j] -= l * a[k * n + j];
+      }
+    }
+  }
+  return true;
+}
+
+// Solve with the factors of lu_factor, b is n x nrhs and overwritten by x.
+template <int N>
+void lu_solve(const double *lu, int n_, const int *piv, double *b, int nrhs) {
+  const int n = dim<N>(n_);
+  for (int k = 0; k < n; k++) {
+    if (piv[k] != k) std::swap_ranges(b + k * nrhs, b + k * nrhs + nrhs, b + piv[k] * nrhs);
+  }
+  for (int k = 0; k < n; k++) {
+    for (int i = k + 1; i < n; i++) {
+      const double l = lu[i * n + k];
+      for (int j = 0; j < nrhs; j++) b[i * nrhs + j] -= l * b[k * nrhs + j];
+    }
+  }
+  for (int k = n - 1; k >= 0; k--) {
+    const double inv = 1.0 / lu[k * n + k];
+    for (int j = 0; j < nrhs; j++) b[k * nrhs + j] *= inv;
+    for (int i = 0; i < k; i++) {
+      const double u = lu[i * n + k];
+      for (int j = 0; j < nrhs; j++) b[i * nrhs + j] -= u * b[k * nrhs + j];
+    }
+  }
+}
+
+inline double det2(const double *a) { return a[0] * a[3] - a[1] * a[2]; }
+
+inline double det3(const double *a) {
+  return a[0] * (a[4] * a[8] - a[5] * a[7]) - a[1] * (a[3] * a[8] - a[5] * a[6]) +
+         a[2] * (a[3] * a[7] - a[4] * a[6]);
+}
+
+// Adjugate inverses of 2 x 2 and 3 x 3 matrices, false if singular.
+bool inv2(const double *a, double *out) {
+  const double d = det2(a);
+  if (d == 0.0 || std::isnan(d)) return false;
+  const double s = 1.0 / d;
+  out[0]         = a[3] * s;
+  out[1]         = -a[1] * s;
+  out[2]         = -a[2] * s;
+  out[3]         = a[0] * s;
+  return true;
+}
+
+bool inv3(const double *a, double *out) {
+  const double d = det3(a);
+  if (d == 0.0 || std::isnan(d)) return false;
+  const double s = 1.0 / d;
+  out[0]         = (a[4] * a[8] - a[5] * a[7]) * s;
+  out[1]         = (a[2] * a[7] - a[1] * a[8]) * s;
+  out[2]         = (a[1] * a[5] - a[2] * a[4]) * s;
+  out[3]         = (a[5] * a[6] - a[3] * a[8]) * s;
+  out[4]         = (a[0] * a[8] - a[2] * a[6]) * s;
+  out[5]         = (a[2] * a[3] - a[0] * a[5]) * s;
+  out[6]         = (a[3] * a[7] - a[4] * a[6]) * s;
+  out[7]         = (a[1] * a[6] - a[0] * a[7]) * s;
+  out[8]         = (a[0] * a[4] - a[1] * a[3]) * s;
+  return true;
+}
+
+template <int N>
+double det_lu(double *a, int n, int *piv) {
+  int sign;
+  if (!lu_factor<N>(a, n, n >= kBlockedMin ? kLuBlock : dim<N>(n), piv, &sign)) return 0.0;
+  double d = sign;
+  for (int i = 0; i < dim<N>(n); i++) d *= a[i * dim<N>(n) + i];
+  return d;
+}
+
+// Factor a into lu and solve for b, false if singular.
+template <int N>
+bool solve_lu(double *a, int n, int *piv, double *b, int nrhs) {
+  int sign;
+  if (!lu_factor<N>(a, n, n >= kBlockedMin ? kLuBlock : dim<N>(n), piv, &sign)) return false;
+  lu_solve<N>(a, n, piv, b, nrhs);
+  return true;
+}
+
+template <int N>
+bool cholesky(const double *a, int n_, double *l) {
+  const int n = dim<N>(n_);
+  std::fill(l, l + n * n, 0.0);
+  for (int j = 0; j < n; j++) {
+    const double *lj = l + j * n;
+    double        s  = a[j * n + j];
+    for (int k = 0; k < j; k++) s -= lj[k] * lj[k];
+    if (!(s > 0.0)) return false;
+    const double d = std::sqrt(s);
+    l[j * n + j]   = d;
+    for (int i = j + 1; i < n; i++) {
+      const double *li = l + i * n;
+      double        t  = a[i * n + j];
+      for (int k = 0; k < j; k++) t -= li[k] * lj[k];
+      l[i * n + j] = t / d;
+    }
+  }
+  return true;
+}
+
+// Householder QR of the m x n matrix in r, overwritten by R, q receives the m x k Q.
+// Reflector j is kept in row j of vs. Reflectors follow LAPACK dlarfg: a column that is
+// already zero below the diagonal is left as is, otherwise R[j][j] is
+// -sign(a[j][j]) * norm, so signs match numpy.
+void qr(double *r, int m, int n, double *q, double *vs, double *tau, double *w) {
+  const int k = std::min(m, n);
+  for (int j = 0; j < k; j++) {
+    double *v     = vs + (size_t)j * m;
+    double  below = 0.0;
+    for (int i = j + 1; i < m; i++) below += r[i * n + j] * r[i * n + j];
+    std::fill(v, v + m, 0.0);
+    v[j] = 1.0;
+    if (below == 0.0) {
+      tau[j] = 0.0;
+      continue;
+    }
+    const double alpha = r[j * n + j];
+    const double norm  = std::sqrt(alpha * alpha + below);
+    const double beta  = alpha >= 0.0 ? -norm : norm;
+    const double scale = 1.0 / (alpha - beta);
+    for (int i = j + 1; i < m; i++) v[i] = r[i * n + j] * scale;
+    tau[j] = (beta - alpha) / beta;
+    // R = (I - tau v v^T) R on columns j.., row by row for contiguous access
+    std::fill(w + j, w + n, 0.0);
+    for (int i = j; i < m; i++) {
+      for (int c = j; c < n; c++) w[c] += v[i] * r[i * n + c];
+    }
+    for (int i = j; i < m; i++) {
+      const double tv = tau[j] * v[i];
+      for (int c = j; c < n; c++) r[i * n + c] -= tv * w[c];
+    }
+    r[j * n + j] = beta;
+    for (int i = j + 1; i < m; i++) r[i * n + j] = 0.0;
+  }
+  // Q = H_0 ... H_{k-1} I[:, :k], applied from the last reflector, H_j leaves columns < j
+  for (int i = 0; i < m; i++) {
+    for (int c = 0; c < k; c++) q[i * k + c] = i == c ? 1.0 : 0.0;
+  }
+  for (int j = k - 1; j >= 0; j--) {
+    if (tau[j] == 0.0) continue;
+    const double *v = vs + (size_t)j * m;
+    std::fill(w + j, w + k, 0.0);
+    for (int i = j; i < m; i++) {
+      for (int c = j; c < k; c++) w[c] += v[i] * q[i * k + c];
+    }
+    for (int i = j; i < m; i++) {
+      const double tv = tau[j] * v[i];
+      for (int c = j; c < k; c++) q[i * k + c] -= tv * w[c];
+    }
+  }
+}
+
+// Run fn(index, scratch, pivots) over the batch in parallel, each task owns its scratch.
+template <typename F>
+bool for_batch(size_t batch, size_t cost, size_t scratch, size_t pivots, int num_threads, F fn) {
+  const size_t grain = std::max<size_t>(1, kLinalgGrain / std::max<size_t>(1, cost));
+  const int    tasks = mnnc::parallel_tasks(batch, grain, num_threads);
+  return mnnc::parallel_for(batch, tasks, [&](size_t begin, size_t end, int) {
+    std::vector<double> buf(scratch);
+    std::vector<int>    piv(pivots);
+    for (size_t i = begin; i < end; i++) fn(i, buf.data(), piv.data());
+  });
+}
+
+inline void load(const float *src, size_t count, double *dst) {
+  for (size_t i = 0; i < count; i++) dst[i] = src[i];
+}
+
+inline void store(const double *src, size_t count, float *dst) {
+  for (size_t i = 0; i < count; i++) dst[i] = (float)src[i];
+}
+
+// Matrices of a float variable, [..., rows, cols].
+struct Matrices {
+  MNN::Express::VARP var;
+  std::vector<int>   batch_dims;
+  const float       *data  = nullptr;
+  size_t             batch = 1;
+  int                rows  = 0;
+  int                cols  = 0;
+};
+
+mnn_error_code_t read_matrices(VARP_t self, int min_ndim, Matrices *out) {
+  if (!self || !(*self).get()) return MNNC_INVALID_PTR;
+  auto var  = *self;
+  auto info = var->getInfo();
+  if (!info) return MNNC_INVALID_VALUE;
+  if (info->type != halide_type_of<float>()) return MNNC_NOT_SUPPORT;
+  if (info->order == MNN::Express::NC4HW4) {
+    var  = MNN::Express::_Convert(var, MNN::Express::NCHW);
+    info = var->getInfo();
+    if (!info) return MNNC_INVALID_VALUE;
+  }
+  const auto &dims = info->dim;
+  if ((int)dims.size() < min_ndim) return MNNC_INVALID_VALUE;
+  for (int d : dims) {
+    if (d < 0) return MNNC_INVALID_VALUE;
+  }
+  const size_t nd = dims.size();
+  out->var        = var;
+  out->rows       = min_ndim >= 2 ? dims[nd - 2] : dims[nd - 1];
+  out->cols       = min_ndim >= 2 ? dims[nd - 1] : 1;
+  out->batch_dims.assign(dims.begin(), dims.end() - (min_ndim >= 2 ? 2 : 1));
+  out->batch = 1;
+  for (int d : out->batch_dims) out->batch *= (size_t)d;
+  if (out->batch * out->rows * out->cols > 0) {
+    out->data = var->readMap<float>();
+    if (!out->data) return MNNC_UNKNOWN_ERROR;
+  }
+  return MNNC_NO_ERROR;
+}
+
+MNN::Express::VARP new_matrices(const std::vector<int> &batch_dims, std::vector<int> tail) {
+  std::vector<int> dims(batch_dims);
+  dims.insert(dims.end(), tail.begin(), tail.end());
+  return MNN::Express::_Input(dims, MNN::Express::NCHW, halide_type_of<float>());
+}
+
+float *write_ptr(MNN::Express::VARP &var) {
+  auto info = var->getInfo();
+  return info && info->size > 0 ? var->writeMap<float>() : nullptr;
+}
+
+} // namespace
+
+mnn_error_code_t mnn_linalg_det(const float *a, size_t batch, int n, float *det, int num_threads) {
+  if (n < 0) return MNNC_INVALID_VALUE;
+  const size_t nn = (size_t)n * n;
+  if ((!a && batch * nn > 0) || (!det && batch > 0)) return MNNC_INVALID_PTR;
+  try {
+    auto run = [&](size_t b, double *m, int *piv) {
+      load(a + b * nn, nn, m);
+      double d;
+      switch (n) {
+      case 0: d = 1.0; break;
+      case 1: d = m[0]; break;
+      case 2: d = det2(m); break;
+      case 3: d = det3(m); break;
+      case 4: d = det_lu<4>(m, n, piv); break;
+      default: d = det_lu<0>(m, n, piv); break;
+      }
+      det[b] = (float)d;
+    };
+    const bool ok = for_batch(batch, nn * n, nn, n, num_threads, run);
+    return ok ? MNNC_NO_ERROR : MNNC_UNKNOWN_ERROR;
+  } catch (...) { return MNNC_UNKNOWN_ERROR; }
+}
+
+mnn_error_code_t mnn_linalg_inv(
+    const float *a, size_t batch, int n, float *inv, int32_t *info, int num_threads
+) {
+  if (n < 0) return MNNC_INVALID_VALUE;
+  const size_t nn = (size_t)n * n;
+  if ((!a || !inv) && batch * nn > 0) return MNNC_INVALID_PTR;
+  try {
+    std::atomic<bool> singular(false);
+    auto              run = [&](size_t b, double *m, int *piv) {
+      double *x = m + nn;
+      load(a + b * nn, nn, m);
+      bool done;
+      switch (n) {
+      case 2: done = inv2(m, x); break;
+      case 3: done = inv3(m, x); break;
+      default:
+        std::fill(x, x + nn, 0.0);
+        for (int i = 0; i < n; i++) x[i * n + i] = 1.0;
+        done = n == 4 ? solve_lu<4>(m, n, piv, x, n) : solve_lu<0>(m, n, piv, x, n);
+        break;
+      }
+      if (info) info[b] = done ? 0 : 1;
+      if (done) {
+        store(x, nn, inv + b * nn);
+      } else {
+        std::fill(inv + b * nn, inv + (b + 1) * nn, kNaN);
+        singular.store(true);
+      }
+    };
+    const bool ok = for_batch(batch, nn * n, 2 * nn, n, num_threads, run);
+    if (!ok) return MNNC_UNKNOWN_ERROR;
+    return singular.load() ? MNNC_INVALID_VALUE : MNNC_NO_ERROR;
+  } catch (...) { return MNNC_UNKNOWN_ERROR; }
+}
+
+mnn_error_code_t mnn_linalg_solve(
+    const float *a,
+    const float *b,
+    size_t       batch,
+    int          n,
+    int          nrhs,
+    float       *x,
+    int32_t     *info,
+    int          num_threads
+) {
+  if (n < 0 || nrhs < 0) return MNNC_INVALID_VALUE;
+  const size_t nn = (size_t)n * n, nk = (size_t)n * nrhs;
+  if ((!a && batch * nn > 0) || ((!b || !x) && batch * nk > 0)) return MNNC_INVALID_PTR;
+  try {
+    std::atomic<bool> singular(false);
+    auto              run = [&](size_t i, double *m, int *piv) {
+      double *rhs = m + nn;
+      load(a + i * nn, nn, m);
+      load(b + i * nk, nk, rhs);
+      const bool done = n == 2   ? solve_lu<2>(m, n, piv, rhs, nrhs)
+                        : n == 3 ? solve_lu<3>(m, n, piv, rhs, nrhs)
+                        : n == 4 ? solve_lu<4>(m, n, piv, rhs, nrhs)
+                                 : solve_lu<0>(m, n, piv, rhs, nrhs);
+      if (info) info[i] = done ? 0 : 1;
+      if (done) {
+        store(rhs, nk, x + i * nk);
+      } else {
+        std::fill(x + i * nk, x + (i + 1) * nk, kNaN);
+        singular.store(true);
+      }
+    };
+    const bool ok = for_batch(batch, nn * (n + nrhs), nn + nk, n, num_threads, run);
+    if (!ok) return MNNC_UNKNOWN_ERROR;
+    return singular.load() ? MNNC_INVALID_VALUE : MNNC_NO_ERROR;
+  } catch (...) { return MNNC_UNKNOWN_ERROR; }
+}
+
+mnn_error_code_t mnn_linalg_cholesky(
+    const float *a, size_t batch, int n, float *l, int32_t *info, int num_threads
+) {
+  if (n < 0) return MNNC_INVALID_VALUE;
+  const size_t nn = (size_t)n * n;
+  if ((!a || !l) && batch * nn > 0) return MNNC_INVALID_PTR;
+  try {
+    std::atomic<bool> indefinite(false);
+    auto              run = [&](size_t b, double *m, int *) {
+      double *f = m + nn;
+      load(a + b * nn, nn, m);
+      const bool done = n == 2   ? cholesky<2>(m, n, f)
+                        : n == 3 ? cholesky<3>(m, n, f)
+                        : n == 4 ? cholesky<4>(m, n, f)
+                                 : cholesky<0>(m, n, f);
+      if (info) info[b] = done ? 0 : 1;
+      if (done) {
+        store(f, nn, l + b * nn);
+      } else {
+        std::fill(l + b * nn, l + (b + 1) * nn, kNaN);
+        indefinite.store(true);
+      }
+    };
+    const bool ok = for_batch(batch, nn * n / 3, 2 * nn, 0, num_threads, run);
+    if (!ok) return MNNC_UNKNOWN_ERROR;
+    return indefinite.load() ? MNNC_INVALID_VALUE : MNNC_NO_ERROR;
+  } catch (...) { return MNNC_UNKNOWN_ERROR; }
+}
+
+mnn_error_code_t mnn_linalg_qr(
+    const float *a, size_t batch, int m, int n, float *q, float *r, int num_threads
+) {
+  if (m < 0 || n < 0) return MNNC_INVALID_VALUE;
+  const int    k  = std::min(m, n);
+  const size_t mn = (size_t)m * n, mk = (size_t)m * k, kn = (size_t)k * n;
+  if ((!a || !q || !r) && batch * mn > 0) return MNNC_INVALID_PTR;
+  try {
+    auto run = [&](size_t b, double *rr, int *) {
+      double *qq = rr + mn, *vs = qq + mk, *tau = vs + mk, *w = tau + k;
+      load(a + b * mn, mn, rr);
+      qr(rr, m, n, qq, vs, tau, w);
+      store(qq, mk, q + b * mk);
+      store(rr, kn, r + b * kn);
+    };
+    // r, q, reflectors, tau and row accumulator
+    const size_t scratch = mn + 2 * mk + k + std::max(n, k);
+    const bool   ok      = for_batch(batch, mn * k, scratch, 0, num_threads, run);
+    return ok ? MNNC_NO_ERROR : MNNC_UNKNOWN_ERROR;
+  } catch (...) { return MNNC_UNKNOWN_ERROR; }
+}
+
+mnn_error_code_t mnn_expr_linalg_det(VARP_t a, VARP_t *out) {
+  if (!out) return MNNC_INVALID_PTR;
+  try {
+    Matrices mats;
+    auto     code = read_matrices(a, 2, &mats);
+    if (code != MNNC_NO_ERROR) return code;
+    if (mats.rows != mats.cols) return MNNC_INVALID_VALUE;
+    auto res = new_matrices(mats.batch_dims, {});
+    code     = mnn_linalg_det(mats.data, mats.batch, mats.rows, write_ptr(res), 0);
+    if (code != MNNC_NO_ERROR) return code;
+    *out = mnnc::make_varp(res);
+    return MNNC_NO_ERROR;
+  } catch (...) { return MNNC_UNKNOWN_ERROR; }
+}
+
+mnn_error_code_t mnn_expr_linalg_inv(VARP_t a, VARP_t *out) {
+  if (!out) return MNNC_INVALID_PTR;
+  try {
+    Matrices mats;
+    auto     code = read_matrices(a, 2, &mats);
+    if (code != MNNC_NO_ERROR) return code;
+    if (mats.rows != mats.cols) return MNNC_INVALID_VALUE;
+    auto res = new_matrices(mats.batch_dims, {mats.rows, mats.cols});
+    code = mnn_linalg_inv(mats.data, mats.batch, mats.rows, write_ptr(res), nullptr, 0);
+    if (code != MNNC_NO_ERROR) return code;
+    *out = mnnc::make_varp(res);
+    return MNNC_NO_ERROR;
+  } catch (...) { return MNNC_UNKNOWN_ERROR; }
+}
+
+mnn_error_code_t mnn_expr_linalg_solve(VARP_t a, VARP_t b, VARP_t *out) {
+  if (!out) return MNNC_INVALID_PTR;
+  try {
+    Matrices mats, rhs;
+    auto     code = read_matrices(a, 2, &mats);
+    if (code != MNNC_NO_ERROR) return code;
+    if (mats.rows != mats.cols) return MNNC_INVALID_VALUE;
+    if (!b || !(*b).get()) return MNNC_INVALID_PTR;
+    auto binfo = (*b)->getInfo();
+    if (!binfo) return MNNC_INVALID_VALUE;
+    // b is a stack of vectors if it has one dimension less than a
+    const bool vector = binfo->dim.size() + 1 == mats.batch_dims.size() + 2;
+    code              = read_matrices(b, vector ? 1 : 2, &rhs);
+    if (code != MNNC_NO_ERROR) return code;
+    if (rhs.batch_dims != mats.batch_dims || rhs.rows != mats.rows) return MNNC_INVALID_VALUE;
+    std::vector<int> tail = {rhs.rows};
+    if (!vector) tail.push_back(rhs.cols);
+    auto res = new_matrices(rhs.batch_dims, tail);
+    code     = mnn_linalg_solve(
+        mats.data, rhs.data, mats.batch, mats.rows, rhs.cols, write_ptr(res), nullptr, 0
+    );
+    if (code != MNNC_NO_ERROR) return code;
+    *out = mnnc::make_varp(res);
+    return MNNC_NO_ERROR;
+  } catch (...) { return MNNC_UNKNOWN_ERROR; }
+}
+
+mnn_error_code_t mnn_expr_linalg_cholesky(VARP_t a, VARP_t *out) {
+  if (!out) return MNNC_INVALID_PTR;
+  try {
+    Matrices mats;
+    auto     code = read_matrices(a, 2, &mats);
+    if (code != MNNC_NO_ERROR) return code;
+    if (mats.rows != mats.cols) return MNNC_INVALID_VALUE;
+    auto res = new_matrices(mats.batch_dims, {mats.rows, mats.cols});
+    code = mnn_linalg_cholesky(mats.data, mats.batch, mats.rows, write_ptr(res), nullptr, 0);
+    if (code != MNNC_NO_ERROR) return code;
+    *out = mnnc::make_varp(res);
+    return MNNC_NO_ERROR;
+  } catch (...) { return MNNC_UNKNOWN_ERROR; }
+}
+
+mnn_error_code_t mnn_expr_linalg_qr(VARP_t a, VARP_t *q, VARP_t *r) {
+  if (!q || !r) return MNNC_INVALID_PTR;
+  try {
+    Matrices mats;
+    auto     code = read_matrices(a, 2, &mats);
+    if (code != MNNC_NO_ERROR) return code;
+    const int k    = std::min(mats.rows, mats.cols);
+    auto      resq = new_matrices(mats.batch_dims, {mats.rows, k});
+    auto      resr = new_matrices(mats.batch_dims, {k, mats.cols});
+    code           = mnn_linalg_qr(
+        mats.data, mats.batch, mats.rows, mats.cols, write_ptr(resq), write_ptr(resr), 0
+    );
+    if (code != MNNC_NO_ERROR) return code;
+    *q = mnnc::make_varp(resq);
+    *r = mnnc::make_varp(resr);
+    return MNNC_NO_ERROR;
+  } catch (...) { return MNNC_UNKNOWN_ERROR; }
+}
@@ -0,0 +1,115 @@
+/*
+ * mmap_file.hpp
+ * Internal read-only / copy-on-write file mapping helper
+ *
+ * Author: Rainyl
+ * License: Apache License 2.0
+ */
+
+#ifndef MNN_C_MMAP_FILE_HPP
+#define MNN_C_MMAP_FILE_HPP
+
+#include "mnn_c/error_code.h"
+#include <cstddef>
+#include <cstdint>
+
+#ifdef _WIN32
+  #ifndef NOMINMAX
+    #define NOMINMAX
+  #endif
+  #include <windows.h>
+#else
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+namespace mnnc {
+
+// Maps a whole file into memory. Pages are mapped copy-on-write so that callers may
+// modify the data in place without touching the file.
+class MappedFile {
+public:
+  MappedFile() = default;
+  MappedFile(const MappedFile &)            = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+  ~MappedFile() { close(); }
+
+  mnn_error_code_t open(const char *path) {
+    close();
+#ifdef _WIN32
+    _file = CreateFileA(
+        path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr
+    );
+    if (_file == INVALID_HANDLE_VALUE) return MNNC_FILE_OPEN_FAILED;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(_file, &size)) {
+      close();
+      return MNNC_FILE_OPEN_FAILED;
+    }
+    _size = (size_t)size.QuadPart;
+    if (_size == 0) return MNNC_NO_ERROR;
+    _mapping = CreateFileMappingA(_file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+    if (_mapping == nullptr) {
+      close();
+      return MNNC_FILE_OPEN_FAILED;
+    }
+    _data = MapViewOfFile(_mapping, FILE_MAP_COPY, 0, 0, 0);
+    if (_data == nullptr) {
+      close();
+      return MNNC_FILE_OPEN_FAILED;
+    }
+#else
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) return MNNC_FILE_OPEN_FAILED;
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+      ::close(fd);
+      return MNNC_FILE_OPEN_FAILED;
+    }
+    _size = (size_t)st.st_size;
+    if (_size == 0) {
+      ::close(fd);
+      return MNNC_NO_ERROR;
+    }
+    void *p = mmap(nullptr, _size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED) {
+      _size = 0;
+      return MNNC_FILE_OPEN_FAILED;
+    }
+    _data = p;
+#endif
+    return MNNC_NO_ERROR;
+  }
+
+  void close() {
+#ifdef _WIN32
+    if (_data) UnmapViewOfFile(_data);
+    if (_mapping) CloseHandle(_mapping);
+    if (_file != INVALID_HANDLE_VALUE) CloseHandle(_file);
+    _mapping = nullptr;
+    _file    = INVALID_HANDLE_VALUE;
+#else
+    if (_data) munmap(_data, _size);
+#endif
+    _data = nullptr;
+    _size = 0;
+  }
+
+  uint8_t *data() const { return (uint8_t *)_data; }
+  size_t   size() const { return _size; }
+
+private:
+  void  *_data = nullptr;
+  size_t _size = 0;
+#ifdef _WIN32
+  HANDLE _file    = INVALID_HANDLE_VALUE;
+  HANDLE _mapping = nullptr;
+#endif
+};
+
+} // namespace mnnc
+
+#endif // MNN_C_MMAP_FILE_HPP
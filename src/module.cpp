@@ -4,6 +4,8 @@
 //
 
 #include "mnn_c/module.h"
+#include "MNN/expr/NeuralNetWorkOp.hpp"
+#include "expr_arena.hpp"
 #include <cstring>
 #include <string>
 #include <vector>
@@ -407,7 +409,7 @@ mnn_module_forward(mnn_module_t self, VARP_t input, VARP_t *output, mnn_callback
   }
   try {
     auto _output = self->forward(*input);
-    *output      = new VARP(_output);
+    *output      = mnnc::make_varp(_output);
     if (callback) callback();
     return MNNC_NO_ERROR;
   } catch (...) {
@@ -416,6 +418,43 @@ mnn_module_forward(mnn_module_t self, VARP_t input, VARP_t *output, mnn_callback
   }
 }
 
+mnn_error_code_t mnn_module_forward_into(
+    mnn_module_t  self,
+    VecVARP_t     inputs,
+    void *const  *outputs,
+    const size_t *sizes,
+    size_t        num_outputs,
+    size_t       *written
+) {
+  if (!self || !inputs || ((!outputs || !sizes) && num_outputs > 0)) return MNNC_INVALID_PTR;
+  try {
+    auto results = self->onForward(*inputs);
+    if (results.size() != num_outputs) return MNNC_INVALID_VALUE;
+    for (auto &result : results) {
+      auto info = result.get() ? result->getInfo() : nullptr;
+      if (!info) return MNNC_UNKNOWN_ERROR;
+      if (info->order == NC4HW4) result = _Convert(result, NCHW);
+    }
+    Variable::compute(results);
+    for (size_t i = 0; i < num_outputs; i++) {
+      auto info = results[i]->getInfo();
+      if (!info) return MNNC_UNKNOWN_ERROR;
+      const size_t bytes = info->size * info->type.bytes();
+      if (bytes > sizes[i]) return MNNC_INVALID_VALUE;
+      if (bytes == 0) {
+        if (written) written[i] = 0;
+        continue;
+      }
+      if (!outputs[i]) return MNNC_INVALID_PTR;
+      auto src = results[i]->readMap<void>();
+      if (!src) return MNNC_UNKNOWN_ERROR;
+      memcpy(outputs[i], src, bytes);
+      if (written) written[i] = bytes;
+    }
+    return MNNC_NO_ERROR;
+  } catch (...) { return MNNC_UNKNOWN_ERROR; }
+}
+
 // Info
 bool mnn_module_get_is_training(mnn_module_t self) {
   if (self) return self->getIsTraining();
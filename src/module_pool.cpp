@@ -0,0 +1,270 @@
+/*
+ * module_pool.cpp
+ * MNN C API for pools of module clones
+ *
+ * Author: Rainyl
+ * License: Apache License 2.0
+ */
+
+#include "mnn_c/module_pool.h"
+#include "MNN/expr/Executor.hpp"
+#include "MNN/expr/ExecutorScope.hpp"
+#include "MNN/expr/Expr.hpp"
+#include "MNN/expr/Module.hpp"
+#include "parallel.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using MNN::Express::Executor;
+using MNN::Express::ExecutorScope;
+using MNN::Express::Module;
+using MNN::Express::VARP;
+using MNN::Express::Variable;
+
+namespace {
+
+uint64_t now_ns() {
+  return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch()
+  )
+      .count();
+}
+
+// One deque per worker, tasks are pushed round-robin, the owner pops from the front and
+// idle workers steal from the back of the others. A task is reserved through the shared
+// pending count before it is searched for, so a reserved task always exists in some deque.
+template <typename T>
+class StealingQueues {
+public:
+  explicit StealingQueues(size_t n) : _queues(n) {}
+
+  void push(std::unique_ptr<T> task) {
+    Queue &q = _queues[_next.fetch_add(1) % _queues.size()];
+    {
+      std::lock_guard<std::mutex> lock(q.mutex);
+      q.tasks.push_back(std::move(task));
+    }
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _pending++;
+    }
+    _cv.notify_one();
+  }
+
+  // Block until a task is available, nullptr once stopped and drained.
+  std::unique_ptr<T> pop(size_t self, bool *stolen) {
+    {
+      std::unique_lock<std::mutex> lock(_mutex);
+      _cv.wait(lock, [this] { return _pending > 0 || _stopped; });
+      if (_pending == 0) return nullptr;
+      _pending--;
+    }
+    const size_t n = _queues.size();
+    for (;;) {
+      for (size_t k = 0; k < n; k++) {
+        Queue                      &q = _queues[(self + k) % n];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (q.tasks.empty()) continue;
+        std::unique_ptr<T> task;
+        if (k == 0) {
+          task = std::move(q.tasks.front());
+          q.tasks.pop_front();
+        } else {
+          task = std::move(q.tasks.back());
+          q.tasks.pop_back();
+        }
+        *stolen = k != 0;
+        return task;
+      }
+      std::this_thread::yield();
+    }
+  }
+
+  void stop() {
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _stopped = true;
+    }
+    _cv.notify_all();
+  }
+
+  size_t pending() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _pending;
+  }
+
+  size_t queued(size_t i) {
+    std::lock_guard<std::mutex> lock(_queues[i].mutex);
+    return _queues[i].tasks.size();
+  }
+
+private:
+  struct Queue {
+    std::mutex                     mutex;
+    std::deque<std::unique_ptr<T>> tasks;
+  };
+
+  std::vector<Queue>      _queues;
+  std::atomic<size_t>     _next{0};
+  std::mutex              _mutex;
+  std::condition_variable _cv;
+  size_t                  _pending = 0;
+  bool                    _stopped = false;
+};
+
+struct Request {
+  std::vector<VARP>              inputs;
+  VecVARP_t                     *outputs;
+  mnn_callback_0                 callback;
+  std::promise<mnn_error_code_t> done;
+};
+
+struct WorkerStats {
+  std::atomic<uint64_t> requests{0};
+  std::atomic<uint64_t> stolen{0};
+  std::atomic<uint64_t> busy_ns{0};
+  std::atomic<uint64_t> start_ns{0};
+  std::atomic<bool>     in_use{false};
+};
+
+} // namespace
+
+struct mnn_module_pool {
+  explicit mnn_module_pool(size_t size) : queues(size), stats(size) {
+    for (auto &s : stats) s.reset(new WorkerStats());
+  }
+
+  ~mnn_module_pool() {
+    queues.stop();
+    for (auto &t : threads) t.join();
+  }
+
+  // Each worker creates its executor and clone under its own ExecutorScope, which is
+  // thread local, and keeps both for its lifetime.
+  void run(
+      size_t index, Module *master, std::shared_ptr<Executor> executor, std::promise<bool> *ready
+  ) {
+    ExecutorScope scope(executor);
+    Module       *clone = Module::clone(master, true);
+    ready->set_value(clone != nullptr);
+    if (!clone) return;
+    WorkerStats &s = *stats[index];
+    s.start_ns.store(now_ns());
+    bool stolen = false;
+    while (auto request = queues.pop(index, &stolen)) {
+      s.in_use.store(true);
+      const uint64_t   start = now_ns();
+      mnn_error_code_t code  = MNNC_UNKNOWN_ERROR;
+      *request->outputs      = nullptr;
+      try {
+        auto outputs = clone->onForward(request->inputs);
+        if (!outputs.empty()) {
+          Variable::compute(outputs);
+          *request->outputs = new std::vector<VARP>(std::move(outputs));
+          code              = MNNC_NO_ERROR;
+        }
+      } catch (...) {}
+      request->inputs.clear();
+      s.busy_ns.fetch_add(now_ns() - start);
+      s.requests.fetch_add(1);
+      if (stolen) s.stolen.fetch_add(1);
+      s.in_use.store(false);
+      if (request->callback) {
+        request->callback();
+      } else {
+        request->done.set_value(code);
+      }
+    }
+    Module::destroy(clone);
+  }
+
+  StealingQueues<Request>                   queues;
+  std::vector<std::unique_ptr<WorkerStats>> stats;
+  std::vector<std::thread>                  threads;
+};
+
+mnn_module_pool_t mnn_module_pool_create(
+    mnn_module_t master, int type, mnn_backend_config_t config, int num_thread, size_t size
+) {
+  if (!master) return nullptr;
+  MNN::BackendConfig _config;
+  _config.memory        = static_cast<MNN::BackendConfig::MemoryMode>(config.memory);
+  _config.power         = static_cast<MNN::BackendConfig::PowerMode>(config.power);
+  _config.precision     = static_cast<MNN::BackendConfig::PrecisionMode>(config.precision);
+  _config.sharedContext = config.sharedContext;
+  _config.flags         = config.flags;
+  if (size == 0) size = (size_t)mnnc::ThreadPool::instance().concurrency();
+  try {
+    std::unique_ptr<mnn_module_pool> self(new mnn_module_pool(size));
+    // clone one at a time, the master is only read by one worker at once
+    for (size_t i = 0; i < size; i++) {
+      auto executor =
+          Executor::newExecutor(static_cast<MNNForwardType>(type), _config, num_thread);
+      std::promise<bool> ready;
+      auto               cloned = ready.get_future();
+      self->threads.emplace_back(&mnn_module_pool::run, self.get(), i, master, executor, &ready);
+      if (!cloned.get()) return nullptr;
+    }
+    return self.release();
+  } catch (...) { return nullptr; }
+}
+
+void mnn_module_pool_destroy(mnn_module_pool_t self) {
+  if (self) {
+    delete self;
+    self = nullptr;
+  }
+}
+
+size_t mnn_module_pool_size(mnn_module_pool_t self) { return self ? self->threads.size() : 0; }
+
+mnn_error_code_t mnn_module_pool_forward(
+    mnn_module_pool_t self, VecVARP_t inputs, VecVARP_t *outputs, mnn_callback_0 callback
+) {
+  if (!self || !inputs || !outputs) {
+    if (callback) callback();
+    return MNNC_INVALID_PTR;
+  }
+  try {
+    std::unique_ptr<Request> request(new Request());
+    request->inputs   = *inputs;
+    request->outputs  = outputs;
+    request->callback = callback;
+    if (callback) {
+      self->queues.push(std::move(request));
+      return MNNC_NO_ERROR;
+    }
+    auto done = request->done.get_future();
+    self->queues.push(std::move(request));
+    return done.get();
+  } catch (...) {
+    if (callback) callback();
+    return MNNC_UNKNOWN_ERROR;
+  }
+}
+
+size_t mnn_module_pool_pending(mnn_module_pool_t self) {
+  return self ? self->queues.pending() : 0;
+}
+
+mnn_error_code_t
+mnn_module_pool_get_stats(mnn_module_pool_t self, size_t index, mnn_module_pool_stats_t *stats) {
+  if (!self || !stats) return MNNC_INVALID_PTR;
+  if (index >= self->threads.size()) return MNNC_INVALID_VALUE;
+  const WorkerStats &s     = *self->stats[index];
+  const uint64_t     start = s.start_ns.load();
+  stats->requests      = s.requests.load();
+  stats->stolen        = s.stolen.load();
+  stats->busy_ns       = s.busy_ns.load();
+  stats->alive_ns      = start ? now_ns() - start : 0;
+  stats->queued        = self->queues.queued(index);
+  stats->in_use        = s.in_use.load();
+  return MNNC_NO_ERROR;
+}
@@ -0,0 +1,501 @@
+/*
+ * npy.cpp
+ * MNN C API for tensor persistence in .npy format
+ *
+ * Author: Rainyl
+ * License: Apache License 2.0
+ */
+
+#include "mnn_c/npy.h"
+#include "MNN/HalideRuntime.h"
+#include "MNN/Tensor.hpp"
+#include "mmap_file.hpp"
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace {
+
+const char     kNpyMagic[]     = "\x93NUMPY";
+const size_t   kNpyMagicLen    = 6;
+const char     kArchiveMagic[] = "MNNNPYA";
+const size_t   kArchiveMagicLen = 8; // including the trailing '\0'
+const uint32_t kArchiveVersion = 1;
+const size_t   kAlign          = 64;
+
+size_t align_up(size_t v) { return (v + kAlign - 1) / kAlign * kAlign; }
+
+template <typename T>
+void append_le(std::string &out, T v) {
+  for (size_t i = 0; i < sizeof(T); i++) out += (char)((v >> (8 * i)) & 0xff);
+}
+
+template <typename T>
+T read_le(const uint8_t *p) {
+  T v = 0;
+  for (size_t i = 0; i < sizeof(T); i++) v |= (T)p[i] << (8 * i);
+  return v;
+}
+
+bool is_little_endian() {
+  const uint16_t v = 1;
+  return *(const uint8_t *)&v == 1;
+}
+
+// numpy dtype descr of a halide type, e.g., '<f4'
+bool descr_of(halide_type_t type, std::string &descr) {
+  if (type.lanes != 1) return false;
+  const char endian = type.bits == 8 ? '|' : (is_little_endian() ? '<' : '>');
+  char       kind;
+  switch (type.code) {
+  case halide_type_float: kind = 'f'; break;
+  case halide_type_int: kind = 'i'; break;
+  case halide_type_uint: kind = 'u'; break;
+  default: return false;
+  }
+  if (type.bits % 8 != 0 || type.bits == 0) return false;
+  descr = std::string(1, endian) + kind + std::to_string(type.bits / 8);
+  return true;
+}
+
+bool type_of(const std::string &descr, halide_type_t &type) {
+  if (descr.size() < 3) return false;
+  const char endian = descr[0];
+  const char kind   = descr[1];
+  const int  bytes  = atoi(descr.c_str() + 2);
+  if (bytes != 1 && endian != '|' && endian != '=' && endian != (is_little_endian() ? '<' : '>')) {
+    return false; // byte swapping is not supported
+  }
+  switch (kind) {
+  case 'f':
+    if (bytes != 4 && bytes != 8) return false;
+    type = halide_type_t(halide_type_float, bytes * 8);
+    return true;
+  case 'i':
+    if (bytes != 1 && bytes != 2 && bytes != 4 && bytes != 8) return false;
+    type = halide_type_t(halide_type_int, bytes * 8);
+    return true;
+  case 'u':
+    if (bytes != 1 && bytes != 2 && bytes != 4 && bytes != 8) return false;
+    type = halide_type_t(halide_type_uint, bytes * 8);
+    return true;
+  case 'b':
+    if (bytes != 1) return false;
+    type = halide_type_t(halide_type_uint, 8);
+    return true;
+  default: return false;
+  }
+}
+
+std::string npy_header(const std::vector<int> &shape, const std::string &descr) {
+  std::string dict = "{'descr': '" + descr + "', 'fortran_order': False, 'shape': (";
+  for (size_t i = 0; i < shape.size(); i++) {
+    dict += std::to_string(shape[i]);
+    if (shape.size() == 1 || i + 1 < shape.size()) dict += ",";
+    if (i + 1 < shape.size()) dict += " ";
+  }
+  dict += "), }";
+  // magic(6) + version(2) + header_len(2) + dict + padding + '\n' must be aligned
+  size_t total = align_up(kNpyMagicLen + 4 + dict.size() + 1);
+  dict.append(total - (kNpyMagicLen + 4) - dict.size() - 1, ' ');
+  dict += '\n';
+  std::string header(kNpyMagic, kNpyMagicLen);
+  header += (char)1; // version 1.0
+  header += (char)0;
+  const uint16_t len = (uint16_t)dict.size();
+  header += (char)(len & 0xff);
+  header += (char)(len >> 8);
+  return header + dict;
+}
+
+struct NpyInfo {
+  halide_type_t    type;
+  std::vector<int> shape;
+  size_t           data_offset; // relative to the beginning of the npy blob
+  size_t           data_size;
+};
+
+// find the value text following 'key': in the header dict
+bool dict_value(const std::string &dict, const std::string &key, std::string &value) {
+  auto pos = dict.find("'" + key + "'");
+  if (pos == std::string::npos) return false;
+  pos = dict.find(':', pos);
+  if (pos == std::string::npos) return false;
+  pos++;
+  while (pos < dict.size() && dict[pos] == ' ') pos++;
+  if (pos >= dict.size()) return false;
+  size_t end;
+  if (dict[pos] == '\'') {
+    end = dict.find('\'', pos + 1);
+    if (end == std::string::npos) return false;
+    value = dict.substr(pos + 1, end - pos - 1);
+  } else if (dict[pos] == '(') {
+    end = dict.find(')', pos);
+    if (end == std::string::npos) return false;
+    value = dict.substr(pos + 1, end - pos - 1);
+  } else {
+    end = dict.find_first_of(",}", pos);
+    if (end == std::string::npos) return false;
+    value = dict.substr(pos, end - pos);
+  }
+  return true;
+}
+
+// Parse the header of a npy blob, `size` only needs to cover the header.
+mnn_error_code_t parse_npy_header(const uint8_t *data, size_t size, NpyInfo &info) {
+  if (size < kNpyMagicLen + 4 || memcmp(data, kNpyMagic, kNpyMagicLen) != 0) {
+    return MNNC_INVALID_VALUE;
+  }
+  const uint8_t major = data[kNpyMagicLen];
+  size_t        header_len, prefix;
+  if (major == 1) {
+    header_len = read_le<uint16_t>(data + 8);
+    prefix     = 10;
+  } else if (major == 2 || major == 3) {
+    if (size < 12) return MNNC_INVALID_VALUE;
+    header_len = read_le<uint32_t>(data + 8);
+    prefix     = 12;
+  } else {
+    return MNNC_NOT_SUPPORT;
+  }
+  if (prefix + header_len > size) return MNNC_INVALID_VALUE;
+  const std::string dict((const char *)data + prefix, header_len);
+
+  std::string descr, fortran, shape;
+  if (!dict_value(dict, "descr", descr) || !dict_value(dict, "fortran_order", fortran) ||
+      !dict_value(dict, "shape", shape)) {
+    return MNNC_INVALID_VALUE;
+  }
+  if (fortran.find("True") != std::string::npos) return MNNC_NOT_SUPPORT;
+  if (!type_of(descr, info.type)) return MNNC_NOT_SUPPORT;
+
+  info.shape.clear();
+  // Tensor sizes are int in MNN, reject dims and element counts that do not fit
+  size_t count = 1;
+  for (size_t pos = 0; pos < shape.size();) {
+    while (pos < shape.size() && (shape[pos] == ' ' || shape[pos] == ',')) pos++;
+    if (pos >= shape.size()) break;
+    char     *end = nullptr;
+    long long dim = strtoll(shape.c_str() + pos, &end, 10);
+    if (end == shape.c_str() + pos || dim < 0 || dim > INT_MAX) return MNNC_INVALID_VALUE;
+    if (dim != 0 && count > (size_t)INT_MAX / (size_t)dim) return MNNC_INVALID_VALUE;
+    info.shape.push_back((int)dim);
+    count *= (size_t)dim;
+    pos = end - shape.c_str();
+  }
+  if (count > SIZE_MAX / info.type.bytes()) return MNNC_INVALID_VALUE;
+  info.data_offset = prefix + header_len;
+  info.data_size   = count * info.type.bytes();
+  return MNNC_NO_ERROR;
+}
+
+// Size of the header of a npy blob, 0 if the prefix is invalid or incomplete. Headers are
+// never shorter than the 12 byte prefix of version 2, a valid dict is longer than that.
+size_t npy_header_size(const uint8_t *data, size_t size) {
+  if (size < 12 || memcmp(data, kNpyMagic, kNpyMagicLen) != 0) return 0;
+  const uint64_t header_size = data[kNpyMagicLen] == 1
+                                   ? 10 + (uint64_t)read_le<uint16_t>(data + 8)
+                                   : 12 + (uint64_t)read_le<uint32_t>(data + 8);
+  if (header_size < 12 || header_size > SIZE_MAX) return 0;
+  return (size_t)header_size;
+}
+
+mnn_error_code_t parse_npy(const uint8_t *data, size_t size, NpyInfo &info) {
+  auto code = parse_npy_header(data, size, info);
+  if (code != MNNC_NO_ERROR) return code;
+  return info.data_offset + info.data_size <= size ? MNNC_NO_ERROR : MNNC_INVALID_VALUE;
+}
+
+mnn_error_code_t host_view(mnn_tensor_t self, std::vector<int> &shape, std::string &descr) {
+  if (!self) return MNNC_INVALID_PTR;
+  auto *t = (MNN::Tensor *)self;
+  if (!t->host<void>()) return MNNC_INVALID_PTR;
+  // NC4HW4 host memory is padded, convert it to NCHW/NHWC before saving
+  if (t->getDimensionType() == MNN::Tensor::CAFFE_C4) return MNNC_NOT_SUPPORT;
+  if (!descr_of(t->getType(), descr)) return MNNC_NOT_SUPPORT;
+  shape = t->shape();
+  return MNNC_NO_ERROR;
+}
+
+// 64-bit file positions, long is 32-bit on Windows
+int file_seek(FILE *fp, int64_t offset, int whence) {
+#ifdef _WIN32
+  return _fseeki64(fp, offset, whence);
+#else
+  return fseeko(fp, (off_t)offset, whence);
+#endif
+}
+
+int64_t file_tell(FILE *fp) {
+#ifdef _WIN32
+  return _ftelli64(fp);
+#else
+  return (int64_t)ftello(fp);
+#endif
+}
+
+bool write_all(FILE *fp, const void *data, size_t size) {
+  return size == 0 || fwrite(data, 1, size, fp) == size;
+}
+
+bool write_padding(FILE *fp, size_t size) {
+  static const char zeros[kAlign] = {0};
+  return write_all(fp, zeros, size);
+}
+
+} // namespace
+
+struct mnn_npy_archive {
+  mnnc::MappedFile          mapped;
+  std::vector<uint8_t>      buffer;
+  std::vector<std::string>  names;
+  std::vector<MNN::Tensor *> tensors;
+
+  ~mnn_npy_archive() {
+    for (auto t : tensors) delete t;
+  }
+};
+
+mnn_error_code_t mnn_tensor_save_npy(mnn_tensor_t self, const char *path) {
+  if (!path) return MNNC_INVALID_PTR;
+  std::vector<int> shape;
+  std::string      descr;
+  auto             code = host_view(self, shape, descr);
+  if (code != MNNC_NO_ERROR) return code;
+  try {
+    auto       *t      = (MNN::Tensor *)self;
+    std::string header = npy_header(shape, descr);
+    FILE       *fp     = fopen(path, "wb");
+    if (!fp) return MNNC_FILE_CREATE_FAILED;
+    bool ok = write_all(fp, header.data(), header.size()) &&
+              write_all(fp, t->host<void>(), (size_t)t->elementSize() * t->getType().bytes());
+    if (fclose(fp) != 0) ok = false;
+    return ok ? MNNC_NO_ERROR : MNNC_FILE_CLOSE_FAILED;
+  } catch (...) { return MNNC_UNKNOWN_ERROR; }
+}
+
+mnn_error_code_t mnn_tensor_load_npy(const char *path, mnn_tensor_t *out) {
+  if (!path || !out) return MNNC_INVALID_PTR;
+  FILE *fp = fopen(path, "rb");
+  if (!fp) return MNNC_FILE_OPEN_FAILED;
+  MNN::Tensor     *tensor = nullptr;
+  mnn_error_code_t code   = MNNC_NO_ERROR;
+  try {
+    // read the header first, then read the data directly into the tensor
+    std::vector<uint8_t> head(12);
+    size_t               header_size = 0;
+    if (fread(head.data(), 1, head.size(), fp) == head.size()) {
+      header_size = npy_header_size(head.data(), head.size());
+    }
+    NpyInfo info;
+    if (header_size < head.size()) {
+      code = MNNC_INVALID_VALUE;
+    } else {
+      const size_t rest = header_size - head.size();
+      head.resize(header_size);
+      if (fread(head.data() + 12, 1, rest, fp) != rest) {
+        code = MNNC_INVALID_VALUE;
+      } else {
+        code = parse_npy_header(head.data(), head.size(), info);
+      }
+    }
+    if (code == MNNC_NO_ERROR && file_seek(fp, (int64_t)info.data_offset, SEEK_SET) != 0) {
+      code = MNNC_INVALID_VALUE;
+    }
+    if (code == MNNC_NO_ERROR) {
+      tensor = MNN::Tensor::create(info.shape, info.type, nullptr, MNN::Tensor::CAFFE);
+      if (!tensor) {
+        code = MNNC_OUT_OF_MEMORY;
+      } else if (info.data_size > 0 &&
+                 fread(tensor->host<void>(), 1, info.data_size, fp) != info.data_size) {
+        code = MNNC_INVALID_VALUE;
+      }
+    }
+  } catch (...) { code = MNNC_UNKNOWN_ERROR; }
+  fclose(fp);
+  if (code != MNNC_NO_ERROR) {
+    delete tensor;
+    return code;
+  }
+  *out = (mnn_tensor_t)tensor;
+  return MNNC_NO_ERROR;
+}
+
+mnn_error_code_t mnn_npy_save_archive(
+    const char *path, const char **names, const mnn_tensor_t *tensors, size_t count
+) {
+  if (!path || (count > 0 && (!names || !tensors))) return MNNC_INVALID_PTR;
+  try {
+    // layout: magic | version u32 | count u32 | {name_len u32, name, offset u64, size u64} * count
+    //         | padding | npy blobs, each aligned to kAlign
+    std::vector<std::string> headers(count);
+    std::vector<size_t>      sizes(count);
+    std::map<std::string, size_t> seen;
+    size_t                   index_size = kArchiveMagicLen + 8;
+    for (size_t i = 0; i < count; i++) {
+      if (!names[i]) return MNNC_INVALID_PTR;
+      if (!seen.insert(std::make_pair(std::string(names[i]), i)).second) return MNNC_INVALID_VALUE;
+      std::vector<int> shape;
+      std::string      descr;
+      auto             code = host_view(tensors[i], shape, descr);
+      if (code != MNNC_NO_ERROR) return code;
+      auto *t    = (MNN::Tensor *)tensors[i];
+      headers[i] = npy_header(shape, descr);
+      sizes[i]   = headers[i].size() + (size_t)t->elementSize() * t->getType().bytes();
+      index_size += 4 + strlen(names[i]) + 16;
+    }
+
+    std::string index(kArchiveMagic, kArchiveMagicLen);
+    append_le<uint32_t>(index, kArchiveVersion);
+    append_le<uint32_t>(index, (uint32_t)count);
+    std::vector<size_t> offsets(count);
+    size_t              offset = align_up(index_size);
+    for (size_t i = 0; i < count; i++) {
+      const size_t len = strlen(names[i]);
+      append_le<uint32_t>(index, (uint32_t)len);
+      index.append(names[i], len);
+      append_le<uint64_t>(index, (uint64_t)offset);
+      append_le<uint64_t>(index, (uint64_t)sizes[i]);
+      offsets[i] = offset;
+      offset     = align_up(offset + sizes[i]);
+    }
+
+    FILE *fp = fopen(path, "wb");
+    if (!fp) return MNNC_FILE_CREATE_FAILED;
+    bool   ok  = write_all(fp, index.data(), index.size());
+    size_t pos = index.size();
+    for (size_t i = 0; ok && i < count; i++) {
+      auto *t = (MNN::Tensor *)tensors[i];
+      ok      = write_padding(fp, offsets[i] - pos) &&
+           write_all(fp, headers[i].data(), headers[i].size()) &&
+           write_all(fp, t->host<void>(), sizes[i] - headers[i].size());
+      pos = offsets[i] + sizes[i];
+    }
+    if (fclose(fp) != 0) ok = false;
+    return ok ? MNNC_NO_ERROR : MNNC_FILE_CLOSE_FAILED;
+  } catch (...) { return MNNC_UNKNOWN_ERROR; }
+}
+
+namespace {
+
+mnn_error_code_t add_entry(
+    mnn_npy_archive *archive, const std::string &name, const uint8_t *data, size_t size
+) {
+  NpyInfo info;
+  auto    code = parse_npy(data, size, info);
+  if (code != MNNC_NO_ERROR) return code;
+  void *host = info.data_size > 0 ? (void *)(data + info.data_offset) : nullptr;
+  // the tensor references the archive memory, no copy is made
+  auto *tensor = MNN::Tensor::create(info.shape, info.type, host, MNN::Tensor::CAFFE);
+  if (!tensor) return MNNC_OUT_OF_MEMORY;
+  archive->names.push_back(name);
+  archive->tensors.push_back(tensor);
+  return MNNC_NO_ERROR;
+}
+
+mnn_error_code_t parse_archive(mnn_npy_archive *archive, const uint8_t *data, size_t size) {
+  if (size >= kNpyMagicLen && memcmp(data, kNpyMagic, kNpyMagicLen) == 0) {
+    return add_entry(archive, "", data, size);
+  }
+  if (size < kArchiveMagicLen + 8 || memcmp(data, kArchiveMagic, kArchiveMagicLen) != 0) {
+    return MNNC_INVALID_VALUE;
+  }
+  if (read_le<uint32_t>(data + kArchiveMagicLen) != kArchiveVersion) return MNNC_NOT_SUPPORT;
+  const uint32_t count = read_le<uint32_t>(data + kArchiveMagicLen + 4);
+  size_t         pos   = kArchiveMagicLen + 8;
+  for (uint32_t i = 0; i < count; i++) {
+    if (pos + 4 > size) return MNNC_INVALID_VALUE;
+    const uint32_t len = read_le<uint32_t>(data + pos);
+    pos += 4;
+    if (pos + len + 16 > size) return MNNC_INVALID_VALUE;
+    std::string name((const char *)data + pos, len);
+    pos += len;
+    const uint64_t offset = read_le<uint64_t>(data + pos);
+    const uint64_t length = read_le<uint64_t>(data + pos + 8);
+    pos += 16;
+    if (offset > size || length > size - offset) return MNNC_INVALID_VALUE;
+    auto code = add_entry(archive, name, data + offset, (size_t)length);
+    if (code != MNNC_NO_ERROR) return code;
+  }
+  return MNNC_NO_ERROR;
+}
+
+} // namespace
+
+mnn_npy_archive_t mnn_npy_archive_open(const char *path, bool use_mmap) {
+  if (!path) return nullptr;
+  auto *archive = new (std::nothrow) mnn_npy_archive();
+  if (!archive) return nullptr;
+  try {
+    const uint8_t *data = nullptr;
+    size_t         size = 0;
+    if (use_mmap) {
+      if (archive->mapped.open(path) != MNNC_NO_ERROR) {
+        delete archive;
+        return nullptr;
+      }
+      data = archive->mapped.data();
+      size = archive->mapped.size();
+    } else {
+      FILE *fp = fopen(path, "rb");
+      if (!fp) {
+        delete archive;
+        return nullptr;
+      }
+      int64_t file_size = -1;
+      if (file_seek(fp, 0, SEEK_END) == 0) file_size = file_tell(fp);
+      bool ok = file_size >= 0 && (uint64_t)file_size <= SIZE_MAX &&
+                file_seek(fp, 0, SEEK_SET) == 0;
+      if (ok) {
+        archive->buffer.resize((size_t)file_size);
+        ok = fread(archive->buffer.data(), 1, archive->buffer.size(), fp) == archive->buffer.size();
+      }
+      fclose(fp);
+      if (!ok) {
+        delete archive;
+        return nullptr;
+      }
+      data = archive->buffer.data();
+      size = archive->buffer.size();
+    }
+    if (parse_archive(archive, data, size) != MNNC_NO_ERROR) {
+      delete archive;
+      return nullptr;
+    }
+    return archive;
+  } catch (...) {
+    delete archive;
+    return nullptr;
+  }
+}
+
+void mnn_npy_archive_destroy(mnn_npy_archive_t self) {
+  if (self == nullptr) return;
+  delete self;
+  self = nullptr;
+}
+
+size_t mnn_npy_archive_size(mnn_npy_archive_t self) { return self ? self->tensors.size() : 0; }
+
+const char *mnn_npy_archive_name(mnn_npy_archive_t self, size_t index) {
+  if (!self || index >= self->names.size()) return nullptr;
+  return self->names[index].c_str();
+}
+
+int mnn_npy_archive_find(mnn_npy_archive_t self, const char *name) {
+  if (!self || !name) return -1;
+  for (size_t i = 0; i < self->names.size(); i++) {
+    if (self->names[i] == name) return (int)i;
+  }
+  return -1;
+}
+
+mnn_tensor_t mnn_npy_archive_get(mnn_npy_archive_t self, size_t index) {
+  if (!self || index >= self->tensors.size()) return nullptr;
+  return (mnn_tensor_t)self->tensors[index];
+}
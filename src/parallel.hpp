@@ -0,0 +1,145 @@
+/*
+ * parallel.hpp
+ * Internal thread pool and parallel-for helpers shared by the host kernels
+ *
+ * Author: Rainyl
+ * License: Apache License 2.0
+ */
+
+#ifndef MNN_C_PARALLEL_HPP
+#define MNN_C_PARALLEL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mnnc {
+
+class ThreadPool {
+public:
+  // The pool is intentionally leaked, workers must not be joined during static destruction
+  // since the host process (e.g., Dart VM) may tear down in arbitrary order.
+  static ThreadPool &instance() {
+    static ThreadPool *pool = new ThreadPool();
+    return *pool;
+  }
+
+  // Number of threads that can run tasks concurrently, including the caller.
+  int concurrency() const { return (int)_workers + 1; }
+
+  // Run fn(0..tasks-1) and block until all tasks are finished. The caller takes part
+  // in the work so nested or concurrent calls never dead-lock.
+  // Returns false if any task threw.
+  bool run(int tasks, const std::function<void(int)> &fn) {
+    if (tasks <= 0) return true;
+    if (tasks == 1 || _workers == 0) {
+      bool ok = true;
+      for (int i = 0; i < tasks; i++) {
+        try {
+          fn(i);
+        } catch (...) { ok = false; }
+      }
+      return ok;
+    }
+    auto batch   = std::make_shared<Batch>();
+    batch->tasks = tasks;
+    batch->fn    = &fn;
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      int                         n = std::min<int>(tasks - 1, (int)_workers);
+      for (int i = 0; i < n; i++) _queue.push_back(batch);
+    }
+    _cv.notify_all();
+    work(*batch);
+    std::unique_lock<std::mutex> lock(batch->mutex);
+    batch->cv.wait(lock, [&] { return batch->done.load() == batch->tasks; });
+    return !batch->failed.load();
+  }
+
+private:
+  struct Batch {
+    std::atomic<int>                 next{0};
+    std::atomic<int>                 done{0};
+    std::atomic<bool>                failed{false};
+    int                              tasks = 0;
+    const std::function<void(int)> *fn    = nullptr;
+    std::mutex                       mutex;
+    std::condition_variable          cv;
+  };
+
+  ThreadPool() {
+    unsigned n = std::thread::hardware_concurrency();
+    _workers   = n > 1 ? n - 1 : 0;
+    for (size_t i = 0; i < _workers; i++) { std::thread(&ThreadPool::loop, this).detach(); }
+  }
+
+  static void work(Batch &batch) {
+    for (;;) {
+      int i = batch.next.fetch_add(1);
+      if (i >= batch.tasks) break;
+      try {
+        (*batch.fn)(i);
+      } catch (...) { batch.failed.store(true); }
+      if (batch.done.fetch_add(1) + 1 == batch.tasks) {
+        std::lock_guard<std::mutex> lock(batch.mutex);
+        batch.cv.notify_all();
+      }
+    }
+  }
+
+  void loop() {
+    for (;;) {
+      std::shared_ptr<Batch> batch;
+      {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _cv.wait(lock, [this] { return !_queue.empty(); });
+        batch = _queue.front();
+        _queue.pop_front();
+      }
+      work(*batch);
+    }
+  }
+
+  size_t                             _workers = 0;
+  std::mutex                         _mutex;
+  std::condition_variable            _cv;
+  std::deque<std::shared_ptr<Batch>> _queue;
+};
+
+// Number of tasks used to split n items, each task handles at least `grain` items.
+// num_threads <= 0 means using all threads of the pool.
+inline int parallel_tasks(size_t n, size_t grain, int num_threads) {
+  int max_tasks = ThreadPool::instance().concurrency();
+  if (num_threads > 0) max_tasks = std::min(max_tasks, num_threads);
+  if (grain == 0) grain = 1;
+  size_t tasks = n / grain;
+  if (tasks < 1) tasks = 1;
+  return (int)std::min<size_t>(tasks, (size_t)max_tasks);
+}
+
+// Split [0, n) into `tasks` contiguous ranges and call fn(begin, end, task) for each.
+template <typename F>
+bool parallel_for(size_t n, int tasks, F fn) {
+  if (n == 0) return true;
+  if (tasks <= 1) {
+    fn((size_t)0, n, 0);
+    return true;
+  }
+  const size_t chunk = (n + tasks - 1) / tasks;
+  return ThreadPool::instance().run(tasks, [&](int t) {
+    size_t begin = (size_t)t * chunk;
+    size_t end   = std::min(n, begin + chunk);
+    if (begin < end) fn(begin, end, t);
+  });
+}
+
+} // namespace mnnc
+
+#endif // MNN_C_PARALLEL_HPP
@@ -0,0 +1,279 @@
+/*
+ * plugin.cpp
+ * MNN C API for custom CPU ops
+ *
+ * Author: Rainyl
+ * License: Apache License 2.0
+ */
+
+#include "mnn_c/plugin.h"
+#include "MNN/expr/Expr.hpp"
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#ifdef MNN_WITH_PLUGIN
+  #include "MNN_generated.h"
+  #include "MNN/plugin/PluginKernel.hpp"
+  #include "MNN/plugin/PluginShapeInference.hpp"
+#endif
+
+namespace {
+
+// MNN_MAX_TENSOR_DIM of the MNN core
+const int kMaxDims = 8;
+
+const MNN::Attribute *find_attr(mnn_plugin_context_t ctx, const char *key) {
+  if (!ctx || !key) return nullptr;
+  return ctx->getAttr(key);
+}
+
+#ifdef MNN_WITH_PLUGIN
+
+// Outputs take the shape and type of input 0.
+bool copy_input_shape(MNN::plugin::PluginContext *ctx) {
+  if (ctx->inputs().empty()) return false;
+  const MNN::Tensor *in = ctx->input(0);
+  for (MNN::Tensor *out : ctx->outputs()) {
+    out->buffer().dimensions = in->dimensions();
+    out->buffer().type       = in->getType();
+    for (int i = 0; i < in->dimensions(); i++) out->setLength(i, in->length(i));
+  }
+  return true;
+}
+
+class CInferShapeKernel : public MNN::plugin::InferShapeKernel {
+public:
+  explicit CInferShapeKernel(const mnn_plugin_op_t &op) : op_(op) {}
+
+  bool compute(MNN::plugin::InferShapeContext *ctx) override {
+    return op_.infer_shape ? op_.infer_shape(ctx, op_.userdata) : copy_input_shape(ctx);
+  }
+
+private:
+  mnn_plugin_op_t op_;
+};
+
+class CCPUComputeKernel : public MNN::plugin::CPUComputeKernel {
+public:
+  explicit CCPUComputeKernel(const mnn_plugin_op_t &op) : op_(op) {}
+
+  bool init(MNN::plugin::CPUKernelContext *) override { return true; }
+
+  bool resize(MNN::plugin::CPUKernelContext *ctx) override {
+    return op_.resize ? op_.resize(ctx, op_.userdata) : true;
+  }
+
+  bool compute(MNN::plugin::CPUKernelContext *ctx) override {
+    return op_.compute(ctx, op_.userdata);
+  }
+
+private:
+  mnn_plugin_op_t op_;
+};
+
+std::mutex &registry_mutex() {
+  static std::mutex *m = new std::mutex();
+  return *m;
+}
+
+bool is_registered(const std::string &name) {
+  std::lock_guard<std::mutex> lock(registry_mutex());
+  auto kernels = MNN::plugin::ComputeKernelRegistry<MNN::plugin::CPUComputeKernel>::getFactoryMap();
+  return kernels->count(name) > 0;
+}
+
+std::unique_ptr<MNN::AttributeT> make_attr(const mnn_plugin_attr_t &a) {
+  std::unique_ptr<MNN::AttributeT> attr(new MNN::AttributeT);
+  attr->key = a.key;
+  switch (a.type) {
+  case MNN_PLUGIN_ATTR_INT:
+    attr->i    = a.i;
+    attr->type = MNN::DataType_DT_INT32;
+    break;
+  case MNN_PLUGIN_ATTR_FLOAT:
+    attr->f    = a.f;
+    attr->type = MNN::DataType_DT_FLOAT;
+    break;
+  case MNN_PLUGIN_ATTR_STRING:
+    if (!a.s) return nullptr;
+    attr->s    = a.s;
+    attr->type = MNN::DataType_DT_STRING;
+    break;
+  case MNN_PLUGIN_ATTR_INTS:
+    if (!a.ints && a.count > 0) return nullptr;
+    attr->list.reset(new MNN::ListValueT);
+    attr->list->i.assign(a.ints, a.ints + a.count);
+    attr->type = MNN::DataType_DT_INT32;
+    break;
+  case MNN_PLUGIN_ATTR_FLOATS:
+    if (!a.floats && a.count > 0) return nullptr;
+    attr->list.reset(new MNN::ListValueT);
+    attr->list->f.assign(a.floats, a.floats + a.count);
+    attr->type = MNN::DataType_DT_FLOAT;
+    break;
+  default: return nullptr;
+  }
+  return attr;
+}
+
+#endif // MNN_WITH_PLUGIN
+
+} // namespace
+
+bool mnn_plugin_supported(void) {
+#ifdef MNN_WITH_PLUGIN
+  return true;
+#else
+  return false;
+#endif
+}
+
+mnn_error_code_t mnn_plugin_register_cpu_op(const char *name, const mnn_plugin_op_t *op) {
+#ifdef MNN_WITH_PLUGIN
+  if (!name || !op || !op->compute) return MNNC_INVALID_PTR;
+  if (name[0] == '\0') return MNNC_INVALID_VALUE;
+  try {
+    const mnn_plugin_op_t       def = *op;
+    std::lock_guard<std::mutex> lock(registry_mutex());
+    // Assign to the factory maps directly, add() refuses names that already exist
+    (*MNN::plugin::InferShapeKernelRegister::getFactoryMap())[name] = [def]() {
+      return new CInferShapeKernel(def);
+    };
+    (*MNN::plugin::ComputeKernelRegistry<MNN::plugin::CPUComputeKernel>::getFactoryMap())[name] =
+        [def]() { return new CCPUComputeKernel(def); };
+    return MNNC_NO_ERROR;
+  } catch (...) { return MNNC_UNKNOWN_ERROR; }
+#else
+  (void)name;
+  (void)op;
+  return MNNC_NOT_SUPPORT;
+#endif
+}
+
+mnn_error_code_t mnn_expr_plugin_op(
+    const char              *name,
+    VecVARP_t                inputs,
+    const mnn_plugin_attr_t *attrs,
+    size_t                   num_attrs,
+    int                      num_outputs,
+    VecVARP_t               *out
+) {
+#ifdef MNN_WITH_PLUGIN
+  if (!name || !out || (!attrs && num_attrs > 0)) return MNNC_INVALID_PTR;
+  if (num_outputs < 1 || !is_registered(name)) return MNNC_INVALID_VALUE;
+  try {
+    std::unique_ptr<MNN::PluginT> param(new MNN::PluginT);
+    param->type = name;
+    for (size_t i = 0; i < num_attrs; i++) {
+      if (!attrs[i].key) return MNNC_INVALID_PTR;
+      auto attr = make_attr(attrs[i]);
+      if (!attr) return MNNC_INVALID_VALUE;
+      param->attr.push_back(std::move(attr));
+    }
+    std::unique_ptr<MNN::OpT> op(new MNN::OpT);
+    op->type       = MNN::OpType_Plugin;
+    op->main.type  = MNN::OpParameter_Plugin;
+    op->main.value = param.release();
+    std::vector<MNN::Express::VARP> ins;
+    if (inputs) ins = *inputs;
+    auto expr = MNN::Express::Expr::create(op.get(), ins, num_outputs);
+    auto res  = new std::vector<MNN::Express::VARP>(num_outputs);
+    for (int i = 0; i < num_outputs; i++) (*res)[i] = MNN::Express::Variable::create(expr, i);
+    *out = res;
+    return MNNC_NO_ERROR;
+  } catch (...) { return MNNC_UNKNOWN_ERROR; }
+#else
+  (void)name;
+  (void)inputs;
+  (void)attrs;
+  (void)num_attrs;
+  (void)num_outputs;
+  (void)out;
+  return MNNC_NOT_SUPPORT;
+#endif
+}
+
+int mnn_plugin_context_num_inputs(mnn_plugin_context_t ctx) {
+  return ctx ? (int)ctx->inputs().size() : 0;
+}
+
+int mnn_plugin_context_num_outputs(mnn_plugin_context_t ctx) {
+  return ctx ? (int)ctx->outputs().size() : 0;
+}
+
+mnn_tensor_t mnn_plugin_context_input(mnn_plugin_context_t ctx, int index) {
+  if (!ctx || index < 0 || index >= (int)ctx->inputs().size()) return nullptr;
+  return ctx->inputs()[index];
+}
+
+mnn_tensor_t mnn_plugin_context_output(mnn_plugin_context_t ctx, int index) {
+  if (!ctx || index < 0 || index >= (int)ctx->outputs().size()) return nullptr;
+  return ctx->outputs()[index];
+}
+
+mnn_error_code_t mnn_plugin_context_set_output(
+    mnn_plugin_context_t ctx, int index, const int *shape, int ndim, halide_type_c_t type
+) {
+  if (!ctx || (!shape && ndim > 0)) return MNNC_INVALID_PTR;
+  if (index < 0 || index >= (int)ctx->outputs().size()) return MNNC_INVALID_VALUE;
+  if (ndim < 0 || ndim > kMaxDims) return MNNC_INVALID_VALUE;
+  for (int i = 0; i < ndim; i++) {
+    if (shape[i] < 0) return MNNC_INVALID_VALUE;
+  }
+  MNN::Tensor *t         = ctx->outputs()[index];
+  t->buffer().dimensions = ndim;
+  t->buffer().type       = halide_type_t((halide_type_code_t)type.code, type.bits, type.lanes);
+  for (int i = 0; i < ndim; i++) t->setLength(i, shape[i]);
+  return MNNC_NO_ERROR;
+}
+
+mnn_error_code_t
+mnn_plugin_context_attr_int(mnn_plugin_context_t ctx, const char *key, int32_t *value) {
+  if (!value) return MNNC_INVALID_PTR;
+  auto attr = find_attr(ctx, key);
+  if (!attr) return MNNC_INVALID_VALUE;
+  *value = attr->i();
+  return MNNC_NO_ERROR;
+}
+
+mnn_error_code_t
+mnn_plugin_context_attr_float(mnn_plugin_context_t ctx, const char *key, float *value) {
+  if (!value) return MNNC_INVALID_PTR;
+  auto attr = find_attr(ctx, key);
+  if (!attr) return MNNC_INVALID_VALUE;
+  *value = attr->f();
+  return MNNC_NO_ERROR;
+}
+
+mnn_error_code_t
+mnn_plugin_context_attr_string(mnn_plugin_context_t ctx, const char *key, const char **value) {
+  if (!value) return MNNC_INVALID_PTR;
+  auto attr = find_attr(ctx, key);
+  if (!attr || !attr->s()) return MNNC_INVALID_VALUE;
+  *value = attr->s()->c_str();
+  return MNNC_NO_ERROR;
+}
+
+mnn_error_code_t mnn_plugin_context_attr_ints(
+    mnn_plugin_context_t ctx, const char *key, const int32_t **values, size_t *count
+) {
+  if (!values || !count) return MNNC_INVALID_PTR;
+  auto attr = find_attr(ctx, key);
+  if (!attr || !attr->list() || !attr->list()->i()) return MNNC_INVALID_VALUE;
+  *values = attr->list()->i()->data();
+  *count  = attr->list()->i()->size();
+  return MNNC_NO_ERROR;
+}
+
+mnn_error_code_t mnn_plugin_context_attr_floats(
+    mnn_plugin_context_t ctx, const char *key, const float **values, size_t *count
+) {
+  if (!values || !count) return MNNC_INVALID_PTR;
+  auto attr = find_attr(ctx, key);
+  if (!attr || !attr->list() || !attr->list()->f()) return MNNC_INVALID_VALUE;
+  *values = attr->list()->f()->data();
+  *count  = attr->list()->f()->size();
+  return MNNC_NO_ERROR;
+}
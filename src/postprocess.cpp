@@ -0,0 +1,238 @@
+/*
+ * postprocess.cpp
+ * MNN C API for fused output postprocessing
+ *
+ * Author: Rainyl
+ * License: Apache License 2.0
+ */
+
+#include "mnn_c/postprocess.h"
+#include "MNN/Tensor.hpp"
+#include "MNN/expr/Expr.hpp"
+#include "parallel.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace {
+
+// Elements per task, small outputs are processed on the calling thread.
+const size_t kPostGrain = 1 << 16;
+// Spatial positions processed together, per-position state lives on the stack.
+const int kTile = 256;
+
+mnn_error_code_t
+make_layout(const std::vector<int> &dims, mnn_dimension_type_t type, mnn_tensor_layout_t *layout) {
+  const int n = (int)dims.size();
+  if (type == MNN_CAFFE_C4 && n < 2) return MNNC_INVALID_VALUE;
+  for (int d : dims) {
+    if (d < 0) return MNNC_INVALID_VALUE;
+  }
+  mnn_tensor_layout_t l;
+  l.dim_type = type;
+  l.batch    = 1;
+  l.channel  = n > 0 ? dims[n - 1] : 1;
+  l.area     = 1;
+  if (n >= 2) {
+    l.batch = dims[0];
+    if (type == MNN_TENSORFLOW) {
+      l.channel = dims[n - 1];
+      for (int i = 1; i < n - 1; i++) l.area *= dims[i];
+    } else {
+      l.channel = dims[1];
+      for (int i = 2; i < n; i++) l.area *= dims[i];
+    }
+  }
+  const size_t C = (size_t)l.channel, A = (size_t)l.area;
+  switch (type) {
+  case MNN_TENSORFLOW:
+    l.pack           = 1;
+    l.batch_stride   = A * C;
+    l.channel_stride = 1;
+    l.area_stride    = C;
+    break;
+  case MNN_CAFFE_C4:
+    // [C/4][N][A][4], each block of 4 channels holds every batch
+    l.pack           = 4;
+    l.batch_stride   = A * 4;
+    l.channel_stride = (size_t)l.batch * A * 4;
+    l.area_stride    = 4;
+    break;
+  default:
+    l.pack           = 1;
+    l.batch_stride   = C * A;
+    l.channel_stride = A;
+    l.area_stride    = 1;
+    break;
+  }
+  *layout = l;
+  return MNNC_NO_ERROR;
+}
+
+bool valid_layout(const mnn_tensor_layout_t *l) {
+  return l->batch >= 0 && l->channel >= 0 && l->area >= 0 && l->pack >= 1;
+}
+
+inline const float *channel_ptr(const float *base, const mnn_tensor_layout_t &l, int c) {
+  return base + (size_t)(c / l.pack) * l.channel_stride + c % l.pack;
+}
+
+// Run fn(n, a0, len, task) on tiles of kTile spatial positions of every batch.
+template <typename F>
+bool for_each_tile(const mnn_tensor_layout_t &l, int num_threads, F fn) {
+  const size_t tiles = ((size_t)l.area + kTile - 1) / kTile;
+  const size_t units = (size_t)l.batch * tiles;
+  const size_t total = (size_t)l.batch * l.channel * l.area;
+  const int    tasks = mnnc::parallel_tasks(total, kPostGrain, num_threads);
+  return mnnc::parallel_for(units, tasks, [&](size_t begin, size_t end, int task) {
+    for (size_t u = begin; u < end; u++) {
+      const int n   = (int)(u / tiles);
+      const int a0  = (int)(u % tiles) * kTile;
+      const int len = std::min(kTile, l.area - a0);
+      fn(n, a0, len, task);
+    }
+  });
+}
+
+// Max over channels of one tile, the argmax is written if arg is not NULL.
+void tile_max(const float *base, const mnn_tensor_layout_t &l, int len, float *best, int32_t *arg) {
+  const size_t as = l.area_stride;
+  const float *p  = channel_ptr(base, l, 0);
+  for (int k = 0; k < len; k++) best[k] = p[k * as];
+  if (arg) std::fill(arg, arg + len, 0);
+  for (int c = 1; c < l.channel; c++) {
+    p = channel_ptr(base, l, c);
+    if (arg) {
+      for (int k = 0; k < len; k++) {
+        const float v = p[k * as];
+        if (v > best[k]) {
+          best[k] = v;
+          arg[k]  = c;
+        }
+      }
+    } else {
+      for (int k = 0; k < len; k++) best[k] = std::max(best[k], p[k * as]);
+    }
+  }
+}
+
+} // namespace
+
+mnn_error_code_t mnn_tensor_get_layout(mnn_tensor_t self, mnn_tensor_layout_t *layout) {
+  if (!self || !layout) return MNNC_INVALID_PTR;
+  try {
+    auto *t = (MNN::Tensor *)self;
+    return make_layout(t->shape(), (mnn_dimension_type_t)t->getDimensionType(), layout);
+  } catch (...) { return MNNC_UNKNOWN_ERROR; }
+}
+
+mnn_error_code_t mnn_expr_VARP_get_layout(VARP_t self, mnn_tensor_layout_t *layout) {
+  if (!self || !(*self).get() || !layout) return MNNC_INVALID_PTR;
+  try {
+    auto info = (*self)->getInfo();
+    if (!info) return MNNC_INVALID_VALUE;
+    mnn_dimension_type_t type;
+    switch (info->order) {
+    case MNN::Express::NHWC: type = MNN_TENSORFLOW; break;
+    case MNN::Express::NC4HW4: type = MNN_CAFFE_C4; break;
+    default: type = MNN_CAFFE; break;
+    }
+    return make_layout(info->dim, type, layout);
+  } catch (...) { return MNNC_UNKNOWN_ERROR; }
+}
+
+mnn_error_code_t mnn_channel_argmax(
+    const float               *data,
+    const mnn_tensor_layout_t *layout,
+    int32_t                   *indices,
+    float                     *scores,
+    int                        num_threads
+) {
+  if (!data || !layout || !indices) return MNNC_INVALID_PTR;
+  if (!valid_layout(layout)) return MNNC_INVALID_VALUE;
+  const mnn_tensor_layout_t l = *layout;
+  if (l.channel == 0) return MNNC_INVALID_VALUE;
+  try {
+    auto ok = for_each_tile(l, num_threads, [&](int n, int a0, int len, int) {
+      float        best[kTile];
+      const size_t o = (size_t)n * l.area + a0;
+      tile_max(data + n * l.batch_stride + a0 * l.area_stride, l, len, best, indices + o);
+      if (scores) std::copy(best, best + len, scores + o);
+    });
+    return ok ? MNNC_NO_ERROR : MNNC_UNKNOWN_ERROR;
+  } catch (...) { return MNNC_UNKNOWN_ERROR; }
+}
+
+mnn_error_code_t mnn_channel_softmax(
+    const float *data, const mnn_tensor_layout_t *layout, float *dst, int num_threads
+) {
+  if (!data || !layout || !dst) return MNNC_INVALID_PTR;
+  if (!valid_layout(layout)) return MNNC_INVALID_VALUE;
+  const mnn_tensor_layout_t l = *layout;
+  if (l.channel == 0) return MNNC_NO_ERROR;
+  try {
+    auto ok = for_each_tile(l, num_threads, [&](int n, int a0, int len, int) {
+      float        best[kTile], sum[kTile];
+      const float *base = data + n * l.batch_stride + a0 * l.area_stride;
+      const size_t as   = l.area_stride;
+      tile_max(base, l, len, best, nullptr);
+      std::fill(sum, sum + len, 0.0f);
+      for (int c = 0; c < l.channel; c++) {
+        const float *p = channel_ptr(base, l, c);
+        float       *q = dst + ((size_t)n * l.channel + c) * l.area + a0;
+        for (int k = 0; k < len; k++) {
+          q[k] = std::exp(p[k * as] - best[k]);
+          sum[k] += q[k];
+        }
+      }
+      for (int k = 0; k < len; k++) sum[k] = 1.0f / sum[k];
+      for (int c = 0; c < l.channel; c++) {
+        float *q = dst + ((size_t)n * l.channel + c) * l.area + a0;
+        for (int k = 0; k < len; k++) q[k] *= sum[k];
+      }
+    });
+    return ok ? MNNC_NO_ERROR : MNNC_UNKNOWN_ERROR;
+  } catch (...) { return MNNC_UNKNOWN_ERROR; }
+}
+
+mnn_error_code_t mnn_channel_sigmoid_threshold(
+    const float               *data,
+    const mnn_tensor_layout_t *layout,
+    float                      threshold,
+    uint8_t                   *mask,
+    size_t                    *count,
+    int                        num_threads
+) {
+  if (!data || !layout || !mask) return MNNC_INVALID_PTR;
+  if (!valid_layout(layout) || std::isnan(threshold)) return MNNC_INVALID_VALUE;
+  const mnn_tensor_layout_t l = *layout;
+  // sigmoid is monotonic, compare the logits against logit(threshold) instead
+  const float inf = std::numeric_limits<float>::infinity();
+  const float cut = threshold <= 0.0f   ? -inf
+                    : threshold >= 1.0f ? inf
+                                        : std::log(threshold / (1.0f - threshold));
+  try {
+    std::vector<size_t> counts(mnnc::ThreadPool::instance().concurrency(), 0);
+    auto ok = for_each_tile(l, num_threads, [&](int n, int a0, int len, int task) {
+      const float *base = data + n * l.batch_stride + a0 * l.area_stride;
+      const size_t as   = l.area_stride;
+      size_t       hit  = 0;
+      for (int c = 0; c < l.channel; c++) {
+        const float *p = channel_ptr(base, l, c);
+        uint8_t     *q = mask + ((size_t)n * l.channel + c) * l.area + a0;
+        for (int k = 0; k < len; k++) {
+          q[k] = p[k * as] > cut ? 1 : 0;
+          hit += q[k];
+        }
+      }
+      counts[task] += hit;
+    });
+    if (!ok) return MNNC_UNKNOWN_ERROR;
+    if (count) {
+      *count = 0;
+      for (size_t c : counts) *count += c;
+    }
+    return MNNC_NO_ERROR;
+  } catch (...) { return MNNC_UNKNOWN_ERROR; }
+}
@@ -0,0 +1,211 @@
+/*
+ * quantize.cpp
+ * MNN C API for host-side quantize/dequantize kernels
+ *
+ * Author: Rainyl
+ * License: Apache License 2.0
+ */
+
+#include "mnn_c/quantize.h"
+#include "MNN/HalideRuntime.h"
+#include "MNN/Tensor.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace {
+
+// Decompose a shape into [outer, channel, inner] around the quantization axis.
+// For per-tensor parameters the whole buffer is treated as a single channel.
+bool quant_layout(
+    const int                *shape,
+    int                       ndim,
+    const mnn_quant_params_t *params,
+    size_t                   &outer,
+    size_t                   &channel,
+    size_t                   &inner
+) {
+  if (ndim < 0 || (ndim > 0 && !shape)) return false;
+  size_t total = 1;
+  for (int i = 0; i < ndim; i++) {
+    if (shape[i] < 0) return false;
+    total *= (size_t)shape[i];
+  }
+  if (params->count == 1) {
+    outer   = 1;
+    channel = 1;
+    inner   = total;
+    return true;
+  }
+  int axis = params->axis < 0 ? params->axis + ndim : params->axis;
+  if (axis < 0 || axis >= ndim || (size_t)shape[axis] != params->count) return false;
+  outer = 1;
+  inner = 1;
+  for (int i = 0; i < axis; i++) outer *= (size_t)shape[i];
+  for (int i = axis + 1; i < ndim; i++) inner *= (size_t)shape[i];
+  channel = params->count;
+  return true;
+}
+
+template <typename T>
+void quant_range(const mnn_quant_params_t *params, float &lo, float &hi) {
+  if (params->qmin < params->qmax) {
+    lo = (float)std::max<int32_t>(params->qmin, std::numeric_limits<T>::min());
+    hi = (float)std::min<int32_t>(params->qmax, std::numeric_limits<T>::max());
+  } else {
+    lo = (float)std::numeric_limits<T>::min();
+    hi = (float)std::numeric_limits<T>::max();
+  }
+}
+
+// The inner loops are branch-free so that compilers can vectorize them.
+template <typename T>
+void quantize_kernel(
+    const float              *src,
+    T                        *dst,
+    size_t                    outer,
+    size_t                    channel,
+    size_t                    inner,
+    const mnn_quant_params_t *params
+) {
+  float lo, hi;
+  quant_range<T>(params, lo, hi);
+  for (size_t o = 0; o < outer; o++) {
+    for (size_t c = 0; c < channel; c++) {
+      const float  inv_scale = params->scale[c] == 0.f ? 0.f : 1.0f / params->scale[c];
+      const float  zp        = params->zero_point ? (float)params->zero_point[c] : 0.f;
+      const size_t base      = (o * channel + c) * inner;
+      const float *s         = src + base;
+      T           *d         = dst + base;
+      for (size_t i = 0; i < inner; i++) {
+        float v = s[i] * inv_scale;
+        // NaN fails both clamps below, map it to the zero point
+        v = v != v ? 0.f : v;
+        // keep the value inside int32 range before truncation
+        v = v < -1e9f ? -1e9f : v;
+        v = v > 1e9f ? 1e9f : v;
+        // round half away from zero
+        v = v >= 0.f ? v + 0.5f : v - 0.5f;
+        v = (float)(int32_t)v + zp;
+        v = v < lo ? lo : v;
+        v = v > hi ? hi : v;
+        d[i] = (T)(int32_t)v;
+      }
+    }
+  }
+}
+
+template <typename T>
+void dequantize_kernel(
+    const T                  *src,
+    float                    *dst,
+    size_t                    outer,
+    size_t                    channel,
+    size_t                    inner,
+    const mnn_quant_params_t *params
+) {
+  for (size_t o = 0; o < outer; o++) {
+    for (size_t c = 0; c < channel; c++) {
+      const float  scale = params->scale[c];
+      const float  zp    = params->zero_point ? (float)params->zero_point[c] : 0.f;
+      const size_t base  = (o * channel + c) * inner;
+      const T     *s     = src + base;
+      float       *d     = dst + base;
+      for (size_t i = 0; i < inner; i++) { d[i] = ((float)s[i] - zp) * scale; }
+    }
+  }
+}
+
+bool is_quant_type(halide_type_c_t type) {
+  if (type.lanes != 1) return false;
+  if (type.code == halide_type_int) return type.bits == 8 || type.bits == 16;
+  if (type.code == halide_type_uint) return type.bits == 8;
+  return false;
+}
+
+bool valid_params(const mnn_quant_params_t *params) {
+  return params && params->scale && params->count > 0;
+}
+
+bool tensor_shape(MNN::Tensor *t, std::vector<int> &shape) {
+  // NC4HW4 host memory is padded, convert it to NCHW/NHWC before quantizing.
+  if (t->getDimensionType() == MNN::Tensor::CAFFE_C4) return false;
+  shape = t->shape();
+  return true;
+}
+
+} // namespace
+
+mnn_error_code_t mnn_quantize_f32(
+    const float              *src,
+    void                     *dst,
+    halide_type_c_t           dst_type,
+    const int                *shape,
+    int                       ndim,
+    const mnn_quant_params_t *params
+) {
+  if (!src || !dst || !valid_params(params)) return MNNC_INVALID_PTR;
+  if (!is_quant_type(dst_type)) return MNNC_NOT_SUPPORT;
+  size_t outer, channel, inner;
+  if (!quant_layout(shape, ndim, params, outer, channel, inner)) return MNNC_INVALID_VALUE;
+  try {
+    if (dst_type.code == halide_type_uint) {
+      quantize_kernel<uint8_t>(src, (uint8_t *)dst, outer, channel, inner, params);
+    } else if (dst_type.bits == 8) {
+      quantize_kernel<int8_t>(src, (int8_t *)dst, outer, channel, inner, params);
+    } else {
+      quantize_kernel<int16_t>(src, (int16_t *)dst, outer, channel, inner, params);
+    }
+    return MNNC_NO_ERROR;
+  } catch (...) { return MNNC_UNKNOWN_ERROR; }
+}
+
+mnn_error_code_t mnn_dequantize_f32(
+    const void               *src,
+    halide_type_c_t           src_type,
+    float                    *dst,
+    const int                *shape,
+    int                       ndim,
+    const mnn_quant_params_t *params
+) {
+  if (!src || !dst || !valid_params(params)) return MNNC_INVALID_PTR;
+  if (!is_quant_type(src_type)) return MNNC_NOT_SUPPORT;
+  size_t outer, channel, inner;
+  if (!quant_layout(shape, ndim, params, outer, channel, inner)) return MNNC_INVALID_VALUE;
+  try {
+    if (src_type.code == halide_type_uint) {
+      dequantize_kernel<uint8_t>((const uint8_t *)src, dst, outer, channel, inner, params);
+    } else if (src_type.bits == 8) {
+      dequantize_kernel<int8_t>((const int8_t *)src, dst, outer, channel, inner, params);
+    } else {
+      dequantize_kernel<int16_t>((const int16_t *)src, dst, outer, channel, inner, params);
+    }
+    return MNNC_NO_ERROR;
+  } catch (...) { return MNNC_UNKNOWN_ERROR; }
+}
+
+mnn_error_code_t mnn_tensor_quantize_from_f32(
+    mnn_tensor_t self, const float *src, const mnn_quant_params_t *params
+) {
+  if (!self || !src) return MNNC_INVALID_PTR;
+  auto *t = (MNN::Tensor *)self;
+  if (!t->host<void>()) return MNNC_INVALID_PTR;
+  std::vector<int> shape;
+  if (!tensor_shape(t, shape)) return MNNC_NOT_SUPPORT;
+  auto            type   = t->getType();
+  halide_type_c_t c_type = {(uint8_t)type.code, type.bits, type.lanes};
+  return mnn_quantize_f32(src, t->host<void>(), c_type, shape.data(), (int)shape.size(), params);
+}
+
+mnn_error_code_t
+mnn_tensor_dequantize_to_f32(mnn_tensor_t self, float *dst, const mnn_quant_params_t *params) {
+  if (!self || !dst) return MNNC_INVALID_PTR;
+  auto *t = (MNN::Tensor *)self;
+  if (!t->host<void>()) return MNNC_INVALID_PTR;
+  std::vector<int> shape;
+  if (!tensor_shape(t, shape)) return MNNC_NOT_SUPPORT;
+  auto            type   = t->getType();
+  halide_type_c_t c_type = {(uint8_t)type.code, type.bits, type.lanes};
+  return mnn_dequantize_f32(t->host<void>(), c_type, dst, shape.data(), (int)shape.size(), params);
+}
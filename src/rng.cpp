@@ -0,0 +1,217 @@
+/*
+ * rng.cpp
+ * MNN C API for counter-based random number generation
+ *
+ * Author: Rainyl
+ * License: Apache License 2.0
+ */
+
+#include "mnn_c/rng.h"
+#include "MNN/expr/Expr.hpp"
+#include "MNN/expr/NeuralNetWorkOp.hpp"
+#include "expr_arena.hpp"
+#include "parallel.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace {
+
+// Samples per task.
+const size_t kRngGrain = 1 << 16;
+// Philox blocks generated together, the rounds run lane-wise over the batch so the
+// 32x32->64 multiplies vectorize.
+const size_t kBatch = 8;
+
+const uint32_t kPhiloxM0 = 0xD2511F53u;
+const uint32_t kPhiloxM1 = 0xCD9E8D57u;
+const uint32_t kPhiloxW0 = 0x9E3779B9u;
+const uint32_t kPhiloxW1 = 0xBB67AE85u;
+
+// Philox4x32-10 of the counters (block, 0) for kBatch consecutive blocks, out[word][j] is
+// word of block first + j.
+void philox_batch(uint64_t first, uint64_t seed, uint32_t out[4][kBatch]) {
+  uint32_t c0[kBatch], c1[kBatch], c2[kBatch], c3[kBatch];
+  for (size_t j = 0; j < kBatch; j++) {
+    const uint64_t block = first + j;
+    c0[j]                = (uint32_t)block;
+    c1[j]                = (uint32_t)(block >> 32);
+    c2[j]                = 0;
+    c3[j]                = 0;
+  }
+  uint32_t k0 = (uint32_t)seed, k1 = (uint32_t)(seed >> 32);
+  for (int round = 0; round < 10; round++) {
+    for (size_t j = 0; j < kBatch; j++) {
+      const uint64_t p0 = (uint64_t)kPhiloxM0 * c0[j];
+      const uint64_t p1 = (uint64_t)kPhiloxM1 * c2[j];
+      const uint32_t n0 = (uint32_t)(p1 >> 32) ^ c1[j] ^ k0;
+      const uint32_t n2 = (uint32_t)(p0 >> 32) ^ c3[j] ^ k1;
+      c1[j]             = (uint32_t)p1;
+      c3[j]             = (uint32_t)p0;
+      c0[j]             = n0;
+      c2[j]             = n2;
+    }
+    k0 += kPhiloxW0;
+    k1 += kPhiloxW1;
+  }
+  for (size_t j = 0; j < kBatch; j++) {
+    out[0][j] = c0[j];
+    out[1][j] = c1[j];
+    out[2][j] = c2[j];
+    out[3][j] = c3[j];
+  }
+}
+
+// 24 random bits in [0, 1).
+inline float unit(uint32_t x) { return (float)(x >> 8) * (1.0f / 16777216.0f); }
+
+// Fill out[0, count) with emit(words of the block, lane) of samples offset + [0, count).
+// Sample i is lane i % 4 of block i / 4, whichever task generates it.
+template <typename T, typename F>
+bool fill_stream(
+    uint64_t seed, uint64_t offset, T *out, size_t count, int num_threads, F emit
+) {
+  const int tasks = mnnc::parallel_tasks(count, kRngGrain, num_threads);
+  return mnnc::parallel_for(count, tasks, [&](size_t begin, size_t end, int) {
+    uint32_t       words[4][kBatch];
+    const uint64_t first = offset + begin, last = offset + end;
+    for (uint64_t block = first / 4; block * 4 < last; block += kBatch) {
+      philox_batch(block, seed, words);
+      for (size_t j = 0; j < kBatch; j++) {
+        const uint64_t base = (block + j) * 4;
+        if (base >= last) break;
+        const uint32_t w[4] = {words[0][j], words[1][j], words[2][j], words[3][j]};
+        for (int lane = 0; lane < 4; lane++) {
+          const uint64_t i = base + lane;
+          if (i >= first && i < last) out[i - offset] = emit(w, lane);
+        }
+      }
+    }
+  });
+}
+
+bool valid_params(const mnn_rng_params_t *p) {
+  switch (p->distribution) {
+  case MNN_RNG_UNIFORM: return std::isfinite(p->a) && std::isfinite(p->b) && p->a <= p->b;
+  case MNN_RNG_NORMAL: return std::isfinite(p->a) && std::isfinite(p->b) && p->b >= 0.0;
+  case MNN_RNG_INTEGER:
+    return p->a >= (double)INT32_MIN && p->b <= (double)INT32_MAX + 1.0 && p->a < p->b &&
+           p->a == std::floor(p->a) && p->b == std::floor(p->b);
+  case MNN_RNG_BERNOULLI: return p->a >= 0.0 && p->a <= 1.0;
+  default: return false;
+  }
+}
+
+bool is_float(const mnn_rng_params_t *p) {
+  return p->distribution == MNN_RNG_UNIFORM || p->distribution == MNN_RNG_NORMAL;
+}
+
+} // namespace
+
+mnn_error_code_t
+mnn_rng_fill(const mnn_rng_params_t *params, void *out, size_t count, int num_threads) {
+  if (!params || (!out && count > 0)) return MNNC_INVALID_PTR;
+  if (!valid_params(params)) return MNNC_INVALID_VALUE;
+  if (count == 0) return MNNC_NO_ERROR;
+  if (params->offset > std::numeric_limits<uint64_t>::max() - count) return MNNC_INVALID_VALUE;
+  try {
+    const uint64_t seed = params->seed, offset = params->offset;
+    bool           ok   = false;
+    switch (params->distribution) {
+    case MNN_RNG_UNIFORM: {
+      const float low = (float)params->a, high = (float)params->b, range = high - low;
+      // float rounding of low + range * u may reach high
+      const float below = high > low ? std::nextafter(high, low) : high;
+      ok                = fill_stream(
+          seed,
+          offset,
+          (float *)out,
+          count,
+          num_threads,
+          [=](const uint32_t *w, int lane) { return std::min(low + range * unit(w[lane]), below); }
+      );
+      break;
+    }
+    case MNN_RNG_NORMAL: {
+      const float mean = (float)params->a, stddev = (float)params->b;
+      const float two_pi = 6.283185307179586f;
+      // Box-Muller over the lane pairs (0, 1) and (2, 3)
+      ok = fill_stream(
+          seed,
+          offset,
+          (float *)out,
+          count,
+          num_threads,
+          [=](const uint32_t *w, int lane) {
+            const int   pair = lane & ~1;
+            const float u1   = ((float)(w[pair] >> 8) + 1.0f) * (1.0f / 16777216.0f);
+            const float r    = std::sqrt(-2.0f * std::log(u1));
+            const float t    = two_pi * unit(w[pair + 1]);
+            return mean + stddev * r * (lane & 1 ? std::sin(t) : std::cos(t));
+          }
+      );
+      break;
+    }
+    case MNN_RNG_INTEGER: {
+      const int64_t  low   = (int64_t)params->a;
+      const uint64_t range = (uint64_t)((int64_t)params->b - low);
+      // multiply-shift, the bias is below range / 2^32
+      ok = fill_stream(
+          seed,
+          offset,
+          (int32_t *)out,
+          count,
+          num_threads,
+          [=](const uint32_t *w, int lane) {
+            return (int32_t)(low + (int64_t)(((uint64_t)w[lane] * range) >> 32));
+          }
+      );
+      break;
+    }
+    case MNN_RNG_BERNOULLI: {
+      const double p = params->a;
+      ok             = fill_stream(
+          seed,
+          offset,
+          (int32_t *)out,
+          count,
+          num_threads,
+          [=](const uint32_t *w, int lane) { return (int32_t)((double)unit(w[lane]) < p); }
+      );
+      break;
+    }
+    }
+    return ok ? MNNC_NO_ERROR : MNNC_UNKNOWN_ERROR;
+  } catch (...) { return MNNC_UNKNOWN_ERROR; }
+}
+
+mnn_error_code_t mnn_rng_create_var(
+    const mnn_rng_params_t *params,
+    const int              *shape,
+    size_t                  ndim,
+    int                     num_threads,
+    VARP_t                 *out
+) {
+  if (!params || !out || (!shape && ndim > 0)) return MNNC_INVALID_PTR;
+  if (!valid_params(params)) return MNNC_INVALID_VALUE;
+  try {
+    std::vector<int> dims(shape, shape + ndim);
+    size_t           count = 1;
+    for (int d : dims) {
+      if (d < 0) return MNNC_INVALID_VALUE;
+      count *= (size_t)d;
+    }
+    auto var = is_float(params)
+                   ? MNN::Express::_Input(dims, MNN::Express::NCHW, halide_type_of<float>())
+                   : MNN::Express::_Input(dims, MNN::Express::NCHW, halide_type_of<int32_t>());
+    if (count > 0) {
+      auto ptr = var->writeMap<void>();
+      if (!ptr) return MNNC_UNKNOWN_ERROR;
+      auto code = mnn_rng_fill(params, ptr, count, num_threads);
+      if (code != MNNC_NO_ERROR) return code;
+    }
+    *out = mnnc::make_varp(var);
+    return MNNC_NO_ERROR;
+  } catch (...) { return MNNC_UNKNOWN_ERROR; }
+}
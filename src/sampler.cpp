@@ -0,0 +1,364 @@
+/*
+ * sampler.cpp
+ * MNN C API for token sampling
+ *
+ * Author: Rainyl
+ * License: Apache License 2.0
+ */
+
+#include "mnn_c/sampler.h"
+#include "MNN/Tensor.hpp"
+#include "MNN/expr/Expr.hpp"
+#include "MNN/expr/NeuralNetWorkOp.hpp"
+#include "topk.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+struct mnn_sampler {
+  mnn_sampler_config_t config;
+  uint64_t             state;
+  // buffers reused across calls, a decoding loop samples without allocating
+  std::vector<mnnc::TopKEntry> cands;
+  std::vector<float>           weights;
+  std::vector<int32_t>         penalized;
+  std::vector<uint8_t>         mask;
+};
+
+namespace {
+
+// Candidates tried for top-p before the whole vocabulary is partitioned.
+const size_t kNucleusProbe = 64;
+
+bool valid_config(const mnn_sampler_config_t *config) {
+  return config && !std::isnan(config->temperature) && config->top_p > 0.0f &&
+         config->repetition_penalty > 0.0f && std::isfinite(config->repetition_penalty);
+}
+
+// SplitMix64, every seed gives a full period stream and the same draws on every platform.
+double next_uniform(uint64_t &state) {
+  uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+  z          = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z          = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  z ^= z >> 31;
+  // 53 random bits in [0, 1)
+  return (double)(z >> 11) * (1.0 / 9007199254740992.0);
+}
+
+inline float penalize(float logit, float penalty) {
+  return logit > 0.0f ? logit / penalty : logit * penalty;
+}
+
+// Unnormalized probability of a logit given the largest one, NaN logits get no weight and
+// an infinite largest logit keeps only its equals.
+inline float weight(float logit, float top, float temperature) {
+  if (std::isinf(top)) return logit == top ? 1.0f : 0.0f;
+  return std::isnan(logit) ? 0.0f : std::exp((logit - top) / temperature);
+}
+
+// Replace the logits of candidates sorted best first by their weights, returns the sum.
+double to_weights(std::vector<mnnc::TopKEntry> &cands, float temperature) {
+  const float top   = cands[0].key;
+  double      total = 0.0;
+  for (auto &c : cands) {
+    c.key = weight(c.key, top, temperature);
+    total += c.key;
+  }
+  return total;
+}
+
+// Number of leading candidates, sorted by weight, whose mass reaches top_p of total.
+size_t nucleus_size(const std::vector<mnnc::TopKEntry> &cands, double total, float top_p) {
+  if (top_p >= 1.0f) return cands.size();
+  const double target = total * top_p;
+  double       cum    = 0.0;
+  for (size_t i = 0; i < cands.size(); i++) {
+    cum += cands[i].key;
+    if (cum >= target) return i + 1;
+  }
+  return cands.size();
+}
+
+// Worst candidate of the nucleus, the fewest best candidates whose mass reaches top_p of
+// total, and the mass of the nucleus. Halving partitions find the boundary in linear time,
+// so a flat distribution with a nucleus of thousands of tokens is never sorted.
+mnnc::TopKEntry
+nucleus_bound(std::vector<mnnc::TopKEntry> &cands, double total, float top_p, double *mass) {
+  double need = total * top_p, kept = 0.0;
+  size_t lo = 0, hi = cands.size();
+  while (hi - lo > 1) {
+    const size_t mid = lo + (hi - lo) / 2;
+    std::nth_element(
+        cands.begin() + lo, cands.begin() + mid, cands.begin() + hi, mnnc::topk_better
+    );
+    double upper = 0.0;
+    for (size_t i = lo; i < mid; i++) upper += cands[i].key;
+    if (upper >= need) {
+      hi = mid;
+    } else {
+      need -= upper;
+      kept += upper;
+      lo = mid;
+    }
+  }
+  // [0, lo) is better than cands[lo] after the partitions
+  *mass = kept + cands[lo].key;
+  return cands[lo];
+}
+
+// Draw one of the first n candidates in proportion to their weights.
+size_t draw(const std::vector<mnnc::TopKEntry> &cands, size_t n, double u, double *mass) {
+  double sum = 0.0;
+  for (size_t i = 0; i < n; i++) sum += cands[i].key;
+  *mass             = sum;
+  const double pick = u * sum;
+  double       cum  = 0.0;
+  for (size_t i = 0; i < n; i++) {
+    cum += cands[i].key;
+    if (pick < cum) return i;
+  }
+  // rounding of the cumulative sum, fall back to the last candidate with weight
+  size_t i = n - 1;
+  while (i > 0 && cands[i].key <= 0.0f) i--;
+  return i;
+}
+
+// Top k candidates after the repetition penalty, sorted best first with logits as keys.
+// History tokens are masked out of the scan, so the heap stays at k entries however long
+// the history is, and only they are penalized on the side.
+void select_candidates(mnn_sampler *self, const float *logits, size_t vocab, size_t k) {
+  auto       &cands   = self->cands;
+  const auto &history = self->penalized;
+  cands.clear();
+  if (history.empty()) {
+    mnnc::topk_select(0, vocab, k, [logits](size_t i) { return logits[i]; }, cands);
+  } else {
+    auto &mask = self->mask;
+    mask.resize(vocab, 0);
+    for (int32_t t : history) mask[t] = 1;
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    mnnc::topk_select(
+        0, vocab, k, [logits, &mask, nan](size_t i) { return mask[i] ? nan : logits[i]; }, cands
+    );
+    const float penalty = self->config.repetition_penalty;
+    for (int32_t t : history) {
+      mask[t]       = 0;
+      const float v = penalize(logits[t], penalty);
+      if (!std::isnan(v)) cands.push_back({v, t});
+    }
+  }
+  mnnc::topk_finish(cands, std::min(k, cands.size()));
+}
+
+mnn_error_code_t sample_top_k(
+    mnn_sampler *self, const float *logits, size_t vocab, size_t k, int32_t *token, float *prob
+) {
+  select_candidates(self, logits, vocab, k);
+  auto &cands = self->cands;
+  if (cands.empty()) return MNNC_INVALID_VALUE;
+  const float temperature = self->config.temperature;
+  if (temperature <= 0.0f || k == 1) {
+    *token = cands[0].index;
+    if (prob) *prob = 1.0f;
+    return MNNC_NO_ERROR;
+  }
+  const double total = to_weights(cands, temperature);
+  const size_t n     = nucleus_size(cands, total, self->config.top_p);
+  double       mass;
+  const size_t i = draw(cands, n, next_uniform(self->state), &mass);
+  *token         = cands[i].index;
+  if (prob) *prob = (float)(cands[i].key / mass);
+  return MNNC_NO_ERROR;
+}
+
+mnn_error_code_t
+sample_full(mnn_sampler *self, const float *logits, size_t vocab, int32_t *token, float *prob) {
+  auto &w = self->weights;
+  w.assign(logits, logits + vocab);
+  const float penalty = self->config.repetition_penalty;
+  for (int32_t t : self->penalized) w[t] = penalize(w[t], penalty);
+  float top = -std::numeric_limits<float>::infinity();
+  bool  any = false;
+  for (size_t i = 0; i < vocab; i++) {
+    if (std::isnan(w[i])) continue;
+    any = true;
+    top = std::max(top, w[i]);
+  }
+  if (!any) return MNNC_INVALID_VALUE;
+  const float temperature = self->config.temperature;
+  double      total       = 0.0;
+  for (size_t i = 0; i < vocab; i++) {
+    w[i] = weight(w[i], top, temperature);
+    total += w[i];
+  }
+  const double u     = next_uniform(self->state);
+  const float  top_p = self->config.top_p;
+  auto        &cands = self->cands;
+  if (top_p < 1.0f) {
+    // peaked distributions hold the nucleus in a few dozen tokens, others are partitioned
+    cands.clear();
+    mnnc::topk_select(0, vocab, kNucleusProbe, [&w](size_t i) { return w[i]; }, cands);
+    mnnc::topk_finish(cands, cands.size());
+    const size_t n = nucleus_size(cands, total, top_p);
+    if (n < cands.size() || cands.size() == vocab) {
+      double       mass;
+      const size_t i = draw(cands, n, u, &mass);
+      *token         = cands[i].index;
+      if (prob) *prob = (float)(cands[i].key / mass);
+      return MNNC_NO_ERROR;
+    }
+    // tokens lighter than (1 - top_p) / vocab of the mass can not all be in the nucleus
+    // together, and being the lightest, none of them is
+    const double cutoff = total * (1.0 - top_p) / vocab;
+    cands.clear();
+    for (size_t i = 0; i < vocab; i++) {
+      if (w[i] > 0.0f && w[i] >= cutoff) cands.push_back({w[i], (int32_t)i});
+    }
+    // tokens outside the nucleus lose their weight, the draw below keeps vocabulary order
+    double     mass;
+    const auto bound = nucleus_bound(cands, total, top_p, &mass);
+    for (size_t i = 0; i < vocab; i++) {
+      if (!mnnc::topk_better({w[i], (int32_t)i}, bound) && (int32_t)i != bound.index) w[i] = 0.0f;
+    }
+    total = mass;
+  }
+  const double pick = u * total;
+  double       cum  = 0.0;
+  size_t       last = 0;
+  for (size_t i = 0; i < vocab; i++) {
+    if (w[i] <= 0.0f) continue;
+    last = i;
+    cum += w[i];
+    if (pick < cum) break;
+  }
+  *token = (int32_t)last;
+  if (prob) *prob = (float)(w[last] / total);
+  return MNNC_NO_ERROR;
+}
+
+mnn_error_code_t last_row(const std::vector<int> &dims, size_t *offset, size_t *vocab) {
+  size_t count = 1;
+  for (int d : dims) {
+    if (d < 0) return MNNC_INVALID_VALUE;
+    count *= (size_t)d;
+  }
+  *vocab = dims.empty() ? 1 : (size_t)dims.back();
+  if (*vocab == 0 || count == 0) return MNNC_INVALID_VALUE;
+  *offset = count - *vocab;
+  return MNNC_NO_ERROR;
+}
+
+} // namespace
+
+mnn_sampler_t mnn_sampler_create(const mnn_sampler_config_t *config) {
+  if (!valid_config(config)) return nullptr;
+  auto self    = new mnn_sampler();
+  self->config = *config;
+  self->state  = config->seed;
+  return self;
+}
+
+void mnn_sampler_destroy(mnn_sampler_t self) {
+  if (self) {
+    delete self;
+    self = nullptr;
+  }
+}
+
+mnn_error_code_t mnn_sampler_set_config(mnn_sampler_t self, const mnn_sampler_config_t *config) {
+  if (!self) return MNNC_INVALID_PTR;
+  if (!valid_config(config)) return MNNC_INVALID_VALUE;
+  self->config = *config;
+  self->state  = config->seed;
+  return MNNC_NO_ERROR;
+}
+
+void mnn_sampler_set_seed(mnn_sampler_t self, uint64_t seed) {
+  if (self) {
+    self->config.seed = seed;
+    self->state       = seed;
+  }
+}
+
+mnn_error_code_t mnn_sampler_sample(
+    mnn_sampler_t  self,
+    const float   *logits,
+    size_t         vocab,
+    const int32_t *history,
+    size_t         num_history,
+    int32_t       *token,
+    float         *prob
+) {
+  if (!self || !logits || !token || (!history && num_history > 0)) return MNNC_INVALID_PTR;
+  if (vocab == 0 || vocab > (size_t)INT32_MAX) return MNNC_INVALID_VALUE;
+  try {
+    auto &penalized = self->penalized;
+    penalized.clear();
+    if (self->config.repetition_penalty != 1.0f) {
+      for (size_t i = 0; i < num_history; i++) {
+        if (history[i] < 0 || (size_t)history[i] >= vocab) return MNNC_INVALID_VALUE;
+      }
+      penalized.assign(history, history + num_history);
+      std::sort(penalized.begin(), penalized.end());
+      penalized.erase(std::unique(penalized.begin(), penalized.end()), penalized.end());
+    }
+    const auto &config = self->config;
+    if (config.temperature <= 0.0f) return sample_top_k(self, logits, vocab, 1, token, prob);
+    if (config.top_k > 0) {
+      const size_t k = std::min((size_t)config.top_k, vocab);
+      return sample_top_k(self, logits, vocab, k, token, prob);
+    }
+    return sample_full(self, logits, vocab, token, prob);
+  } catch (...) { return MNNC_UNKNOWN_ERROR; }
+}
+
+mnn_error_code_t mnn_sampler_sample_tensor(
+    mnn_sampler_t  self,
+    mnn_tensor_t   logits,
+    const int32_t *history,
+    size_t         num_history,
+    int32_t       *token,
+    float         *prob
+) {
+  if (!logits) return MNNC_INVALID_PTR;
+  auto *t = (MNN::Tensor *)logits;
+  if (!t->host<void>()) return MNNC_INVALID_PTR;
+  // NC4HW4 host memory is padded and not row-major
+  if (t->getDimensionType() == MNN::Tensor::CAFFE_C4) return MNNC_NOT_SUPPORT;
+  if (t->getType() != halide_type_of<float>()) return MNNC_NOT_SUPPORT;
+  size_t offset, vocab;
+  auto   code = last_row(t->shape(), &offset, &vocab);
+  if (code != MNNC_NO_ERROR) return code;
+  return mnn_sampler_sample(
+      self, t->host<float>() + offset, vocab, history, num_history, token, prob
+  );
+}
+
+mnn_error_code_t mnn_sampler_sample_var(
+    mnn_sampler_t  self,
+    VARP_t         logits,
+    const int32_t *history,
+    size_t         num_history,
+    int32_t       *token,
+    float         *prob
+) {
+  if (!logits || !(*logits).get()) return MNNC_INVALID_PTR;
+  try {
+    auto var  = *logits;
+    auto info = var->getInfo();
+    if (!info) return MNNC_INVALID_VALUE;
+    if (info->type != halide_type_of<float>()) return MNNC_NOT_SUPPORT;
+    if (info->order == MNN::Express::NC4HW4) {
+      var  = MNN::Express::_Convert(var, MNN::Express::NCHW);
+      info = var->getInfo();
+      if (!info) return MNNC_INVALID_VALUE;
+    }
+    size_t offset, vocab;
+    auto   code = last_row(info->dim, &offset, &vocab);
+    if (code != MNNC_NO_ERROR) return code;
+    auto ptr = var->readMap<float>();
+    if (!ptr) return MNNC_UNKNOWN_ERROR;
+    return mnn_sampler_sample(self, ptr + offset, vocab, history, num_history, token, prob);
+  } catch (...) { return MNNC_UNKNOWN_ERROR; }
+}
@@ -0,0 +1,235 @@
+/*
+ * stats.cpp
+ * MNN C API for tensor statistics
+ *
+ * Author: Rainyl
+ * License: Apache License 2.0
+ */
+
+#include "mnn_c/stats.h"
+#include "MNN/HalideRuntime.h"
+#include "MNN/Tensor.hpp"
+#include "MNN/expr/Expr.hpp"
+#include "MNN/expr/NeuralNetWorkOp.hpp"
+#include "parallel.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace {
+
+// Elements per task, small buffers are scanned on the calling thread.
+const size_t kStatsGrain = 1 << 16;
+
+struct Partial {
+  size_t nan_count = 0;
+  size_t inf_count = 0;
+  size_t n         = 0; // finite count
+  double min       = std::numeric_limits<double>::infinity();
+  double max       = -std::numeric_limits<double>::infinity();
+  double mean      = 0;
+  double m2        = 0;
+};
+
+template <typename T>
+inline bool is_nan(T v) {
+  return v != v;
+}
+
+template <typename T>
+inline bool is_inf(T v) {
+  return std::numeric_limits<T>::has_infinity &&
+         (v == std::numeric_limits<T>::infinity() || v == -std::numeric_limits<T>::infinity());
+}
+
+// One pass over [begin, end), values are shifted by the first finite element so that the
+// sum of squares stays numerically stable. The loop is kept branch-free for vectorization.
+template <typename T>
+Partial scan(const T *data, size_t begin, size_t end) {
+  Partial p;
+  size_t  first = begin;
+  while (first < end && (is_nan(data[first]) || is_inf(data[first]))) first++;
+  for (size_t i = begin; i < first; i++) {
+    p.nan_count += is_nan(data[i]) ? 1 : 0;
+    p.inf_count += is_inf(data[i]) ? 1 : 0;
+  }
+  if (first == end) return p;
+
+  const double shift = (double)data[first];
+  T            vmin  = data[first];
+  T            vmax  = data[first];
+  double       s1 = 0, s2 = 0;
+  size_t       nan_count = 0, inf_count = 0;
+  for (size_t i = first; i < end; i++) {
+    const T    v      = data[i];
+    const bool nan    = is_nan(v);
+    const bool inf    = is_inf(v);
+    const bool finite = !(nan || inf);
+    nan_count += nan ? 1 : 0;
+    inf_count += inf ? 1 : 0;
+    vmin = (finite && v < vmin) ? v : vmin;
+    vmax = (finite && v > vmax) ? v : vmax;
+    const double d = finite ? (double)v - shift : 0.0;
+    s1 += d;
+    s2 += d * d;
+  }
+  p.nan_count += nan_count;
+  p.inf_count += inf_count;
+  p.n    = (end - first) - nan_count - inf_count;
+  p.min  = (double)vmin;
+  p.max  = (double)vmax;
+  p.mean = shift + s1 / (double)p.n;
+  p.m2   = s2 - s1 * s1 / (double)p.n;
+  if (p.m2 < 0) p.m2 = 0;
+  return p;
+}
+
+// Chan et al. parallel merge of mean/M2
+void merge(Partial &a, const Partial &b) {
+  a.nan_count += b.nan_count;
+  a.inf_count += b.inf_count;
+  if (b.n == 0) return;
+  if (a.n == 0) {
+    a.n    = b.n;
+    a.min  = b.min;
+    a.max  = b.max;
+    a.mean = b.mean;
+    a.m2   = b.m2;
+    return;
+  }
+  const double n     = (double)(a.n + b.n);
+  const double delta = b.mean - a.mean;
+  a.mean += delta * (double)b.n / n;
+  a.m2 += b.m2 + delta * delta * (double)a.n * (double)b.n / n;
+  a.n += b.n;
+  a.min = std::min(a.min, b.min);
+  a.max = std::max(a.max, b.max);
+}
+
+template <typename T>
+void histogram(
+    const T *data, size_t begin, size_t end, double lo, double hi, int bins, uint64_t *hist
+) {
+  const double scale = hi > lo ? (double)bins / (hi - lo) : 0.0;
+  for (size_t i = begin; i < end; i++) {
+    const double v = (double)data[i];
+    if (!(v >= lo && v <= hi)) continue; // also skips NaN
+    int b = (int)((v - lo) * scale);
+    b     = b >= bins ? bins - 1 : b;
+    hist[b]++;
+  }
+}
+
+template <typename T>
+mnn_error_code_t stats_impl(
+    const T *data, size_t count, const mnn_stats_config_t *config, mnn_tensor_stats_t *stats
+) {
+  const int num_threads = config ? config->num_threads : 0;
+  const int tasks       = mnnc::parallel_tasks(count, kStatsGrain, num_threads);
+
+  std::vector<Partial> partials(tasks);
+  bool ok = mnnc::parallel_for(count, tasks, [&](size_t begin, size_t end, int t) {
+    partials[t] = scan<T>(data, begin, end);
+  });
+  if (!ok) return MNNC_UNKNOWN_ERROR;
+  Partial total;
+  for (const auto &p : partials) merge(total, p);
+
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  stats->count     = count;
+  stats->nan_count = total.nan_count;
+  stats->inf_count = total.inf_count;
+  stats->min       = total.n > 0 ? total.min : nan;
+  stats->max       = total.n > 0 ? total.max : nan;
+  stats->mean      = total.n > 0 ? total.mean : nan;
+  stats->variance  = total.n > 0 ? total.m2 / (double)total.n : nan;
+
+  if (config && config->bins > 0) {
+    const int bins = config->bins;
+    double    lo = config->hist_min, hi = config->hist_max;
+    if (lo >= hi) {
+      lo = total.min;
+      hi = total.max;
+    }
+    std::fill(config->histogram, config->histogram + bins, (uint64_t)0);
+    if (total.n == 0) return MNNC_NO_ERROR;
+    std::vector<std::vector<uint64_t>> hists(tasks, std::vector<uint64_t>(bins, 0));
+    ok = mnnc::parallel_for(count, tasks, [&](size_t begin, size_t end, int t) {
+      histogram<T>(data, begin, end, lo, hi, bins, hists[t].data());
+    });
+    if (!ok) return MNNC_UNKNOWN_ERROR;
+    for (const auto &h : hists) {
+      for (int b = 0; b < bins; b++) config->histogram[b] += h[b];
+    }
+  }
+  return MNNC_NO_ERROR;
+}
+
+} // namespace
+
+mnn_error_code_t mnn_stats_compute(
+    const void               *data,
+    halide_type_c_t           type,
+    size_t                    count,
+    const mnn_stats_config_t *config,
+    mnn_tensor_stats_t       *stats
+) {
+  if (!stats || (!data && count > 0)) return MNNC_INVALID_PTR;
+  if (config && config->bins > 0 && !config->histogram) return MNNC_INVALID_PTR;
+  if (config && config->bins < 0) return MNNC_INVALID_VALUE;
+  if (type.lanes != 1) return MNNC_NOT_SUPPORT;
+  try {
+    switch (type.code) {
+    case halide_type_float:
+      if (type.bits == 32) return stats_impl<float>((const float *)data, count, config, stats);
+      if (type.bits == 64) return stats_impl<double>((const double *)data, count, config, stats);
+      break;
+    case halide_type_int:
+      if (type.bits == 8) return stats_impl<int8_t>((const int8_t *)data, count, config, stats);
+      if (type.bits == 16) return stats_impl<int16_t>((const int16_t *)data, count, config, stats);
+      if (type.bits == 32) return stats_impl<int32_t>((const int32_t *)data, count, config, stats);
+      break;
+    case halide_type_uint:
+      if (type.bits == 8) return stats_impl<uint8_t>((const uint8_t *)data, count, config, stats);
+      if (type.bits == 16) {
+        return stats_impl<uint16_t>((const uint16_t *)data, count, config, stats);
+      }
+      break;
+    default: break;
+    }
+    return MNNC_NOT_SUPPORT;
+  } catch (...) { return MNNC_UNKNOWN_ERROR; }
+}
+
+mnn_error_code_t
+mnn_tensor_stats(mnn_tensor_t self, const mnn_stats_config_t *config, mnn_tensor_stats_t *stats) {
+  if (!self) return MNNC_INVALID_PTR;
+  auto *t = (MNN::Tensor *)self;
+  if (!t->host<void>()) return MNNC_INVALID_PTR;
+  // NC4HW4 host memory is padded, the padding must not be counted
+  if (t->getDimensionType() == MNN::Tensor::CAFFE_C4) return MNNC_NOT_SUPPORT;
+  auto            type   = t->getType();
+  halide_type_c_t c_type = {(uint8_t)type.code, type.bits, type.lanes};
+  return mnn_stats_compute(t->host<void>(), c_type, (size_t)t->elementSize(), config, stats);
+}
+
+mnn_error_code_t
+mnn_expr_VARP_stats(VARP_t self, const mnn_stats_config_t *config, mnn_tensor_stats_t *stats) {
+  if (!self || !(*self).get()) return MNNC_INVALID_PTR;
+  try {
+    auto var  = *self;
+    auto info = var->getInfo();
+    if (!info) return MNNC_INVALID_VALUE;
+    if (info->order == MNN::Express::NC4HW4) {
+      var  = MNN::Express::_Convert(var, MNN::Express::NCHW);
+      info = var->getInfo();
+      if (!info) return MNNC_INVALID_VALUE;
+    }
+    auto ptr = var->readMap<void>();
+    if (!ptr) return MNNC_UNKNOWN_ERROR;
+    halide_type_c_t c_type = {(uint8_t)info->type.code, info->type.bits, info->type.lanes};
+    return mnn_stats_compute(ptr, c_type, (size_t)info->size, config, stats);
+  } catch (...) { return MNNC_UNKNOWN_ERROR; }
+}
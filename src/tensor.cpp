@@ -12,6 +12,8 @@
 #include "MNN/HalideRuntime.h"
 #include "MNN/Tensor.hpp"
 #include "mnn_c/error_code.h"
+#include "parallel.hpp"
+#include <algorithm>
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
@@ -184,6 +186,195 @@ mnn_error_code_t mnn_tensor_copy_to_host(mnn_tensor_t self, mnn_tensor_t host_te
   } catch (...) { return MNNC_UNKNOWN_ERROR; }
 }
 
+namespace {
+
+// Tensors smaller than this are not worth splitting even above the user threshold.
+const size_t kCopyGrain = 1 << 16;
+
+enum HostLayout { LAYOUT_NCHW, LAYOUT_NHWC, LAYOUT_NC4HW4 };
+
+// Logical [n, c, area] view of a host tensor, area is the product of the spatial dims.
+// NC4HW4 keeps the batch inside each block of 4 channels, [C/4][N][area][4], as MNN does.
+struct HostView {
+  uint8_t   *data;
+  HostLayout layout;
+  size_t     n, c, area;
+};
+
+bool host_view(const MNN::Tensor *t, HostView &v) {
+  v.data = t->host<uint8_t>();
+  if (!v.data) return false;
+  const int  dims = t->dimensions();
+  const auto type = t->getDimensionType();
+  v.layout        = type == MNN::Tensor::TENSORFLOW ? LAYOUT_NHWC
+                    : type == MNN::Tensor::CAFFE_C4 ? LAYOUT_NC4HW4
+                                                    : LAYOUT_NCHW;
+  if (dims < 2) {
+    // scalars and vectors are plain arrays in every layout
+    if (v.layout == LAYOUT_NC4HW4) return false;
+    v.layout = LAYOUT_NCHW;
+    v.n      = dims == 1 ? (size_t)t->length(0) : 1;
+    v.c      = 1;
+    v.area   = 1;
+    return true;
+  }
+  v.n    = (size_t)t->length(0);
+  v.area = 1;
+  if (v.layout == LAYOUT_NHWC) {
+    v.c = (size_t)t->length(dims - 1);
+    for (int i = 1; i < dims - 1; i++) v.area *= (size_t)t->length(i);
+  } else {
+    v.c = (size_t)t->length(1);
+    for (int i = 2; i < dims; i++) v.area *= (size_t)t->length(i);
+  }
+  return true;
+}
+
+// Copy/convert src into dst, the work is split on the flattened dst index so that
+// tensors with few channels but large spatial size are still spread evenly.
+template <typename T>
+void convert_layout(const HostView &s, const HostView &d, int tasks) {
+  const T     *src = (const T *)s.data;
+  T           *dst = (T *)d.data;
+  const size_t N = d.n, C = d.c, A = d.area, C4 = (C + 3) / 4;
+  size_t       rows, inner;
+  switch (d.layout) {
+  case LAYOUT_NCHW:
+    rows  = N * C;
+    inner = A;
+    break;
+  case LAYOUT_NHWC:
+    rows  = N * A;
+    inner = C;
+    break;
+  default:
+    rows  = N * C4 * A;
+    inner = 4;
+    break;
+  }
+  mnnc::parallel_for(rows * inner, tasks, [&](size_t begin, size_t end, int) {
+    size_t row = begin / inner, i = begin % inner, pos = begin;
+    while (pos < end) {
+      const size_t seg = std::min(inner - i, end - pos);
+      // each row is contiguous in dst, find where it comes from in src
+      size_t n, c = 0, a = 0, base = 0, stride = 1, valid = inner;
+      switch (d.layout) {
+      case LAYOUT_NCHW:
+        n = row / C;
+        c = row % C;
+        if (s.layout == LAYOUT_NCHW) {
+          base   = (n * C + c) * A;
+          stride = 1;
+        } else if (s.layout == LAYOUT_NHWC) {
+          base   = n * A * C + c;
+          stride = C;
+        } else {
+          base   = ((c / 4 * N + n) * A) * 4 + c % 4;
+          stride = 4;
+        }
+        break;
+      case LAYOUT_NHWC:
+        n = row / A;
+        a = row % A;
+        if (s.layout == LAYOUT_NCHW) {
+          base   = n * C * A + a;
+          stride = A;
+        } else if (s.layout == LAYOUT_NHWC) {
+          base   = (n * A + a) * C;
+          stride = 1;
+        } else {
+          stride = 0; // not linear, handled below
+        }
+        break;
+      default: {
+        const size_t cb = row / (N * A);
+        n               = (row / A) % N;
+        a               = row % A;
+        c               = cb * 4;
+        valid           = std::min<size_t>(4, C - c);
+        if (s.layout == LAYOUT_NCHW) {
+          base   = (n * C + c) * A + a;
+          stride = A;
+        } else if (s.layout == LAYOUT_NHWC) {
+          base   = (n * A + a) * C + c;
+          stride = 1;
+        } else {
+          base   = row * 4;
+          stride = 1;
+          valid  = 4;
+        }
+        break;
+      }
+      }
+      T *out = dst + pos;
+      if (stride == 0) {
+        for (size_t k = 0; k < seg; k++) {
+          const size_t cc = i + k;
+          out[k]          = src[((cc / 4 * N + n) * A + a) * 4 + cc % 4];
+        }
+      } else if (stride == 1 && valid == inner) {
+        memcpy(out, src + base + i, seg * sizeof(T));
+      } else {
+        for (size_t k = 0; k < seg; k++) {
+          const size_t ii = i + k;
+          out[k]          = ii < valid ? src[base + ii * stride] : (T)0;
+        }
+      }
+      pos += seg;
+      row++;
+      i = 0;
+    }
+  });
+}
+
+// Returns false if the tensors can not be handled on host, the caller should fall back to MNN.
+bool parallel_host_copy(
+    const MNN::Tensor *src, MNN::Tensor *dst, int num_threads, size_t threshold
+) {
+  if (src->getType() != dst->getType() || src->getType().lanes != 1) return false;
+  HostView s, d;
+  if (!host_view(src, s) || !host_view(dst, d)) return false;
+  if (s.n != d.n || s.c != d.c || s.area != d.area) return false;
+  const size_t bytes = src->getType().bytes();
+  const size_t count = d.n * d.c * d.area;
+  if (count * bytes < threshold) return false;
+  const int tasks = mnnc::parallel_tasks(count, kCopyGrain, num_threads);
+  switch (bytes) {
+  case 1: convert_layout<uint8_t>(s, d, tasks); break;
+  case 2: convert_layout<uint16_t>(s, d, tasks); break;
+  case 4: convert_layout<uint32_t>(s, d, tasks); break;
+  case 8: convert_layout<uint64_t>(s, d, tasks); break;
+  default: return false;
+  }
+  return true;
+}
+
+} // namespace
+
+mnn_error_code_t mnn_tensor_copy_from_host_parallel(
+    mnn_tensor_t self, mnn_tensor_t host_tensor, int num_threads, size_t threshold
+) {
+  if (!self || !host_tensor) return MNNC_INVALID_VALUE;
+  try {
+    auto *dst = (MNN::Tensor *)self;
+    auto *src = (MNN::Tensor *)host_tensor;
+    if (parallel_host_copy(src, dst, num_threads, threshold)) return MNNC_BOOL_TRUE;
+  } catch (...) { return MNNC_UNKNOWN_ERROR; }
+  return mnn_tensor_copy_from_host(self, host_tensor);
+}
+
+mnn_error_code_t mnn_tensor_copy_to_host_parallel(
+    mnn_tensor_t self, mnn_tensor_t host_tensor, int num_threads, size_t threshold
+) {
+  if (!self || !host_tensor) return MNNC_INVALID_VALUE;
+  try {
+    auto *src = (MNN::Tensor *)self;
+    auto *dst = (MNN::Tensor *)host_tensor;
+    if (parallel_host_copy(src, dst, num_threads, threshold)) return MNNC_BOOL_TRUE;
+  } catch (...) { return MNNC_UNKNOWN_ERROR; }
+  return mnn_tensor_copy_to_host(self, host_tensor);
+}
+
 // MNN::Tensor properties
 int mnn_tensor_dimensions(mnn_tensor_t self) {
   if (!self) return -1;
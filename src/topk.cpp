@@ -0,0 +1,153 @@
+/*
+ * topk.cpp
+ * MNN C API for top-k selection
+ *
+ * Author: Rainyl
+ * License: Apache License 2.0
+ */
+
+#include "mnn_c/topk.h"
+#include "MNN/Tensor.hpp"
+#include "MNN/expr/Expr.hpp"
+#include "MNN/expr/NeuralNetWorkOp.hpp"
+#include "parallel.hpp"
+#include "topk.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <vector>
+
+namespace {
+
+// Elements per task, a row is split into chunks only if it is longer than this.
+const size_t kTopKGrain = 1 << 15;
+
+void softmax(const float *values, size_t k, float *probs) {
+  const float top = *std::max_element(values, values + k);
+  float       sum = 0.0f;
+  for (size_t i = 0; i < k; i++) {
+    probs[i] = std::exp(values[i] - top);
+    sum += probs[i];
+  }
+  for (size_t i = 0; i < k; i++) probs[i] /= sum;
+}
+
+mnn_error_code_t last_dim_rows(const std::vector<int> &dims, size_t *rows, size_t *cols) {
+  size_t count = 1;
+  for (int d : dims) {
+    if (d < 0) return MNNC_INVALID_VALUE;
+    count *= (size_t)d;
+  }
+  *cols = dims.empty() ? 1 : (size_t)dims.back();
+  *rows = *cols == 0 ? 0 : count / *cols;
+  return MNNC_NO_ERROR;
+}
+
+} // namespace
+
+mnn_error_code_t mnn_topk_compute(
+    const float             *data,
+    size_t                   rows,
+    size_t                   cols,
+    const mnn_topk_config_t *config,
+    float                   *values,
+    int32_t                 *indices,
+    float                   *probs
+) {
+  if (!config || !values || !indices || (!data && rows > 0)) return MNNC_INVALID_PTR;
+  const size_t k = (size_t)std::max(config->k, 0);
+  if (k == 0 || k > cols || cols > (size_t)INT32_MAX) return MNNC_INVALID_VALUE;
+  if (rows == 0) return MNNC_NO_ERROR;
+  const bool largest = config->largest;
+  try {
+    const int tasks  = mnnc::parallel_tasks(rows * cols, kTopKGrain, config->num_threads);
+    // long rows are split into chunks so that a single row still uses all tasks
+    size_t    chunks = 1;
+    if (rows < (size_t)tasks) {
+      chunks = std::min(((size_t)tasks + rows - 1) / rows, std::max<size_t>(1, cols / kTopKGrain));
+    }
+    const size_t                               units = rows * chunks;
+    std::vector<std::vector<mnnc::TopKEntry>> cands(units);
+
+    auto ok = mnnc::parallel_for(units, tasks, [&](size_t begin, size_t end, int) {
+      for (size_t u = begin; u < end; u++) {
+        const size_t r = u / chunks, c = u % chunks;
+        const size_t b = cols * c / chunks, e = cols * (c + 1) / chunks;
+        const float *row = data + r * cols;
+        // the smallest entries are the largest negated ones
+        if (largest) {
+          mnnc::topk_select(b, e, k, [row](size_t i) { return row[i]; }, cands[u]);
+        } else {
+          mnnc::topk_select(b, e, k, [row](size_t i) { return -row[i]; }, cands[u]);
+        }
+      }
+    });
+    if (!ok) return MNNC_UNKNOWN_ERROR;
+
+    std::atomic<bool> enough{true};
+    const int         merge_tasks = (int)std::min<size_t>((size_t)tasks, rows);
+
+    ok = mnnc::parallel_for(rows, merge_tasks, [&](size_t begin, size_t end, int) {
+      for (size_t r = begin; r < end; r++) {
+        auto &best = cands[r * chunks];
+        for (size_t c = 1; c < chunks; c++) {
+          auto &other = cands[r * chunks + c];
+          best.insert(best.end(), other.begin(), other.end());
+        }
+        if (!mnnc::topk_finish(best, k)) {
+          enough.store(false);
+          continue;
+        }
+        for (size_t i = 0; i < k; i++) {
+          values[r * k + i]  = largest ? best[i].key : -best[i].key;
+          indices[r * k + i] = best[i].index;
+        }
+        if (probs) softmax(values + r * k, k, probs + r * k);
+      }
+    });
+    if (!ok) return MNNC_UNKNOWN_ERROR;
+    return enough.load() ? MNNC_NO_ERROR : MNNC_INVALID_VALUE;
+  } catch (...) { return MNNC_UNKNOWN_ERROR; }
+}
+
+mnn_error_code_t mnn_tensor_topk(
+    mnn_tensor_t             self,
+    const mnn_topk_config_t *config,
+    float                   *values,
+    int32_t                 *indices,
+    float                   *probs
+) {
+  if (!self) return MNNC_INVALID_PTR;
+  auto *t = (MNN::Tensor *)self;
+  if (!t->host<void>()) return MNNC_INVALID_PTR;
+  // NC4HW4 host memory is padded and not row-major
+  if (t->getDimensionType() == MNN::Tensor::CAFFE_C4) return MNNC_NOT_SUPPORT;
+  if (t->getType() != halide_type_of<float>()) return MNNC_NOT_SUPPORT;
+  size_t rows, cols;
+  auto   code = last_dim_rows(t->shape(), &rows, &cols);
+  if (code != MNNC_NO_ERROR) return code;
+  return mnn_topk_compute(t->host<float>(), rows, cols, config, values, indices, probs);
+}
+
+mnn_error_code_t mnn_expr_VARP_topk(
+    VARP_t self, const mnn_topk_config_t *config, float *values, int32_t *indices, float *probs
+) {
+  if (!self || !(*self).get()) return MNNC_INVALID_PTR;
+  try {
+    auto var  = *self;
+    auto info = var->getInfo();
+    if (!info) return MNNC_INVALID_VALUE;
+    if (info->type != halide_type_of<float>()) return MNNC_NOT_SUPPORT;
+    if (info->order == MNN::Express::NC4HW4) {
+      var  = MNN::Express::_Convert(var, MNN::Express::NCHW);
+      info = var->getInfo();
+      if (!info) return MNNC_INVALID_VALUE;
+    }
+    size_t rows, cols;
+    auto   code = last_dim_rows(info->dim, &rows, &cols);
+    if (code != MNNC_NO_ERROR) return code;
+    auto ptr = var->readMap<float>();
+    if (!ptr && rows > 0) return MNNC_UNKNOWN_ERROR;
+    return mnn_topk_compute(ptr, rows, cols, config, values, indices, probs);
+  } catch (...) { return MNNC_UNKNOWN_ERROR; }
+}
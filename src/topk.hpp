@@ -0,0 +1,79 @@
+/*
+ * topk.hpp
+ * Internal partial selection of the top k entries of a sequence
+ *
+ * Author: Rainyl
+ * License: Apache License 2.0
+ */
+
+#ifndef MNN_C_TOPK_HPP
+#define MNN_C_TOPK_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace mnnc {
+
+struct TopKEntry {
+  float   key;
+  int32_t index;
+};
+
+// Larger key first, ties resolve to the smaller index.
+inline bool topk_better(const TopKEntry &a, const TopKEntry &b) {
+  return a.key > b.key || (a.key == b.key && a.index < b.index);
+}
+
+// Append the k entries of [begin, end) with the largest key(i) to out, unordered, NaN
+// keys are skipped. A bounded heap rejects most entries with one compare against its
+// worst entry; quickselect is used instead when k is a large part of the range.
+template <typename F>
+void topk_select(size_t begin, size_t end, size_t k, F key, std::vector<TopKEntry> &out) {
+  if (k == 0 || begin >= end) return;
+  const size_t base = out.size();
+  if (k * 8 >= end - begin) {
+    for (size_t i = begin; i < end; i++) {
+      const float v = key(i);
+      if (!std::isnan(v)) out.push_back({v, (int32_t)i});
+    }
+    if (out.size() - base > k) {
+      std::nth_element(out.begin() + base, out.begin() + base + k, out.end(), topk_better);
+      out.resize(base + k);
+    }
+    return;
+  }
+  out.reserve(base + k);
+  size_t i = begin;
+  for (; i < end && out.size() - base < k; i++) {
+    const float v = key(i);
+    if (!std::isnan(v)) out.push_back({v, (int32_t)i});
+  }
+  // the worst kept entry is on top of the heap
+  std::make_heap(out.begin() + base, out.end(), topk_better);
+  float worst = out.size() - base == k ? out[base].key : -std::numeric_limits<float>::infinity();
+  for (; i < end; i++) {
+    const float v = key(i);
+    // later indices never win ties, so only strictly better keys replace the worst
+    if (!(v > worst)) continue;
+    std::pop_heap(out.begin() + base, out.end(), topk_better);
+    out.back() = {v, (int32_t)i};
+    std::push_heap(out.begin() + base, out.end(), topk_better);
+    worst = out[base].key;
+  }
+}
+
+// Keep the k best candidates sorted best first, returns false if there are less than k.
+inline bool topk_finish(std::vector<TopKEntry> &cands, size_t k) {
+  if (cands.size() < k) return false;
+  std::partial_sort(cands.begin(), cands.begin() + k, cands.end(), topk_better);
+  cands.resize(k);
+  return true;
+}
+
+} // namespace mnnc
+
+#endif // MNN_C_TOPK_HPP
@@ -0,0 +1,102 @@
+import 'dart:io';
+import 'dart:typed_data';
+
+import 'package:mnn/mnn.dart' as mnn;
+import 'package:test/test.dart';
+
+void main() async {
+  final tmpDir = Directory('test/tmp');
+  if (!tmpDir.existsSync()) {
+    tmpDir.createSync(recursive: true);
+  }
+
+  test('Tensor save/load npy', () {
+    final data = Float32List.fromList(List.generate(24, (index) => index * 0.5));
+    final tensor = mnn.Tensor.fromData(
+      [2, 3, 4],
+      mnn.HalideType.f32,
+      data: data.buffer.asUint8List(),
+      dimType: mnn.DimensionType.MNN_CAFFE,
+    );
+    const path = 'test/tmp/tensor.npy';
+    tensor.saveNpy(path);
+
+    final bytes = File(path).readAsBytesSync();
+    expect(bytes.sublist(1, 6), 'NUMPY'.codeUnits);
+
+    final loaded = mnn.Tensor.fromNpy(path);
+    expect(loaded.shape, [2, 3, 4]);
+    expect(loaded.type, mnn.HalideType.f32);
+    expect(loaded.cast<mnn.float32>().asTypedList(24), data);
+
+    expect(() => mnn.Tensor.fromNpy('test/tmp/not_exist.npy'), throwsA(isA<mnn.MNNException>()));
+    tensor.dispose();
+    loaded.dispose();
+  });
+
+  test('Tensor load npy rejects malformed headers', () {
+    Uint8List npy(String dict, {int? headerLen}) {
+      final len = headerLen ?? dict.length;
+      return Uint8List.fromList([
+        0x93,
+        ...'NUMPY'.codeUnits,
+        1,
+        0,
+        len & 0xff,
+        len >> 8,
+        ...dict.codeUnits,
+        ...List.filled(64, 0),
+      ]);
+    }
+
+    const prefix = "{'descr': '<f4', 'fortran_order': False, 'shape': ";
+    final cases = {
+      // header_len < 2, shorter than the fixed prefix
+      'short': npy('{', headerLen: 1),
+      'huge_dim': npy('$prefix(4294967297,), }'),
+      'overflow': npy('$prefix(65536, 65536, 65536), }'),
+    };
+    for (final MapEntry(:key, :value) in cases.entries) {
+      final path = 'test/tmp/malformed_$key.npy';
+      File(path).writeAsBytesSync(value);
+      expect(() => mnn.Tensor.fromNpy(path), throwsA(isA<mnn.MNNException>()), reason: key);
+    }
+  });
+
+  test('NpyArchive', () {
+    final x = mnn.Tensor.fromData(
+      [2, 2],
+      mnn.HalideType.f32,
+      data: Float32List.fromList([1, 2, 3, 4]).buffer.asUint8List(),
+    );
+    final y = mnn.Tensor.fromData(
+      [3],
+      mnn.HalideType.i32,
+      data: Int32List.fromList([10, 20, 30]).buffer.asUint8List(),
+    );
+    const path = 'test/tmp/tensors.mnpy';
+    mnn.NpyArchive.save(path, {'x': x, 'y': y});
+
+    for (final mmap in [true, false]) {
+      final archive = mnn.NpyArchive.open(path, mmap: mmap);
+      expect(archive.length, 2);
+      expect(archive.names, ['x', 'y']);
+      expect(archive['x']!.shape, [2, 2]);
+      expect(archive['x']!.cast<mnn.float32>().asTypedList(4), [1, 2, 3, 4]);
+      expect(archive['y']!.type, mnn.HalideType.i32);
+      expect(archive['y']!.cast<mnn.int32>().asTypedList(3), [10, 20, 30]);
+      expect(archive['z'], isNull);
+      archive.dispose();
+    }
+
+    // a single .npy file is opened as one entry named ""
+    x.saveNpy('test/tmp/x.npy');
+    final single = mnn.NpyArchive.open('test/tmp/x.npy');
+    expect(single.names, ['']);
+    expect(single.at(0).cast<mnn.float32>().asTypedList(4), [1, 2, 3, 4]);
+    single.dispose();
+
+    x.dispose();
+    y.dispose();
+  });
+}
@@ -98,6 +98,64 @@ void main() async {
     expect(tensor.deviceId, isA<int>());
   });
 
+  test('Tensor parallel host copy', () {
+    final data = Float32List.fromList(List.generate(12, (index) => index.toDouble()));
+    final nchw = mnn.Tensor.fromData(
+      [1, 3, 2, 2],
+      mnn.HalideType.f32,
+      data: data.buffer.asUint8List(),
+      dimType: mnn.DimensionType.MNN_CAFFE,
+    );
+    final nhwc = mnn.Tensor.fromData(
+      [1, 2, 2, 3],
+      mnn.HalideType.f32,
+      data: Uint8List(12 * 4),
+      dimType: mnn.DimensionType.MNN_TENSORFLOW,
+    );
+    expect(nchw.copyToHost(nhwc, parallel: true, numThreads: 2, threshold: 0), true);
+    expect(nhwc.cast<mnn.float32>().asTypedList(12), [0, 4, 8, 1, 5, 9, 2, 6, 10, 3, 7, 11]);
+
+    final back = mnn.Tensor.fromData(
+      [1, 3, 2, 2],
+      mnn.HalideType.f32,
+      data: Uint8List(12 * 4),
+      dimType: mnn.DimensionType.MNN_CAFFE,
+    );
+    expect(back.copyFromHost(nhwc, parallel: true, threshold: 0), true);
+    expect(back.cast<mnn.float32>().asTypedList(12), data);
+  });
+
+  test('Tensor channel postprocess', () {
+    final data = Float32List.fromList([0, 5, 1, 0, 1, 0, 2, 3, 2, 1, 0, 1]);
+    final tensor = mnn.Tensor.fromData(
+      [1, 3, 2, 2],
+      mnn.HalideType.f32,
+      data: data.buffer.asUint8List(),
+      dimType: mnn.DimensionType.MNN_CAFFE,
+    );
+    final layout = tensor.layout;
+    expect(layout.batch, 1);
+    expect(layout.channel, 3);
+    expect(layout.area, 4);
+    expect(layout.isPacked, false);
+    expect(layout.channelStride, 4);
+
+    final (indices, scores) = tensor.channelArgmax();
+    expect(indices, [2, 0, 1, 1]);
+    expect(scores, [2, 5, 2, 3]);
+
+    final probs = tensor.channelSoftmax(numThreads: 2);
+    for (var a = 0; a < 4; a++) {
+      expect(probs[a] + probs[4 + a] + probs[8 + a], closeTo(1.0, 1e-6));
+    }
+    expect(probs[1], greaterThan(probs[5]));
+
+    final (mask, count) = tensor.channelSigmoidThreshold(0.5);
+    expect(mask, [0, 1, 1, 0, 1, 0, 1, 1, 1, 1, 0, 1]);
+    expect(count, 8);
+    tensor.dispose();
+  });
+
   test('Tensor type operations', () {
     final tensor = mnn.Tensor.create();
     tensor.setDataType(mnn.DataType.DataType_DT_FLOAT);
@@ -121,4 +179,48 @@ void main() async {
     tensor.setDataType(mnn.DataType.DataType_DT_UINT8);
     expect(tensor.type, mnn.DataType.DataType_DT_UINT8.toHalideType());
   });
+
+  test('Tensor quantize per-tensor', () {
+    final tensor = mnn.Tensor.fromData([6], mnn.HalideType.i8, data: Uint8List(6));
+    final params = mnn.QuantParams.create([0.5], zeroPoints: [1]);
+    tensor.quantizeFrom(Float32List.fromList([-1.0, -0.25, 0.0, 0.25, 1.0, 100.0]), params);
+    expect(tensor.cast<mnn.int8>().asTypedList(6), [-1, 0, 1, 2, 3, 127]);
+    expect(tensor.dequantize(params), [-1.0, -0.5, 0.0, 0.5, 1.0, 63.0]);
+
+    // NaN quantizes to the zero point, infinities saturate
+    final special = [double.nan, double.infinity, double.negativeInfinity, 0.0, 0.0, 0.0];
+    tensor.quantizeFrom(Float32List.fromList(special), params);
+    expect(tensor.cast<mnn.int8>().asTypedList(6), [1, 127, -128, 1, 1, 1]);
+  });
+
+  test('Tensor quantize per-channel', () {
+    final tensor = mnn.Tensor.fromData([3, 2], mnn.HalideType.u8, data: Uint8List(6));
+    final params = mnn.QuantParams.create([1.0, 2.0], zeroPoints: [0, 10], axis: 1);
+    expect(params.count, 2);
+    expect(params.zeroPoints, [0, 10]);
+    tensor.quantizeFrom(Float32List.fromList([-1.0, -0.25, 0.0, 0.25, 1.0, 100.0]), params);
+    expect(tensor.cast<mnn.uint8>().asTypedList(6), [0, 10, 0, 10, 1, 60]);
+    expect(tensor.dequantize(params), [0.0, 0.0, 0.0, 0.0, 1.0, 100.0]);
+
+    final badAxis = mnn.QuantParams.create([1.0, 2.0], axis: 0);
+    expect(() => tensor.dequantize(badAxis), throwsA(isA<mnn.MNNException>()));
+  });
+
+  test('Tensor stats', () {
+    final data = Float32List.fromList(List.generate(27, (index) => index.toDouble()));
+    final tensor = mnn.Tensor.fromData(
+      [1, 3, 3, 3],
+      mnn.HalideType.f32,
+      data: data.buffer.asUint8List(),
+      dimType: mnn.DimensionType.MNN_CAFFE,
+    );
+    final stats = tensor.stats(bins: 3, numThreads: 2);
+    expect(stats.count, 27);
+    expect(stats.isFinite, true);
+    expect(stats.min, 0.0);
+    expect(stats.max, 26.0);
+    expect(stats.mean, closeTo(13.0, 1e-6));
+    expect(stats.variance, closeTo(60.666667, 1e-4));
+    expect(stats.histogram, [9, 9, 9]);
+  });
 }
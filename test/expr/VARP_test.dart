@@ -1,5 +1,8 @@
 // ignore_for_file: file_names
 
+import 'dart:typed_data';
+
+import 'package:mnn/expr.dart' as expr;
 import 'package:mnn/mnn.dart' as mnn;
 import 'package:mnn/numpy.dart' as np;
 import 'package:test/test.dart';
@@ -281,6 +284,162 @@ void main() {
       s.dispose();
     });
 
+    test('stats', () {
+      final x = mnn.VARP.fromListND<mnn.float32>([1.0, 2.0, double.nan, 4.0, double.infinity, 5.0], [2, 3]);
+      final st = x.stats(bins: 2);
+      expect(st.count, 6);
+      expect(st.nanCount, 1);
+      expect(st.infCount, 1);
+      expect(st.isFinite, false);
+      expect(st.min, 1.0);
+      expect(st.max, 5.0);
+      expect(st.mean, closeTo(3.0, 1e-6));
+      expect(st.variance, closeTo(2.5, 1e-6));
+      expect(st.histogram, [2, 2]);
+
+      final y = x * mnn.VARP.scalar<mnn.float32>(0.0);
+      final st1 = y.stats(bins: 4, histMin: -1.0, histMax: 1.0);
+      expect(st1.nanCount, 2);
+      expect(st1.histogram, [0, 0, 4, 0]);
+      x.dispose();
+      y.dispose();
+    });
+
+    test('topK', () {
+      final x = mnn.VARP.fromListND<mnn.float32>([1, 5, 3, 2, 4, double.nan, 6, 6], [2, 4]);
+      final top = x.topK(2);
+      expect(top.rows, 2);
+      expect(top.values, [5, 3, 6, 6]);
+      expect(top.indices, [1, 2, 2, 3]);
+      expect(top.probs, isNull);
+
+      final bottom = x.topK(2, largest: false, softmax: true);
+      expect(bottom.values, [1, 2, 4, 6]);
+      expect(bottom.indices, [0, 3, 0, 2]);
+      expect(bottom.probs![0] + bottom.probs![1], closeTo(1.0, 1e-6));
+      expect(bottom.probs![2], greaterThan(bottom.probs![3]));
+
+      expect(() => x.topK(4), throwsA(isA<mnn.MNNException>()));
+      x.dispose();
+    });
+
+    test('channel postprocess NC4HW4', () {
+      final x = mnn.VARP.fromListND<mnn.float32>([0, 5, 1, 0, 1, 0, 2, 3, 2, 1, 0, 1], [1, 3, 2, 2]);
+      final y = expr.convert(x, mnn.DimensionFormat.NC4HW4);
+      final layout = y.layout;
+      expect(layout.dimType, mnn.DimensionType.MNN_CAFFE_C4);
+      expect(layout.isPacked, true);
+      expect(layout.channel, 3);
+      expect(layout.area, 4);
+      expect(layout.storageSize, 16);
+
+      final (indices, scores) = y.channelArgmax();
+      expect(indices, [2, 0, 1, 1]);
+      expect(scores, [2, 5, 2, 3]);
+      expect(y.channelSoftmax(), listCloseTo(x.channelSoftmax(), 1e-6));
+      final (mask, count) = y.channelSigmoidThreshold(0.5);
+      expect(mask, [0, 1, 1, 0, 1, 0, 1, 1, 1, 1, 0, 1]);
+      expect(count, 8);
+      x.dispose();
+      y.dispose();
+    });
+
+    test('channel postprocess NC4HW4 batched', () {
+      // channels 4 and 5 share their block with the padding, and every block holds both batches
+      final data = List.generate(2 * 6 * 3, (i) => (i * 7 % 11) - 5.0);
+      final x = mnn.VARP.fromListND<mnn.float32>(data, [2, 6, 1, 3]);
+      final y = expr.convert(x, mnn.DimensionFormat.NC4HW4);
+      final layout = y.layout;
+      expect(layout.batch, 2);
+      expect(layout.batchStride, 3 * 4);
+      expect(layout.channelStride, 2 * 3 * 4);
+      expect(layout.storageSize, 2 * 2 * 3 * 4);
+
+      // the same data converted back to NCHW by MNN
+      final z = expr.convert(y, mnn.DimensionFormat.NCHW);
+      final (indices, scores) = y.channelArgmax(numThreads: 2);
+      final (zIndices, zScores) = z.channelArgmax();
+      expect(indices, zIndices);
+      expect(scores, zScores);
+      expect(y.channelSoftmax(numThreads: 2), listCloseTo(z.channelSoftmax(), 1e-6));
+
+      // the parallel host copy unpacks MNN's NC4HW4 data to the same NCHW
+      final raw = Float32List.fromList(y.readMap<mnn.float32>().asTypedList(layout.storageSize));
+      final packed = mnn.Tensor.fromData(
+        [2, 6, 1, 3],
+        mnn.HalideType.f32,
+        data: raw.buffer.asUint8List(),
+        dimType: mnn.DimensionType.MNN_CAFFE_C4,
+      );
+      final nchw = mnn.Tensor.fromData(
+        [2, 6, 1, 3],
+        mnn.HalideType.f32,
+        data: Uint8List(2 * 6 * 3 * 4),
+        dimType: mnn.DimensionType.MNN_CAFFE,
+      );
+      expect(packed.copyToHost(nchw, parallel: true, numThreads: 2, threshold: 0), true);
+      expect(nchw.cast<mnn.float32>().asTypedList(36), z.data);
+      for (final v in [x, y, z]) {
+        v.dispose();
+      }
+      packed.dispose();
+      nchw.dispose();
+    });
+
+    test('detect YOLO and SSD', () {
+      // 4 anchors of [cx, cy, w, h, class0, class1], anchors 0 and 1 overlap
+      final head = mnn.VARP.fromListND<mnn.float32>([
+        50, 52, 50, 200, //
+        50, 50, 50, 200, //
+        20, 20, 20, 10, //
+        20, 20, 20, 10, //
+        0.9, 0.8, 0.1, 0.1, //
+        0.1, 0.2, 0.7, 0.2, //
+      ], [1, 6, 4]);
+      const params = mnn.DetectParams(scoreThreshold: 0.25, iouThreshold: 0.45);
+      final dets = head.detect(params, letterbox: [const mnn.Letterbox(scale: 2, padY: 10, width: 100)]);
+      expect(dets.length, 1);
+      expect(dets[0].length, 2);
+      expect(dets[0][0].classId, 0);
+      expect(dets[0][0].score, closeTo(0.9, 1e-6));
+      expect([dets[0][0].x0, dets[0][0].y0, dets[0][0].x1, dets[0][0].y1], listCloseTo([20, 15, 30, 25], 1e-5));
+      expect(dets[0][1].classId, 1);
+
+      final agnostic = head.detect(const mnn.DetectParams(classAgnostic: true));
+      expect(agnostic[0].length, 1);
+
+      final headT = expr.transpose(head, [0, 2, 1]);
+      final detsT = headT.detect(params, channelLast: true);
+      expect(detsT[0].map((e) => e.score), listCloseTo([0.9, 0.7], 1e-6));
+
+      // SSD with background class 0 and softmax scores
+      final deltas = mnn.VARP.fromListND<mnn.float32>([0, 0, 0, 0, 1, 0, 0, 0], [1, 2, 4]);
+      final scores = mnn.VARP.fromListND<mnn.float32>([0, 2, 0, 3, 0, 0], [1, 2, 3]);
+      final priors = mnn.VARP.fromListND<mnn.float32>([10, 10, 4, 4, 30, 30, 8, 8], [2, 4]);
+      final ssd = deltas.detect(
+        const mnn.DetectParams(
+          format: mnn.DetectFormat.MNN_DETECT_SSD,
+          activation: mnn.ScoreActivation.MNN_SCORE_SOFTMAX,
+          scoreThreshold: 0.3,
+          backgroundClass: 0,
+        ),
+        scores: scores,
+        priors: priors,
+        channelLast: true,
+      );
+      expect(ssd[0].length, 1);
+      expect(ssd[0][0].classId, 1);
+      expect([ssd[0][0].x0, ssd[0][0].y0, ssd[0][0].x1, ssd[0][0].y1], listCloseTo([8, 8, 12, 12], 1e-5));
+
+      final letterbox = mnn.Letterbox.fit(1280, 720, 640, 640);
+      expect(letterbox.scale, 0.5);
+      expect(letterbox.padY, 140);
+
+      for (final v in [head, headT, deltas, scores, priors]) {
+        v.dispose();
+      }
+    });
+
     // Testing load/save requires file system or buffer.
     // Buffer test is easier.
     test('saveToBuffer, loadFromBuffer', () {
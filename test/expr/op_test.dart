@@ -481,6 +481,56 @@ void main() {
       b.dispose();
     });
 
+    test('einsum', () {
+      final a = mnn.VARP.fromListND<mnn.float32>([1, 2, 3, 4, 5, 6], [2, 3]);
+      final b = mnn.VARP.fromListND<mnn.float32>([1, 0, 0, 1, 1, 1], [3, 2]);
+      final c = mnn.VARP.fromListND<mnn.float32>([2, 0, 0, 3], [2, 2]);
+
+      final mm = expr.einsum('ij,jk->ik', [a, b]);
+      expect(mm.dim, [2, 2]);
+      expect(mm.data, listCloseTo([4.0, 5.0, 10.0, 11.0], 1e-5));
+
+      final chain = np.einsum('ij,jk,kl->il', [a, b, c]);
+      expect(chain.data, listCloseTo([8.0, 15.0, 20.0, 33.0], 1e-5));
+
+      // implicit output sorts the labels, so 'ji' transposes
+      final t = expr.einsum('ji', [a]);
+      expect(t.dim, [3, 2]);
+      expect(t.data, listCloseTo([1.0, 4.0, 2.0, 5.0, 3.0, 6.0], 1e-5));
+
+      final trace = expr.einsum('ii->', [c]);
+      expect(trace.data, listCloseTo([5.0], 1e-5));
+      final diag = expr.einsum('ii->i', [c]);
+      expect(diag.data, listCloseTo([2.0, 3.0], 1e-5));
+
+      // the same batched product through each layout: adj_y, adj_x and neither
+      final q = mnn.VARP.fromListND<mnn.float32>(List.generate(12, (i) => i + 1.0), [2, 2, 3]);
+      final k = mnn.VARP.fromListND<mnn.float32>([1, 0, 2, 0, 1, 1, -1, 2, 0, 3, 1, -2], [2, 2, 3]);
+      final qt = mnn.VARP.fromListND<mnn.float32>([1, 4, 2, 5, 3, 6, 7, 10, 8, 11, 9, 12], [2, 3, 2]);
+      final kt = mnn.VARP.fromListND<mnn.float32>([1, 0, 0, 1, 2, 1, -1, 3, 2, 1, 0, -2], [2, 3, 2]);
+      final qks = [
+        expr.einsum('bqd,bkd->bqk', [q, k]),
+        expr.einsum('bdq,bdk->bqk', [qt, kt]),
+        expr.einsum('bqd,bdk->bqk', [q, kt]),
+      ];
+      for (final qk in qks) {
+        expect(qk.dim, [2, 2, 2]);
+        expect(qk.data, listCloseTo([7.0, 5.0, 16.0, 11.0, 9.0, 11.0, 12.0, 17.0], 1e-5));
+      }
+
+      // unbatched adj_x and adj_y
+      final ata = expr.einsum('ji,jk->ik', [a, a]);
+      expect(ata.data, listCloseTo([17.0, 22.0, 27.0, 22.0, 29.0, 36.0, 27.0, 36.0, 45.0], 1e-5));
+      final aat = expr.einsum('ij,kj->ik', [a, a]);
+      expect(aat.data, listCloseTo([14.0, 32.0, 32.0, 77.0], 1e-5));
+
+      expect(() => expr.einsum('ij,jk->ik', [a]), throwsA(isA<mnn.MNNException>()));
+
+      for (final v in [a, b, c, mm, chain, t, trace, diag, q, k, qt, kt, ...qks, ata, aat]) {
+        v.dispose();
+      }
+    });
+
     test('unravelIndex', () {
       // unravelIndex
       final indices = mnn.VARP.scalar<mnn.int32>(5);
@@ -1038,6 +1088,53 @@ void main() {
       scores.dispose();
       result.dispose();
     });
+
+    test('batchedNms', () {
+      // 2 images of 4 boxes and 2 classes, image 1 is image 0 with box 2 moved onto box 0
+      final boxes = mnn.VARP.fromListND<mnn.float32>([
+        0, 0, 10, 10, 1, 1, 11, 11, 20, 20, 30, 30, 0, 0, 10, 10, //
+        0, 0, 10, 10, 1, 1, 11, 11, 0, 0, 10, 10, 0, 0, 10, 10, //
+      ], [2, 4, 4]);
+      final scores = mnn.VARP.fromListND<mnn.float32>([
+        0.9, 0.1, 0.8, 0.7, 0.6, 0.0, 0.1, 0.95, //
+        0.9, 0.1, 0.8, 0.7, 0.6, 0.0, 0.1, 0.95, //
+      ], [2, 4, 2]);
+      List<(int, int)> ids(List<mnn.NmsResult> r) => r.map((e) => (e.boxIndex, e.classId)).toList();
+
+      final perClass = expr.batchedNms(boxes, scores, params: const mnn.NmsParams(scoreThreshold: 0.05));
+      expect(ids(perClass[0]), [(3, 1), (0, 0), (2, 0)]);
+      expect(ids(perClass[1]), [(3, 1), (0, 0)]);
+      expect(perClass[0][0].score, closeTo(0.95, 1e-6));
+
+      final agnostic = expr.batchedNms(
+        boxes,
+        scores,
+        params: const mnn.NmsParams(scoreThreshold: 0.05, classAgnostic: true, maxDetections: 1),
+      );
+      expect(ids(agnostic[0]), [(3, 1)]);
+
+      final soft = expr.batchedNms(
+        boxes,
+        scores,
+        params: const mnn.NmsParams(method: mnn.NmsMethod.MNN_NMS_SOFT_LINEAR, scoreThreshold: 0.05),
+      );
+      expect(ids(soft[0]), [(3, 1), (0, 0), (2, 0), (1, 0), (1, 1)]);
+      expect(soft[0][3].score, lessThan(0.8));
+
+      // rotating a square by 90 degrees does not change it, by 45 degrees leaves the octagon
+      expect(mnn.rotatedIou([0, 0, 2, 2, 0], [0, 0, 2, 2, math.pi / 2]), closeTo(1.0, 1e-5));
+      expect(mnn.rotatedIou([0, 0, 2, 2, 0], [0, 0, 2, 2, math.pi / 4]), closeTo(math.sqrt1_2, 1e-4));
+      final rboxes = mnn.VARP.fromListND<mnn.float32>([
+        0, 0, 2, 2, 0, 0, 0, 2, 2, math.pi / 4, 5, 5, 2, 2, 0, //
+      ], [1, 3, 5]);
+      final rscores = mnn.VARP.fromListND<mnn.float32>([0.9, 0.8, 0.7], [1, 3, 1]);
+      final rotated = expr.batchedNms(rboxes, rscores, params: const mnn.NmsParams(rotated: true));
+      expect(rotated[0].map((e) => e.boxIndex), [0, 2]);
+
+      for (final v in [boxes, scores, rboxes, rscores]) {
+        v.dispose();
+      }
+    });
   });
 
   group('More Ops', () {
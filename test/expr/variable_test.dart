@@ -1,8 +1,14 @@
+import 'dart:ffi' as ffi;
 import 'dart:io';
+import 'dart:typed_data';
 
+import 'package:ffi/ffi.dart';
 import 'package:mnn/mnn.dart' as mnn;
+import 'package:mnn/src/g/mnn.g.dart' as C;
 import 'package:test/test.dart';
 
+import '../list_element_equals.dart';
+
 void main() {
   test('VariableInfo', () {
     final shape = [2, 1, 640, 640];
@@ -89,4 +95,240 @@ void main() {
     // final varpMap = mnn.VARP.loadMapFromFile("test/data/mnist-8.mnn");
     // print(varpMap["Plus214_Output_0"]?.data);
   });
+
+  test('Variable streaming save and mapped load', () {
+    final outFile = File('test/tmp/variable_stream.mnn');
+    if (!outFile.parent.existsSync()) {
+      outFile.parent.createSync(recursive: true);
+    }
+    final varp = mnn.VARP.fromList1D<mnn.float32>(List.generate(1000, (i) => i.toDouble()));
+    varp.setName('x');
+
+    final chunks = <int>[];
+    final builder = BytesBuilder();
+    mnn.VARP.saveToSink([varp], (chunk) {
+      chunks.add(chunk.length);
+      builder.add(chunk);
+    }, chunkSize: 256);
+    final bytes = builder.takeBytes();
+    expect(chunks.every((e) => e <= 256), true);
+    final bufOut = mnn.VARP.saveToBuffer([varp]);
+    expect(bytes, bufOut.data);
+    bufOut.dispose();
+    outFile.writeAsBytesSync(bytes);
+
+    final loaded = mnn.VARP.loadFromFile(outFile.path);
+    expect(loaded[0].data, varp.data);
+    final loadedMap = mnn.VARP.loadMapFromFile(outFile.path);
+    expect(loadedMap['x']?.data, varp.data);
+    expect(() => mnn.VARP.loadFromFile('test/tmp/not_exist.mnn'), throwsA(isA<mnn.MNNException>()));
+
+    expect(
+      () => mnn.VARP.saveToSink([varp], (chunk) => throw StateError('stop')),
+      throwsA(isA<StateError>()),
+    );
+    for (final v in [varp, ...loaded, ...loadedMap.values]) {
+      v.dispose();
+    }
+  });
+
+  test('ExprScope', () {
+    final x = mnn.VARP.fromList1D<mnn.float32>([1, 2, 3, 4]);
+    expect(mnn.ExprScope.isActive, false);
+    late int size;
+    final y = mnn.ExprScope.run((scope) {
+      expect(mnn.ExprScope.isActive, true);
+      var t = x;
+      for (var i = 0; i < 10; i++) {
+        t = t * x + x;
+      }
+      final inner = mnn.ExprScope.run((inner) => inner.escape(t.sum([])));
+      size = scope.size;
+      return scope.escape(inner * mnn.VARP.scalar<mnn.float32>(0.0) + t.sum([]));
+    });
+    expect(mnn.ExprScope.isActive, false);
+    expect(size, greaterThanOrEqualTo(20));
+    expect(y.value, isA<num>());
+    expect(() => mnn.ExprScope.run((scope) async => 0), throwsA(isA<mnn.MNNException>()));
+    expect(mnn.ExprScope.isActive, false);
+    x.dispose();
+    y.dispose();
+  });
+
+  test('GraphBuilder', () {
+    final x = mnn.VARP.fromList1D<mnn.float32>([1, 2, 3, 4]);
+    final g = mnn.GraphBuilder(numInputs: 1);
+    final w = g.constant([2, 2, 2, 2], [4]);
+    final t = g.add(g.multiply(0, w), g.scalar(1.0));
+    final s = g.reduceSum(t, []);
+    final r = g.reshape(g.stridedSlice(t, [1], [3], [1]), [2, 1]);
+    final outputs = g.build([x], [t, s, r]);
+    expect(outputs.length, 3);
+    expect(outputs[0].data, listCloseTo([3.0, 5.0, 7.0, 9.0], 0.001));
+    expect(outputs[1].value, closeTo(24.0, 0.001));
+    expect(outputs[2].shape, [2, 1]);
+    expect(outputs[2].data, listCloseTo([5.0, 7.0], 0.001));
+
+    expect(() => g.add(0, 100), throwsA(isA<mnn.MNNException>()));
+    final bad = mnn.GraphBuilder()..emit(mnn.ExprOpcode.MNN_EXPR_OP_RESHAPE, []);
+    expect(() => bad.build([], [0]), throwsA(isA<mnn.MNNException>()));
+    x.dispose();
+    for (final v in outputs) {
+      v.dispose();
+    }
+  });
+
+  test('pluginOp', () {
+    // y = x * scale + offsets[i % offsets.length], computed synchronously on this thread
+    bool compute(C.mnn_plugin_context_t ctx, ffi.Pointer<ffi.Void> userdata) {
+      final cScale = 'scale'.toNativeUtf8().cast<ffi.Char>();
+      final cOffsets = 'offsets'.toNativeUtf8().cast<ffi.Char>();
+      final pScale = calloc<ffi.Float>();
+      final pOffsets = calloc<ffi.Pointer<ffi.Float>>();
+      final pCount = calloc<ffi.Size>();
+      try {
+        if (C.mnn_plugin_context_num_inputs(ctx) != 1 ||
+            C.mnn_plugin_context_attr_float(ctx, cScale, pScale) != C.ErrorCode.MNNC_NO_ERROR ||
+            C.mnn_plugin_context_attr_floats(ctx, cOffsets, pOffsets, pCount) != C.ErrorCode.MNNC_NO_ERROR) {
+          return false;
+        }
+        final input = C.mnn_plugin_context_input(ctx, 0);
+        final n = C.mnn_tensor_element_size(input);
+        final x = C.mnn_tensor_host(input).cast<ffi.Float>().asTypedList(n);
+        final y = C.mnn_tensor_host(C.mnn_plugin_context_output(ctx, 0)).cast<ffi.Float>().asTypedList(n);
+        final offsets = pOffsets.value.asTypedList(pCount.value);
+        for (var i = 0; i < n; i++) {
+          y[i] = x[i] * pScale.value + offsets[i % offsets.length];
+        }
+        return true;
+      } finally {
+        calloc.free(pScale);
+        calloc.free(pOffsets);
+        calloc.free(pCount);
+        malloc.free(cScale);
+        malloc.free(cOffsets);
+      }
+    }
+
+    // the registration outlives the test, the callable is never closed
+    final callable = ffi.NativeCallable<C.mnn_plugin_kernel_fnFunction>.isolateLocal(
+      compute,
+      exceptionalReturn: false,
+    );
+    mnn.registerPluginOp('DartScaleOffset', compute: callable.nativeFunction);
+
+    final x = mnn.VARP.fromList1D<mnn.float32>([1, 2, 3, 4]);
+    final outputs = mnn.pluginOp(
+      'DartScaleOffset',
+      [x],
+      attrs: {
+        'scale': 2.0,
+        'offsets': [0.5, -0.5],
+      },
+    );
+    expect(outputs.length, 1);
+    expect(outputs[0].shape, [4]);
+    expect(outputs[0].data, listCloseTo([2.5, 3.5, 6.5, 7.5], 0.001));
+
+    expect(() => mnn.pluginOp('NotRegistered', [x]), throwsA(isA<mnn.MNNException>()));
+    expect(() => mnn.pluginOp('DartScaleOffset', [x], attrs: {'bad': true}), throwsArgumentError);
+    x.dispose();
+    outputs[0].dispose();
+  }, skip: mnn.pluginSupported ? false : 'MNN is built without MNN_WITH_PLUGIN');
+
+  test('Eager', () {
+    expect(mnn.Eager.threshold, 0);
+    final x = mnn.VARP.fromList2D<mnn.float32>([
+      [1, 2, 3],
+      [4, 5, 6],
+    ]);
+    final y = mnn.VARP.fromList1D<mnn.float32>([10, 20, 30]);
+    final lazy = x * y + x;
+    final lazySum = lazy.sum([1]);
+    final (eager, eagerSum) = mnn.Eager.run(() {
+      expect(mnn.Eager.threshold, 1024);
+      final t = x * y + x;
+      return (t, t.sum([1]));
+    });
+    expect(mnn.Eager.threshold, 0);
+    expect(eager.expr.$1.inputType, mnn.InputType.CONSTANT);
+    expect(eager.shape, [2, 3]);
+    expect(eager.data, listCloseTo(lazy.data!, 1e-4));
+    expect(eagerSum.data, listCloseTo(lazySum.data!, 1e-4));
+
+    // inputs above the threshold are left to the graph, the ones below are folded
+    final (big, small) = mnn.Eager.run(() => (x * y, y * y), threshold: 4);
+    // an op node over x and y, not a folded constant
+    expect(big.expr.$1.inputs, hasLength(2));
+    expect(big.data, listCloseTo([10, 40, 90, 40, 100, 180], 1e-4));
+    expect(small.expr.$1.inputType, mnn.InputType.CONSTANT);
+    expect(small.expr.$1.inputs, isEmpty);
+    expect(small.data, listCloseTo([100, 400, 900], 1e-4));
+    for (final v in [x, y, lazy, lazySum, eager, eagerSum, big, small]) {
+      v.dispose();
+    }
+  });
+
+  test('VARP.queryInfo', () {
+    final x = mnn.VARP.fromList2D<mnn.float32>([
+      [1, 2, 3],
+      [4, 5, 6],
+    ]);
+    final info = x.queryInfo()!;
+    expect(info.dim, [2, 3]);
+    expect(info.size, 6);
+    expect(info.type, mnn.HalideType.f32);
+    expect(info.order, mnn.DimensionFormat.NCHW);
+
+    final deep = mnn.VARP.fromListND<mnn.int32>(List.filled(1, 1), List.filled(40, 1));
+    expect(deep.ndim, 40);
+
+    final infos = mnn.VARP.queryInfos([x, deep, mnn.VARP.scalar<mnn.int32>(7)]);
+    expect(infos[0]!.dim, [2, 3]);
+    expect(infos[1]!.dim, List.filled(40, 1));
+    expect(infos[2]!.dim, isEmpty);
+    expect(infos[2]!.type, mnn.HalideType.i32);
+
+    mnn.VARP.cacheInfo = true;
+    try {
+      final y = mnn.VARP.fromList1D<mnn.float32>([1, 2, 3, 4]);
+      expect(y.shape, [4]);
+      y.resize([2, 2]);
+      expect(y.shape, [2, 2]);
+      y.dispose();
+    } finally {
+      mnn.VARP.cacheInfo = false;
+    }
+    x.dispose();
+    deep.dispose();
+  });
+
+  test('VARP.data pinned view', () {
+    final x = mnn.VARP.fromList1D<mnn.float32>([1, 2, 3, 4]);
+    final y = x * mnn.VARP.scalar<mnn.float32>(2);
+    final view = y.data!;
+    expect(view, isA<Float32List>());
+    // the view keeps the computed data alive after the VARP is freed
+    y.dispose();
+    x.dispose();
+    expect(view, listCloseTo([2, 4, 6, 8], 1e-6));
+  });
+
+  test('VARP.computeParallel', () {
+    final x = mnn.VARP.fromList1D<mnn.float32>([1, 2, 3, 4]);
+    final outputs = [for (var i = 1; i <= 4; i++) (x * mnn.VARP.scalar<mnn.float32>(i)).sum([0])];
+    // sharing an op node merges two outputs into one group
+    final shared = x * x;
+    final a = shared + mnn.VARP.scalar<mnn.float32>(1);
+    final b = shared - mnn.VARP.scalar<mnn.float32>(1);
+    expect(mnn.VARP.computeParallel([...outputs, a, b]), 5);
+    for (var i = 0; i < 4; i++) {
+      expect(outputs[i].value, closeTo(10.0 * (i + 1), 1e-4));
+    }
+    expect((a - b).data, listCloseTo([2, 2, 2, 2], 1e-4));
+    expect(mnn.VARP.computeParallel([outputs[0]]), 1);
+    for (final v in [x, shared, a, b, ...outputs]) {
+      v.dispose();
+    }
+  });
 }
@@ -143,4 +143,66 @@ void main() {
     expect(executor.isEmpty, false);
     executor.dispose();
   });
+
+  test('ExecutorPool', () {
+    final pool = nn.ExecutorPool.create(size: 2);
+    expect(pool.size, 2);
+    final executor = pool[1];
+    expect(executor.isEmpty, false);
+    executor.dispose();
+
+    List<int> leased() => [
+      for (var i = 0; i < pool.size; i++)
+        if (pool.stats(i).inUse) i,
+    ];
+    pool.run(() {
+      final index = leased();
+      expect(index, hasLength(1));
+      // nested runs on the same thread reuse the executor
+      pool.run(() => expect(leased(), index));
+      expect(leased(), index);
+    });
+    expect(leased(), isEmpty);
+    expect(() => pool.run(() async => 1), throwsA(isA<mnn.MNNException>()));
+    expect(leased(), isEmpty);
+
+    final sum = pool.run(() {
+      final x = mnn.VARP.fromList1D<mnn.float32>([1, 2, 3]);
+      final y = (x + x).sum([0]);
+      final v = y.value;
+      x.dispose();
+      y.dispose();
+      return v;
+    });
+    expect(sum, closeTo(12, 1e-5));
+
+    final x = mnn.VARP.fromList1D<mnn.float32>([1, 2, 3]);
+    final outputs = [x * x, x + x, x - x];
+    expect(pool.compute(outputs), 3);
+    expect(outputs[1].data, [2, 4, 6]);
+    for (final v in [x, ...outputs]) {
+      v.dispose();
+    }
+
+    final stats = [for (var i = 0; i < pool.size; i++) pool.stats(i)];
+    expect(stats.fold(0, (a, s) => a + s.tasks), greaterThanOrEqualTo(3));
+    expect(pool.gc(), 2);
+    expect(pool.stats(0).gcCount, 1);
+    pool.dispose();
+  });
+
+  test('ExecutorPool.compute on a bound thread', () {
+    // the only executor is leased to this thread, compute must reuse it instead of waiting
+    final pool = nn.ExecutorPool.create(size: 1);
+    final x = mnn.VARP.fromList1D<mnn.float32>([1, 2, 3]);
+    final outputs = [x * x, x + x, x - x];
+    expect(pool.run(() => pool.compute(outputs)), 3);
+    expect(outputs[0].data, [1, 4, 9]);
+    expect(outputs[1].data, [2, 4, 6]);
+    expect(pool.stats(0).inUse, false);
+    for (final v in [x, ...outputs]) {
+      v.dispose();
+    }
+    pool.dispose();
+  });
 }
@@ -1,10 +1,15 @@
 import 'dart:ffi' as ffi;
+import 'dart:math' as math;
 import 'dart:typed_data';
 
+import 'package:ffi/ffi.dart';
+import 'package:mnn/expr.dart' as expr;
 import 'package:mnn/mnn.dart' as mnn;
 import 'package:mnn/nn.dart' as nn;
 import 'package:test/test.dart';
 
+import '../list_element_equals.dart';
+
 void main() {
   group('ModuleConfig Tests', () {
     test('ModuleConfig creation and properties', () {
@@ -155,6 +160,33 @@ void main() {
       });
     });
 
+    test('Module forwardInto', () {
+      final input = mnn.VARP.fromListND<ffi.Float>(Float32List(1 * 1 * 28 * 28), [
+        1,
+        1,
+        28,
+        28,
+      ], format: mnn.DimensionFormat.NCHW);
+      final inputs = mnn.VecVARP.of([input]);
+      final expected = module.onForward(inputs);
+      expect(expected.length, 1);
+
+      final buffer = calloc<ffi.Float>(10);
+      final view = buffer.asTypedList(10);
+      for (var i = 0; i < 3; i++) {
+        final written = module.forwardInto(inputs, [buffer.cast()], [10 * 4]);
+        expect(written, [10 * 4]);
+        expect(view, listCloseTo(expected.at(0).data!, 1e-4));
+      }
+      expect(() => module.forwardInto(inputs, [buffer.cast()], [4]), throwsA(isA<mnn.MNNException>()));
+      expect(() => module.forwardInto(inputs, [], []), throwsA(isA<mnn.MNNException>()));
+
+      calloc.free(buffer);
+      input.dispose();
+      inputs.dispose();
+      expected.dispose();
+    });
+
     test('Module onForwardAsync', () async {
       await nn.usingExecutor((e) async {
         // Mnist input 1x1x28x28
@@ -177,5 +209,104 @@ void main() {
         outputs.dispose();
       });
     });
+
+    test('ModulePool', () async {
+      final pool = nn.ModulePool.create(module, size: 2);
+      expect(pool.size, 2);
+
+      final input = mnn.VARP.fromListND<ffi.Float>(Float32List(1 * 1 * 28 * 28), [
+        1,
+        1,
+        28,
+        28,
+      ], format: mnn.DimensionFormat.NCHW);
+      final expected = module.forward(input);
+
+      final outputs = [
+        pool.forward([input]),
+        ...await Future.wait(List.generate(8, (_) => pool.forwardAsync([input]))),
+      ];
+      for (final out in outputs) {
+        expect(out.length, 1);
+        expect(out.first.data, listCloseTo(expected.data!, 1e-4));
+      }
+      expect(pool.pending, 0);
+
+      final stats = List.generate(pool.size, pool.stats);
+      expect(stats.fold<int>(0, (sum, s) => sum + s.requests), 9);
+      expect(stats.every((s) => !s.inUse && s.busy <= s.alive), true);
+      expect(() => pool.stats(pool.size), throwsA(isA<mnn.MNNException>()));
+
+      for (final v in [input, expected, for (final out in outputs) ...out]) {
+        v.dispose();
+      }
+      pool.dispose();
+    });
+  });
+
+  test('GraphCache', () {
+    final cache = nn.GraphCache.create(capacity: 2);
+    List<mnn.VARP> build(List<double> data) {
+      final x = expr.input<mnn.float32>([4], dataFormat: mnn.DimensionFormat.NCHW);
+      x.writeMap<ffi.Float>().asTypedList(4).setAll(0, data);
+      final y = expr.sigmoid(x * expr.scalar<mnn.float32>(2.0));
+      return [x, y];
+    }
+
+    final [x0, y0] = build([0, 1, 2, 3]);
+    final (r0, hit0) = cache.run([x0], [y0]);
+    expect(hit0, false);
+    expect(cache.size, 1);
+
+    final [x1, y1] = build([-1, -2, -3, -4]);
+    final (r1, hit1) = cache.run([x1], [y1]);
+    expect(hit1, true);
+    expect(cache.size, 1);
+    expect(r1.first.data, listCloseTo(y1.data!, 1e-4));
+
+    cache.clear();
+    expect(cache.size, 0);
+    for (final v in [x0, y0, x1, y1, ...r0, ...r1]) {
+      v.dispose();
+    }
+    cache.dispose();
+  });
+
+  test('DynamicBatcher', () async {
+    final x = expr.input<mnn.float32>([-1, 4], dataFormat: mnn.DimensionFormat.NCHW);
+    final y = expr.sigmoid(x * expr.scalar<mnn.float32>(2.0));
+    final (vx, vy) = (mnn.VecVARP.of([x]), mnn.VecVARP.of([y]));
+    final module = nn.Module.extract(vx, vy);
+    final batcher = nn.DynamicBatcher.create(module, maxBatch: 4, maxDelay: const Duration(milliseconds: 50));
+    expect(batcher.maxBatch, 4);
+
+    mnn.VARP request(int rows, double offset) =>
+        mnn.VARP.fromListND<ffi.Float>(List.generate(rows * 4, (i) => offset + i * 0.1), [rows, 4]);
+    final inputs = [request(1, 0), request(2, -1), request(1, 0.5)];
+    // queued together, the three requests fill one batch of 4 rows
+    final outputs = await Future.wait(inputs.map((v) => batcher.forwardAsync([v])));
+    for (final (i, out) in outputs.indexed) {
+      final expected = inputs[i].data!.map((v) => 1 / (1 + math.exp(-2 * v))).toList();
+      expect(out.first.shape, inputs[i].shape);
+      expect(out.first.data, listCloseTo(expected, 1e-4));
+    }
+
+    final stats = batcher.stats;
+    expect(stats.requests, 3);
+    expect(stats.batches, 1);
+    expect(stats.histogram, [0, 0, 0, 1]);
+    expect(stats.maxQueueDelay, lessThanOrEqualTo(stats.queueDelay));
+    expect(batcher.pending, 0);
+
+    final tooLarge = request(5, 0);
+    expect(() => batcher.forward([tooLarge]), throwsA(isA<mnn.MNNException>()));
+
+    for (final v in [x, y, tooLarge, ...inputs, for (final out in outputs) ...out]) {
+      v.dispose();
+    }
+    batcher.dispose();
+    module.dispose();
+    vx.dispose();
+    vy.dispose();
   });
 }
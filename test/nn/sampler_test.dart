@@ -0,0 +1,58 @@
+import 'package:mnn/mnn.dart' as mnn;
+import 'package:mnn/nn.dart' as nn;
+import 'package:test/test.dart';
+
+void main() {
+  group('Sampler', () {
+    late mnn.VARP logits;
+
+    setUp(() {
+      // the last row is sampled
+      logits = mnn.VARP.fromListND<mnn.float32>([0, 0, 0, 0, 0, 1, 5, 3, 2, 4], [2, 5]);
+    });
+
+    tearDown(() {
+      logits.dispose();
+    });
+
+    test('greedy and repetition penalty', () {
+      final sampler = nn.Sampler.greedy(repetitionPenalty: 2.0);
+      expect(sampler.sample(logits), (token: 1, prob: 1.0));
+      // 5 / 2 and 4 / 2 fall behind 3
+      expect(sampler.sample(logits, history: [1, 4, 1]).token, 2);
+      expect(() => sampler.sample(logits, history: [5]), throwsA(isA<mnn.MNNException>()));
+      sampler.dispose();
+    });
+
+    test('top-k and top-p', () {
+      final sampler = nn.Sampler.create(topK: 2, seed: 42);
+      final counts = <int, int>{};
+      for (var i = 0; i < 2000; i++) {
+        final s = sampler.sample(logits);
+        counts[s.token] = (counts[s.token] ?? 0) + 1;
+      }
+      expect(counts.keys.toSet(), {1, 4});
+      // e^5 / (e^5 + e^4)
+      expect(counts[1]! / 2000, closeTo(0.731, 0.04));
+
+      sampler.configure(topP: 0.5, seed: 1);
+      expect(sampler.sample(logits).token, 1);
+
+      expect(() => sampler.configure(topP: 0), throwsA(isA<mnn.MNNException>()));
+      expect(() => nn.Sampler.create(repetitionPenalty: 0), throwsA(isA<mnn.MNNException>()));
+      sampler.dispose();
+    });
+
+    test('seeded draws are reproducible', () {
+      final a = nn.Sampler.create(temperature: 1.5, seed: 7);
+      final b = nn.Sampler.create(temperature: 1.5, seed: 7);
+      final first = List.generate(32, (_) => a.sample(logits));
+      expect(List.generate(32, (_) => b.sample(logits)), first);
+      a.reseed(7);
+      expect(List.generate(32, (_) => a.sample(logits).token), first.map((e) => e.token).toList());
+      expect(first.map((e) => e.token).toSet().length, greaterThan(1));
+      a.dispose();
+      b.dispose();
+    });
+  });
+}
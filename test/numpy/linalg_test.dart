@@ -60,4 +60,103 @@ void main() {
     // Note: ordering of singular values might vary but usually sorted desc.
     expect(w.data, containsAll([1.0, 1.0]));
   });
+
+  test('det inv', () {
+    final a = np.array<float32>([
+      [
+        [1.0, 2.0],
+        [3.0, 4.0],
+      ],
+      [
+        [2.0, 0.0],
+        [0.0, 4.0],
+      ],
+    ]);
+    expect(la.det(a).shape, [2]);
+    expect(la.det(a).data, listCloseTo([-2.0, 8.0], 1e-5));
+    final b = la.inv(a);
+    expect(b.shape, [2, 2, 2]);
+    expect(b.data, listCloseTo([-2.0, 1.0, 1.5, -0.5, 0.5, 0.0, 0.0, 0.25], 1e-5));
+
+    final c = np.array<float32>([
+      [4.0, 1.0, 0.0, 0.0, 0.0],
+      [1.0, 4.0, 1.0, 0.0, 0.0],
+      [0.0, 1.0, 4.0, 1.0, 0.0],
+      [0.0, 0.0, 1.0, 4.0, 1.0],
+      [0.0, 0.0, 0.0, 1.0, 4.0],
+    ]);
+    expect(la.det(c).value, closeTo(780.0, 1e-3));
+    expect(np.matmul(c, la.inv(c)).data, listCloseTo(np.eye<float32>(5).data!, 1e-5));
+
+    final singular = np.array<float32>([
+      [1.0, 2.0],
+      [2.0, 4.0],
+    ]);
+    expect(la.det(singular).value, 0.0);
+    expect(() => la.inv(singular), throwsA(isA<MNNException>()));
+  });
+
+  test('solve', () {
+    final a = np.array<float32>([
+      [3.0, 1.0],
+      [1.0, 2.0],
+    ]);
+    final x = la.solve(a, np.array<float32>([9.0, 8.0]));
+    expect(x.shape, [2]);
+    expect(x.data, listCloseTo([2.0, 3.0], 1e-5));
+
+    final b = np.array<float32>([
+      [9.0, 1.0],
+      [8.0, 0.0],
+    ]);
+    final y = la.solve(a, b);
+    expect(y.shape, [2, 2]);
+    expect(y.data, listCloseTo([2.0, 0.4, 3.0, -0.2], 1e-5));
+  });
+
+  test('cholesky qr', () {
+    final a = np.array<float32>([
+      [4.0, 2.0],
+      [2.0, 5.0],
+    ]);
+    final l = la.cholesky(a);
+    expect(l.data, listCloseTo([2.0, 0.0, 1.0, 2.0], 1e-5));
+    expect(
+      () => la.cholesky(
+        np.array<float32>([
+          [1.0, 2.0],
+          [2.0, 1.0],
+        ]),
+      ),
+      throwsA(isA<MNNException>()),
+    );
+
+    final m = np.array<float32>([
+      [3.0, 1.0],
+      [4.0, 2.0],
+      [0.0, 5.0],
+    ]);
+    final (q, r) = la.qr(m);
+    expect(q.shape, [3, 2]);
+    expect(r.shape, [2, 2]);
+    // numpy.linalg.qr
+    expect(q.data, listCloseTo([-0.6, 0.063796, -0.8, -0.047847, 0.0, -0.996815], 1e-5));
+    expect(r.data, listCloseTo([-5.0, -2.2, 0.0, -5.015974], 1e-5));
+    expect(np.matmul(q, r).data, listCloseTo(m.data!, 1e-5));
+    expect(np.matmul(np.transpose(q), q).data, listCloseTo(np.eye<float32>(2).data!, 1e-5));
+
+    // the last column of a square matrix has nothing below the diagonal, no reflector
+    final (q2, r2) = la.qr(
+      np.array<float32>([
+        [1.0, 2.0],
+        [3.0, 4.0],
+      ]),
+    );
+    expect(q2.data, listCloseTo([-0.316228, -0.948683, -0.948683, 0.316228], 1e-5));
+    expect(r2.data, listCloseTo([-3.162278, -4.427189, 0.0, -0.632456], 1e-5));
+
+    final (qi, ri) = la.qr(np.eye<float32>(2));
+    expect(qi.data, listCloseTo([1.0, 0.0, 0.0, 1.0], 1e-6));
+    expect(ri.data, listCloseTo([1.0, 0.0, 0.0, 1.0], 1e-6));
+  });
 }
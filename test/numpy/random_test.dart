@@ -1,3 +1,4 @@
+import 'package:mnn/mnn.dart' as mnn;
 import 'package:mnn/numpy.dart' as np;
 import 'package:test/test.dart';
 
@@ -25,4 +26,45 @@ void main() {
       expect(a.value, lessThanOrEqualTo(10));
     }
   });
+
+  test('np.randn', () {
+    final a = np.randn([64, 64], loc: 2.0, scale: 0.5, seed0: 3);
+    expect(a.shape, [64, 64]);
+    expect(np.mean(a).value, closeTo(2.0, 0.05));
+  });
+
+  test('np.defaultRng', () {
+    final rng = np.defaultRng(42);
+    final a = rng.random([1000]);
+    expect(rng.offset, 1000);
+    final b = rng.normal([2, 3]);
+    expect(rng.offset, 1006);
+
+    // the same seed gives the same stream regardless of threads, offsets continue it
+    final rng1 = np.Generator(42, numThreads: 1);
+    expect(rng1.random([1000]).data, a.data);
+    // several tasks of 65536 samples each, starting inside a Philox block
+    const count = 5 * 65536 + 7;
+    final single = np.Generator(7, offset: 3, numThreads: 1).normal([count]).data!;
+    final multi = np.Generator(7, offset: 3, numThreads: 4).normal([count]).data!;
+    expect(multi, single);
+    expect(np.Generator(42, offset: 1000).normal([2, 3]).data, b.data);
+    expect(np.Generator(42, offset: 10).random([990]).data, a.data!.sublist(10));
+
+    final c = rng.integers(-3, high: 4, size: [500]);
+    expect(np.min(c).value, greaterThanOrEqualTo(-3));
+    expect(np.max(c).value, lessThan(4));
+
+    final d = rng.bernoulli(0.25, [4000]);
+    expect(d.data!.reduce((a, b) => a + b) / 4000, closeTo(0.25, 0.03));
+    expect(() => rng.integers(3, high: 3), throwsA(isA<mnn.MNNException>()));
+  });
+
+  test('np.Generator Philox4x32-10 known answer', () {
+    // Random123 kat_vectors, zero counter and key: 6627e8d5 e169c58d bc57ac4c 9b00dbd8,
+    // integers over the full int32 range are the words minus 2^31
+    final words = np.Generator(0).integers(-0x80000000, high: 0x80000000, size: [4]);
+    const kat = [0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8];
+    expect(words.data, [for (final w in kat) w - 0x80000000]);
+  });
 }